@@ -0,0 +1,372 @@
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/renderer.hpp>
+#include <rive/shapes/paint/solid_color.hpp>
+#include <rive/transform_component.hpp>
+#include <rive/world_transform_component.hpp>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+// PSAPI_VERSION 2 resolves GetProcessMemoryInfo from kernel32.
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace bench {
+
+namespace {
+
+double percentile(const std::vector<double> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  // Nearest-rank percentile, so p99 of a small run is an actual sample.
+  size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  rank = std::clamp<size_t>(rank, 1, sorted.size());
+  return sorted[rank - 1];
+}
+
+// Mixes the calls made on it into a checksum: their kind, transforms and
+// counts, but not the render objects they pass.
+class ChecksumRenderer : public rive::Renderer {
+public:
+  explicit ChecksumRenderer(Checksum &checksum) : m_checksum(checksum) {}
+
+  void save() override { m_checksum.mix(uint64_t(1)); }
+  void restore() override { m_checksum.mix(uint64_t(2)); }
+  void transform(const rive::Mat2D &transform) override {
+    m_checksum.mix(uint64_t(3));
+    for (int i = 0; i < 6; i++) {
+      m_checksum.mix(transform[i]);
+    }
+  }
+  void drawPath(rive::RenderPath *, rive::RenderPaint *) override {
+    m_checksum.mix(uint64_t(4));
+  }
+  void clipPath(rive::RenderPath *) override { m_checksum.mix(uint64_t(5)); }
+  void drawImage(const rive::RenderImage *, rive::ImageSampler,
+                 rive::BlendMode blendMode, float opacity) override {
+    m_checksum.mix(uint64_t(6));
+    m_checksum.mix(static_cast<uint64_t>(blendMode));
+    m_checksum.mix(opacity);
+  }
+  void drawImageMesh(const rive::RenderImage *, rive::ImageSampler,
+                     rive::rcp<rive::RenderBuffer>,
+                     rive::rcp<rive::RenderBuffer>,
+                     rive::rcp<rive::RenderBuffer>, uint32_t vertexCount,
+                     uint32_t indexCount, rive::BlendMode blendMode,
+                     float opacity) override {
+    m_checksum.mix(uint64_t(7));
+    m_checksum.mix(static_cast<uint64_t>(vertexCount));
+    m_checksum.mix(static_cast<uint64_t>(indexCount));
+    m_checksum.mix(static_cast<uint64_t>(blendMode));
+    m_checksum.mix(opacity);
+  }
+
+private:
+  Checksum &m_checksum;
+};
+
+} // namespace
+
+Stats summarize(std::vector<double> &samples) {
+  Stats stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::sort(samples.begin(), samples.end());
+  stats.samples = samples.size();
+  stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) /
+               static_cast<double>(samples.size());
+  stats.p50 = percentile(samples, 0.50);
+  stats.p99 = percentile(samples, 0.99);
+  stats.max = samples.back();
+  return stats;
+}
+
+void JsonWriter::separator() {
+  if (m_hasItems.empty()) {
+    return;
+  }
+  if (m_hasItems.back()) {
+    m_out << ',';
+  }
+  m_hasItems.back() = true;
+  m_out << '\n' << std::string(m_hasItems.size() * 2, ' ');
+}
+
+void JsonWriter::writeKey(const char *key) {
+  separator();
+  if (key != nullptr) {
+    writeString(key);
+    m_out << ": ";
+  }
+}
+
+void JsonWriter::writeString(const std::string &value) {
+  m_out << '"';
+  for (char c : value) {
+    switch (c) {
+    case '"':
+      m_out << "\\\"";
+      break;
+    case '\\':
+      m_out << "\\\\";
+      break;
+    case '\n':
+      m_out << "\\n";
+      break;
+    case '\t':
+      m_out << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        m_out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+      } else {
+        m_out << c;
+      }
+      break;
+    }
+  }
+  m_out << '"';
+}
+
+void JsonWriter::beginObject() { beginObject(nullptr); }
+
+void JsonWriter::beginObject(const char *key) {
+  writeKey(key);
+  m_out << '{';
+  m_hasItems.push_back(false);
+}
+
+void JsonWriter::endObject() {
+  bool hadItems = m_hasItems.back();
+  m_hasItems.pop_back();
+  if (hadItems) {
+    m_out << '\n' << std::string(m_hasItems.size() * 2, ' ');
+  }
+  m_out << '}';
+  if (m_hasItems.empty()) {
+    m_out << '\n';
+  }
+}
+
+void JsonWriter::beginArray(const char *key) {
+  writeKey(key);
+  m_out << '[';
+  m_hasItems.push_back(false);
+}
+
+void JsonWriter::endArray() {
+  bool hadItems = m_hasItems.back();
+  m_hasItems.pop_back();
+  if (hadItems) {
+    m_out << '\n' << std::string(m_hasItems.size() * 2, ' ');
+  }
+  m_out << ']';
+}
+
+void JsonWriter::value(const char *key, const std::string &value) {
+  writeKey(key);
+  writeString(value);
+}
+
+void JsonWriter::value(const char *key, double value) {
+  writeKey(key);
+  if (std::isfinite(value)) {
+    m_out << std::fixed << std::setprecision(3) << value;
+    m_out.unsetf(std::ios_base::floatfield);
+  } else {
+    m_out << "null";
+  }
+}
+
+void JsonWriter::value(const char *key, int64_t value) {
+  writeKey(key);
+  m_out << value;
+}
+
+void JsonWriter::value(const char *key, bool value) {
+  writeKey(key);
+  m_out << (value ? "true" : "false");
+}
+
+void JsonWriter::stats(const char *key, const Stats &stats) {
+  beginObject(key);
+  value("samples", static_cast<int64_t>(stats.samples));
+  value("mean_us", stats.mean);
+  value("p50_us", stats.p50);
+  value("p99_us", stats.p99);
+  value("max_us", stats.max);
+  endObject();
+}
+
+void JsonWriter::resultsMatch(bool match) {
+  value("results_match", match);
+  m_allResultsMatch = m_allResultsMatch && match;
+}
+
+RivWriter::RivWriter() : m_writer(&m_bytes) {
+  m_writer.write(reinterpret_cast<const uint8_t *>("RIVE"), 4);
+  m_writer.writeVarUint(static_cast<uint32_t>(rive::File::majorVersion));
+  m_writer.writeVarUint(static_cast<uint32_t>(rive::File::minorVersion));
+  m_writer.writeVarUint(0u); // file id
+  m_writer.writeVarUint(0u); // no unknown properties to describe
+}
+
+uint32_t RivWriter::begin(uint16_t typeKey) {
+  beginUncounted(typeKey);
+  // Ids count from each artboard.
+  if (typeKey == rive::ArtboardBase::typeKey) {
+    m_nextId = 0;
+  }
+  return m_nextId++;
+}
+
+void RivWriter::beginUncounted(uint16_t typeKey) {
+  endObject();
+  m_writer.writeVarUint(static_cast<uint32_t>(typeKey));
+  m_open = true;
+}
+
+void RivWriter::uintValue(uint16_t key, uint32_t value) {
+  m_writer.writeVarUint(static_cast<uint32_t>(key));
+  m_writer.writeVarUint(value);
+}
+
+void RivWriter::floatValue(uint16_t key, float value) {
+  m_writer.writeVarUint(static_cast<uint32_t>(key));
+  m_writer.writeFloat(value);
+}
+
+void RivWriter::boolValue(uint16_t key, bool value) {
+  m_writer.writeVarUint(static_cast<uint32_t>(key));
+  m_writer.write(static_cast<uint8_t>(value ? 1 : 0));
+}
+
+void RivWriter::idsValue(uint16_t key, const std::vector<uint32_t> &ids) {
+  std::vector<uint8_t> encoded;
+  rive::VectorBinaryWriter idWriter(&encoded);
+  for (uint32_t id : ids) {
+    idWriter.writeVarUint(id);
+  }
+  bytesValue(key, encoded);
+}
+
+void RivWriter::bytesValue(uint16_t key, const std::vector<uint8_t> &bytes) {
+  m_writer.writeVarUint(static_cast<uint32_t>(key));
+  m_writer.writeVarUint(static_cast<uint32_t>(bytes.size()));
+  m_writer.write(bytes.data(), bytes.size());
+}
+
+void RivWriter::endObject() {
+  if (m_open) {
+    m_writer.writeVarUint(0u);
+    m_open = false;
+  }
+}
+
+uint64_t artboardChecksum(rive::ArtboardInstance &artboard) {
+  Checksum checksum;
+  for (auto object : artboard.objects()) {
+    if (object == nullptr) {
+      continue;
+    }
+    if (object->is<rive::WorldTransformComponent>()) {
+      const auto &transform =
+          object->as<rive::WorldTransformComponent>()->worldTransform();
+      for (int i = 0; i < 6; i++) {
+        checksum.mix(transform[i]);
+      }
+    }
+    if (object->is<rive::TransformComponent>()) {
+      checksum.mix(object->as<rive::TransformComponent>()->renderOpacity());
+    }
+    if (object->is<rive::SolidColor>()) {
+      checksum.mix(
+          static_cast<uint64_t>(object->as<rive::SolidColor>()->colorValue()));
+    }
+  }
+  ChecksumRenderer renderer(checksum);
+  artboard.draw(&renderer);
+  return checksum.value();
+}
+
+std::vector<uint8_t> loadFileContents(const std::filesystem::path &filepath) {
+  std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return {};
+  }
+
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<uint8_t> buffer(size);
+  if (file.read(reinterpret_cast<char *>(buffer.data()), size)) {
+    return buffer;
+  }
+  return {};
+}
+
+int64_t peakResidentKilobytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                            sizeof(counters))) {
+    return 0;
+  }
+  return static_cast<int64_t>(counters.PeakWorkingSetSize / 1024);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  // Reported in bytes on Apple platforms, KiB elsewhere.
+  return static_cast<int64_t>(usage.ru_maxrss / 1024);
+#else
+  return static_cast<int64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+std::vector<std::filesystem::path>
+findRiveFiles(const std::filesystem::path &dir, const std::string &filter) {
+  std::vector<std::filesystem::path> files;
+  std::error_code ec;
+  for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+       !ec && it != std::filesystem::recursive_directory_iterator();
+       it.increment(ec)) {
+    const auto &path = it->path();
+    if (!it->is_regular_file() || path.extension() != ".riv") {
+      continue;
+    }
+    if (!filter.empty() &&
+        path.filename().string().find(filter) == std::string::npos) {
+      continue;
+    }
+    files.push_back(path);
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+} // namespace bench
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <rive/core/vector_binary_writer.hpp>
+
+namespace rive {
+class ArtboardInstance;
+} // namespace rive
+
+// Shared helpers for the headless rive_bench target: timing, percentile
+// summaries, a tiny streaming JSON writer and .riv discovery.
+
+namespace bench {
+
+struct BenchOptions {
+  std::filesystem::path assetsDir;
+  std::string filter;     // only run files whose name contains this
+  int warmup = 10;        // untimed iterations per phase
+  int iterations = 200;   // timed iterations per phase
+  float frameSeconds = 1.0f / 60.0f;
+  int instances = 1000; // artboard copies for the fleet suite
+  int threads = 0;      // max worker threads, 0 = hardware concurrency
+  std::string loadMode = "all"; // load suite: copy, mmap, lazy or all
+};
+
+// Monotonic stopwatch reporting elapsed microseconds.
+class Stopwatch {
+public:
+  Stopwatch() : m_start(Clock::now()) {}
+
+  void reset() { m_start = Clock::now(); }
+
+  double elapsedMicros() const {
+    return std::chrono::duration<double, std::micro>(Clock::now() - m_start)
+        .count();
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point m_start;
+};
+
+struct Stats {
+  size_t samples = 0;
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+// Sorts the samples in place and returns their summary.
+Stats summarize(std::vector<double> &samples);
+
+// Minimal streaming JSON writer. Keys and values are emitted in call order;
+// commas and nesting are tracked so callers only describe structure.
+class JsonWriter {
+public:
+  explicit JsonWriter(std::ostream &out) : m_out(out) {}
+
+  void beginObject();
+  void beginObject(const char *key);
+  void endObject();
+  void beginArray(const char *key);
+  void endArray();
+
+  void value(const char *key, const std::string &value);
+  void value(const char *key, double value);
+  void value(const char *key, int64_t value);
+  void value(const char *key, bool value);
+
+  // Writes {"samples", "mean_us", "p50_us", "p99_us", "max_us"} under key.
+  void stats(const char *key, const Stats &stats);
+
+  // Writes a suite's correctness check as "results_match". rive_bench fails
+  // the run if any check didn't match.
+  void resultsMatch(bool match);
+  bool allResultsMatch() const { return m_allResultsMatch; }
+
+private:
+  void separator();
+  void writeKey(const char *key);
+  void writeString(const std::string &value);
+
+  std::ostream &m_out;
+  std::vector<bool> m_hasItems;
+  bool m_allResultsMatch = true;
+};
+
+// Writes a minimal .riv for suites that build their own synthetic files
+// instead of using the assets directory.
+class RivWriter {
+public:
+  RivWriter();
+
+  std::vector<uint8_t> &bytes() { return m_bytes; }
+
+  // Starts an object and returns its id within the artboard.
+  uint32_t begin(uint16_t typeKey);
+
+  // Objects outside the artboard's components (the backboard, view models,
+  // data binds, state machines) don't get ids.
+  void beginUncounted(uint16_t typeKey);
+
+  void uintValue(uint16_t key, uint32_t value);
+  void floatValue(uint16_t key, float value);
+  void boolValue(uint16_t key, bool value);
+  // Writes a list of var uints as a bytes property, like a data bind's
+  // source path.
+  void idsValue(uint16_t key, const std::vector<uint32_t> &ids);
+  void bytesValue(uint16_t key, const std::vector<uint8_t> &bytes);
+
+  void endObject();
+
+private:
+  std::vector<uint8_t> m_bytes;
+  rive::VectorBinaryWriter m_writer;
+  uint32_t m_nextId = 0;
+  bool m_open = false;
+};
+
+// FNV-1a over 64-bit words, for suites checking that two ways of computing
+// something agree.
+class Checksum {
+public:
+  uint64_t value() const { return m_hash; }
+
+  void mix(uint64_t word) { m_hash = (m_hash ^ word) * 0x100000001b3ull; }
+  void mix(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    mix(static_cast<uint64_t>(bits));
+  }
+
+private:
+  uint64_t m_hash = 0xcbf29ce484222325ull;
+};
+
+// Checksum of what an artboard instance shows: each component's world
+// transform and render opacity, each solid color, and the calls its draw
+// makes. Render objects are left out, so separate instances of the same
+// artboard match when they are in the same state.
+uint64_t artboardChecksum(rive::ArtboardInstance &artboard);
+
+std::vector<uint8_t> loadFileContents(const std::filesystem::path &filepath);
+
+// Process-wide peak resident set size in KiB, 0 where unsupported.
+int64_t peakResidentKilobytes();
+
+// Returns every .riv under dir (recursively), sorted by path.
+std::vector<std::filesystem::path>
+findRiveFiles(const std::filesystem::path &dir, const std::string &filter);
+
+} // namespace bench
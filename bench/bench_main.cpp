@@ -0,0 +1,180 @@
+// Headless CPU benchmark for the Rive runtime. Uses the no-op factory and
+// renderer, or a CPU-only render context, so it needs neither SDL nor a GPU,
+// and prints JSON to stdout (or to --out).
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "bench_suites.hpp"
+
+#include <rive/profiler/profiler.hpp>
+
+namespace {
+
+struct Suite {
+  const char *name;
+  bench::SuiteFn run;
+};
+
+const Suite suites[] = {
+    {"phases", bench::runPhaseBench},
+    {"fleet", bench::runFleetBench},
+    {"load", bench::runLoadBench},
+    {"instances", bench::runInstanceBench},
+    {"commands", bench::runCommandBench},
+    {"formula", bench::runFormulaBench},
+    {"skin", bench::runSkinBench},
+    {"databind", bench::runDataBindBench},
+    {"render", bench::runRenderBench},
+    {"writeresources", bench::runWriteResourcesBench},
+    {"triangulation", bench::runTriangulationBench},
+    {"gradients", bench::runGradientBench},
+    {"transitions", bench::runTransitionBench},
+    {"lists", bench::runListBench},
+    {"images", bench::runImageBench},
+    {"displaylist", bench::runDisplayListBench},
+    {"culling", bench::runCullingBench},
+};
+
+void printUsage() {
+  std::cerr << "Usage: rive_bench [options]\n"
+               "  --suite <name>       suite to run (default: phases)\n"
+               "  --assets <dir>       directory searched for .riv files\n"
+               "  --filter <text>      only files whose name contains text\n"
+               "  --warmup <n>         untimed iterations per phase\n"
+               "  --iterations <n>     timed iterations per phase\n"
+               "  --instances <n>      artboard copies (fleet, instances)\n"
+               "  --threads <n>        max worker threads (fleet, skin,\n"
+               "                       writeresources)\n"
+               "  --load-mode <mode>   copy, mmap, lazy or all (load suite)\n"
+               "  --out <file>         write JSON to file instead of stdout\n"
+               "  --trace <file>       write profiler zones as a Chrome trace\n"
+               "                       (needs RIVE_PROFILER)\n"
+               "Suites:";
+  for (const auto &suite : suites) {
+    std::cerr << " " << suite.name;
+  }
+  std::cerr << "\n";
+}
+
+#ifdef RIVE_PROFILER
+// Adds the percentiles of every profiler zone the suite recorded.
+void writeProfile(bench::JsonWriter &json) {
+  json.beginArray("profile");
+  for (const auto &zone : rive::Profiler::zoneStats()) {
+    json.beginObject();
+    json.value("zone", std::string(zone.name));
+    json.value("count", static_cast<int64_t>(zone.count));
+    json.value("p50_us", zone.p50Micros);
+    json.value("p95_us", zone.p95Micros);
+    json.value("p99_us", zone.p99Micros);
+    json.value("max_us", zone.maxMicros);
+    json.value("total_us", zone.totalMicros);
+    json.endObject();
+  }
+  json.endArray();
+}
+#endif
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  bench::BenchOptions options;
+  options.assetsDir =
+      std::filesystem::path(__FILE__).parent_path().parent_path() /
+      "assets/rive_files";
+  std::string suiteName = "phases";
+  std::string outPath;
+  std::string tracePath;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (strcmp(argv[i], "--suite") == 0 && hasValue) {
+      suiteName = argv[++i];
+    } else if (strcmp(argv[i], "--assets") == 0 && hasValue) {
+      options.assetsDir = argv[++i];
+    } else if (strcmp(argv[i], "--filter") == 0 && hasValue) {
+      options.filter = argv[++i];
+    } else if (strcmp(argv[i], "--warmup") == 0 && hasValue) {
+      options.warmup = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--iterations") == 0 && hasValue) {
+      options.iterations = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--instances") == 0 && hasValue) {
+      options.instances = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+      options.threads = std::max(0, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--load-mode") == 0 && hasValue) {
+      options.loadMode = argv[++i];
+    } else if (strcmp(argv[i], "--out") == 0 && hasValue) {
+      outPath = argv[++i];
+    } else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+      tracePath = argv[++i];
+    } else {
+      printUsage();
+      return strcmp(argv[i], "--help") == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  const Suite *suite = nullptr;
+  for (const auto &candidate : suites) {
+    if (suiteName == candidate.name) {
+      suite = &candidate;
+    }
+  }
+  if (suite == nullptr) {
+    std::cerr << "rive_bench: unknown suite '" << suiteName << "'\n";
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+#ifndef RIVE_PROFILER
+  if (!tracePath.empty()) {
+    std::cerr << "rive_bench: --trace needs a build with RIVE_PROFILER\n";
+    return EXIT_FAILURE;
+  }
+#endif
+
+  std::ofstream outFile;
+  if (!outPath.empty()) {
+    outFile.open(outPath);
+    if (!outFile.is_open()) {
+      std::cerr << "rive_bench: cannot write " << outPath << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream &out = outPath.empty() ? std::cout : outFile;
+
+  bench::JsonWriter json(out);
+  json.beginObject();
+  json.value("suite", suiteName);
+  json.beginObject("config");
+  json.value("warmup", static_cast<int64_t>(options.warmup));
+  json.value("iterations", static_cast<int64_t>(options.iterations));
+  json.value("frames_per_second",
+             static_cast<double>(1.0f / options.frameSeconds));
+  json.endObject();
+  bool ok = suite->run(options, json);
+  if (!json.allResultsMatch()) {
+    std::cerr << "rive_bench: " << suiteName << " results don't match\n";
+    ok = false;
+  }
+#ifdef RIVE_PROFILER
+  writeProfile(json);
+  if (!tracePath.empty()) {
+    std::ofstream traceFile(tracePath);
+    if (!traceFile.is_open()) {
+      std::cerr << "rive_bench: cannot write " << tracePath << "\n";
+      ok = false;
+    } else {
+      rive::Profiler::writeChromeTrace(traceFile);
+    }
+  }
+#endif
+  json.endObject();
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
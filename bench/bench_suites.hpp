@@ -0,0 +1,92 @@
+#pragma once
+
+#include "bench_common.hpp"
+
+namespace bench {
+
+// Each suite writes its results as members of the currently open JSON
+// object and returns false if it could not run at all. Checks of what a
+// suite computed go through JsonWriter::resultsMatch.
+using SuiteFn = bool (*)(const BenchOptions &, JsonWriter &);
+
+// Per-file phase timings: import, instance, linear/state machine
+// advanceAndApply and the draw walk into a no-op renderer.
+bool runPhaseBench(const BenchOptions &options, JsonWriter &json);
+
+// ArtboardFleet advance throughput over 1, 2, 4, ... threads for
+// --instances copies of each file's default artboard.
+bool runFleetBench(const BenchOptions &options, JsonWriter &json);
+
+// Time to first frame (read or map, import, instance, first advance and
+// draw) and peak RSS when loading by copy, memory-mapped with borrowed
+// asset bytes, and memory-mapped with lazily imported artboards.
+bool runLoadBench(const BenchOptions &options, JsonWriter &json);
+
+// Artboard::instance() creation and destruction rates for batches of
+// --instances live copies of each file's default artboard.
+bool runInstanceBench(const BenchOptions &options, JsonWriter &json);
+
+// CommandQueue throughput and enqueue-to-execute latency with the locked
+// and lock-free transports, driving a CommandServer on its own thread.
+bool runCommandBench(const BenchOptions &options, JsonWriter &json);
+
+// DataConverterFormula conversions per second for a set of dashboard-style
+// formulas, comparing the token interpreter with the compiled program.
+bool runFormulaBench(const BenchOptions &options, JsonWriter &json);
+
+// Skin::deform throughput on synthetic skinned rigs through the per-vertex
+// virtual path, the flattened SIMD path and the flattened path split across
+// a WorkStealingPool.
+bool runSkinBench(const BenchOptions &options, JsonWriter &json);
+
+// State machine advance cost with 10000 view model bindings of which 1%
+// change per frame, scanning every bind versus pushing only the changed
+// ones.
+bool runDataBindBench(const BenchOptions &options, JsonWriter &json);
+
+// RiveRenderer draw and RenderContext::flush times per frame for each
+// file's default state machine, on a CPU-only render context in raster
+// ordering, atomic and msaa modes, with flushes, batches and mapped bytes.
+bool runRenderBench(const BenchOptions &options, JsonWriter &json);
+
+// RenderContext::flush time for a 4K frame tiled with copies of each file's
+// artboard, writing the paths' tessellation data serially versus across a
+// WorkStealingPool, and whether both write identical buffers.
+bool runWriteResourcesBench(const BenchOptions &options, JsonWriter &json);
+
+// Frame time for each file's artboard filling a 4K headless target, with
+// large fills re-triangulated every frame versus reused from the render
+// context's triangulation cache, with the cache's hits and misses.
+bool runTriangulationBench(const BenchOptions &options, JsonWriter &json);
+
+// RenderContext::flush time for each file's default state machine with every
+// color ramp drawn into the gradient texture each flush versus kept there by
+// the render context's gradient ramp cache, with ramps reused and written.
+bool runGradientBench(const BenchOptions &options, JsonWriter &json);
+
+// State machine advance cost with 500 layers of which one changes state per
+// frame, evaluating every layer's transitions versus only those whose inputs
+// changed, with conditions evaluated and layers skipped.
+bool runTransitionBench(const BenchOptions &options, JsonWriter &json);
+
+// Bind time and scrolling frame time for an ArtboardComponentList of 2000
+// items, instancing every item versus only the visible ones with recycling,
+// with instances alive and created or recycled per frame.
+bool runListBench(const BenchOptions &options, JsonWriter &json);
+
+// Time to import a file of embedded images and until every image is
+// decoded, inline versus on an ImageDecodePool, with the decode cache cold
+// and warm from an earlier import of the same images.
+bool runImageBench(const BenchOptions &options, JsonWriter &json);
+
+// Artboard::draw time for a settled dashboard of nested artboards and each
+// file's default state machine, walking the drawables every frame versus
+// replaying the artboard's recorded display list, with draws replayed.
+bool runDisplayListBench(const BenchOptions &options, JsonWriter &json);
+
+// Frame time for a map of 256 nested tile artboards and each file's default
+// state machine panned through a viewport on a headless target, drawing every
+// drawable versus culling those outside, with drawn and culled counts.
+bool runCullingBench(const BenchOptions &options, JsonWriter &json);
+
+} // namespace bench
@@ -0,0 +1,187 @@
+#include "bench_suites.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/command_queue.hpp>
+#include <rive/command_server.hpp>
+#include <rive/file.hpp>
+#include <utils/no_op_factory.hpp>
+
+namespace bench {
+
+namespace {
+
+// pointerMove commands sent per timed burst.
+constexpr int kCommandsPerBurst = 10000;
+// Numbered commands sent to check the order they run in.
+constexpr int kCheckCommands = 1000;
+
+struct TransportRun {
+  const char *name;
+  rive::CommandQueue::Transport transport;
+  bool batched;
+};
+
+const TransportRun transportRuns[] = {
+    {"locked", rive::CommandQueue::Transport::locked, false},
+    {"lock_free", rive::CommandQueue::Transport::lockFree, false},
+    {"lock_free_batched", rive::CommandQueue::Transport::lockFree, true},
+};
+
+// Returns the first file whose default artboard has a state machine.
+std::vector<uint8_t> findStateMachineFile(const BenchOptions &options,
+                                          std::string &fileName) {
+  rive::NoOpFactory factory;
+  for (const auto &path : findRiveFiles(options.assetsDir, options.filter)) {
+    auto bytes = loadFileContents(path);
+    auto file = rive::File::import(
+        rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+    if (!file) {
+      continue;
+    }
+    auto artboard = file->artboardDefault();
+    if (artboard && artboard->defaultStateMachine()) {
+      fileName = path.filename().string();
+      return bytes;
+    }
+  }
+  return {};
+}
+
+// Blocks until the server has run everything recorded so far and returns
+// when (in steady clock microseconds since the stopwatch started) it ran the
+// marker command.
+double runMarker(rive::CommandQueue &queue, const Stopwatch &stopwatch) {
+  std::atomic<bool> done{false};
+  double executedMicros = 0.0;
+  queue.runOnce([&](rive::CommandServer *) {
+    executedMicros = stopwatch.elapsedMicros();
+    done.store(true, std::memory_order_release);
+  });
+  while (!done.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  return executedMicros;
+}
+
+void benchTransport(const BenchOptions &options, const TransportRun &run,
+                    const std::vector<uint8_t> &bytes, JsonWriter &json) {
+  auto queue = rive::make_rcp<rive::CommandQueue>(run.transport);
+  std::thread serverThread([queue]() {
+    rive::NoOpFactory factory;
+    rive::CommandServer server(queue, &factory);
+    server.serveUntilDisconnect();
+  });
+
+  auto fileHandle = queue->loadFile(bytes);
+  auto artboardHandle = queue->instantiateDefaultArtboard(fileHandle);
+  auto stateMachineHandle =
+      queue->instantiateDefaultStateMachine(artboardHandle);
+  runMarker(*queue, Stopwatch());
+
+  // Throughput: a burst of pointer moves followed by a marker, timed until
+  // the server has executed all of them.
+  std::vector<double> burstSamples;
+  burstSamples.reserve(options.iterations);
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    Stopwatch stopwatch;
+    if (run.batched) {
+      queue->beginBatch();
+    }
+    for (int j = 0; j < kCommandsPerBurst; j++) {
+      queue->pointerMove(stateMachineHandle,
+                         rive::Vec2D(static_cast<float>(j % 500),
+                                     static_cast<float>(j % 300)));
+    }
+    if (run.batched) {
+      queue->commitBatch();
+    }
+    double micros = runMarker(*queue, stopwatch);
+    if (i >= options.warmup) {
+      burstSamples.push_back(micros);
+    }
+  }
+
+  // Latency: a single command sent to an idle server, from enqueue to the
+  // server executing it, so it includes waking the server thread.
+  std::vector<double> latencySamples;
+  latencySamples.reserve(options.iterations);
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    Stopwatch stopwatch;
+    double micros = runMarker(*queue, stopwatch);
+    if (i >= options.warmup) {
+      latencySamples.push_back(micros);
+    }
+  }
+
+  // Each command must run once, in the order sent: numbered runOnce
+  // commands between pointer moves must all run, in order.
+  std::vector<int> executed;
+  if (run.batched) {
+    queue->beginBatch();
+  }
+  for (int j = 0; j < kCheckCommands; j++) {
+    queue->pointerMove(stateMachineHandle,
+                       rive::Vec2D(static_cast<float>(j), 0.0f));
+    queue->runOnce(
+        [&executed, j](rive::CommandServer *) { executed.push_back(j); });
+  }
+  if (run.batched) {
+    queue->commitBatch();
+  }
+  runMarker(*queue, Stopwatch());
+  bool resultsMatch = executed.size() == static_cast<size_t>(kCheckCommands);
+  for (size_t j = 0; resultsMatch && j < executed.size(); j++) {
+    resultsMatch = executed[j] == static_cast<int>(j);
+  }
+
+  queue->deleteStateMachine(stateMachineHandle);
+  queue->deleteArtboard(artboardHandle);
+  queue->deleteFile(fileHandle);
+  queue->disconnect();
+  serverThread.join();
+
+  Stats burst = summarize(burstSamples);
+  json.beginObject();
+  json.value("transport", std::string(run.name));
+  json.value("batched", run.batched);
+  json.stats("burst", burst);
+  // Commands (pointer moves plus the marker) per second at the median
+  // burst.
+  json.value("commands_per_second",
+             burst.p50 > 0.0 ? (kCommandsPerBurst + 1) * 1e6 / burst.p50
+                             : 0.0);
+  json.stats("enqueue_to_execute", summarize(latencySamples));
+  json.resultsMatch(resultsMatch);
+  json.endObject();
+}
+
+} // namespace
+
+bool runCommandBench(const BenchOptions &options, JsonWriter &json) {
+  std::string fileName;
+  auto bytes = findStateMachineFile(options, fileName);
+  if (bytes.empty()) {
+    std::cerr << "rive_bench: no .riv file with a state machine under "
+              << options.assetsDir << "\n";
+    return false;
+  }
+
+  json.value("file", fileName);
+  json.value("commands_per_burst", static_cast<int64_t>(kCommandsPerBurst));
+  json.beginArray("transports");
+  for (const auto &run : transportRuns) {
+    benchTransport(options, run, bytes, json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
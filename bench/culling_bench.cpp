@@ -0,0 +1,376 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/animation/state_machine_base.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/component_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <rive/generated/nested_artboard_base.hpp>
+#include <rive/generated/node_base.hpp>
+#include <rive/generated/shapes/paint/fill_base.hpp>
+#include <rive/generated/shapes/paint/solid_color_base.hpp>
+#include <rive/generated/shapes/paint/stroke_base.hpp>
+#include <rive/generated/shapes/parametric_path_base.hpp>
+#include <rive/generated/shapes/rectangle_base.hpp>
+#include <rive/generated/shapes/shape_base.hpp>
+#include <rive/nested_artboard.hpp>
+#include <rive/renderer/headless/render_context_headless_impl.hpp>
+#include <rive/renderer/render_context.hpp>
+#include <rive/renderer/rive_renderer.hpp>
+#include <rive/shapes/paint/stroke_join.hpp>
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTargetWidth = 1920;
+constexpr uint32_t kTargetHeight = 1080;
+
+// A map: kGridSize x kGridSize nested copies of a clipping tile artboard of
+// kShapesPerRow x kShapesPerRow filled and stroked squares, viewed through a
+// kViewWidth x kViewHeight viewport filling the target.
+constexpr int kGridSize = 16;
+constexpr int kShapesPerRow = 4;
+constexpr float kTileSize = 160.0f;
+constexpr float kShapeSpacing = 40.0f;
+constexpr float kShapeSize = 24.0f;
+// Round joins keep the stroke within half its thickness of the path.
+constexpr float kStrokeThickness = 2.0f;
+constexpr float kViewWidth = 960.0f;
+constexpr float kViewHeight = 540.0f;
+// How far the viewport pans each frame, in artboard units.
+constexpr float kPanStep = 13.0f;
+
+// The center of a tile's i-th square, along either axis.
+float shapeCenter(int i) { return kShapeSpacing * (i + 0.5f); }
+
+std::vector<uint8_t> buildMapFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+
+  uint32_t host = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey,
+                 kTileSize * kGridSize);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey,
+                 kTileSize * kGridSize);
+  for (int i = 0; i < kGridSize * kGridSize; i++) {
+    riv.begin(rive::NestedArtboardBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, host);
+    riv.floatValue(rive::NodeBase::xPropertyKey, kTileSize * (i % kGridSize));
+    riv.floatValue(rive::NodeBase::yPropertyKey, kTileSize * (i / kGridSize));
+    // The tile is the file's second artboard.
+    riv.uintValue(rive::NestedArtboardBase::artboardIdPropertyKey, 1);
+  }
+  riv.beginUncounted(rive::StateMachineBase::typeKey);
+
+  uint32_t tile = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, kTileSize);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, kTileSize);
+  riv.boolValue(rive::LayoutComponentBase::clipPropertyKey, true);
+  for (int i = 0; i < kShapesPerRow * kShapesPerRow; i++) {
+    uint32_t shape = riv.begin(rive::ShapeBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, tile);
+    riv.floatValue(rive::NodeBase::xPropertyKey,
+                   shapeCenter(i % kShapesPerRow));
+    riv.floatValue(rive::NodeBase::yPropertyKey,
+                   shapeCenter(i / kShapesPerRow));
+    riv.begin(rive::RectangleBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.floatValue(rive::ParametricPathBase::widthPropertyKey, kShapeSize);
+    riv.floatValue(rive::ParametricPathBase::heightPropertyKey, kShapeSize);
+    uint32_t fill = riv.begin(rive::FillBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.begin(rive::SolidColorBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, fill);
+    uint32_t stroke = riv.begin(rive::StrokeBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.floatValue(rive::StrokeBase::thicknessPropertyKey, kStrokeThickness);
+    riv.uintValue(rive::StrokeBase::joinPropertyKey,
+                  static_cast<uint32_t>(rive::StrokeJoin::round));
+    riv.begin(rive::SolidColorBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, stroke);
+  }
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+// Whether [min, max] overlaps [regionMin, regionMax], touching included,
+// like the artboard's cull test.
+bool overlaps(float min, float max, float regionMin, float regionMax) {
+  return max >= regionMin && min <= regionMax;
+}
+
+// Drawables of the map a draw through viewport must draw: the tiles it
+// overlaps and, within each, the squares it overlaps.
+uint64_t expectedMapDrawn(const rive::AABB &viewport) {
+  uint64_t drawn = 0;
+  const float outset = kShapeSize * 0.5f + kStrokeThickness * 0.5f;
+  for (int row = 0; row < kGridSize; row++) {
+    for (int column = 0; column < kGridSize; column++) {
+      float left = kTileSize * column;
+      float top = kTileSize * row;
+      if (!overlaps(left, left + kTileSize, viewport.minX, viewport.maxX) ||
+          !overlaps(top, top + kTileSize, viewport.minY, viewport.maxY)) {
+        continue;
+      }
+      drawn++;
+      // Tiles clip, so only the part of the viewport inside one culls.
+      float minX = std::max(viewport.minX - left, 0.0f);
+      float minY = std::max(viewport.minY - top, 0.0f);
+      float maxX = std::min(viewport.maxX - left, kTileSize);
+      float maxY = std::min(viewport.maxY - top, kTileSize);
+      for (int i = 0; i < kShapesPerRow * kShapesPerRow; i++) {
+        float x = shapeCenter(i % kShapesPerRow);
+        float y = shapeCenter(i / kShapesPerRow);
+        if (overlaps(x - outset, x + outset, minX, maxX) &&
+            overlaps(y - outset, y + outset, minY, maxY)) {
+          drawn++;
+        }
+      }
+    }
+  }
+  return drawn;
+}
+
+// Bounces position back and forth across [0, range].
+float pingPong(float position, float range) {
+  if (range <= 0.0f) {
+    return 0.0f;
+  }
+  float t = std::fmod(position, range * 2.0f);
+  return t > range ? range * 2.0f - t : t;
+}
+
+// The frame-th viewport of size viewSize panning over bounds, twice as fast
+// across as down.
+rive::AABB viewportAt(int frame, const rive::AABB &bounds,
+                      rive::Vec2D viewSize) {
+  float x = bounds.minX +
+            pingPong(frame * kPanStep, bounds.width() - viewSize.x);
+  float y = bounds.minY +
+            pingPong(frame * kPanStep * 0.5f, bounds.height() - viewSize.y);
+  return rive::AABB::fromLTWH(x, y, viewSize.x, viewSize.y);
+}
+
+// Drawn and culled counts of artboard and every artboard nested in it.
+rive::Artboard::CullingCounters
+totalCullingCounters(rive::Artboard *artboard) {
+  rive::Artboard::CullingCounters total = artboard->cullingCounters();
+  for (auto nested : artboard->nestedArtboards()) {
+    if (nested->artboardInstance() != nullptr) {
+      auto counters = totalCullingCounters(nested->artboardInstance());
+      total.drawablesDrawn += counters.drawablesDrawn;
+      total.drawablesCulled += counters.drawablesCulled;
+    }
+  }
+  return total;
+}
+
+struct CullMode {
+  const char *name;
+  bool drawAll;
+};
+
+const CullMode cullModes[] = {
+    {"draw_all", true},
+    {"culled", false},
+};
+
+struct Scene {
+  std::string name;
+  rive::Span<const uint8_t> data;
+  // The part of the artboard's width and height shown.
+  rive::Vec2D viewFraction;
+  // Checks the drawn counts against expectedMapDrawn().
+  bool isMap;
+};
+
+// The top artboard's drawables drawn each frame of the draw_all mode, to
+// check that culled frames account for every one.
+using FrameCounts = std::vector<uint64_t>;
+
+bool benchMode(const BenchOptions &options, const Scene &scene,
+               const CullMode &mode, FrameCounts *visible,
+               double *drawAllP50, JsonWriter &json, bool *resultsMatch) {
+  auto context = rive::gpu::RenderContextHeadlessImpl::MakeContext({});
+  auto *impl =
+      context->static_impl_cast<rive::gpu::RenderContextHeadlessImpl>();
+  rive::gpu::RenderTargetHeadless target(kTargetWidth, kTargetHeight);
+
+  auto file = rive::File::import(scene.data, context.get());
+  auto artboard = file != nullptr ? file->artboardDefault() : nullptr;
+  if (artboard == nullptr) {
+    return false;
+  }
+  std::unique_ptr<rive::StateMachineInstance> machine;
+  if (artboard->stateMachineCount() > 0) {
+    machine = artboard->defaultStateMachine();
+    if (!machine) {
+      machine = artboard->stateMachineAt(0);
+    }
+  }
+  // Nested artboards get no viewport from an artboard drawing everything.
+  artboard->forceDrawAll(mode.drawAll);
+  rive::Vec2D viewSize = {artboard->width() * scene.viewFraction.x,
+                          artboard->height() * scene.viewFraction.y};
+  float scale = std::min(kTargetWidth / viewSize.x,
+                         kTargetHeight / viewSize.y);
+
+  std::vector<double> drawSamples;
+  std::vector<double> flushSamples;
+  std::vector<double> frameSamples;
+  drawSamples.reserve(options.iterations);
+  flushSamples.reserve(options.iterations);
+  frameSamples.reserve(options.iterations);
+  uint64_t drawn = 0;
+  uint64_t culled = 0;
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    if (i == options.warmup) {
+      impl->resetCounters();
+    }
+    if (machine) {
+      machine->advanceAndApply(options.frameSeconds);
+    } else {
+      artboard->advance(options.frameSeconds);
+    }
+    rive::AABB viewport = viewportAt(i, artboard->bounds(), viewSize);
+    artboard->viewport(viewport);
+    rive::Artboard::CullingCounters before =
+        totalCullingCounters(artboard.get());
+    rive::Artboard::CullingCounters rootBefore = artboard->cullingCounters();
+
+    Stopwatch stopwatch;
+    rive::gpu::RenderContext::FrameDescriptor frameDescriptor;
+    frameDescriptor.renderTargetWidth = kTargetWidth;
+    frameDescriptor.renderTargetHeight = kTargetHeight;
+    frameDescriptor.loadAction = rive::gpu::LoadAction::clear;
+    frameDescriptor.clearColor = 0xFF404040;
+    context->beginFrame(frameDescriptor);
+    rive::RiveRenderer renderer(context.get());
+    renderer.save();
+    renderer.transform(rive::Mat2D::fromScale(scale, scale) *
+                       rive::Mat2D::fromTranslate(-viewport.minX,
+                                                  -viewport.minY));
+    artboard->draw(&renderer);
+    renderer.restore();
+    double drawMicros = stopwatch.elapsedMicros();
+
+    stopwatch.reset();
+    rive::gpu::RenderContext::FlushResources flushResources;
+    flushResources.renderTarget = &target;
+    // Nothing is in flight on a headless context, so everything is safe.
+    flushResources.currentFrameNumber = i + 1;
+    flushResources.safeFrameNumber = i + 1;
+    context->flush(flushResources);
+    double flushMicros = stopwatch.elapsedMicros();
+
+    rive::Artboard::CullingCounters after =
+        totalCullingCounters(artboard.get());
+    uint64_t frameDrawn = after.drawablesDrawn - before.drawablesDrawn;
+    uint64_t frameCulled = after.drawablesCulled - before.drawablesCulled;
+    // The contents of a culled nested artboard are neither drawn nor culled,
+    // so only the top artboard's drawables add up to the same count.
+    const auto &rootAfter = artboard->cullingCounters();
+    uint64_t rootCount = rootAfter.drawablesDrawn + rootAfter.drawablesCulled -
+                         rootBefore.drawablesDrawn - rootBefore.drawablesCulled;
+    bool frameMatches;
+    if (mode.drawAll) {
+      visible->push_back(rootCount);
+      frameMatches = frameCulled == 0;
+    } else {
+      frameMatches = static_cast<size_t>(i) < visible->size() &&
+                     rootCount == (*visible)[i] &&
+                     (!scene.isMap || frameDrawn == expectedMapDrawn(viewport));
+    }
+    *resultsMatch = *resultsMatch && frameMatches;
+    if (i >= options.warmup) {
+      drawSamples.push_back(drawMicros);
+      flushSamples.push_back(flushMicros);
+      frameSamples.push_back(drawMicros + flushMicros);
+      drawn += frameDrawn;
+      culled += frameCulled;
+    }
+  }
+
+  const auto &counters = impl->counters();
+  double frames = std::max(options.iterations, 1);
+  Stats frameStats = summarize(frameSamples);
+  if (mode.drawAll) {
+    *drawAllP50 = frameStats.p50;
+  }
+  json.beginObject();
+  json.value("mode", std::string(mode.name));
+  json.stats("draw", summarize(drawSamples));
+  json.stats("flush", summarize(flushSamples));
+  json.stats("frame", frameStats);
+  json.value("drawn_per_frame", drawn / frames);
+  json.value("culled_per_frame", culled / frames);
+  json.value("draw_batches_per_frame", counters.drawBatches / frames);
+  json.value("bytes_mapped_per_frame", counters.bytesMapped / frames);
+  json.value("speedup",
+             frameStats.p50 > 0.0 ? *drawAllP50 / frameStats.p50 : 0.0);
+  json.endObject();
+  return true;
+}
+
+bool benchScene(const BenchOptions &options, const Scene &scene,
+                JsonWriter &json) {
+  json.beginObject();
+  json.value("file", scene.name);
+  json.beginArray("modes");
+  FrameCounts visible;
+  double drawAllP50 = 0.0;
+  bool resultsMatch = true;
+  bool ok = true;
+  for (const auto &mode : cullModes) {
+    if (!benchMode(options, scene, mode, &visible, &drawAllP50, json,
+                   &resultsMatch)) {
+      std::cerr << "rive_bench: failed to render " << scene.name << "\n";
+      ok = false;
+      break;
+    }
+  }
+  json.endArray();
+  json.resultsMatch(ok && resultsMatch);
+  json.endObject();
+  return ok;
+}
+
+} // namespace
+
+bool runCullingBench(const BenchOptions &options, JsonWriter &json) {
+  auto map = buildMapFile();
+  json.value("target_width", static_cast<int64_t>(kTargetWidth));
+  json.value("target_height", static_cast<int64_t>(kTargetHeight));
+  json.value("tiles", static_cast<int64_t>(kGridSize * kGridSize));
+  json.value("shapes_per_tile",
+             static_cast<int64_t>(kShapesPerRow * kShapesPerRow));
+  json.beginArray("files");
+  const float mapSize = kTileSize * kGridSize;
+  Scene mapScene = {"map", rive::Span<const uint8_t>(map.data(), map.size()),
+                    {kViewWidth / mapSize, kViewHeight / mapSize}, true};
+  if (!benchScene(options, mapScene, json)) {
+    json.endArray();
+    return false;
+  }
+  // Files are viewed a quarter at a time.
+  for (const auto &path : findRiveFiles(options.assetsDir, options.filter)) {
+    auto bytes = loadFileContents(path);
+    Scene scene = {path.filename().string(),
+                   rive::Span<const uint8_t>(bytes.data(), bytes.size()),
+                   {0.5f, 0.5f}, false};
+    benchScene(options, scene, json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,187 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/animation/state_machine_base.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/component_base.hpp>
+#include <rive/generated/data_bind/data_bind_base.hpp>
+#include <rive/generated/data_bind/data_bind_context_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <rive/generated/node_base.hpp>
+#include <rive/generated/viewmodel/viewmodel_base.hpp>
+#include <rive/generated/viewmodel/viewmodel_property_number_base.hpp>
+#include <rive/node.hpp>
+#include <rive/viewmodel/viewmodel_instance_number.hpp>
+#include <utils/no_op_factory.hpp>
+
+namespace bench {
+
+namespace {
+
+// A dashboard-like view model: kProperties numbers, each bound to the x of
+// kBindsPerProperty nodes. Each frame writes kChangedPerFrame properties,
+// so 1% of the binds see a change.
+constexpr int kProperties = 1000;
+constexpr int kBindsPerProperty = 10;
+constexpr int kBinds = kProperties * kBindsPerProperty;
+constexpr int kChangedPerFrame = kProperties / 100;
+
+// Writes a .riv with the view model and an artboard of kBinds nodes, each
+// with a data bind from its x to a property, plus an empty state machine
+// to drive them the way a player does.
+std::vector<uint8_t> buildBoundFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+  riv.beginUncounted(rive::ViewModelBase::typeKey);
+  for (int i = 0; i < kProperties; i++) {
+    riv.beginUncounted(rive::ViewModelPropertyNumberBase::typeKey);
+  }
+
+  uint32_t artboard = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, 1000.0f);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, 1000.0f);
+  for (int i = 0; i < kBinds; i++) {
+    riv.begin(rive::NodeBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, artboard);
+    // Binds attach to the object before them. Neighbouring nodes read
+    // different properties, so a property's binds are spread out.
+    riv.beginUncounted(rive::DataBindContextBase::typeKey);
+    riv.uintValue(rive::DataBindBase::propertyKeyPropertyKey,
+                  rive::NodeBase::xPropertyKey);
+    riv.idsValue(rive::DataBindContextBase::sourcePathIdsPropertyKey,
+                 {0u, static_cast<uint32_t>(i % kProperties)});
+  }
+  riv.beginUncounted(rive::StateMachineBase::typeKey);
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+struct ScanMode {
+  const char *name;
+  bool fullScan;
+};
+
+const ScanMode scanModes[] = {
+    {"full_scan", true},
+    {"push", false},
+};
+
+struct FrameTotals {
+  std::vector<double> samples;
+  uint64_t bindsVisited = 0;
+  uint64_t bindsUpdated = 0;
+};
+
+// Writes this frame's properties, then times the state machine's advance.
+void runFrame(rive::StateMachineInstance &machine,
+              std::vector<rive::ViewModelInstanceNumber *> &properties,
+              int frame, FrameTotals *totals) {
+  for (int i = 0; i < kChangedPerFrame; i++) {
+    int property = (frame * kChangedPerFrame + i * 97) % kProperties;
+    properties[property]->propertyValue(static_cast<float>(frame + i));
+  }
+
+  auto &artboardQueue = machine.artboard()->dataBindQueue();
+  artboardQueue.resetCounters();
+  machine.dataBindQueue().resetCounters();
+  Stopwatch stopwatch;
+  machine.advanceAndApply(1.0f / 60.0f);
+  double micros = stopwatch.elapsedMicros();
+  if (totals != nullptr) {
+    totals->samples.push_back(micros);
+    totals->bindsVisited += artboardQueue.counters().visited +
+                            machine.dataBindQueue().counters().visited;
+    totals->bindsUpdated += artboardQueue.counters().updated +
+                            machine.dataBindQueue().counters().updated;
+  }
+}
+
+} // namespace
+
+bool runDataBindBench(const BenchOptions &options, JsonWriter &json) {
+  auto bytes = buildBoundFile();
+  rive::NoOpFactory factory;
+  auto file = rive::File::import(
+      rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+  if (!file) {
+    std::cerr << "rive_bench: failed to import the synthetic bindings\n";
+    return false;
+  }
+  auto artboard = file->artboardDefault();
+  auto machine = artboard->stateMachineAt(0);
+  auto viewModelInstance = file->createViewModelInstance(file->viewModel(0));
+  if (machine == nullptr || viewModelInstance == nullptr) {
+    std::cerr << "rive_bench: the synthetic bindings are incomplete\n";
+    return false;
+  }
+  machine->bindViewModelInstance(viewModelInstance);
+
+  std::vector<rive::ViewModelInstanceNumber *> properties;
+  for (auto value : viewModelInstance->propertyValues()) {
+    properties.push_back(value->as<rive::ViewModelInstanceNumber>());
+  }
+  std::vector<rive::Node *> nodes;
+  for (auto object : artboard->objects()) {
+    if (object != nullptr && object->is<rive::Node>() &&
+        object != artboard.get()) {
+      nodes.push_back(object->as<rive::Node>());
+    }
+  }
+  // Applies the initial values of every bind.
+  machine->advanceAndApply(0.0f);
+
+  json.value("binds", static_cast<int64_t>(artboard->allDataBinds().size()));
+  json.value("properties", static_cast<int64_t>(properties.size()));
+  json.value("changed_binds_per_frame",
+             static_cast<int64_t>(kChangedPerFrame * kBindsPerProperty));
+  json.beginArray("modes");
+  double fullScanP50 = 0.0;
+  bool resultsMatch = true;
+  // Frames are numbered across modes so every write is a new value.
+  int frame = 0;
+  for (const auto &mode : scanModes) {
+    artboard->dataBindQueue().forceFullScan(mode.fullScan);
+    machine->dataBindQueue().forceFullScan(mode.fullScan);
+
+    FrameTotals totals;
+    totals.samples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      runFrame(*machine, properties, frame++,
+               i >= options.warmup ? &totals : nullptr);
+    }
+    // Every node should now hold the value of the property it reads.
+    for (size_t i = 0; i < nodes.size(); i++) {
+      float expected = properties[i % kProperties]->propertyValue();
+      resultsMatch = resultsMatch && nodes[i]->x() == expected;
+    }
+
+    int frames = std::max(options.iterations, 1);
+    Stats stats = summarize(totals.samples);
+    if (mode.fullScan) {
+      fullScanP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("advance", stats);
+    json.value("binds_visited_per_frame",
+               static_cast<double>(totals.bindsVisited) / frames);
+    json.value("binds_updated_per_frame",
+               static_cast<double>(totals.bindsUpdated) / frames);
+    json.value("speedup", stats.p50 > 0.0 ? fullScanP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  json.resultsMatch(resultsMatch);
+
+  artboard->dataBindQueue().forceFullScan(false);
+  machine->dataBindQueue().forceFullScan(false);
+  return true;
+}
+
+} // namespace bench
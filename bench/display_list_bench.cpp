@@ -0,0 +1,284 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/animation/state_machine_base.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/component_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <rive/generated/nested_artboard_base.hpp>
+#include <rive/generated/node_base.hpp>
+#include <rive/generated/shapes/paint/fill_base.hpp>
+#include <rive/generated/shapes/paint/solid_color_base.hpp>
+#include <rive/generated/shapes/paint/stroke_base.hpp>
+#include <rive/generated/shapes/parametric_path_base.hpp>
+#include <rive/generated/shapes/rectangle_base.hpp>
+#include <rive/generated/shapes/shape_base.hpp>
+#include <rive/nested_artboard.hpp>
+#include <utils/no_op_factory.hpp>
+
+namespace bench {
+
+namespace {
+
+// A dashboard: kWidgets nested copies of a widget artboard of
+// kShapesPerWidget filled and stroked rectangles, kColumns to a row. Nothing
+// animates, so it settles on its first frame.
+constexpr int kWidgets = 64;
+constexpr int kShapesPerWidget = 16;
+constexpr int kColumns = 8;
+constexpr float kWidgetSize = 120.0f;
+// Files still changing after this many frames are benched unsettled.
+constexpr int kSettleFrames = 600;
+
+std::vector<uint8_t> buildDashboardFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+
+  uint32_t host = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey,
+                 kWidgetSize * kColumns);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey,
+                 kWidgetSize * (kWidgets / kColumns));
+  for (int i = 0; i < kWidgets; i++) {
+    riv.begin(rive::NestedArtboardBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, host);
+    riv.floatValue(rive::NodeBase::xPropertyKey,
+                   kWidgetSize * (i % kColumns));
+    riv.floatValue(rive::NodeBase::yPropertyKey,
+                   kWidgetSize * (i / kColumns));
+    // The widget is the file's second artboard.
+    riv.uintValue(rive::NestedArtboardBase::artboardIdPropertyKey, 1);
+  }
+  riv.beginUncounted(rive::StateMachineBase::typeKey);
+
+  uint32_t widget = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, kWidgetSize);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, kWidgetSize);
+  for (int i = 0; i < kShapesPerWidget; i++) {
+    uint32_t shape = riv.begin(rive::ShapeBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, widget);
+    riv.floatValue(rive::NodeBase::xPropertyKey, 10.0f + (i % 4) * 28.0f);
+    riv.floatValue(rive::NodeBase::yPropertyKey, 10.0f + (i / 4) * 28.0f);
+    riv.begin(rive::RectangleBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.floatValue(rive::ParametricPathBase::widthPropertyKey, 20.0f);
+    riv.floatValue(rive::ParametricPathBase::heightPropertyKey, 20.0f);
+    uint32_t fill = riv.begin(rive::FillBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.begin(rive::SolidColorBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, fill);
+    uint32_t stroke = riv.begin(rive::StrokeBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.floatValue(rive::StrokeBase::thicknessPropertyKey, 2.0f);
+    riv.begin(rive::SolidColorBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, stroke);
+  }
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+// Hashes the calls made on it, render objects by address, so two draws of
+// the same artboard match only if they issue the same calls.
+class ChecksumRenderer : public rive::Renderer {
+public:
+  uint64_t checksum() const { return m_hash; }
+  uint64_t calls() const { return m_calls; }
+  void reset() {
+    m_hash = 0xcbf29ce484222325ull;
+    m_calls = 0;
+  }
+
+  void save() override { call(1); }
+  void restore() override { call(2); }
+  void transform(const rive::Mat2D &transform) override {
+    call(3);
+    for (int i = 0; i < 6; i++) {
+      uint32_t bits;
+      memcpy(&bits, &transform[i], sizeof(bits));
+      mix(bits);
+    }
+  }
+  void drawPath(rive::RenderPath *path, rive::RenderPaint *paint) override {
+    call(4);
+    mix(reinterpret_cast<uintptr_t>(path));
+    mix(reinterpret_cast<uintptr_t>(paint));
+  }
+  void clipPath(rive::RenderPath *path) override {
+    call(5);
+    mix(reinterpret_cast<uintptr_t>(path));
+  }
+  void drawImage(const rive::RenderImage *image, rive::ImageSampler,
+                 rive::BlendMode blendMode, float) override {
+    call(6);
+    mix(reinterpret_cast<uintptr_t>(image));
+    mix(static_cast<uint64_t>(blendMode));
+  }
+  void drawImageMesh(const rive::RenderImage *image, rive::ImageSampler,
+                     rive::rcp<rive::RenderBuffer>,
+                     rive::rcp<rive::RenderBuffer>,
+                     rive::rcp<rive::RenderBuffer>, uint32_t vertexCount,
+                     uint32_t indexCount, rive::BlendMode blendMode,
+                     float) override {
+    call(7);
+    mix(reinterpret_cast<uintptr_t>(image));
+    mix(vertexCount);
+    mix(indexCount);
+    mix(static_cast<uint64_t>(blendMode));
+  }
+
+private:
+  void call(uint64_t kind) {
+    m_calls++;
+    mix(kind);
+  }
+  void mix(uint64_t value) { m_hash = (m_hash ^ value) * 0x100000001b3ull; }
+
+  uint64_t m_hash = 0xcbf29ce484222325ull;
+  uint64_t m_calls = 0;
+};
+
+struct DrawMode {
+  const char *name;
+  bool forceTraversal;
+};
+
+const DrawMode drawModes[] = {
+    {"traverse", true},
+    {"replay", false},
+};
+
+// Sets forceDrawTraversal on artboard and every artboard nested in it.
+void forceTraversal(rive::Artboard *artboard, bool value) {
+  artboard->forceDrawTraversal(value);
+  for (auto nested : artboard->nestedArtboards()) {
+    if (nested->artboardInstance() != nullptr) {
+      forceTraversal(nested->artboardInstance(), value);
+    }
+  }
+}
+
+void benchArtboard(const BenchOptions &options, const std::string &name,
+                   rive::ArtboardInstance *artboard,
+                   rive::StateMachineInstance *machine, JsonWriter &json) {
+  auto advance = [&]() {
+    return machine != nullptr ? machine->advanceAndApply(options.frameSeconds)
+                              : artboard->advance(options.frameSeconds);
+  };
+  int settleFrames = 0;
+  while (settleFrames < kSettleFrames && advance()) {
+    settleFrames++;
+  }
+
+  json.beginObject();
+  json.value("file", name);
+  json.value("settled", settleFrames < kSettleFrames);
+  json.beginArray("modes");
+  ChecksumRenderer renderer;
+  double traverseP50 = 0.0;
+  size_t commands = 0;
+  bool resultsMatch = true;
+  for (const auto &mode : drawModes) {
+    forceTraversal(artboard, mode.forceTraversal);
+    artboard->resetDisplayListCounters();
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    uint64_t calls = 0;
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      if (i == options.warmup) {
+        artboard->resetDisplayListCounters();
+      }
+      advance();
+      renderer.reset();
+      Stopwatch stopwatch;
+      artboard->draw(&renderer);
+      double micros = stopwatch.elapsedMicros();
+      if (i >= options.warmup) {
+        samples.push_back(micros);
+        calls += renderer.calls();
+      }
+    }
+    // Copied before the check below draws again.
+    rive::Artboard::DisplayListCounters counters =
+        artboard->displayListCounters();
+    double frames = std::max(options.iterations, 1);
+    Stats stats = summarize(samples);
+    if (mode.forceTraversal) {
+      traverseP50 = stats.p50;
+    } else {
+      const auto &list = artboard->displayList();
+      commands = list != nullptr ? list->commandCount() : 0;
+      // Whatever was drawn last, a traversal of the same frame must issue
+      // the same calls.
+      renderer.reset();
+      artboard->draw(&renderer);
+      uint64_t drawn = renderer.checksum();
+      forceTraversal(artboard, true);
+      renderer.reset();
+      artboard->draw(&renderer);
+      resultsMatch = resultsMatch && drawn == renderer.checksum();
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("draw", stats);
+    json.value("calls_per_frame", calls / frames);
+    json.value("traversed_per_frame", counters.drawsTraversed / frames);
+    json.value("recorded_per_frame", counters.drawsRecorded / frames);
+    json.value("replayed_per_frame", counters.drawsReplayed / frames);
+    json.value("speedup", stats.p50 > 0.0 ? traverseP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  json.value("display_list_commands", static_cast<int64_t>(commands));
+  json.resultsMatch(resultsMatch);
+  json.endObject();
+}
+
+bool benchFile(const BenchOptions &options, const std::string &name,
+               rive::Span<const uint8_t> data, rive::Factory *factory,
+               JsonWriter &json) {
+  auto file = rive::File::import(data, factory);
+  auto artboard = file != nullptr ? file->artboardDefault() : nullptr;
+  if (artboard == nullptr) {
+    std::cerr << "rive_bench: failed to import " << name << "\n";
+    return false;
+  }
+  auto machine = artboard->defaultStateMachine();
+  if (!machine && artboard->stateMachineCount() > 0) {
+    machine = artboard->stateMachineAt(0);
+  }
+  benchArtboard(options, name, artboard.get(), machine.get(), json);
+  return true;
+}
+
+} // namespace
+
+bool runDisplayListBench(const BenchOptions &options, JsonWriter &json) {
+  rive::NoOpFactory factory;
+  auto dashboard = buildDashboardFile();
+  json.value("widgets", static_cast<int64_t>(kWidgets));
+  json.value("shapes_per_widget", static_cast<int64_t>(kShapesPerWidget));
+  json.beginArray("files");
+  if (!benchFile(options, "dashboard",
+                 rive::Span<const uint8_t>(dashboard.data(), dashboard.size()),
+                 &factory, json)) {
+    json.endArray();
+    return false;
+  }
+  for (const auto &path : findRiveFiles(options.assetsDir, options.filter)) {
+    auto bytes = loadFileContents(path);
+    benchFile(options, path.filename().string(),
+              rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory,
+              json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,119 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <utils/no_op_factory.hpp>
+
+#include "artboard_fleet.hpp"
+
+namespace bench {
+
+namespace {
+
+// 1, 2, 4, ... up to maxThreads, always ending on maxThreads itself.
+std::vector<size_t> threadSteps(size_t maxThreads) {
+  std::vector<size_t> steps;
+  for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+    steps.push_back(threads);
+  }
+  steps.push_back(maxThreads);
+  return steps;
+}
+
+// Checksum of every member in spawn order.
+uint64_t fleetChecksum(const ArtboardFleet &fleet) {
+  Checksum checksum;
+  for (const auto &member : fleet.members()) {
+    checksum.mix(artboardChecksum(*member.artboard));
+  }
+  return checksum.value();
+}
+
+} // namespace
+
+bool runFleetBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  size_t maxThreads = options.threads > 0
+                          ? static_cast<size_t>(options.threads)
+                          : std::max(1u, std::thread::hardware_concurrency());
+  json.value("instances", static_cast<int64_t>(options.instances));
+  json.value("hardware_threads",
+             static_cast<int64_t>(std::thread::hardware_concurrency()));
+
+  rive::NoOpFactory factory;
+  json.beginArray("files");
+  for (const auto &path : files) {
+    auto bytes = loadFileContents(path);
+    auto file = rive::File::import(
+        rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+    if (!file || file->artboard() == nullptr) {
+      std::cerr << "rive_bench: failed to import " << path << "\n";
+      continue;
+    }
+    const rive::Artboard *artboard = file->artboard();
+
+    json.beginObject();
+    json.value("file", path.filename().string());
+    json.value("artboard", artboard->name());
+    json.beginArray("runs");
+    double singleThreadThroughput = 0.0;
+    // Every run advances fresh members through the same frames, so each
+    // must end where the single-threaded run did.
+    uint64_t serialChecksum = 0;
+    bool resultsMatch = true;
+    for (size_t threads : threadSteps(maxThreads)) {
+      ArtboardFleet fleet(threads);
+      for (int i = 0; i < options.instances; i++) {
+        fleet.spawn(artboard);
+      }
+
+      std::vector<double> samples;
+      samples.reserve(options.iterations);
+      for (int i = 0; i < options.warmup + options.iterations; i++) {
+        Stopwatch stopwatch;
+        fleet.advance(options.frameSeconds);
+        double micros = stopwatch.elapsedMicros();
+        if (i >= options.warmup) {
+          samples.push_back(micros);
+        }
+      }
+      Stats stats = summarize(samples);
+      // Instance advances per second at the median frame time.
+      double throughput =
+          stats.p50 > 0.0 ? options.instances * 1e6 / stats.p50 : 0.0;
+      uint64_t checksum = fleetChecksum(fleet);
+      if (threads == 1) {
+        singleThreadThroughput = throughput;
+        serialChecksum = checksum;
+      }
+      resultsMatch = resultsMatch && checksum == serialChecksum;
+
+      json.beginObject();
+      json.value("threads", static_cast<int64_t>(threads));
+      json.stats("advance", stats);
+      json.value("instances_per_second", throughput);
+      json.value("speedup", singleThreadThroughput > 0.0
+                                ? throughput / singleThreadThroughput
+                                : 0.0);
+      json.endObject();
+    }
+    json.endArray();
+    json.resultsMatch(resultsMatch);
+    json.endObject();
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,186 @@
+#include "bench_suites.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <rive/animation/arithmetic_operation.hpp>
+#include <rive/data_bind/converters/data_converter_formula.hpp>
+#include <rive/data_bind/converters/formula/formula_token_argument_separator.hpp>
+#include <rive/data_bind/converters/formula/formula_token_function.hpp>
+#include <rive/data_bind/converters/formula/formula_token_input.hpp>
+#include <rive/data_bind/converters/formula/formula_token_operation.hpp>
+#include <rive/data_bind/converters/formula/formula_token_parenthesis_close.hpp>
+#include <rive/data_bind/converters/formula/formula_token_parenthesis_open.hpp>
+#include <rive/data_bind/converters/formula/formula_token_value.hpp>
+#include <rive/data_bind/data_values/data_value_number.hpp>
+#include <rive/function_type.hpp>
+
+namespace bench {
+
+namespace {
+
+// Formula evaluations per timed sample.
+constexpr int kEvaluationsPerSample = 10000;
+
+// Typical dashboard converters; "x" is the bound input value.
+const char *const formulas[] = {
+    "x*2+10",
+    "round(min(x,100)/(4*25)*360)",
+    "sqrt(pow(x-50,2)+pow(30/2,2))",
+    "max(0,min(1,(x-20)/(80-20)))*(cos(3.14159/4)+sin(3.14159/4))",
+};
+
+struct FunctionName {
+  const char *name;
+  rive::FunctionType type;
+};
+
+const FunctionName functionNames[] = {
+    {"min", rive::FunctionType::min},     {"max", rive::FunctionType::max},
+    {"round", rive::FunctionType::round}, {"sqrt", rive::FunctionType::sqrt},
+    {"pow", rive::FunctionType::pow},     {"cos", rive::FunctionType::cosine},
+    {"sin", rive::FunctionType::sine},
+};
+
+rive::FormulaToken *makeOperation(rive::ArithmeticOperation operation) {
+  auto token = new rive::FormulaTokenOperation();
+  token->operationType(static_cast<uint32_t>(operation));
+  return token;
+}
+
+// Tokenizes an expression the way the editor exports it: a function name and
+// its opening parenthesis become a single function token.
+bool addTokens(rive::DataConverterFormula &formula, const char *expression) {
+  for (const char *c = expression; *c != '\0';) {
+    if (std::isdigit(static_cast<unsigned char>(*c)) || *c == '.') {
+      char *end = nullptr;
+      auto token = new rive::FormulaTokenValue();
+      token->operationValue(std::strtof(c, &end));
+      formula.addToken(token);
+      c = end;
+      continue;
+    }
+    if (std::isalpha(static_cast<unsigned char>(*c))) {
+      const char *start = c;
+      while (std::isalpha(static_cast<unsigned char>(*c))) {
+        c++;
+      }
+      std::string name(start, c);
+      if (name == "x") {
+        formula.addToken(new rive::FormulaTokenInput());
+        continue;
+      }
+      const FunctionName *function = nullptr;
+      for (const auto &candidate : functionNames) {
+        if (name == candidate.name) {
+          function = &candidate;
+        }
+      }
+      if (function == nullptr || *c != '(') {
+        return false;
+      }
+      auto token = new rive::FormulaTokenFunction();
+      token->functionType(static_cast<uint32_t>(function->type));
+      formula.addToken(token);
+      c++;
+      continue;
+    }
+    switch (*c) {
+    case '+':
+      formula.addToken(makeOperation(rive::ArithmeticOperation::add));
+      break;
+    case '-':
+      formula.addToken(makeOperation(rive::ArithmeticOperation::subtract));
+      break;
+    case '*':
+      formula.addToken(makeOperation(rive::ArithmeticOperation::multiply));
+      break;
+    case '/':
+      formula.addToken(makeOperation(rive::ArithmeticOperation::divide));
+      break;
+    case '(':
+      formula.addToken(new rive::FormulaTokenParenthesisOpen());
+      break;
+    case ')':
+      formula.addToken(new rive::FormulaTokenParenthesisClose());
+      break;
+    case ',':
+      formula.addToken(new rive::FormulaTokenArgumentSeparator());
+      break;
+    default:
+      return false;
+    }
+    c++;
+  }
+  return true;
+}
+
+// Times kEvaluationsPerSample conversions over a sweep of inputs and returns
+// the sum of the outputs so the two evaluators can be compared.
+double timeEvaluations(const BenchOptions &options,
+                       rive::DataConverter &formula,
+                       std::vector<double> &samples) {
+  rive::DataValueNumber input;
+  double checksum = 0.0;
+  samples.reserve(options.iterations);
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    double sum = 0.0;
+    Stopwatch stopwatch;
+    for (int j = 0; j < kEvaluationsPerSample; j++) {
+      input.value(static_cast<float>(j % 120));
+      auto output = formula.convert(&input, nullptr);
+      sum += output->as<rive::DataValueNumber>()->value();
+    }
+    double micros = stopwatch.elapsedMicros();
+    if (i >= options.warmup) {
+      samples.push_back(micros);
+    }
+    checksum = sum;
+  }
+  return checksum;
+}
+
+} // namespace
+
+bool runFormulaBench(const BenchOptions &options, JsonWriter &json) {
+  json.value("evaluations_per_sample",
+             static_cast<int64_t>(kEvaluationsPerSample));
+  json.beginArray("formulas");
+  for (const char *expression : formulas) {
+    rive::DataConverterFormula formula;
+    if (!addTokens(formula, expression)) {
+      std::cerr << "rive_bench: failed to tokenize " << expression << "\n";
+      return false;
+    }
+    formula.initialize();
+
+    std::vector<double> interpretedSamples;
+    std::vector<double> compiledSamples;
+    formula.forceInterpreter(true);
+    double interpretedSum =
+        timeEvaluations(options, formula, interpretedSamples);
+    formula.forceInterpreter(false);
+    double compiledSum = timeEvaluations(options, formula, compiledSamples);
+    Stats interpreted = summarize(interpretedSamples);
+    Stats compiled = summarize(compiledSamples);
+
+    json.beginObject();
+    json.value("formula", std::string(expression));
+    json.stats("interpreted", interpreted);
+    json.stats("compiled", compiled);
+    // Nanoseconds per conversion at the median sample.
+    json.value("interpreted_ns", interpreted.p50 * 1e3 / kEvaluationsPerSample);
+    json.value("compiled_ns", compiled.p50 * 1e3 / kEvaluationsPerSample);
+    json.value("speedup",
+               compiled.p50 > 0.0 ? interpreted.p50 / compiled.p50 : 0.0);
+    json.resultsMatch(interpretedSum == compiledSum);
+    json.endObject();
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,270 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/renderer/headless/render_context_headless_impl.hpp>
+#include <rive/renderer/render_context.hpp>
+#include <rive/renderer/rive_renderer.hpp>
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTargetWidth = 1920;
+constexpr uint32_t kTargetHeight = 1080;
+// Frames rendered again with an emulated gradient texture to compare the
+// cache against drawing every ramp again.
+constexpr int kVerifyFrames = 10;
+// The check also draws swatches with new ramps every frame into a cache of
+// only a few rows, so it recycles rows as well.
+constexpr int kVerifySwatches = 4;
+constexpr size_t kVerifyCacheRows = 4;
+
+struct CacheMode {
+  const char *name;
+  bool cached;
+};
+
+const CacheMode cacheModes[] = {
+    {"uncached", false},
+    {"cached", true},
+};
+
+// Animated frames change whichever gradients the animation moves. Static
+// frames keep drawing the first frame, like a paused scene.
+struct Scenario {
+  const char *name;
+  bool advance;
+};
+
+const Scenario scenarios[] = {
+    {"animated", true},
+    {"static", false},
+};
+
+// A context, with its own instance of the file's default artboard and state
+// machine, so every mode starts from the same state.
+struct Scene {
+  std::unique_ptr<rive::gpu::RenderContext> context;
+  rive::gpu::RenderContextHeadlessImpl *impl = nullptr;
+  std::unique_ptr<rive::File> file;
+  std::unique_ptr<rive::ArtboardInstance> artboard;
+  std::unique_ptr<rive::StateMachineInstance> machine;
+};
+
+bool makeScene(rive::Span<const uint8_t> data, bool cached,
+               bool emulateGradientTexture, Scene *scene) {
+  rive::gpu::RenderContextHeadlessImpl::ContextOptions contextOptions;
+  contextOptions.emulateGradientTexture = emulateGradientTexture;
+  scene->context =
+      rive::gpu::RenderContextHeadlessImpl::MakeContext(contextOptions);
+  scene->impl =
+      scene->context->static_impl_cast<rive::gpu::RenderContextHeadlessImpl>();
+  if (!cached) {
+    scene->context->setGradientRampCacheCapacity(0);
+  }
+  scene->file = rive::File::import(data, scene->context.get());
+  if (!scene->file) {
+    return false;
+  }
+  scene->artboard = scene->file->artboardDefault();
+  if (!scene->artboard) {
+    return false;
+  }
+  if (scene->artboard->stateMachineCount() > 0) {
+    scene->machine = scene->artboard->defaultStateMachine();
+    if (!scene->machine) {
+      scene->machine = scene->artboard->stateMachineAt(0);
+    }
+  }
+  return true;
+}
+
+void drawSwatches(rive::Renderer &renderer, rive::Factory &factory,
+                  uint64_t frameNumber) {
+  const float stops[] = {0.0f, 0.5f, 1.0f};
+  for (int i = 0; i < kVerifySwatches; i++) {
+    float x = 20.0f + i * 120.0f;
+    uint32_t seed = static_cast<uint32_t>(frameNumber * kVerifySwatches + i);
+    const rive::ColorInt colors[] = {0xFF000000 | (seed * 0x9E3779B1u >> 8),
+                                     0xFFFFFFFF,
+                                     0xFF000000 | (seed * 0x85EBCA6Bu >> 8)};
+    auto paint = factory.makeRenderPaint();
+    paint->shader(factory.makeLinearGradient(x, 0.0f, x + 100.0f, 0.0f,
+                                             colors, stops, 3));
+    auto path =
+        factory.makeRenderPath(rive::AABB(x, 20.0f, x + 100.0f, 120.0f));
+    renderer.drawPath(path.get(), paint.get());
+  }
+}
+
+// Advances the scene, draws it and returns the time spent in
+// RenderContext::flush, which lays out and writes the gradient spans.
+double renderFrame(float seconds, Scene &scene,
+                   rive::gpu::RenderTarget &target, uint64_t frameNumber,
+                   bool swatches = false) {
+  if (scene.machine) {
+    scene.machine->advanceAndApply(seconds);
+  } else {
+    scene.artboard->advance(seconds);
+  }
+
+  rive::gpu::RenderContext::FrameDescriptor frameDescriptor;
+  frameDescriptor.renderTargetWidth = kTargetWidth;
+  frameDescriptor.renderTargetHeight = kTargetHeight;
+  frameDescriptor.loadAction = rive::gpu::LoadAction::clear;
+  frameDescriptor.clearColor = 0xFF404040;
+  scene.context->beginFrame(frameDescriptor);
+
+  rive::ArtboardInstance &artboard = *scene.artboard;
+  float scale = std::min(kTargetWidth / artboard.width(),
+                         kTargetHeight / artboard.height());
+  rive::RiveRenderer renderer(scene.context.get());
+  renderer.save();
+  renderer.transform(rive::Mat2D::fromTranslate(
+                         (kTargetWidth - artboard.width() * scale) * 0.5f,
+                         (kTargetHeight - artboard.height() * scale) * 0.5f) *
+                     rive::Mat2D::fromScale(scale, scale));
+  artboard.draw(&renderer);
+  renderer.restore();
+  if (swatches) {
+    drawSwatches(renderer, *scene.context, frameNumber);
+  }
+
+  Stopwatch stopwatch;
+  rive::gpu::RenderContext::FlushResources flushResources;
+  flushResources.renderTarget = &target;
+  flushResources.currentFrameNumber = frameNumber;
+  flushResources.safeFrameNumber = frameNumber;
+  scene.context->flush(flushResources);
+  return stopwatch.elapsedMicros();
+}
+
+// Renders kVerifyFrames with a small cache, either trusting it or making it
+// draw every ramp again each frame, and returns the gradient texture hash.
+uint64_t verifyHash(rive::Span<const uint8_t> data, const Scenario &scenario,
+                    const BenchOptions &options,
+                    rive::gpu::RenderTarget &target, bool redrawRamps) {
+  Scene scene;
+  if (!makeScene(data, true, true, &scene)) {
+    return 0;
+  }
+  scene.context->setGradientRampCacheCapacity(kVerifyCacheRows);
+  for (int i = 0; i < kVerifyFrames; i++) {
+    if (redrawRamps) {
+      scene.context->invalidateGradientRamps();
+    }
+    float seconds = scenario.advance || i == 0 ? options.frameSeconds : 0.0f;
+    renderFrame(seconds, scene, target, i + 1, true);
+  }
+  return scene.impl->counters().gradientTextureHash;
+}
+
+bool benchScenario(const BenchOptions &options, const Scenario &scenario,
+                   rive::Span<const uint8_t> data, JsonWriter &json) {
+  rive::gpu::RenderTargetHeadless target(kTargetWidth, kTargetHeight);
+  json.beginObject();
+  json.value("scenario", std::string(scenario.name));
+  json.beginArray("modes");
+  double uncachedP50 = 0.0;
+  bool ok = true;
+  for (const auto &mode : cacheModes) {
+    Scene scene;
+    if (!makeScene(data, mode.cached, false, &scene)) {
+      ok = false;
+      break;
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      if (i == options.warmup) {
+        scene.context->resetGradientRampCacheCounters();
+        scene.impl->resetCounters();
+      }
+      // Static scenes still apply their first frame.
+      float seconds = scenario.advance || i == 0 ? options.frameSeconds : 0.0f;
+      double micros = renderFrame(seconds, scene, target, i + 1);
+      if (i >= options.warmup) {
+        samples.push_back(micros);
+      }
+    }
+
+    const auto &counters = scene.context->gradientRampCacheCounters();
+    double flushes =
+        std::max<double>(static_cast<double>(scene.impl->counters().flushes),
+                         1.0);
+    Stats stats = summarize(samples);
+    if (!mode.cached) {
+      uncachedP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("flush", stats);
+    json.value("ramps_reused_per_flush", counters.rampsReused / flushes);
+    json.value("ramps_written_per_flush", counters.rampsWritten / flushes);
+    json.value("speedup", stats.p50 > 0.0 ? uncachedP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  if (ok) {
+    // Hashing would skew the timings, so the check renders its own frames.
+    uint64_t cachedHash = verifyHash(data, scenario, options, target, false);
+    uint64_t redrawnHash = verifyHash(data, scenario, options, target, true);
+    json.resultsMatch(cachedHash != 0 && cachedHash == redrawnHash);
+  }
+  json.endObject();
+  return ok;
+}
+
+bool benchFile(const BenchOptions &options, const std::filesystem::path &path,
+               JsonWriter &json) {
+  auto bytes = loadFileContents(path);
+  if (bytes.empty()) {
+    std::cerr << "rive_bench: failed to read " << path << "\n";
+    return false;
+  }
+  rive::Span<const uint8_t> data(bytes.data(), bytes.size());
+
+  json.beginObject();
+  json.value("file", path.filename().string());
+  json.beginArray("scenarios");
+  bool ok = true;
+  for (const auto &scenario : scenarios) {
+    if (!benchScenario(options, scenario, data, json)) {
+      std::cerr << "rive_bench: failed to import " << path << "\n";
+      ok = false;
+      break;
+    }
+  }
+  json.endArray();
+  json.endObject();
+  return ok;
+}
+
+} // namespace
+
+bool runGradientBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  json.value("target_width", static_cast<int64_t>(kTargetWidth));
+  json.value("target_height", static_cast<int64_t>(kTargetHeight));
+  json.beginArray("files");
+  for (const auto &path : files) {
+    benchFile(options, path, json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,328 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <rive/assets/image_asset.hpp>
+#include <rive/assets/image_decode_cache.hpp>
+#include <rive/assets/image_decode_pool.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/assets/file_asset_base.hpp>
+#include <rive/generated/assets/file_asset_contents_base.hpp>
+#include <rive/generated/assets/image_asset_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <utils/no_op_factory.hpp>
+
+namespace bench {
+
+namespace {
+
+// kImages distinct kImageSize x kImageSize images embedded in one file.
+constexpr int kImages = 16;
+constexpr uint32_t kImageSize = 256;
+constexpr uint32_t kBytesPerPixel = 4;
+constexpr uint8_t kMagic[4] = {'R', 'B', 'I', 'M'};
+constexpr size_t kHeaderSize = 12;
+
+// Images are stored the way PNG stores them once inflated: each row is
+// Paeth filtered against the row above, and decoding undoes the filter and
+// premultiplies. That keeps the decode's cost and shape (a serial pass over
+// every byte) without linking an image library into the bench.
+uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+  int p = a + b - c;
+  int pa = std::abs(p - a);
+  int pb = std::abs(p - b);
+  int pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc) {
+    return a;
+  }
+  return pb <= pc ? b : c;
+}
+
+void writeUint32(std::vector<uint8_t> &bytes, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    bytes.push_back(static_cast<uint8_t>(value >> (i * 8)));
+  }
+}
+
+uint32_t readUint32(const uint8_t *bytes) {
+  return bytes[0] | bytes[1] << 8 | bytes[2] << 16 |
+         static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+std::vector<uint8_t> encodeImage(int seed) {
+  const uint32_t stride = kImageSize * kBytesPerPixel;
+  std::vector<uint8_t> pixels(stride * kImageSize);
+  uint32_t noise = 0x9e3779b9u * (seed + 1);
+  for (uint32_t y = 0; y < kImageSize; y++) {
+    for (uint32_t x = 0; x < kImageSize; x++) {
+      noise = noise * 1664525u + 1013904223u;
+      uint8_t *pixel = &pixels[y * stride + x * kBytesPerPixel];
+      pixel[0] = static_cast<uint8_t>(x * 3 + seed * 17);
+      pixel[1] = static_cast<uint8_t>(y * 5 + seed * 29);
+      pixel[2] = static_cast<uint8_t>((x ^ y) + (noise >> 28));
+      pixel[3] = static_cast<uint8_t>(128 + ((x + y + seed) & 127));
+    }
+  }
+
+  std::vector<uint8_t> bytes(kMagic, kMagic + 4);
+  writeUint32(bytes, kImageSize);
+  writeUint32(bytes, kImageSize);
+  for (uint32_t y = 0; y < kImageSize; y++) {
+    const uint8_t *row = &pixels[y * stride];
+    const uint8_t *up = y > 0 ? row - stride : nullptr;
+    for (uint32_t i = 0; i < stride; i++) {
+      uint8_t a = i >= kBytesPerPixel ? row[i - kBytesPerPixel] : 0;
+      uint8_t b = up != nullptr ? up[i] : 0;
+      uint8_t c = up != nullptr && i >= kBytesPerPixel
+                      ? up[i - kBytesPerPixel]
+                      : 0;
+      bytes.push_back(static_cast<uint8_t>(row[i] - paeth(a, b, c)));
+    }
+  }
+  return bytes;
+}
+
+std::unique_ptr<rive::DecodedImage>
+decodeImageBytes(rive::Span<const uint8_t> bytes) {
+  if (bytes.size() < kHeaderSize ||
+      memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+    return nullptr;
+  }
+  auto image = std::make_unique<rive::DecodedImage>();
+  image->width = readUint32(bytes.data() + 4);
+  image->height = readUint32(bytes.data() + 8);
+  const size_t stride = size_t(image->width) * kBytesPerPixel;
+  if (bytes.size() - kHeaderSize != stride * image->height) {
+    return nullptr;
+  }
+  image->pixels.resize(stride * image->height);
+  const uint8_t *filtered = bytes.data() + kHeaderSize;
+  for (uint32_t y = 0; y < image->height; y++) {
+    uint8_t *row = &image->pixels[y * stride];
+    const uint8_t *up = y > 0 ? row - stride : nullptr;
+    for (size_t i = 0; i < stride; i++) {
+      uint8_t a = i >= kBytesPerPixel ? row[i - kBytesPerPixel] : 0;
+      uint8_t b = up != nullptr ? up[i] : 0;
+      uint8_t c = up != nullptr && i >= kBytesPerPixel
+                      ? up[i - kBytesPerPixel]
+                      : 0;
+      row[i] = static_cast<uint8_t>(filtered[y * stride + i] + paeth(a, b, c));
+    }
+  }
+  for (size_t i = 0; i < image->pixels.size(); i += kBytesPerPixel) {
+    uint8_t *pixel = &image->pixels[i];
+    for (size_t channel = 0; channel < 3; channel++) {
+      pixel[channel] =
+          static_cast<uint8_t>((pixel[channel] * pixel[3] + 127) / 255);
+    }
+  }
+  return image;
+}
+
+// Stands in for a texture: the upload is a copy of the pixels.
+class BenchImage : public rive::RenderImage {
+public:
+  explicit BenchImage(const rive::DecodedImage &image)
+      : m_pixels(image.pixels) {
+    m_Width = static_cast<int>(image.width);
+    m_Height = static_cast<int>(image.height);
+  }
+
+  uint64_t checksum() const {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint8_t byte : m_pixels) {
+      hash = (hash ^ byte) * 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+private:
+  std::vector<uint8_t> m_pixels;
+};
+
+// A no-op factory that decodes the bench's images, in one step for plain
+// imports and in two for an ImageDecodePool.
+class ImageFactory : public rive::NoOpFactory {
+public:
+  rive::rcp<rive::RenderImage>
+  decodeImage(rive::Span<const uint8_t> bytes) override {
+    auto image = decodeImageBytes(bytes);
+    return image != nullptr ? makeImage(*image) : nullptr;
+  }
+
+  bool canDecodeImagePixels() const override { return true; }
+
+  std::unique_ptr<rive::DecodedImage>
+  decodeImagePixels(rive::Span<const uint8_t> bytes) override {
+    return decodeImageBytes(bytes);
+  }
+
+  rive::rcp<rive::RenderImage>
+  makeImage(const rive::DecodedImage &image) override {
+    return rive::make_rcp<BenchImage>(image);
+  }
+};
+
+std::vector<uint8_t> buildImageFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+  for (int i = 0; i < kImages; i++) {
+    riv.beginUncounted(rive::ImageAssetBase::typeKey);
+    riv.uintValue(rive::FileAssetBase::assetIdPropertyKey, i);
+    riv.beginUncounted(rive::FileAssetContentsBase::typeKey);
+    riv.bytesValue(rive::FileAssetContentsBase::bytesPropertyKey,
+                   encodeImage(i));
+  }
+  riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, 100.0f);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, 100.0f);
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+struct ImportMode {
+  const char *name;
+  bool async;
+  // Keeps the decode cache warm across imports, like opening files that
+  // share their images.
+  bool cached;
+};
+
+const ImportMode importModes[] = {
+    {"sync", false, false},
+    {"async", true, false},
+    {"async_cached", true, true},
+};
+
+// The checksums of a file's images, 0 for an image without one.
+std::vector<uint64_t> imageChecksums(rive::File &file) {
+  std::vector<uint64_t> checksums;
+  for (auto asset : file.assets()) {
+    auto image = asset->is<rive::ImageAsset>()
+                     ? asset->as<rive::ImageAsset>()->renderImage()
+                     : nullptr;
+    checksums.push_back(
+        image != nullptr ? static_cast<BenchImage *>(image)->checksum() : 0);
+  }
+  return checksums;
+}
+
+// Imports two files through a single worker whose queue holds two images, so
+// each import waits on the bounded queue, then destroys the second file while
+// its images are still queued, decoding or waiting for resolve(). The file
+// must cancel every one of them, leaving only the first file's images pending.
+bool cancelLeavesNothingPending(rive::Span<const uint8_t> data,
+                                rive::Factory *factory) {
+  // No cache, so every image is decoded.
+  auto pool = rive::make_rcp<rive::ImageDecodePool>(1, 2, nullptr);
+  auto kept = rive::File::import(data, factory, nullptr, nullptr, pool);
+  auto cancelled = rive::File::import(data, factory, nullptr, nullptr, pool);
+  if (!kept || !cancelled) {
+    return false;
+  }
+  const size_t images = kImages;
+  bool bothPending = pool->pendingCount(kept.get()) == images &&
+                     pool->pendingCount(cancelled.get()) == images;
+  cancelled.reset();
+  bool onlyKeptPending = pool->pendingCount(kept.get()) == images &&
+                         pool->pendingCount() == images;
+  kept.reset();
+  rive::ImageDecodePool::Counters counters = pool->counters();
+  return bothPending && onlyKeptPending && pool->pendingCount() == 0 &&
+         counters.queued == 2 * images &&
+         counters.cancelled == counters.queued && counters.resolved == 0;
+}
+
+} // namespace
+
+bool runImageBench(const BenchOptions &options, JsonWriter &json) {
+  auto bytes = buildImageFile();
+  rive::Span<const uint8_t> data(bytes.data(), bytes.size());
+  ImageFactory factory;
+  auto pool = rive::make_rcp<rive::ImageDecodePool>(
+      static_cast<size_t>(options.threads));
+  auto &cache = rive::ImageDecodeCache::shared();
+
+  std::vector<uint64_t> expected;
+  {
+    auto file = rive::File::import(data, &factory);
+    if (!file || file->assets().size() != static_cast<size_t>(kImages)) {
+      std::cerr << "rive_bench: failed to import the synthetic images\n";
+      return false;
+    }
+    expected = imageChecksums(*file);
+  }
+
+  json.value("images", static_cast<int64_t>(kImages));
+  json.value("image_size", static_cast<int64_t>(kImageSize));
+  json.value("threads", static_cast<int64_t>(pool->threadCount()));
+  json.beginArray("modes");
+  double syncP50 = 0.0;
+  bool resultsMatch = true;
+  for (const auto &mode : importModes) {
+    std::vector<double> importSamples;
+    std::vector<double> readySamples;
+    importSamples.reserve(options.iterations);
+    readySamples.reserve(options.iterations);
+    cache.clear();
+    rive::ImageDecodeCache::Counters before = cache.counters();
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      if (i == options.warmup) {
+        before = cache.counters();
+      }
+      if (!mode.cached) {
+        cache.clear();
+      }
+      Stopwatch stopwatch;
+      auto file = mode.async
+                      ? rive::File::import(data, &factory, nullptr, nullptr,
+                                           pool)
+                      : rive::File::import(data, &factory);
+      double importMicros = stopwatch.elapsedMicros();
+      if (mode.async) {
+        pool->finish();
+      }
+      double readyMicros = stopwatch.elapsedMicros();
+      if (i >= options.warmup) {
+        importSamples.push_back(importMicros);
+        readySamples.push_back(readyMicros);
+        resultsMatch = resultsMatch && file != nullptr &&
+                       imageChecksums(*file) == expected;
+      }
+    }
+    rive::ImageDecodeCache::Counters after = cache.counters();
+
+    double imports = std::max(options.iterations, 1);
+    Stats importStats = summarize(importSamples);
+    Stats readyStats = summarize(readySamples);
+    if (!mode.async) {
+      syncP50 = readyStats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("import", importStats);
+    json.stats("ready", readyStats);
+    // Sync imports decode outside of the cache.
+    json.value("decodes_per_import",
+               mode.async ? (after.misses - before.misses) / imports
+                          : static_cast<double>(kImages));
+    json.value("cache_hits_per_import", (after.hits - before.hits) / imports);
+    json.value("speedup",
+               readyStats.p50 > 0.0 ? syncP50 / readyStats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  bool cancelled = cancelLeavesNothingPending(data, &factory);
+  json.value("cancel_leaves_nothing_pending", cancelled);
+  resultsMatch = resultsMatch && cancelled;
+  json.resultsMatch(resultsMatch);
+  cache.clear();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,127 @@
+#include "bench_suites.hpp"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/scene.hpp>
+#include <utils/no_op_factory.hpp>
+
+namespace bench {
+
+namespace {
+
+// Instances checked against one made from scratch, and the frames of their
+// default scene they are compared over.
+constexpr int kCheckInstances = 8;
+constexpr int kCheckFrames = 30;
+
+double perSecond(int count, double micros) {
+  return micros > 0.0 ? count * 1e6 / micros : 0.0;
+}
+
+// Checksums kCheckFrames frames of instance's default scene.
+uint64_t playedChecksum(rive::ArtboardInstance &instance,
+                        float frameSeconds) {
+  Checksum checksum;
+  auto scene = instance.defaultScene();
+  for (int frame = 0; frame < kCheckFrames; frame++) {
+    if (scene) {
+      scene->advanceAndApply(frameSeconds);
+    } else {
+      instance.advance(frameSeconds);
+    }
+    checksum.mix(artboardChecksum(instance));
+  }
+  return checksum.value();
+}
+
+} // namespace
+
+bool runInstanceBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  json.value("instances", static_cast<int64_t>(options.instances));
+
+  rive::NoOpFactory factory;
+  json.beginArray("files");
+  for (const auto &path : files) {
+    auto bytes = loadFileContents(path);
+    auto file = rive::File::import(
+        rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+    if (!file || file->artboard() == nullptr) {
+      std::cerr << "rive_bench: failed to import " << path << "\n";
+      continue;
+    }
+    rive::Artboard *artboard = file->artboard();
+
+    // Each iteration creates --instances copies, keeping them all alive like
+    // a list or nested artboards would, then destroys them.
+    std::vector<std::unique_ptr<rive::ArtboardInstance>> instances;
+    instances.reserve(options.instances);
+    std::vector<double> createSamples;
+    std::vector<double> destroySamples;
+    createSamples.reserve(options.iterations);
+    destroySamples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      Stopwatch createStopwatch;
+      for (int j = 0; j < options.instances; j++) {
+        instances.push_back(artboard->instance());
+      }
+      double createMicros = createStopwatch.elapsedMicros();
+
+      Stopwatch destroyStopwatch;
+      instances.clear();
+      double destroyMicros = destroyStopwatch.elapsedMicros();
+      if (i >= options.warmup) {
+        createSamples.push_back(createMicros);
+        destroySamples.push_back(destroyMicros);
+      }
+    }
+    Stats create = summarize(createSamples);
+    Stats destroy = summarize(destroySamples);
+
+    // Instances reusing the source's topology, in an arena sized by the
+    // ones before, must play like one cloned and sorted from scratch.
+    artboard->forceFullInstancing(true);
+    uint64_t fullChecksum =
+        playedChecksum(*artboard->instance(), options.frameSeconds);
+    artboard->forceFullInstancing(false);
+    bool resultsMatch = true;
+    for (int j = 0; j < kCheckInstances; j++) {
+      instances.push_back(artboard->instance());
+    }
+    for (auto &instance : instances) {
+      resultsMatch =
+          resultsMatch &&
+          playedChecksum(*instance, options.frameSeconds) == fullChecksum;
+    }
+    instances.clear();
+
+    json.beginObject();
+    json.value("file", path.filename().string());
+    json.value("artboard", artboard->name());
+    json.value("objects", static_cast<int64_t>(artboard->objects().size()));
+    json.stats("create", create);
+    json.stats("destroy", destroy);
+    // Rates at the median batch time.
+    json.value("created_per_second", perSecond(options.instances, create.p50));
+    json.value("destroyed_per_second",
+               perSecond(options.instances, destroy.p50));
+    json.value("churn_per_second",
+               perSecond(options.instances, create.p50 + destroy.p50));
+    json.resultsMatch(resultsMatch);
+    json.endObject();
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,415 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#include <rive/animation/state_machine_input_instance.hpp>
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/artboard_component_list.hpp>
+#include <rive/data_bind/data_context.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/animation/animation_state_base.hpp>
+#include <rive/generated/animation/any_state_base.hpp>
+#include <rive/generated/animation/entry_state_base.hpp>
+#include <rive/generated/animation/exit_state_base.hpp>
+#include <rive/generated/animation/interpolating_keyframe_base.hpp>
+#include <rive/generated/animation/keyed_object_base.hpp>
+#include <rive/generated/animation/keyed_property_base.hpp>
+#include <rive/generated/animation/keyframe_double_base.hpp>
+#include <rive/generated/animation/linear_animation_base.hpp>
+#include <rive/generated/animation/state_machine_base.hpp>
+#include <rive/generated/animation/state_machine_bool_base.hpp>
+#include <rive/generated/animation/state_machine_layer_base.hpp>
+#include <rive/generated/animation/state_transition_base.hpp>
+#include <rive/generated/animation/transition_bool_condition_base.hpp>
+#include <rive/generated/animation/transition_input_condition_base.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/component_base.hpp>
+#include <rive/generated/data_bind/data_bind_base.hpp>
+#include <rive/generated/data_bind/data_bind_context_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <rive/generated/node_base.hpp>
+#include <rive/generated/shapes/paint/fill_base.hpp>
+#include <rive/generated/shapes/paint/solid_color_base.hpp>
+#include <rive/generated/shapes/parametric_path_base.hpp>
+#include <rive/generated/shapes/rectangle_base.hpp>
+#include <rive/generated/shapes/shape_base.hpp>
+#include <rive/generated/viewmodel/viewmodel_base.hpp>
+#include <rive/generated/viewmodel/viewmodel_property_number_base.hpp>
+#include <rive/node.hpp>
+#include <rive/viewmodel/viewmodel_instance_list_item.hpp>
+#include <rive/viewmodel/viewmodel_instance_number.hpp>
+#include <utils/no_op_factory.hpp>
+#include <utils/no_op_renderer.hpp>
+
+namespace bench {
+
+namespace {
+
+// A feed: a list of kItems view model items, each shown by a kItemSize
+// artboard of kShapesPerItem rectangles and a node whose x is bound to the
+// item's number. Pressing an item plays kPressFrames of its first rectangle
+// rising to the top. The host artboard shows about ten items at a time and
+// scrolls by kScrollPerFrame every frame.
+constexpr int kItems = 2000;
+constexpr float kItemSize = 100.0f;
+constexpr int kShapesPerItem = 8;
+constexpr float kHostSize = 1000.0f;
+constexpr float kScrollPerFrame = 40.0f;
+constexpr float kOverscan = 100.0f;
+constexpr int kPressFrames = 15;
+// Frames the eager and virtualized feeds are compared over, short of the
+// scroll wrapping back to items that were pressed.
+constexpr int kCheckFrames = 120;
+// Entry, any and exit come before the item machine's idle and pressed
+// states.
+constexpr int kIdleState = 3;
+constexpr int kPressedState = 4;
+// Most items a virtualized feed may instance or pool at once: those
+// overlapping the host plus the overscan on both sides, with a partial item
+// at each end.
+constexpr size_t kMaxLiveItems =
+    static_cast<size_t>((kHostSize + 2.0f * kOverscan) / kItemSize) + 2;
+
+// Writes a .riv with the item view model, a host artboard holding the list
+// and an item artboard for the view model. The host gets an empty state
+// machine to drive the list. The item's machine idles until its pressed
+// input is set, then plays the press animation.
+std::vector<uint8_t> buildFeedFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+  riv.beginUncounted(rive::ViewModelBase::typeKey);
+  riv.beginUncounted(rive::ViewModelPropertyNumberBase::typeKey);
+
+  uint32_t host = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, kHostSize);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, kHostSize);
+  riv.begin(rive::ArtboardComponentListBase::typeKey);
+  riv.uintValue(rive::ComponentBase::parentIdPropertyKey, host);
+  riv.beginUncounted(rive::StateMachineBase::typeKey);
+
+  uint32_t item = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, kItemSize);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, kItemSize);
+  riv.uintValue(rive::ArtboardBase::viewModelIdPropertyKey, 0);
+  riv.begin(rive::NodeBase::typeKey);
+  riv.uintValue(rive::ComponentBase::parentIdPropertyKey, item);
+  riv.beginUncounted(rive::DataBindContextBase::typeKey);
+  riv.uintValue(rive::DataBindBase::propertyKeyPropertyKey,
+                rive::NodeBase::xPropertyKey);
+  riv.idsValue(rive::DataBindContextBase::sourcePathIdsPropertyKey, {0u, 0u});
+  uint32_t firstShape = 0;
+  for (int i = 0; i < kShapesPerItem; i++) {
+    uint32_t shape = riv.begin(rive::ShapeBase::typeKey);
+    if (i == 0) {
+      firstShape = shape;
+    }
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, item);
+    riv.floatValue(rive::NodeBase::xPropertyKey, 10.0f + i * 10.0f);
+    riv.floatValue(rive::NodeBase::yPropertyKey, 50.0f);
+    riv.begin(rive::RectangleBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.floatValue(rive::ParametricPathBase::widthPropertyKey, 8.0f);
+    riv.floatValue(rive::ParametricPathBase::heightPropertyKey, 80.0f);
+    uint32_t fill = riv.begin(rive::FillBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.begin(rive::SolidColorBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, fill);
+  }
+
+  riv.beginUncounted(rive::LinearAnimationBase::typeKey);
+  riv.uintValue(rive::LinearAnimationBase::durationPropertyKey, kPressFrames);
+  riv.beginUncounted(rive::KeyedObjectBase::typeKey);
+  riv.uintValue(rive::KeyedObjectBase::objectIdPropertyKey, firstShape);
+  riv.beginUncounted(rive::KeyedPropertyBase::typeKey);
+  riv.uintValue(rive::KeyedPropertyBase::propertyKeyPropertyKey,
+                rive::NodeBase::yPropertyKey);
+  const float pressKeys[][2] = {{0.0f, 50.0f}, {kPressFrames, 0.0f}};
+  for (const auto &key : pressKeys) {
+    riv.beginUncounted(rive::KeyFrameDoubleBase::typeKey);
+    riv.uintValue(rive::KeyFrameBase::framePropertyKey,
+                  static_cast<uint32_t>(key[0]));
+    riv.uintValue(rive::InterpolatingKeyFrameBase::interpolationTypePropertyKey,
+                  1); // linear
+    riv.floatValue(rive::KeyFrameDoubleBase::valuePropertyKey, key[1]);
+  }
+
+  riv.beginUncounted(rive::StateMachineBase::typeKey);
+  riv.beginUncounted(rive::StateMachineBoolBase::typeKey);
+  riv.beginUncounted(rive::StateMachineLayerBase::typeKey);
+  riv.beginUncounted(rive::EntryStateBase::typeKey);
+  riv.beginUncounted(rive::StateTransitionBase::typeKey);
+  riv.uintValue(rive::StateTransitionBase::stateToIdPropertyKey, kIdleState);
+  riv.beginUncounted(rive::AnyStateBase::typeKey);
+  riv.beginUncounted(rive::ExitStateBase::typeKey);
+  riv.beginUncounted(rive::AnimationStateBase::typeKey);
+  riv.beginUncounted(rive::StateTransitionBase::typeKey);
+  riv.uintValue(rive::StateTransitionBase::stateToIdPropertyKey,
+                kPressedState);
+  riv.beginUncounted(rive::TransitionBoolConditionBase::typeKey);
+  riv.uintValue(rive::TransitionInputConditionBase::inputIdPropertyKey, 0);
+  riv.beginUncounted(rive::AnimationStateBase::typeKey);
+  riv.uintValue(rive::AnimationStateBase::animationIdPropertyKey, 0);
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+struct ListMode {
+  const char *name;
+  bool virtualized;
+};
+
+const ListMode listModes[] = {
+    {"eager", false},
+    {"virtualized", true},
+};
+
+// The host artboard with its list and state machine, bound to fresh items
+// so every mode starts from the same state.
+struct Feed {
+  std::unique_ptr<rive::ArtboardInstance> artboard;
+  std::unique_ptr<rive::StateMachineInstance> machine;
+  rive::ArtboardComponentList *list = nullptr;
+  std::vector<rive::rcp<rive::ViewModelInstanceListItem>> items;
+};
+
+bool makeFeed(rive::File &file, bool virtualized, Feed *feed) {
+  feed->artboard = file.artboardAt(0);
+  if (!feed->artboard) {
+    return false;
+  }
+  for (auto object : feed->artboard->objects()) {
+    if (object != nullptr && object->is<rive::ArtboardComponentList>()) {
+      feed->list = object->as<rive::ArtboardComponentList>();
+    }
+  }
+  feed->machine = feed->artboard->stateMachineAt(0);
+  if (feed->list == nullptr || feed->machine == nullptr) {
+    return false;
+  }
+  feed->list->virtualize(virtualized);
+  feed->list->overscan(kOverscan);
+  for (int i = 0; i < kItems; i++) {
+    auto viewModelInstance = file.createViewModelInstance(file.viewModel(0));
+    if (viewModelInstance == nullptr) {
+      return false;
+    }
+    viewModelInstance->propertyValues()[0]
+        ->as<rive::ViewModelInstanceNumber>()
+        ->propertyValue(static_cast<float>(i));
+    auto item = rive::make_rcp<rive::ViewModelInstanceListItem>();
+    item->viewModelInstance(viewModelInstance);
+    feed->items.push_back(item);
+  }
+  return true;
+}
+
+// Binds every item at once, the way a list source change does.
+double bindItems(Feed &feed) {
+  std::vector<rive::ViewModelInstanceListItem *> items;
+  for (auto &item : feed.items) {
+    items.push_back(item.get());
+  }
+  Stopwatch stopwatch;
+  feed.list->updateList(rive::ArtboardComponentListBase::listSourcePropertyKey,
+                        &items);
+  return stopwatch.elapsedMicros();
+}
+
+// Whether item index overlaps the host artboard.
+bool inView(rive::ArtboardComponentList &list, int index) {
+  rive::AABB bounds = list.layoutBoundsForNode(index);
+  float left = bounds.left() + list.x();
+  float top = bounds.top() + list.y();
+  return left <= kHostSize && left + bounds.width() >= 0.0f &&
+         top <= kHostSize && top + bounds.height() >= 0.0f;
+}
+
+// Every item within the host artboard must be instanced and show its own
+// view model.
+bool visibleItemsMatch(Feed &feed) {
+  auto &list = *feed.list;
+  for (int i = 0; i < kItems; i++) {
+    if (!inView(list, i)) {
+      continue;
+    }
+    auto artboard = list.artboardInstance(i);
+    if (artboard == nullptr || artboard->dataContext() == nullptr ||
+        artboard->dataContext()->viewModelInstance() !=
+            feed.items[i]->viewModelInstance()) {
+      return false;
+    }
+    for (auto object : artboard->objects()) {
+      if (object != nullptr && object->coreType() == rive::NodeBase::typeKey) {
+        if (object->as<rive::Node>()->x() != static_cast<float>(i)) {
+          return false;
+        }
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+// Hashes item index's world transforms and pressed input, all an instance
+// recycled from another item could carry over.
+uint64_t itemHash(rive::ArtboardComponentList &list, int index) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  auto mix = [&hash](float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash = (hash ^ bits) * 0x100000001b3ull;
+  };
+  for (auto object : list.artboardInstance(index)->objects()) {
+    if (object != nullptr && object->is<rive::Node>()) {
+      const rive::Mat2D &transform = object->as<rive::Node>()->worldTransform();
+      for (int i = 0; i < 6; i++) {
+        mix(transform[i]);
+      }
+    }
+  }
+  auto machine = list.stateMachineInstance(index);
+  auto pressed = machine != nullptr ? machine->input(0) : nullptr;
+  mix(pressed != nullptr && static_cast<rive::SMIBool *>(pressed)->value()
+          ? 1.0f
+          : 0.0f);
+  return hash;
+}
+
+void press(rive::ArtboardComponentList &list, int index) {
+  auto machine = list.stateMachineInstance(index);
+  auto pressed = machine != nullptr ? machine->input(0) : nullptr;
+  if (pressed != nullptr) {
+    static_cast<rive::SMIBool *>(pressed)->value(true);
+  }
+}
+
+// Scrolls an eager and a virtualized feed together, pressing every third
+// item in view, and requires each item in view to look the same in both. An
+// item that takes over a recycled instance must show as it would on a new
+// one, whatever the item before it had pressed or animated.
+bool virtualizedMatchesEager(rive::File &file) {
+  Feed eager;
+  Feed virtualized;
+  if (!makeFeed(file, false, &eager) || !makeFeed(file, true, &virtualized)) {
+    return false;
+  }
+  Feed *feeds[] = {&eager, &virtualized};
+  for (Feed *feed : feeds) {
+    bindItems(*feed);
+    feed->machine->advanceAndApply(0.0f);
+  }
+  for (int frame = 0; frame < kCheckFrames; frame++) {
+    for (Feed *feed : feeds) {
+      feed->list->x(-(frame + 1) * kScrollPerFrame);
+      feed->machine->advanceAndApply(1.0f / 60.0f);
+    }
+    for (int i = 0; i < kItems; i++) {
+      if (!inView(*virtualized.list, i)) {
+        continue;
+      }
+      if (eager.list->artboardInstance(i) == nullptr ||
+          virtualized.list->artboardInstance(i) == nullptr ||
+          itemHash(*eager.list, i) != itemHash(*virtualized.list, i)) {
+        return false;
+      }
+      if (i % 3 == 0) {
+        press(*eager.list, i);
+        press(*virtualized.list, i);
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool runListBench(const BenchOptions &options, JsonWriter &json) {
+  auto bytes = buildFeedFile();
+  rive::NoOpFactory factory;
+  auto file = rive::File::import(
+      rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+  if (!file) {
+    std::cerr << "rive_bench: failed to import the synthetic feed\n";
+    return false;
+  }
+
+  json.value("items", static_cast<int64_t>(kItems));
+  json.value("scroll_per_frame", static_cast<double>(kScrollPerFrame));
+  json.beginArray("modes");
+  double eagerP50 = 0.0;
+  bool resultsMatch = true;
+  for (const auto &mode : listModes) {
+    Feed feed;
+    if (!makeFeed(*file, mode.virtualized, &feed)) {
+      std::cerr << "rive_bench: the synthetic feed is incomplete\n";
+      json.endArray();
+      return false;
+    }
+    double bindMicros = bindItems(feed);
+    // Peaks count from the first advance after binding, where a list that
+    // instanced items before the layout placed them would show.
+    feed.machine->advanceAndApply(0.0f);
+    size_t peakInstanced = feed.list->instancedCount();
+    size_t peakPooled = feed.list->recycledCount();
+
+    rive::NoOpRenderer renderer;
+    float scrollRange = kItems * kItemSize - kHostSize;
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    double instanced = 0.0;
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      float scroll = std::fmod((i + 1) * kScrollPerFrame, scrollRange);
+      feed.list->x(-scroll);
+      Stopwatch stopwatch;
+      feed.machine->advanceAndApply(1.0f / 60.0f);
+      feed.artboard->draw(&renderer);
+      double micros = stopwatch.elapsedMicros();
+      peakInstanced = std::max(peakInstanced, feed.list->instancedCount());
+      peakPooled = std::max(peakPooled, feed.list->recycledCount());
+      if (i >= options.warmup) {
+        samples.push_back(micros);
+        instanced += static_cast<double>(feed.list->instancedCount());
+        resultsMatch = resultsMatch && visibleItemsMatch(feed);
+      }
+    }
+
+    if (mode.virtualized) {
+      resultsMatch = resultsMatch && peakInstanced <= kMaxLiveItems &&
+                     peakPooled <= kMaxLiveItems;
+    }
+    // Totals since binding, the first advance's instancing included.
+    const auto &counters = feed.list->virtualizationCounters();
+    double frames = std::max(options.iterations, 1);
+    Stats stats = summarize(samples);
+    if (!mode.virtualized) {
+      eagerP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.value("bind_us", bindMicros);
+    json.stats("frame", stats);
+    json.value("instanced_per_frame", instanced / frames);
+    json.value("peak_instanced", static_cast<int64_t>(peakInstanced));
+    json.value("pooled", static_cast<int64_t>(feed.list->recycledCount()));
+    json.value("peak_pooled", static_cast<int64_t>(peakPooled));
+    json.value("items_created", static_cast<int64_t>(counters.itemsCreated));
+    json.value("items_recycled",
+               static_cast<int64_t>(counters.itemsRecycled));
+    json.value("instances_freed",
+               static_cast<int64_t>(counters.instancesFreed));
+    json.value("speedup", stats.p50 > 0.0 ? eagerP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  bool matchesEager = virtualizedMatchesEager(*file);
+  json.value("virtualized_matches_eager", matchesEager);
+  json.resultsMatch(resultsMatch && matchesEager);
+  return true;
+}
+
+} // namespace bench
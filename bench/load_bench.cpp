@@ -0,0 +1,208 @@
+#include "bench_suites.hpp"
+
+#include <iostream>
+#include <memory>
+
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/scene.hpp>
+#include <utils/no_op_factory.hpp>
+#include <utils/no_op_renderer.hpp>
+
+#include "mapped_file.hpp"
+
+namespace bench {
+
+namespace {
+
+enum class LoadMode { copy, mmap, lazy };
+
+const char *loadModeName(LoadMode mode) {
+  switch (mode) {
+  case LoadMode::copy:
+    return "copy";
+  case LoadMode::mmap:
+    return "mmap";
+  case LoadMode::lazy:
+    return "lazy";
+  }
+  return "";
+}
+
+// Everything the app keeps alive after its first frame. Members are
+// declared so the File is destroyed before the bytes it may borrow.
+struct LoadedFile {
+  std::vector<uint8_t> contents;
+  std::unique_ptr<MappedFile> mapping;
+  std::unique_ptr<rive::File> file;
+  std::unique_ptr<rive::ArtboardInstance> artboard;
+  std::unique_ptr<rive::Scene> scene;
+};
+
+// Mirrors the app's startup: load, import, instance the default artboard
+// and scene, advance once and draw. Returns false on any failure.
+bool loadToFirstFrame(LoadMode mode, const std::filesystem::path &path,
+                      rive::Factory *factory, LoadedFile &loaded) {
+  if (mode != LoadMode::copy) {
+    loaded.mapping = MappedFile::open(path);
+    if (!loaded.mapping) {
+      return false;
+    }
+    loaded.file =
+        mode == LoadMode::lazy
+            ? rive::File::importLazy(loaded.mapping->bytes(), factory)
+            : rive::File::importBorrowed(loaded.mapping->bytes(), factory);
+  } else {
+    loaded.contents = loadFileContents(path);
+    if (loaded.contents.empty()) {
+      return false;
+    }
+    loaded.file = rive::File::import(
+        rive::Span<const uint8_t>(loaded.contents.data(),
+                                  loaded.contents.size()),
+        factory);
+  }
+  if (!loaded.file) {
+    return false;
+  }
+  loaded.artboard = loaded.file->artboardDefault();
+  if (!loaded.artboard) {
+    return false;
+  }
+  loaded.scene = loaded.artboard->defaultScene();
+  if (loaded.scene) {
+    loaded.scene->advanceAndApply(0.0f);
+  } else {
+    loaded.artboard->advance(0.0f);
+  }
+  rive::NoOpRenderer renderer;
+  loaded.artboard->draw(&renderer);
+  return true;
+}
+
+// Frames of each artboard's default scene the modes are compared over.
+constexpr int kCheckFrames = 30;
+
+// Checksums every artboard of file, instanced and advanced through
+// kCheckFrames frames of its default scene.
+uint64_t fileChecksum(const rive::File &file, float frameSeconds) {
+  Checksum checksum;
+  for (size_t i = 0; i < file.artboardCount(); i++) {
+    auto artboard = file.artboardAt(i);
+    if (!artboard) {
+      checksum.mix(uint64_t(0));
+      continue;
+    }
+    auto scene = artboard->defaultScene();
+    for (int frame = 0; frame < kCheckFrames; frame++) {
+      if (scene) {
+        scene->advanceAndApply(frameSeconds);
+      } else {
+        artboard->advance(frameSeconds);
+      }
+      checksum.mix(artboardChecksum(*artboard));
+    }
+  }
+  return checksum.value();
+}
+
+// Times mode and writes the checksum of a file it loaded to checksum.
+bool benchMode(const BenchOptions &options, LoadMode mode,
+               const std::filesystem::path &path, rive::Factory *factory,
+               JsonWriter &json, uint64_t *checksum) {
+  std::vector<double> samples;
+  samples.reserve(options.iterations);
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    Stopwatch stopwatch;
+    LoadedFile loaded;
+    if (!loadToFirstFrame(mode, path, factory, loaded)) {
+      std::cerr << "rive_bench: failed to load " << path << " ("
+                << loadModeName(mode) << ")\n";
+      return false;
+    }
+    double micros = stopwatch.elapsedMicros();
+    if (i >= options.warmup) {
+      samples.push_back(micros);
+    }
+  }
+
+  json.beginObject();
+  json.value("mode", std::string(loadModeName(mode)));
+  json.stats("time_to_first_frame", summarize(samples));
+  // The high-water mark is process wide, so it only isolates one mode when
+  // the suite runs with a single --load-mode.
+  json.value("peak_rss_kb", peakResidentKilobytes());
+  json.endObject();
+
+  // After reading the peak, since checking imports every artboard.
+  LoadedFile loaded;
+  if (!loadToFirstFrame(mode, path, factory, loaded)) {
+    return false;
+  }
+  *checksum = fileChecksum(*loaded.file, options.frameSeconds);
+  return true;
+}
+
+} // namespace
+
+bool runLoadBench(const BenchOptions &options, JsonWriter &json) {
+  std::vector<LoadMode> modes;
+  for (LoadMode mode : {LoadMode::copy, LoadMode::mmap, LoadMode::lazy}) {
+    if (options.loadMode == "all" || options.loadMode == loadModeName(mode)) {
+      modes.push_back(mode);
+    }
+  }
+  if (modes.empty()) {
+    std::cerr << "rive_bench: unknown load mode '" << options.loadMode
+              << "'\n";
+    return false;
+  }
+
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  rive::NoOpFactory factory;
+  json.value("load_mode", options.loadMode);
+  json.value("baseline_peak_rss_kb", peakResidentKilobytes());
+  json.beginArray("files");
+  for (const auto &path : files) {
+    json.beginObject();
+    json.value("file", path.filename().string());
+    json.value("bytes",
+               static_cast<int64_t>(std::filesystem::file_size(path)));
+    json.beginArray("modes");
+    std::vector<uint64_t> checksums;
+    for (LoadMode mode : modes) {
+      uint64_t checksum = 0;
+      if (benchMode(options, mode, path, &factory, json, &checksum)) {
+        checksums.push_back(checksum);
+      }
+    }
+    json.endArray();
+
+    // Every mode must load what an eager import of the same bytes does.
+    auto mapping = MappedFile::open(path);
+    auto reference =
+        mapping ? rive::File::importBorrowed(mapping->bytes(), &factory)
+                : nullptr;
+    bool resultsMatch =
+        reference != nullptr && checksums.size() == modes.size();
+    if (reference) {
+      uint64_t referenceChecksum =
+          fileChecksum(*reference, options.frameSeconds);
+      for (uint64_t checksum : checksums) {
+        resultsMatch = resultsMatch && checksum == referenceChecksum;
+      }
+    }
+    json.resultsMatch(resultsMatch);
+    json.endObject();
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,211 @@
+#include "bench_suites.hpp"
+
+#include <iostream>
+#include <memory>
+
+#include <rive/animation/linear_animation_instance.hpp>
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <utils/no_op_factory.hpp>
+#include <utils/no_op_renderer.hpp>
+
+namespace bench {
+
+namespace {
+
+// Runs body warmup + iterations times and summarizes the timed iterations.
+template <typename Body>
+Stats timePhase(const BenchOptions &options, Body &&body) {
+  std::vector<double> samples;
+  samples.reserve(options.iterations);
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    Stopwatch stopwatch;
+    body();
+    double micros = stopwatch.elapsedMicros();
+    if (i >= options.warmup) {
+      samples.push_back(micros);
+    }
+  }
+  return summarize(samples);
+}
+
+// Per advance work since the artboard's counters were reset: components
+// Artboard::updateComponents visited and updated, and its layout passes.
+struct FrameCounts {
+  const char *phase;
+  double visited;
+  double updated;
+  double layoutPasses;
+  double layoutSkipped;
+  double layoutNodes;
+  double layoutMicros;
+};
+
+FrameCounts frameCounts(const char *phase, const rive::Artboard &artboard,
+                        int frames) {
+  const auto &updates = artboard.updateCounters();
+  const auto &layout = artboard.layoutCounters();
+  return {phase,
+          static_cast<double>(updates.componentsVisited) / frames,
+          static_cast<double>(updates.componentsUpdated) / frames,
+          static_cast<double>(layout.passes) / frames,
+          static_cast<double>(layout.skippedPasses) / frames,
+          static_cast<double>(layout.nodesVisited) / frames,
+          layout.seconds * 1e6 / frames};
+}
+
+// Checksum of an instance after advancing it by zero, as the first frame
+// would.
+uint64_t settledChecksum(rive::ArtboardInstance &instance) {
+  instance.advance(0.0f);
+  return artboardChecksum(instance);
+}
+
+bool benchFile(const BenchOptions &options, const std::filesystem::path &path,
+               rive::Factory *factory, JsonWriter &json) {
+  auto bytes = loadFileContents(path);
+  if (bytes.empty()) {
+    std::cerr << "rive_bench: failed to read " << path << "\n";
+    return false;
+  }
+  rive::Span<const uint8_t> data(bytes.data(), bytes.size());
+
+  std::unique_ptr<rive::File> file = rive::File::import(data, factory);
+  if (!file || file->artboard() == nullptr) {
+    std::cerr << "rive_bench: failed to import " << path << "\n";
+    return false;
+  }
+  rive::Artboard *artboard = file->artboard();
+
+  json.beginObject();
+  json.value("file", path.filename().string());
+  json.value("bytes", static_cast<int64_t>(bytes.size()));
+  json.value("artboard", artboard->name());
+  json.beginObject("phases");
+  std::vector<FrameCounts> counts;
+  int frames = options.warmup + options.iterations;
+
+  // Each phase keeps what it made last, to check against instances made
+  // and advanced outside the timings.
+  std::unique_ptr<rive::File> imported;
+  json.stats("import", timePhase(options, [&]() {
+               imported = rive::File::import(data, factory);
+             }));
+  bool resultsMatch = imported != nullptr &&
+                      settledChecksum(*imported->artboardDefault()) ==
+                          settledChecksum(*artboard->instance());
+
+  std::unique_ptr<rive::ArtboardInstance> instanced;
+  json.stats("instance", timePhase(options, [&]() {
+               instanced = artboard->instance();
+             }));
+  resultsMatch = resultsMatch && settledChecksum(*instanced) ==
+                                     settledChecksum(*artboard->instance());
+
+  // Animation and state machine phases each get their own instance so one
+  // doesn't leave the other's artboard settled.
+  if (artboard->animationCount() > 0) {
+    auto instance = artboard->instance();
+    rive::LinearAnimationInstance animation(artboard->animation(0),
+                                            instance.get());
+    instance->resetUpdateCounters();
+    instance->resetLayoutCounters();
+    json.stats("linear_advance_apply", timePhase(options, [&]() {
+                 animation.advanceAndApply(options.frameSeconds);
+               }));
+    counts.push_back(
+        frameCounts("linear_advance_apply", *instance, frames));
+
+    auto replayed = artboard->instance();
+    rive::LinearAnimationInstance replay(artboard->animation(0),
+                                         replayed.get());
+    for (int i = 0; i < frames; i++) {
+      replay.advanceAndApply(options.frameSeconds);
+    }
+    resultsMatch = resultsMatch && artboardChecksum(*instance) ==
+                                       artboardChecksum(*replayed);
+  }
+
+  if (artboard->stateMachineCount() > 0) {
+    auto instance = artboard->instance();
+    auto machine = instance->defaultStateMachine();
+    if (!machine) {
+      machine = instance->stateMachineAt(0);
+    }
+    instance->resetUpdateCounters();
+    instance->resetLayoutCounters();
+    json.stats("state_machine_advance_apply", timePhase(options, [&]() {
+                 machine->advanceAndApply(options.frameSeconds);
+               }));
+    counts.push_back(
+        frameCounts("state_machine_advance_apply", *instance, frames));
+
+    auto replayed = artboard->instance();
+    auto replay = replayed->defaultStateMachine();
+    if (!replay) {
+      replay = replayed->stateMachineAt(0);
+    }
+    for (int i = 0; i < frames; i++) {
+      replay->advanceAndApply(options.frameSeconds);
+    }
+    resultsMatch = resultsMatch && artboardChecksum(*instance) ==
+                                       artboardChecksum(*replayed);
+  }
+
+  {
+    auto instance = artboard->instance();
+    instance->advance(0.0f);
+    rive::NoOpRenderer renderer;
+    json.stats("draw",
+               timePhase(options, [&]() { instance->draw(&renderer); }));
+    // Drawn again and again, it must still draw what a fresh instance does.
+    resultsMatch = resultsMatch && artboardChecksum(*instance) ==
+                                       settledChecksum(*artboard->instance());
+  }
+  json.endObject();
+
+  json.beginObject("components_per_frame");
+  for (const auto &count : counts) {
+    json.beginObject(count.phase);
+    json.value("visited", count.visited);
+    json.value("updated", count.updated);
+    json.endObject();
+  }
+  json.endObject();
+
+  json.beginObject("layout_per_frame");
+  for (const auto &count : counts) {
+    json.beginObject(count.phase);
+    json.value("passes", count.layoutPasses);
+    json.value("skipped_passes", count.layoutSkipped);
+    json.value("nodes_visited", count.layoutNodes);
+    json.value("time_us", count.layoutMicros);
+    json.endObject();
+  }
+  json.endObject();
+  json.resultsMatch(resultsMatch);
+  json.endObject();
+  return true;
+}
+
+} // namespace
+
+bool runPhaseBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  rive::NoOpFactory factory;
+  json.beginArray("files");
+  for (const auto &path : files) {
+    benchFile(options, path, &factory, json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,269 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/renderer/headless/render_context_headless_impl.hpp>
+#include <rive/renderer/render_context.hpp>
+#include <rive/renderer/rive_renderer.hpp>
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t kTargetWidth = 1920;
+constexpr uint32_t kTargetHeight = 1080;
+// Frames rendered twice with hashed buffers to check each mode writes the
+// same resources for the same frames.
+constexpr int kVerifyFrames = 10;
+
+struct ContextMode {
+  const char *name;
+  rive::gpu::RenderContextHeadlessImpl::ContextOptions options;
+  // The interlock mode these options should make RenderContext pick.
+  rive::gpu::InterlockMode interlockMode;
+};
+
+// The interlock mode RenderContext picks follows the platform features, so
+// each mode gets its own context reporting what that mode needs.
+const ContextMode contextModes[] = {
+    {"raster_ordering",
+     {false, false},
+     rive::gpu::InterlockMode::rasterOrdering},
+    {"atomics", {true, false}, rive::gpu::InterlockMode::atomics},
+    {"msaa", {true, true}, rive::gpu::InterlockMode::msaa},
+};
+
+const char *interlockModeName(rive::gpu::InterlockMode mode) {
+  switch (mode) {
+  case rive::gpu::InterlockMode::rasterOrdering:
+    return "raster_ordering";
+  case rive::gpu::InterlockMode::atomics:
+    return "atomics";
+  case rive::gpu::InterlockMode::clockwiseAtomic:
+    return "clockwise_atomic";
+  case rive::gpu::InterlockMode::msaa:
+    return "msaa";
+  }
+  return "unknown";
+}
+
+// Draws the artboard centered in the render target, the way the viewer does,
+// and returns the time spent in RiveRenderer and RenderContext::flush.
+void renderFrame(rive::gpu::RenderContext &context,
+                 rive::gpu::RenderTarget &target, rive::Artboard &artboard,
+                 uint64_t frameNumber, double *drawMicros,
+                 double *flushMicros) {
+  Stopwatch stopwatch;
+  rive::gpu::RenderContext::FrameDescriptor frameDescriptor;
+  frameDescriptor.renderTargetWidth = kTargetWidth;
+  frameDescriptor.renderTargetHeight = kTargetHeight;
+  frameDescriptor.loadAction = rive::gpu::LoadAction::clear;
+  frameDescriptor.clearColor = 0xFF404040;
+  context.beginFrame(frameDescriptor);
+
+  float scale = std::min(kTargetWidth / artboard.width(),
+                         kTargetHeight / artboard.height());
+  rive::RiveRenderer renderer(&context);
+  renderer.save();
+  renderer.transform(rive::Mat2D::fromTranslate(
+                         (kTargetWidth - artboard.width() * scale) * 0.5f,
+                         (kTargetHeight - artboard.height() * scale) * 0.5f) *
+                     rive::Mat2D::fromScale(scale, scale));
+  artboard.draw(&renderer);
+  renderer.restore();
+  *drawMicros = stopwatch.elapsedMicros();
+
+  stopwatch.reset();
+  rive::gpu::RenderContext::FlushResources flushResources;
+  flushResources.renderTarget = &target;
+  // Nothing is in flight on a headless context, so everything is safe.
+  flushResources.currentFrameNumber = frameNumber;
+  flushResources.safeFrameNumber = frameNumber;
+  context.flush(flushResources);
+  *flushMicros = stopwatch.elapsedMicros();
+}
+
+// A context with its own instance of the file's default artboard and state
+// machine.
+struct Scene {
+  std::unique_ptr<rive::gpu::RenderContext> context;
+  rive::gpu::RenderContextHeadlessImpl *impl = nullptr;
+  std::unique_ptr<rive::File> file;
+  std::unique_ptr<rive::ArtboardInstance> artboard;
+  std::unique_ptr<rive::StateMachineInstance> machine;
+};
+
+bool makeScene(rive::Span<const uint8_t> data,
+               const rive::gpu::RenderContextHeadlessImpl::ContextOptions
+                   &contextOptions,
+               Scene *scene) {
+  scene->context =
+      rive::gpu::RenderContextHeadlessImpl::MakeContext(contextOptions);
+  scene->impl =
+      scene->context->static_impl_cast<rive::gpu::RenderContextHeadlessImpl>();
+  // Import through the context so paths, paints and images are the
+  // renderer's own.
+  scene->file = rive::File::import(data, scene->context.get());
+  if (!scene->file) {
+    return false;
+  }
+  scene->artboard = scene->file->artboardDefault();
+  if (!scene->artboard) {
+    return false;
+  }
+  if (scene->artboard->stateMachineCount() > 0) {
+    scene->machine = scene->artboard->defaultStateMachine();
+    if (!scene->machine) {
+      scene->machine = scene->artboard->stateMachineAt(0);
+    }
+  }
+  return true;
+}
+
+void advanceScene(const BenchOptions &options, Scene &scene) {
+  if (scene.machine) {
+    scene.machine->advanceAndApply(options.frameSeconds);
+  } else {
+    scene.artboard->advance(options.frameSeconds);
+  }
+}
+
+// Renders kVerifyFrames frames of a fresh scene with hashed buffers and
+// returns the hash of everything the front end wrote.
+uint64_t verifyHash(const BenchOptions &options, const ContextMode &mode,
+                    rive::Span<const uint8_t> data,
+                    rive::gpu::RenderTarget &target) {
+  auto contextOptions = mode.options;
+  contextOptions.hashMappedBuffers = true;
+  Scene scene;
+  if (!makeScene(data, contextOptions, &scene)) {
+    return 0;
+  }
+  for (int i = 0; i < kVerifyFrames; i++) {
+    advanceScene(options, scene);
+    double drawMicros = 0.0;
+    double flushMicros = 0.0;
+    renderFrame(*scene.context, target, *scene.artboard, i + 1, &drawMicros,
+                &flushMicros);
+  }
+  return scene.impl->counters().mappedBytesHash;
+}
+
+bool benchMode(const BenchOptions &options, const ContextMode &mode,
+               rive::Span<const uint8_t> data, JsonWriter &json) {
+  rive::gpu::RenderTargetHeadless target(kTargetWidth, kTargetHeight);
+  Scene scene;
+  if (!makeScene(data, mode.options, &scene)) {
+    return false;
+  }
+  auto *impl = scene.impl;
+
+  std::vector<double> drawSamples;
+  std::vector<double> flushSamples;
+  drawSamples.reserve(options.iterations);
+  flushSamples.reserve(options.iterations);
+  for (int i = 0; i < options.warmup + options.iterations; i++) {
+    if (i == options.warmup) {
+      impl->resetCounters();
+    }
+    advanceScene(options, scene);
+    double drawMicros = 0.0;
+    double flushMicros = 0.0;
+    renderFrame(*scene.context, target, *scene.artboard, i + 1, &drawMicros,
+                &flushMicros);
+    if (i >= options.warmup) {
+      drawSamples.push_back(drawMicros);
+      flushSamples.push_back(flushMicros);
+    }
+  }
+
+  // Every timed frame must have drawn something through the interlock mode
+  // the mode is meant to exercise.
+  bool resultsMatch =
+      impl->counters().frames == static_cast<uint64_t>(options.iterations) &&
+      impl->counters().drawBatches > 0 && !impl->flushes().empty();
+  for (const auto &flush : impl->flushes()) {
+    resultsMatch =
+        resultsMatch && flush.desc.interlockMode == mode.interlockMode;
+  }
+  // Hashing would skew the timings, so the check renders its own frames,
+  // twice, and both must write the same resources.
+  uint64_t hash = verifyHash(options, mode, data, target);
+  resultsMatch = resultsMatch && hash != 0 &&
+                 hash == verifyHash(options, mode, data, target);
+
+  const auto &counters = impl->counters();
+  double frames = std::max<double>(static_cast<double>(counters.frames), 1.0);
+  json.beginObject();
+  json.value("mode", std::string(mode.name));
+  json.stats("draw", summarize(drawSamples));
+  json.stats("flush", summarize(flushSamples));
+  json.value("flushes_per_frame", counters.flushes / frames);
+  json.value("draw_batches_per_frame", counters.drawBatches / frames);
+  json.value("bytes_mapped_per_frame", counters.bytesMapped / frames);
+  if (!impl->flushes().empty()) {
+    // Interlock mode RenderContext settled on in the last frame.
+    json.value("interlock_mode",
+               std::string(interlockModeName(
+                   impl->flushes().back().desc.interlockMode)));
+  }
+  json.value("gradient_texture_height",
+             static_cast<int64_t>(impl->gradientTextureHeight()));
+  json.value("tessellation_texture_height",
+             static_cast<int64_t>(impl->tessellationTextureHeight()));
+  json.resultsMatch(resultsMatch);
+  json.endObject();
+  return true;
+}
+
+bool benchFile(const BenchOptions &options, const std::filesystem::path &path,
+               JsonWriter &json) {
+  auto bytes = loadFileContents(path);
+  if (bytes.empty()) {
+    std::cerr << "rive_bench: failed to read " << path << "\n";
+    return false;
+  }
+  rive::Span<const uint8_t> data(bytes.data(), bytes.size());
+
+  json.beginObject();
+  json.value("file", path.filename().string());
+  json.beginArray("modes");
+  bool ok = true;
+  for (const auto &mode : contextModes) {
+    if (!benchMode(options, mode, data, json)) {
+      std::cerr << "rive_bench: failed to render " << path << "\n";
+      ok = false;
+      break;
+    }
+  }
+  json.endArray();
+  json.endObject();
+  return ok;
+}
+
+} // namespace
+
+bool runRenderBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  json.value("target_width", static_cast<int64_t>(kTargetWidth));
+  json.value("target_height", static_cast<int64_t>(kTargetHeight));
+  json.beginArray("files");
+  for (const auto &path : files) {
+    benchFile(options, path, json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
@@ -0,0 +1,336 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <rive/artboard.hpp>
+#include <rive/bones/cubic_weight.hpp>
+#include <rive/bones/root_bone.hpp>
+#include <rive/bones/skin.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/bones/bone_base.hpp>
+#include <rive/generated/bones/cubic_weight_base.hpp>
+#include <rive/generated/bones/root_bone_base.hpp>
+#include <rive/generated/bones/skin_base.hpp>
+#include <rive/generated/bones/tendon_base.hpp>
+#include <rive/generated/bones/weight_base.hpp>
+#include <rive/generated/component_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <rive/generated/shapes/cubic_detached_vertex_base.hpp>
+#include <rive/generated/shapes/points_path_base.hpp>
+#include <rive/generated/shapes/shape_base.hpp>
+#include <rive/generated/shapes/straight_vertex_base.hpp>
+#include <rive/generated/shapes/vertex_base.hpp>
+#include <rive/generated/transform_component_base.hpp>
+#include <rive/shapes/cubic_vertex.hpp>
+#include <rive/shapes/points_path.hpp>
+#include <utils/no_op_factory.hpp>
+
+#include "work_stealing_pool.hpp"
+
+namespace bench {
+
+namespace {
+
+// Shape of the synthetic character rigs: each is a closed path whose
+// vertices are weighted to a chain of bones, like a skinned limb or body.
+constexpr int kRigs = 24;
+constexpr int kBonesPerRig = 16;
+constexpr int kVerticesPerRig = 2000;
+
+// Packs four byte sized bone indices or weights the way Weight stores them.
+uint32_t pack(const uint32_t (&values)[4]) {
+  return values[0] | (values[1] << 8) | (values[2] << 16) | (values[3] << 24);
+}
+
+// Weights point p of n to the two bones nearest to it along the chain. Some
+// points also take a little of the chain's first and last bones.
+void weightsFor(int p, int n, bool fourBones, uint32_t &indices,
+                uint32_t &weights) {
+  float along = static_cast<float>(p) / n * (kBonesPerRig - 1);
+  uint32_t bone = static_cast<uint32_t>(along);
+  uint32_t next = std::min<uint32_t>(bone + 1, kBonesPerRig - 1);
+  uint32_t total = fourBones ? 200 : 255;
+  uint32_t nextWeight = static_cast<uint32_t>((along - bone) * total);
+  // Tendon i is bone index i + 1; index 0 is the skin's own transform.
+  uint32_t boneIndices[4] = {bone + 1, next + 1, 1, kBonesPerRig};
+  uint32_t boneWeights[4] = {total - nextWeight, nextWeight, 0, 0};
+  if (fourBones) {
+    boneWeights[2] = 30;
+    boneWeights[3] = 25;
+  }
+  indices = pack(boneIndices);
+  weights = pack(boneWeights);
+}
+
+// Writes a .riv holding one artboard of kRigs skinned paths. The assets
+// directory has no skinned files, so the rigs are built here.
+std::vector<uint8_t> buildRigFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+  uint32_t artboard = riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, 2000.0f);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, 2000.0f);
+
+  for (int rig = 0; rig < kRigs; rig++) {
+    float originX = 100.0f + (rig % 6) * 300.0f;
+    float originY = 200.0f + (rig / 6) * 400.0f;
+
+    uint32_t bones[kBonesPerRig];
+    bones[0] = riv.begin(rive::RootBoneBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, artboard);
+    riv.floatValue(rive::RootBoneBase::xPropertyKey, originX);
+    riv.floatValue(rive::RootBoneBase::yPropertyKey, originY);
+    riv.floatValue(rive::BoneBase::lengthPropertyKey, 15.0f);
+    for (int i = 1; i < kBonesPerRig; i++) {
+      bones[i] = riv.begin(rive::BoneBase::typeKey);
+      riv.uintValue(rive::ComponentBase::parentIdPropertyKey, bones[i - 1]);
+      riv.floatValue(rive::TransformComponentBase::rotationPropertyKey, 0.05f);
+      riv.floatValue(rive::BoneBase::lengthPropertyKey, 15.0f);
+    }
+
+    uint32_t shape = riv.begin(rive::ShapeBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, artboard);
+    uint32_t path = riv.begin(rive::PointsPathBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, shape);
+    riv.boolValue(rive::PointsPathBase::isClosedPropertyKey, true);
+
+    uint32_t skin = riv.begin(rive::SkinBase::typeKey);
+    riv.uintValue(rive::ComponentBase::parentIdPropertyKey, path);
+    for (int i = 0; i < kBonesPerRig; i++) {
+      riv.begin(rive::TendonBase::typeKey);
+      riv.uintValue(rive::ComponentBase::parentIdPropertyKey, skin);
+      riv.uintValue(rive::TendonBase::boneIdPropertyKey, bones[i]);
+      riv.floatValue(rive::TendonBase::txPropertyKey, -originX - i * 15.0f);
+      riv.floatValue(rive::TendonBase::tyPropertyKey, -originY);
+    }
+
+    // A tube around the chain: mostly detached cubic vertices, with every
+    // fourth one straight.
+    for (int v = 0; v < kVerticesPerRig; v++) {
+      float t = static_cast<float>(v) / kVerticesPerRig;
+      float angle = t * 6.2831853f;
+      float x = originX + 120.0f + 115.0f * std::cos(angle);
+      float y = originY + 40.0f * std::sin(angle);
+      bool straight = v % 4 == 3;
+      uint32_t vertex = riv.begin(straight
+                                      ? rive::StraightVertexBase::typeKey
+                                      : rive::CubicDetachedVertexBase::typeKey);
+      riv.uintValue(rive::ComponentBase::parentIdPropertyKey, path);
+      riv.floatValue(rive::VertexBase::xPropertyKey, x);
+      riv.floatValue(rive::VertexBase::yPropertyKey, y);
+      if (!straight) {
+        riv.floatValue(rive::CubicDetachedVertexBase::inRotationPropertyKey,
+                       angle + 3.14159f);
+        riv.floatValue(rive::CubicDetachedVertexBase::inDistancePropertyKey,
+                       0.2f);
+        riv.floatValue(rive::CubicDetachedVertexBase::outRotationPropertyKey,
+                       angle);
+        riv.floatValue(rive::CubicDetachedVertexBase::outDistancePropertyKey,
+                       0.2f);
+      }
+
+      // Points are weighted by their position along the chain.
+      int p = std::abs(kVerticesPerRig / 2 - v) * 2;
+      uint32_t indices = 0, weights = 0;
+      weightsFor(p, kVerticesPerRig, v % 8 == 0, indices, weights);
+      riv.begin(straight ? rive::WeightBase::typeKey
+                         : rive::CubicWeightBase::typeKey);
+      riv.uintValue(rive::ComponentBase::parentIdPropertyKey, vertex);
+      riv.uintValue(rive::WeightBase::valuesPropertyKey, weights);
+      riv.uintValue(rive::WeightBase::indicesPropertyKey, indices);
+      if (!straight) {
+        riv.uintValue(rive::CubicWeightBase::inValuesPropertyKey, weights);
+        riv.uintValue(rive::CubicWeightBase::inIndicesPropertyKey, indices);
+        riv.uintValue(rive::CubicWeightBase::outValuesPropertyKey, weights);
+        riv.uintValue(rive::CubicWeightBase::outIndicesPropertyKey, indices);
+      }
+    }
+  }
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+struct SkinnedPath {
+  rive::Skin *skin;
+  rive::Span<rive::Vertex *> vertices;
+  std::vector<float> restX;
+};
+
+struct DeformMode {
+  const char *name;
+  bool perVertex;
+  bool parallel;
+  bool movesVertices;
+};
+
+const DeformMode deformModes[] = {
+    {"per_vertex", true, false, false},
+    {"flattened", false, false, false},
+    {"flattened_parallel", false, true, false},
+    {"flattened_moving_vertices", false, false, true},
+};
+
+// Frame the modes are compared at, with the vertices moved off their rest
+// positions so the flattened points are refreshed in place.
+constexpr int kCheckFrame = 7;
+
+WorkStealingPool *gPool = nullptr;
+
+void poolParallelFor(uint32_t count, uint32_t grain, void *context,
+                     void (*range)(void *, uint32_t, uint32_t)) {
+  gPool->parallelFor(count, grain, [&](size_t begin, size_t end) {
+    range(context, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+  });
+}
+
+// Poses the rigs for frame, deforms every skin and returns a checksum of
+// the deformed points. With moveVertices, every vertex is also moved along
+// x, as a mesh or path animation would.
+uint64_t poseAndDeform(rive::ArtboardInstance &artboard,
+                       const std::vector<rive::RootBone *> &roots,
+                       const std::vector<SkinnedPath> &paths, int frame,
+                       bool moveVertices, std::vector<double> *samples) {
+  for (size_t i = 0; i < roots.size(); i++) {
+    roots[i]->rotation(0.3f * std::sin(frame * 0.1f + i));
+  }
+  if (moveVertices) {
+    float offset = 4.0f * std::sin(frame * 0.2f);
+    for (const auto &path : paths) {
+      for (size_t i = 0; i < path.vertices.size(); i++) {
+        path.vertices[i]->x(path.restX[i] + offset);
+      }
+    }
+  }
+  artboard.advance(0.0f);
+
+  Stopwatch stopwatch;
+  for (const auto &path : paths) {
+    path.skin->deform(path.vertices);
+  }
+  double micros = stopwatch.elapsedMicros();
+  if (samples != nullptr) {
+    samples->push_back(micros);
+  }
+
+  uint64_t hash = 0xcbf29ce484222325ull;
+  auto mix = [&hash](rive::Vec2D point) {
+    uint32_t bits[2];
+    std::memcpy(bits, &point, sizeof(bits));
+    for (uint32_t word : bits) {
+      hash ^= word;
+      hash *= 0x100000001b3ull;
+    }
+  };
+  for (const auto &path : paths) {
+    for (auto vertex : path.vertices) {
+      if (vertex->is<rive::CubicVertex>()) {
+        auto weight = vertex->weight<rive::CubicWeight>();
+        mix(weight->translation());
+        mix(weight->inTranslation());
+        mix(weight->outTranslation());
+      } else {
+        mix(vertex->weight<rive::Weight>()->translation());
+      }
+    }
+  }
+  return hash;
+}
+
+} // namespace
+
+bool runSkinBench(const BenchOptions &options, JsonWriter &json) {
+  auto bytes = buildRigFile();
+  rive::NoOpFactory factory;
+  auto file = rive::File::import(
+      rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+  if (!file) {
+    std::cerr << "rive_bench: failed to import the synthetic rigs\n";
+    return false;
+  }
+  auto artboard = file->artboardDefault();
+
+  std::vector<rive::RootBone *> roots;
+  std::vector<SkinnedPath> paths;
+  size_t points = 0;
+  for (auto object : artboard->objects()) {
+    if (object != nullptr && object->is<rive::RootBone>()) {
+      roots.push_back(object->as<rive::RootBone>());
+    }
+    if (object != nullptr && object->is<rive::Skin>()) {
+      auto skin = object->as<rive::Skin>();
+      auto &vertices = skin->parent()->as<rive::PointsPath>()->vertices();
+      SkinnedPath path{skin,
+                       rive::Span<rive::Vertex *>(
+                           reinterpret_cast<rive::Vertex **>(vertices.data()),
+                           vertices.size()),
+                       {}};
+      for (auto vertex : vertices) {
+        path.restX.push_back(vertex->x());
+        points += vertex->is<rive::CubicVertex>() ? 3 : 1;
+      }
+      paths.push_back(std::move(path));
+    }
+  }
+
+  int threads = options.threads > 0
+                    ? options.threads
+                    : static_cast<int>(std::thread::hardware_concurrency());
+  WorkStealingPool pool(static_cast<size_t>(std::max(threads, 1)));
+  gPool = &pool;
+
+  json.value("rigs", static_cast<int64_t>(paths.size()));
+  json.value("bones_per_rig", static_cast<int64_t>(kBonesPerRig));
+  json.value("weighted_points", static_cast<int64_t>(points));
+  json.value("threads", static_cast<int64_t>(pool.threadCount()));
+  json.beginArray("modes");
+  uint64_t referenceHash = 0;
+  double perVertexP50 = 0.0;
+  bool resultsMatch = true;
+  for (const auto &mode : deformModes) {
+    for (const auto &path : paths) {
+      path.skin->forcePerVertexDeform(mode.perVertex);
+    }
+    rive::Skin::gParallelForProc = mode.parallel ? poolParallelFor : nullptr;
+
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      poseAndDeform(*artboard, roots, paths, i, mode.movesVertices,
+                    i >= options.warmup ? &samples : nullptr);
+    }
+    // Every mode deforms the same moved pose for the comparison.
+    uint64_t hash =
+        poseAndDeform(*artboard, roots, paths, kCheckFrame, true, nullptr);
+    if (&mode == &deformModes[0]) {
+      referenceHash = hash;
+    }
+    resultsMatch = resultsMatch && hash == referenceHash;
+
+    Stats stats = summarize(samples);
+    if (mode.perVertex) {
+      perVertexP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("deform", stats);
+    json.value("points_per_second",
+               stats.p50 > 0.0 ? points * 1e6 / stats.p50 : 0.0);
+    json.value("speedup", stats.p50 > 0.0 ? perVertexP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  json.resultsMatch(resultsMatch);
+
+  rive::Skin::gParallelForProc = nullptr;
+  gPool = nullptr;
+  return true;
+}
+
+} // namespace bench
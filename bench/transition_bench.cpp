@@ -0,0 +1,209 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include <rive/animation/entry_state.hpp>
+#include <rive/animation/state_machine.hpp>
+#include <rive/animation/state_machine_input_instance.hpp>
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/animation/state_machine_layer.hpp>
+#include <rive/animation/state_transition.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/generated/animation/animation_state_base.hpp>
+#include <rive/generated/animation/any_state_base.hpp>
+#include <rive/generated/animation/entry_state_base.hpp>
+#include <rive/generated/animation/exit_state_base.hpp>
+#include <rive/generated/animation/state_machine_base.hpp>
+#include <rive/generated/animation/state_machine_layer_base.hpp>
+#include <rive/generated/animation/state_machine_number_base.hpp>
+#include <rive/generated/animation/state_transition_base.hpp>
+#include <rive/generated/animation/transition_input_condition_base.hpp>
+#include <rive/generated/animation/transition_number_condition_base.hpp>
+#include <rive/generated/animation/transition_value_condition_base.hpp>
+#include <rive/generated/artboard_base.hpp>
+#include <rive/generated/backboard_base.hpp>
+#include <rive/generated/layout_component_base.hpp>
+#include <utils/no_op_factory.hpp>
+
+namespace bench {
+
+namespace {
+
+// A machine of kLayers independent layers, each driven by its own number
+// input and holding kStates animation states with a transition between
+// every pair of them. A transition to state j fires when the layer's input
+// equals j. Each frame changes one layer's input, so one layer changes
+// state while the others sit idle.
+constexpr int kLayers = 500;
+constexpr int kStates = 8;
+// Entry, any and exit come before the animation states in every layer.
+constexpr int kFirstAnimationState = 3;
+
+std::vector<uint8_t> buildMachineFile() {
+  RivWriter riv;
+  riv.beginUncounted(rive::BackboardBase::typeKey);
+  riv.begin(rive::ArtboardBase::typeKey);
+  riv.floatValue(rive::LayoutComponentBase::widthPropertyKey, 100.0f);
+  riv.floatValue(rive::LayoutComponentBase::heightPropertyKey, 100.0f);
+  riv.beginUncounted(rive::StateMachineBase::typeKey);
+  for (int i = 0; i < kLayers; i++) {
+    riv.beginUncounted(rive::StateMachineNumberBase::typeKey);
+  }
+  for (int layer = 0; layer < kLayers; layer++) {
+    riv.beginUncounted(rive::StateMachineLayerBase::typeKey);
+    // The entry state moves straight on to the first animation state.
+    riv.beginUncounted(rive::EntryStateBase::typeKey);
+    riv.beginUncounted(rive::StateTransitionBase::typeKey);
+    riv.uintValue(rive::StateTransitionBase::stateToIdPropertyKey,
+                  kFirstAnimationState);
+    riv.beginUncounted(rive::AnyStateBase::typeKey);
+    riv.beginUncounted(rive::ExitStateBase::typeKey);
+    for (int from = 0; from < kStates; from++) {
+      riv.beginUncounted(rive::AnimationStateBase::typeKey);
+      for (int to = 0; to < kStates; to++) {
+        if (to == from) {
+          continue;
+        }
+        riv.beginUncounted(rive::StateTransitionBase::typeKey);
+        riv.uintValue(rive::StateTransitionBase::stateToIdPropertyKey,
+                      kFirstAnimationState + to);
+        riv.beginUncounted(rive::TransitionNumberConditionBase::typeKey);
+        riv.uintValue(rive::TransitionInputConditionBase::inputIdPropertyKey,
+                      layer);
+        riv.uintValue(rive::TransitionValueConditionBase::opValuePropertyKey,
+                      0); // equal
+        riv.floatValue(rive::TransitionNumberConditionBase::valuePropertyKey,
+                       static_cast<float>(to));
+      }
+    }
+  }
+  riv.endObject();
+  return std::move(riv.bytes());
+}
+
+struct EvaluationMode {
+  const char *name;
+  bool scanAll;
+};
+
+const EvaluationMode evaluationModes[] = {
+    {"scan_all", true},
+    {"indexed", false},
+};
+
+// The animation states of every layer, found through the transitions out of
+// the entry state and the first animation state.
+std::vector<std::vector<const rive::LayerState *>>
+layerStates(const rive::StateMachine &definition) {
+  std::vector<std::vector<const rive::LayerState *>> layers;
+  for (size_t i = 0; i < definition.layerCount(); i++) {
+    const rive::LayerState *first =
+        definition.layer(i)->entryState()->transition(0)->stateTo();
+    std::vector<const rive::LayerState *> states = {first};
+    for (size_t j = 0; j < first->transitionCount(); j++) {
+      states.push_back(first->transition(j)->stateTo());
+    }
+    layers.push_back(std::move(states));
+  }
+  return layers;
+}
+
+struct FrameTotals {
+  std::vector<double> samples;
+  bool resultsMatch = true;
+};
+
+// Moves one layer on to its next state, then times the state machine's
+// advance and checks that exactly that layer changed state.
+void runFrame(rive::StateMachineInstance &machine,
+              const std::vector<std::vector<const rive::LayerState *>> &layers,
+              std::vector<int> &states, int frame, FrameTotals *totals) {
+  int layer = frame % kLayers;
+  states[layer] = (states[layer] + 1) % kStates;
+  auto input = static_cast<rive::SMINumber *>(machine.input(layer));
+  input->value(static_cast<float>(states[layer]));
+
+  Stopwatch stopwatch;
+  machine.advanceAndApply(1.0f / 60.0f);
+  double micros = stopwatch.elapsedMicros();
+  if (totals != nullptr) {
+    totals->samples.push_back(micros);
+    totals->resultsMatch =
+        totals->resultsMatch && machine.stateChangedCount() == 1 &&
+        machine.stateChangedByIndex(0) == layers[layer][states[layer]];
+  }
+}
+
+} // namespace
+
+bool runTransitionBench(const BenchOptions &options, JsonWriter &json) {
+  auto bytes = buildMachineFile();
+  rive::NoOpFactory factory;
+  auto file = rive::File::import(
+      rive::Span<const uint8_t>(bytes.data(), bytes.size()), &factory);
+  if (!file) {
+    std::cerr << "rive_bench: failed to import the synthetic state machine\n";
+    return false;
+  }
+  auto artboard = file->artboardDefault();
+  auto machine = artboard->stateMachineAt(0);
+  const rive::StateMachine *definition = file->artboard()->stateMachine(0);
+  if (machine == nullptr || definition == nullptr ||
+      machine->inputCount() != kLayers) {
+    std::cerr << "rive_bench: the synthetic state machine is incomplete\n";
+    return false;
+  }
+  auto layers = layerStates(*definition);
+  // Takes every layer from its entry state to its first animation state,
+  // and lets those states' empty animations complete.
+  machine->advanceAndApply(0.0f);
+  machine->advanceAndApply(1.0f / 60.0f);
+
+  json.value("layers", static_cast<int64_t>(kLayers));
+  json.value("transitions_per_state", static_cast<int64_t>(kStates - 1));
+  json.beginArray("modes");
+  double scanAllP50 = 0.0;
+  bool resultsMatch = true;
+  std::vector<int> states(kLayers, 0);
+  // Frames are numbered across modes so every layer keeps cycling.
+  int frame = 0;
+  for (const auto &mode : evaluationModes) {
+    machine->forceTransitionEvaluation(mode.scanAll);
+
+    FrameTotals totals;
+    totals.samples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      if (i == options.warmup) {
+        machine->resetTransitionCounters();
+      }
+      runFrame(*machine, layers, states, frame++,
+               i >= options.warmup ? &totals : nullptr);
+    }
+    resultsMatch = resultsMatch && totals.resultsMatch;
+
+    const auto &counters = machine->transitionCounters();
+    double frames = std::max(options.iterations, 1);
+    Stats stats = summarize(totals.samples);
+    if (mode.scanAll) {
+      scanAllP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("advance", stats);
+    json.value("conditions_evaluated_per_frame",
+               counters.conditionsEvaluated / frames);
+    json.value("layers_evaluated_per_frame", counters.layersEvaluated / frames);
+    json.value("layers_skipped_per_frame", counters.layersSkipped / frames);
+    json.value("speedup", stats.p50 > 0.0 ? scanAllP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  json.resultsMatch(resultsMatch);
+
+  machine->forceTransitionEvaluation(false);
+  return true;
+}
+
+} // namespace bench
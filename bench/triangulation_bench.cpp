@@ -0,0 +1,232 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/renderer/headless/render_context_headless_impl.hpp>
+#include <rive/renderer/render_context.hpp>
+#include <rive/renderer/rive_renderer.hpp>
+
+namespace bench {
+
+namespace {
+
+// The artboard fills a 4K target, so its larger fills cover more than the
+// 512x512 pixels that send a path down the interior triangulation path.
+constexpr uint32_t kTargetWidth = 3840;
+constexpr uint32_t kTargetHeight = 2160;
+// Frames rendered again with hashed buffers to compare the modes.
+constexpr int kVerifyFrames = 10;
+
+struct CacheMode {
+  const char *name;
+  bool cached;
+};
+
+const CacheMode cacheModes[] = {
+    {"uncached", false},
+    {"cached", true},
+};
+
+// Animated frames mutate whichever paths the animation moves. Static frames
+// keep drawing the first frame, like a paused scene or a still background.
+struct Scenario {
+  const char *name;
+  bool advance;
+};
+
+const Scenario scenarios[] = {
+    {"animated", true},
+    {"static", false},
+};
+
+// A context, with its own instance of the file's default artboard and state
+// machine, so every mode starts from the same state.
+struct Scene {
+  std::unique_ptr<rive::gpu::RenderContext> context;
+  rive::gpu::RenderContextHeadlessImpl *impl = nullptr;
+  std::unique_ptr<rive::File> file;
+  std::unique_ptr<rive::ArtboardInstance> artboard;
+  std::unique_ptr<rive::StateMachineInstance> machine;
+};
+
+bool makeScene(rive::Span<const uint8_t> data, const CacheMode &mode,
+               bool hashMappedBuffers, Scene *scene) {
+  rive::gpu::RenderContextHeadlessImpl::ContextOptions contextOptions;
+  contextOptions.hashMappedBuffers = hashMappedBuffers;
+  scene->context =
+      rive::gpu::RenderContextHeadlessImpl::MakeContext(contextOptions);
+  scene->impl =
+      scene->context->static_impl_cast<rive::gpu::RenderContextHeadlessImpl>();
+  if (!mode.cached) {
+    scene->context->setTriangulationCacheCapacity(0);
+  }
+  scene->file = rive::File::import(data, scene->context.get());
+  if (!scene->file) {
+    return false;
+  }
+  scene->artboard = scene->file->artboardDefault();
+  if (!scene->artboard) {
+    return false;
+  }
+  if (scene->artboard->stateMachineCount() > 0) {
+    scene->machine = scene->artboard->defaultStateMachine();
+    if (!scene->machine) {
+      scene->machine = scene->artboard->stateMachineAt(0);
+    }
+  }
+  return true;
+}
+
+// Advances the scene, then returns the time spent drawing the artboard, which
+// is where large fills get triangulated, and flushing.
+double renderFrame(float seconds, Scene &scene,
+                   rive::gpu::RenderTarget &target, uint64_t frameNumber) {
+  if (scene.machine) {
+    scene.machine->advanceAndApply(seconds);
+  } else {
+    scene.artboard->advance(seconds);
+  }
+
+  Stopwatch stopwatch;
+  rive::gpu::RenderContext::FrameDescriptor frameDescriptor;
+  frameDescriptor.renderTargetWidth = kTargetWidth;
+  frameDescriptor.renderTargetHeight = kTargetHeight;
+  frameDescriptor.loadAction = rive::gpu::LoadAction::clear;
+  frameDescriptor.clearColor = 0xFF404040;
+  scene.context->beginFrame(frameDescriptor);
+
+  rive::ArtboardInstance &artboard = *scene.artboard;
+  float scale = std::min(kTargetWidth / artboard.width(),
+                         kTargetHeight / artboard.height());
+  rive::RiveRenderer renderer(scene.context.get());
+  renderer.save();
+  renderer.transform(rive::Mat2D::fromTranslate(
+                         (kTargetWidth - artboard.width() * scale) * 0.5f,
+                         (kTargetHeight - artboard.height() * scale) * 0.5f) *
+                     rive::Mat2D::fromScale(scale, scale));
+  artboard.draw(&renderer);
+  renderer.restore();
+
+  rive::gpu::RenderContext::FlushResources flushResources;
+  flushResources.renderTarget = &target;
+  flushResources.currentFrameNumber = frameNumber;
+  flushResources.safeFrameNumber = frameNumber;
+  scene.context->flush(flushResources);
+  return stopwatch.elapsedMicros();
+}
+
+bool benchScenario(const BenchOptions &options, const Scenario &scenario,
+                   rive::Span<const uint8_t> data, JsonWriter &json) {
+  rive::gpu::RenderTargetHeadless target(kTargetWidth, kTargetHeight);
+  json.beginObject();
+  json.value("scenario", std::string(scenario.name));
+  json.beginArray("modes");
+  double uncachedP50 = 0.0;
+  uint64_t referenceHash = 0;
+  bool resultsMatch = true;
+  bool ok = true;
+  for (const auto &mode : cacheModes) {
+    Scene scene;
+    Scene verifyScene;
+    if (!makeScene(data, mode, false, &scene) ||
+        !makeScene(data, mode, true, &verifyScene)) {
+      ok = false;
+      break;
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      if (i == options.warmup) {
+        scene.context->resetTriangulationCacheCounters();
+      }
+      // Static scenes still apply their first frame.
+      float seconds = scenario.advance || i == 0 ? options.frameSeconds : 0.0f;
+      double micros = renderFrame(seconds, scene, target, i + 1);
+      if (i >= options.warmup) {
+        samples.push_back(micros);
+      }
+    }
+
+    // Hashing would skew the timings, so the check renders its own frames.
+    for (int i = 0; i < kVerifyFrames; i++) {
+      float seconds = scenario.advance || i == 0 ? options.frameSeconds : 0.0f;
+      renderFrame(seconds, verifyScene, target, i + 1);
+    }
+    uint64_t hash = verifyScene.impl->counters().mappedBytesHash;
+    if (&mode == &cacheModes[0]) {
+      referenceHash = hash;
+    }
+    resultsMatch = resultsMatch && hash == referenceHash;
+
+    const auto &counters = scene.context->triangulationCacheCounters();
+    double frames = std::max(options.iterations, 1);
+    Stats stats = summarize(samples);
+    if (!mode.cached) {
+      uncachedP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("frame", stats);
+    json.value("cache_hits_per_frame", counters.hits / frames);
+    json.value("cache_misses_per_frame", counters.misses / frames);
+    json.value("speedup", stats.p50 > 0.0 ? uncachedP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  json.resultsMatch(resultsMatch);
+  json.endObject();
+  return ok;
+}
+
+bool benchFile(const BenchOptions &options, const std::filesystem::path &path,
+               JsonWriter &json) {
+  auto bytes = loadFileContents(path);
+  if (bytes.empty()) {
+    std::cerr << "rive_bench: failed to read " << path << "\n";
+    return false;
+  }
+  rive::Span<const uint8_t> data(bytes.data(), bytes.size());
+
+  json.beginObject();
+  json.value("file", path.filename().string());
+  json.beginArray("scenarios");
+  bool ok = true;
+  for (const auto &scenario : scenarios) {
+    if (!benchScenario(options, scenario, data, json)) {
+      std::cerr << "rive_bench: failed to import " << path << "\n";
+      ok = false;
+      break;
+    }
+  }
+  json.endArray();
+  json.endObject();
+  return ok;
+}
+
+} // namespace
+
+bool runTriangulationBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  json.value("target_width", static_cast<int64_t>(kTargetWidth));
+  json.value("target_height", static_cast<int64_t>(kTargetHeight));
+  json.beginArray("files");
+  for (const auto &path : files) {
+    benchFile(options, path, json);
+  }
+  json.endArray();
+  return true;
+}
+
+} // namespace bench
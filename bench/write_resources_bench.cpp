@@ -0,0 +1,231 @@
+#include "bench_suites.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <rive/animation/state_machine_instance.hpp>
+#include <rive/artboard.hpp>
+#include <rive/file.hpp>
+#include <rive/renderer/headless/render_context_headless_impl.hpp>
+#include <rive/renderer/render_context.hpp>
+#include <rive/renderer/rive_renderer.hpp>
+
+#include "work_stealing_pool.hpp"
+
+namespace bench {
+
+namespace {
+
+// A 4K target tiled with copies of the artboard, so each flush has enough
+// paths for the write phase to dominate.
+constexpr uint32_t kTargetWidth = 3840;
+constexpr uint32_t kTargetHeight = 2160;
+constexpr int kGridColumns = 8;
+constexpr int kGridRows = 8;
+// Frames rendered again with hashed buffers to compare the modes.
+constexpr int kVerifyFrames = 10;
+
+struct WriteMode {
+  const char *name;
+  bool parallel;
+};
+
+const WriteMode writeModes[] = {
+    {"serial", false},
+    {"parallel", true},
+};
+
+WorkStealingPool *gPool = nullptr;
+
+void poolParallelFor(uint32_t count, uint32_t grain, void *context,
+                     void (*range)(void *, uint32_t, uint32_t)) {
+  gPool->parallelFor(count, grain, [&](size_t begin, size_t end) {
+    range(context, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+  });
+}
+
+// A context, with its own instance of the file's default artboard and state
+// machine, so every mode starts from the same state.
+struct Scene {
+  std::unique_ptr<rive::gpu::RenderContext> context;
+  rive::gpu::RenderContextHeadlessImpl *impl = nullptr;
+  std::unique_ptr<rive::File> file;
+  std::unique_ptr<rive::ArtboardInstance> artboard;
+  std::unique_ptr<rive::StateMachineInstance> machine;
+};
+
+bool makeScene(rive::Span<const uint8_t> data, bool hashMappedBuffers,
+               Scene *scene) {
+  rive::gpu::RenderContextHeadlessImpl::ContextOptions contextOptions;
+  contextOptions.hashMappedBuffers = hashMappedBuffers;
+  scene->context =
+      rive::gpu::RenderContextHeadlessImpl::MakeContext(contextOptions);
+  scene->impl =
+      scene->context->static_impl_cast<rive::gpu::RenderContextHeadlessImpl>();
+  scene->context->setParallelForProc(poolParallelFor);
+  scene->file = rive::File::import(data, scene->context.get());
+  if (!scene->file) {
+    return false;
+  }
+  scene->artboard = scene->file->artboardDefault();
+  if (!scene->artboard) {
+    return false;
+  }
+  if (scene->artboard->stateMachineCount() > 0) {
+    scene->machine = scene->artboard->defaultStateMachine();
+    if (!scene->machine) {
+      scene->machine = scene->artboard->stateMachineAt(0);
+    }
+  }
+  return true;
+}
+
+// Advances the scene, draws the grid and returns the time spent in
+// RenderContext::flush, which lays out and writes the resources.
+double renderFrame(const BenchOptions &options, Scene &scene,
+                   rive::gpu::RenderTarget &target, bool parallel,
+                   uint64_t frameNumber) {
+  if (scene.machine) {
+    scene.machine->advanceAndApply(options.frameSeconds);
+  } else {
+    scene.artboard->advance(options.frameSeconds);
+  }
+
+  rive::gpu::RenderContext::FrameDescriptor frameDescriptor;
+  frameDescriptor.renderTargetWidth = kTargetWidth;
+  frameDescriptor.renderTargetHeight = kTargetHeight;
+  frameDescriptor.loadAction = rive::gpu::LoadAction::clear;
+  frameDescriptor.clearColor = 0xFF404040;
+  frameDescriptor.parallelWriteResources = parallel;
+  scene.context->beginFrame(frameDescriptor);
+
+  rive::ArtboardInstance &artboard = *scene.artboard;
+  float cellWidth = static_cast<float>(kTargetWidth) / kGridColumns;
+  float cellHeight = static_cast<float>(kTargetHeight) / kGridRows;
+  float scale = std::min(cellWidth / artboard.width(),
+                         cellHeight / artboard.height());
+  rive::RiveRenderer renderer(scene.context.get());
+  for (int row = 0; row < kGridRows; row++) {
+    for (int column = 0; column < kGridColumns; column++) {
+      renderer.save();
+      renderer.transform(
+          rive::Mat2D::fromTranslate(column * cellWidth, row * cellHeight) *
+          rive::Mat2D::fromScale(scale, scale));
+      artboard.draw(&renderer);
+      renderer.restore();
+    }
+  }
+
+  Stopwatch stopwatch;
+  rive::gpu::RenderContext::FlushResources flushResources;
+  flushResources.renderTarget = &target;
+  flushResources.currentFrameNumber = frameNumber;
+  flushResources.safeFrameNumber = frameNumber;
+  scene.context->flush(flushResources);
+  return stopwatch.elapsedMicros();
+}
+
+bool benchFile(const BenchOptions &options, const std::filesystem::path &path,
+               JsonWriter &json) {
+  auto bytes = loadFileContents(path);
+  if (bytes.empty()) {
+    std::cerr << "rive_bench: failed to read " << path << "\n";
+    return false;
+  }
+  rive::Span<const uint8_t> data(bytes.data(), bytes.size());
+  rive::gpu::RenderTargetHeadless target(kTargetWidth, kTargetHeight);
+
+  json.beginObject();
+  json.value("file", path.filename().string());
+  json.beginArray("modes");
+  double serialP50 = 0.0;
+  uint64_t referenceHash = 0;
+  bool resultsMatch = true;
+  bool ok = true;
+  for (const auto &mode : writeModes) {
+    Scene scene;
+    Scene verifyScene;
+    if (!makeScene(data, false, &scene) ||
+        !makeScene(data, true, &verifyScene)) {
+      std::cerr << "rive_bench: failed to import " << path << "\n";
+      ok = false;
+      break;
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.iterations);
+    for (int i = 0; i < options.warmup + options.iterations; i++) {
+      if (i == options.warmup) {
+        scene.impl->resetCounters();
+      }
+      double micros = renderFrame(options, scene, target, mode.parallel, i + 1);
+      if (i >= options.warmup) {
+        samples.push_back(micros);
+      }
+    }
+
+    // Hashing would skew the timings, so the check renders its own frames.
+    for (int i = 0; i < kVerifyFrames; i++) {
+      renderFrame(options, verifyScene, target, mode.parallel, i + 1);
+    }
+    uint64_t hash = verifyScene.impl->counters().mappedBytesHash;
+    if (&mode == &writeModes[0]) {
+      referenceHash = hash;
+    }
+    resultsMatch = resultsMatch && hash == referenceHash;
+
+    const auto &counters = scene.impl->counters();
+    double frames =
+        std::max<double>(static_cast<double>(counters.frames), 1.0);
+    Stats stats = summarize(samples);
+    if (!mode.parallel) {
+      serialP50 = stats.p50;
+    }
+    json.beginObject();
+    json.value("mode", std::string(mode.name));
+    json.stats("flush", stats);
+    json.value("draw_batches_per_frame", counters.drawBatches / frames);
+    json.value("bytes_mapped_per_frame", counters.bytesMapped / frames);
+    json.value("speedup", stats.p50 > 0.0 ? serialP50 / stats.p50 : 0.0);
+    json.endObject();
+  }
+  json.endArray();
+  json.resultsMatch(resultsMatch);
+  json.endObject();
+  return ok;
+}
+
+} // namespace
+
+bool runWriteResourcesBench(const BenchOptions &options, JsonWriter &json) {
+  auto files = findRiveFiles(options.assetsDir, options.filter);
+  if (files.empty()) {
+    std::cerr << "rive_bench: no .riv files under " << options.assetsDir
+              << "\n";
+    return false;
+  }
+
+  int threads = options.threads > 0
+                    ? options.threads
+                    : static_cast<int>(std::thread::hardware_concurrency());
+  WorkStealingPool pool(static_cast<size_t>(std::max(threads, 1)));
+  gPool = &pool;
+
+  json.value("target_width", static_cast<int64_t>(kTargetWidth));
+  json.value("target_height", static_cast<int64_t>(kTargetHeight));
+  json.value("copies_per_frame",
+             static_cast<int64_t>(kGridColumns * kGridRows));
+  json.value("threads", static_cast<int64_t>(pool.threadCount()));
+  json.beginArray("files");
+  for (const auto &path : files) {
+    benchFile(options, path, json);
+  }
+  json.endArray();
+
+  gPool = nullptr;
+  return true;
+}
+
+} // namespace bench
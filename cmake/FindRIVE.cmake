@@ -157,6 +157,11 @@ if(NOT TARGET RIVE::rive)
         _RIVE_INTERNAL_=1
     )
 
+    # Profiler zones, public so the renderer and apps record them too
+    if(RIVE_PROFILER)
+        target_compile_definitions(RIVE_rive PUBLIC RIVE_PROFILER=1)
+    endif()
+
     # Platform-specific settings
     if(RIVE_PLATFORM_APPLE)
         target_link_libraries(RIVE_rive PUBLIC "-framework CoreText")
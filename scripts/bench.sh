@@ -0,0 +1,23 @@
+#!/bin/bash
+set -e
+
+# Benchmarks are only meaningful on optimized builds
+BUILD_TYPE=Release
+ARGS=()
+
+# Parse command line arguments; anything we don't know is passed to rive_bench
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    --debug)
+      BUILD_TYPE=Debug
+      shift
+      ;;
+    *)
+      ARGS+=("$1")
+      shift
+      ;;
+  esac
+done
+
+echo "Running headless Rive benchmark (${BUILD_TYPE})" >&2
+./build/$BUILD_TYPE/rive_bench "${ARGS[@]}"
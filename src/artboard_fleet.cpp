@@ -0,0 +1,30 @@
+#include "artboard_fleet.hpp"
+
+ArtboardFleet::ArtboardFleet(size_t threadCount) : m_pool(threadCount) {}
+
+bool ArtboardFleet::spawn(const rive::Artboard *source) {
+  Member member;
+  member.artboard = source->instance();
+  if (!member.artboard) {
+    return false;
+  }
+  member.scene = member.artboard->defaultScene();
+  m_members.push_back(std::move(member));
+  return true;
+}
+
+void ArtboardFleet::advance(float seconds) {
+  m_pool.parallelFor(m_members.size(), m_grain,
+                     [this, seconds](size_t begin, size_t end) {
+                       for (size_t i = begin; i < end; i++) {
+                         Member &member = m_members[i];
+                         if (member.scene) {
+                           member.animating =
+                               member.scene->advanceAndApply(seconds);
+                         } else {
+                           member.animating =
+                               member.artboard->advance(seconds);
+                         }
+                       }
+                     });
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <rive/artboard.hpp>
+#include <rive/scene.hpp>
+
+#include "work_stealing_pool.hpp"
+
+// Owns many independent copies of artboards (HUD widgets, list rows, crowd
+// characters, ...) together with the scene driving each one, and advances
+// them in parallel. Drawing stays serial: members() is always in spawn
+// order, so the caller's draw loop is deterministic regardless of which
+// thread advanced which member.
+class ArtboardFleet {
+public:
+  struct Member {
+    std::unique_ptr<rive::ArtboardInstance> artboard;
+    // StateMachineInstance or LinearAnimationInstance bound to artboard.
+    std::unique_ptr<rive::Scene> scene;
+    // Result of the last advance: false once the scene has settled.
+    bool animating = true;
+  };
+
+  // threadCount includes the calling thread, 0 uses every core.
+  explicit ArtboardFleet(size_t threadCount = 0);
+
+  // Instances source and binds its default scene (default state machine,
+  // else first state machine, else first animation). Returns false if the
+  // artboard could not be instanced.
+  bool spawn(const rive::Artboard *source);
+
+  // Advances every member by seconds, in parallel. Members are independent,
+  // so no ordering between them is implied.
+  void advance(float seconds);
+
+  const std::vector<Member> &members() const { return m_members; }
+  size_t size() const { return m_members.size(); }
+  size_t threadCount() const { return m_pool.threadCount(); }
+
+  // Members handed to one task at a time. Small enough to balance uneven
+  // artboards, large enough to amortize the queue locking.
+  void grain(size_t value) { m_grain = value > 0 ? value : 1; }
+
+  void clear() { m_members.clear(); }
+
+private:
+  WorkStealingPool m_pool;
+  std::vector<Member> m_members;
+  size_t m_grain = 8;
+};
@@ -3,21 +3,31 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <vector>
 
 // Graphics backend abstraction
 #include "graphics_backend.hpp"
 
+// Parallel advancing of many artboard instances (--fleet)
+#include "artboard_fleet.hpp"
+
+// Memory-mapped .riv loading (--load mmap/lazy)
+#include "mapped_file.hpp"
+
 // Rive includes
 #include <rive/animation/linear_animation_instance.hpp>
 #include <rive/artboard.hpp>
 #include <rive/file.hpp>
 #include <rive/math/aabb.hpp>
+#include <rive/profiler/profiler.hpp>
 #include <rive/renderer/render_context.hpp>
 #include <rive/renderer/rive_renderer.hpp>
 
@@ -28,9 +38,13 @@ namespace {
 SDL_Window *window = nullptr;
 bool isPaused = false;
 GraphicsBackend selectedBackend = GraphicsBackend::OpenGL;
+bool backendFromCommandLine = false;
 
 // Graphics backend and Rive related variables
 std::unique_ptr<GraphicsBackendInterface> graphicsBackend;
+// When the file is imported with borrowed asset bytes this mapping backs
+// riveFile and must be released after it.
+std::unique_ptr<MappedFile> riveFileMapping;
 std::unique_ptr<rive::File> riveFile;
 std::unique_ptr<rive::ArtboardInstance> artboardInstance;
 std::unique_ptr<rive::LinearAnimationInstance> animationInstance;
@@ -38,10 +52,37 @@ rive::gpu::RenderContext *renderContext;
 std::unique_ptr<rive::Renderer> renderer;
 rive::Factory *factory;
 
+// When fleetSize > 0 the app spawns that many copies of the default artboard
+// in a grid and advances them through an ArtboardFleet instead of driving
+// artboardInstance/animationInstance.
+int fleetSize = 0;
+std::unique_ptr<ArtboardFleet> fleet;
+
+// How the .riv is loaded:
+//   copy - read into memory and imported with rive::File::import.
+//   mmap - mapped and imported without copying its assets (default).
+//   lazy - mapped, and only the artboards actually used get imported.
+enum class LoadMode { copy, mmap, lazy };
+LoadMode loadMode = LoadMode::mmap;
+
+// With imageWorkers > 0 embedded images are decoded on that many threads
+// while the app starts, and handed to their assets at the top of each frame.
+int imageWorkers = 0;
+rive::rcp<rive::ImageDecodePool> imageDecodePool;
+
 int windowWidth = 640;
 int windowHeight = 480;
 float lastTime = 0.0f;
 
+// Used to log the time to first frame.
+Uint64 appStartTicks = 0;
+bool firstFramePresented = false;
+
+// Where P (or quitting, with --profile) writes the profiler's Chrome trace.
+// Only builds with RIVE_PROFILER record anything.
+std::string profilePath = "rive_profile.json";
+bool profileOnQuit = false;
+
 // Helper function to load file contents
 std::vector<uint8_t> loadFileContents(const std::filesystem::path &filepath) {
   std::ifstream file(filepath, std::ios::binary | std::ios::ate);
@@ -74,22 +115,46 @@ bool initializeRive() {
   // Load the Rive file
 #ifdef PLATFORM_WEB
   // For web builds, use the virtual filesystem path (mounted by --preload-file)
-  auto fileContents = loadFileContents("/assets/rive_files/alien.riv");
+  std::filesystem::path filePath = "/assets/rive_files/alien.riv";
 #else
   // For desktop builds, use relative path from executable
-  auto fileContents = loadFileContents(
+  std::filesystem::path filePath =
       std::filesystem::path(__FILE__).parent_path().parent_path() /
-      "assets/rive_files/alien.riv");
+      "assets/rive_files/alien.riv";
 #endif
-  if (fileContents.empty()) {
-    SDL_Log("Failed to load Rive file");
-    return false;
+
+#ifndef PLATFORM_WEB
+  // No pthreads in the web build, decode during the import.
+  if (imageWorkers > 0) {
+    imageDecodePool = rive::make_rcp<rive::ImageDecodePool>(imageWorkers);
   }
+#endif
 
   // Create Rive file instance with factory
-  auto file = rive::File::import(
-      rive::Span<const uint8_t>(fileContents.data(), fileContents.size()),
-      factory);
+  std::unique_ptr<rive::File> file;
+  if (loadMode != LoadMode::copy) {
+    riveFileMapping = MappedFile::open(filePath);
+    if (!riveFileMapping) {
+      SDL_Log("Failed to map Rive file: %s", filePath.generic_string().c_str());
+      return false;
+    }
+    // The mapping stays alive until after riveFile, so assets can reference
+    // their bytes in place.
+    file = loadMode == LoadMode::lazy
+               ? rive::File::importLazy(riveFileMapping->bytes(), factory,
+                                        nullptr, nullptr, imageDecodePool)
+               : rive::File::importBorrowed(riveFileMapping->bytes(), factory,
+                                            nullptr, nullptr, imageDecodePool);
+  } else {
+    auto fileContents = loadFileContents(filePath);
+    if (fileContents.empty()) {
+      SDL_Log("Failed to load Rive file");
+      return false;
+    }
+    file = rive::File::import(
+        rive::Span<const uint8_t>(fileContents.data(), fileContents.size()),
+        factory, nullptr, nullptr, imageDecodePool);
+  }
   if (!file) {
     SDL_Log("Failed to import Rive file");
     return false;
@@ -106,6 +171,20 @@ bool initializeRive() {
 
   artboardInstance = artboard->instance();
 
+  if (fleetSize > 0) {
+#ifdef PLATFORM_WEB
+    // No pthreads in the web build, advance on the main thread.
+    fleet = std::make_unique<ArtboardFleet>(1);
+#else
+    fleet = std::make_unique<ArtboardFleet>();
+#endif
+    for (int i = 0; i < fleetSize; i++) {
+      fleet->spawn(artboard.get());
+    }
+    SDL_Log("Spawned fleet of %d instances on %d threads", (int)fleet->size(),
+            (int)fleet->threadCount());
+  }
+
   // Get the first animation
   if (artboard->animationCount() > 0) {
     auto animation = artboard->animation(0);
@@ -141,6 +220,7 @@ void parseCommandLine(int argc, char *argv[]) {
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
       std::string backendName = argv[i + 1];
+      backendFromCommandLine = true;
       if (backendName == "opengl") {
         selectedBackend = GraphicsBackend::OpenGL;
         SDL_Log("Using OpenGL backend (command line)");
@@ -152,15 +232,102 @@ void parseCommandLine(int argc, char *argv[]) {
       }
 
       i++; // Skip the next argument as it's the backend name
+    } else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc) {
+      std::string modeName = argv[i + 1];
+      if (modeName == "copy") {
+        loadMode = LoadMode::copy;
+      } else if (modeName == "mmap") {
+        loadMode = LoadMode::mmap;
+      } else if (modeName == "lazy") {
+        loadMode = LoadMode::lazy;
+      } else {
+        SDL_Log("Unknown load mode: %s, using default", modeName.c_str());
+      }
+      SDL_Log("Load mode: %s (command line)", modeName.c_str());
+      i++;
+    } else if (strcmp(argv[i], "--fleet") == 0 && i + 1 < argc) {
+      fleetSize = std::max(0, atoi(argv[i + 1]));
+      SDL_Log("Fleet mode: %d instances (command line)", fleetSize);
+      i++;
+    } else if (strcmp(argv[i], "--image-workers") == 0 && i + 1 < argc) {
+      imageWorkers = std::max(0, atoi(argv[i + 1]));
+      SDL_Log("Image workers: %d (command line)", imageWorkers);
+      i++;
+    } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+      profilePath = argv[i + 1];
+      profileOnQuit = true;
+      SDL_Log("Profile: %s (command line)", profilePath.c_str());
+      i++;
     }
   }
 }
 
+// Draws every fleet member into a near-square grid filling the window.
+void drawFleet() {
+  const auto &members = fleet->members();
+  if (members.empty()) {
+    return;
+  }
+  int columns = (int)std::ceil(std::sqrt((float)members.size()));
+  int rows = ((int)members.size() + columns - 1) / columns;
+  float cellWidth = (float)windowWidth / columns;
+  float cellHeight = (float)windowHeight / rows;
+
+  for (size_t i = 0; i < members.size(); i++) {
+    rive::ArtboardInstance *instance = members[i].artboard.get();
+    float scale = std::min(cellWidth / instance->width(),
+                           cellHeight / instance->height()) *
+                  0.9f;
+    float cellX = (i % columns) * cellWidth;
+    float cellY = (i / columns) * cellHeight;
+    float offsetX = cellX + (cellWidth - instance->width() * scale) * 0.5f;
+    float offsetY = cellY + (cellHeight - instance->height() * scale) * 0.5f;
+
+    renderer->save();
+    renderer->transform(rive::Mat2D::fromTranslate(offsetX, offsetY) *
+                        rive::Mat2D::fromScale(scale, scale));
+    instance->draw(renderer.get());
+    renderer->restore();
+  }
+}
+
+// Logs the percentiles of every profiler zone over the most recent frames and
+// writes the zones as a chrome://tracing JSON file.
+void dumpProfile() {
+#ifdef RIVE_PROFILER
+  for (const auto &zone : rive::Profiler::zoneStats()) {
+    SDL_Log("%-40s n=%-6llu p50=%8.1fus p95=%8.1fus p99=%8.1fus max=%8.1fus",
+            zone.name, (unsigned long long)zone.count, zone.p50Micros,
+            zone.p95Micros, zone.p99Micros, zone.maxMicros);
+  }
+  std::ofstream file(profilePath);
+  if (!file.is_open()) {
+    SDL_Log("Failed to write profile: %s", profilePath.c_str());
+    return;
+  }
+  rive::Profiler::writeChromeTrace(file);
+  SDL_Log("Wrote profile to %s", profilePath.c_str());
+#else
+  SDL_Log("Profiling is disabled, reconfigure with -DRIVE_PROFILER=ON");
+#endif
+}
+
+// Ends the frame and logs how long the app took to present its first one.
+void finishFrame() {
+  graphicsBackend->endFrame();
+  if (!firstFramePresented) {
+    firstFramePresented = true;
+    SDL_Log("Time to first frame: %.2f ms",
+            (SDL_GetTicksNS() - appStartTicks) / 1.0e6);
+  }
+}
+
 } // namespace
 
 /* This function runs once at startup. */
 SDL_AppResult SDL_AppInit([[maybe_unused]] void **appstate, int argc,
                           char *argv[]) {
+  appStartTicks = SDL_GetTicksNS();
   SDL_SetAppMetadata("Rive SDL3 Multi-Backend Example", "1.0",
                      "cl.staytrue.rive");
 
@@ -168,7 +335,7 @@ SDL_AppResult SDL_AppInit([[maybe_unused]] void **appstate, int argc,
   parseCommandLine(argc, argv);
 
   // If no backend was specified, detect the best one
-  if (selectedBackend == GraphicsBackend::OpenGL && argc == 1) {
+  if (!backendFromCommandLine) {
     selectedBackend = detectBestBackend();
     SDL_Log("Auto-detected backend: %s",
             selectedBackend == GraphicsBackend::Metal ? "Metal" : "OpenGL");
@@ -260,6 +427,8 @@ SDL_AppResult SDL_AppEvent([[maybe_unused]] void *appstate, SDL_Event *event) {
     if (event->key.key == SDLK_SPACE) {
       isPaused = !isPaused;
       SDL_Log("Animation %s", isPaused ? "paused" : "resumed");
+    } else if (event->key.key == SDLK_P) {
+      dumpProfile();
     }
   }
 
@@ -271,14 +440,21 @@ SDL_AppResult SDL_AppIterate([[maybe_unused]] void *appstate) {
   if (!artboardInstance || !renderer || !renderContext) {
     return SDL_APP_CONTINUE;
   }
+  RIVE_PROF_SCOPENAME("Frame");
 
   // Calculate delta time
   float currentTime = ((float)SDL_GetTicks()) / 1000.0f;
   float deltaTime = currentTime - lastTime;
   lastTime = currentTime;
 
+  // Hand images decoded since the last frame to their assets.
+  if (imageDecodePool)
+    imageDecodePool->resolve();
+
   // Update animation
-  if (!isPaused && animationInstance)
+  if (!isPaused && fleet)
+    fleet->advance(deltaTime);
+  else if (!isPaused && animationInstance)
     animationInstance->advanceAndApply(deltaTime);
 
   // Begin frame (backend-specific preparation)
@@ -299,6 +475,12 @@ SDL_AppResult SDL_AppIterate([[maybe_unused]] void *appstate) {
   // Begin context drawing
   renderContext->beginFrame(frameDescriptor);
 
+  if (fleet) {
+    drawFleet();
+    finishFrame();
+    return SDL_APP_CONTINUE;
+  }
+
   // Calculate scale to fit the artboard in the window while maintaining aspect
   // ratio
   float artboardWidth = artboardInstance->width();
@@ -319,6 +501,11 @@ SDL_AppResult SDL_AppIterate([[maybe_unused]] void *appstate) {
   transform = rive::Mat2D::fromTranslate(offsetX, offsetY) *
               rive::Mat2D::fromScale(scale, scale);
 
+  // Cull to the part of the artboard the window shows. Nested artboards and
+  // list items inside it take their share of this region.
+  artboardInstance->viewport(transform.invertOrIdentity().mapBoundingBox(
+      rive::AABB(0.0f, 0.0f, (float)windowWidth, (float)windowHeight)));
+
   // Render the artboard
   renderer->save();
   renderer->transform(transform);
@@ -326,7 +513,7 @@ SDL_AppResult SDL_AppIterate([[maybe_unused]] void *appstate) {
   renderer->restore();
 
   // End frame (backend-specific cleanup and flushing)
-  graphicsBackend->endFrame();
+  finishFrame();
 
   return SDL_APP_CONTINUE;
 }
@@ -334,10 +521,17 @@ SDL_AppResult SDL_AppIterate([[maybe_unused]] void *appstate) {
 /* This function runs once at shutdown. */
 void SDL_AppQuit([[maybe_unused]] void *appstate,
                  [[maybe_unused]] SDL_AppResult result) {
+  if (profileOnQuit) {
+    dumpProfile();
+  }
+
   // Clean up Rive resources
+  fleet.reset();
   animationInstance.reset();
   artboardInstance.reset();
   riveFile.reset();
+  riveFileMapping.reset();
+  imageDecodePool = nullptr;
   renderer.reset();
   renderContext =
       nullptr; // Set render context to nullptr (owned by graphics backend)
@@ -0,0 +1,97 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+std::unique_ptr<MappedFile> MappedFile::open(const std::filesystem::path &path) {
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return nullptr;
+  }
+
+  std::unique_ptr<MappedFile> mapped(new MappedFile());
+  mapped->m_data = static_cast<const uint8_t *>(data);
+  mapped->m_size = static_cast<size_t>(size.QuadPart);
+  mapped->m_file = file;
+  mapped->m_mapping = mapping;
+  return mapped;
+}
+
+MappedFile::~MappedFile() {
+  if (m_data != nullptr) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping != nullptr) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file != nullptr) {
+    CloseHandle(m_file);
+  }
+}
+
+#else
+
+std::unique_ptr<MappedFile> MappedFile::open(const std::filesystem::path &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+  size_t size = static_cast<size_t>(info.st_size);
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+
+  std::unique_ptr<MappedFile> mapped(new MappedFile());
+  mapped->m_data = static_cast<const uint8_t *>(data);
+  mapped->m_size = size;
+  return mapped;
+}
+
+MappedFile::~MappedFile() {
+  if (m_data != nullptr) {
+    munmap(const_cast<uint8_t *>(m_data), m_size);
+  }
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include <rive/span.hpp>
+
+// A read-only memory mapping of a whole file. Pages are only faulted in when
+// touched and are shared with the OS page cache, so importing a .riv through
+// rive::File::importBorrowed never holds a private copy of the file or of
+// its embedded assets. The mapping must outlive the imported File.
+class MappedFile {
+public:
+  // Returns nullptr if the file can't be opened, is empty or can't be
+  // mapped.
+  static std::unique_ptr<MappedFile> open(const std::filesystem::path &path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  rive::Span<const uint8_t> bytes() const { return {m_data, m_size}; }
+  size_t size() const { return m_size; }
+
+private:
+  MappedFile() = default;
+
+  const uint8_t *m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void *m_file = nullptr;
+  void *m_mapping = nullptr;
+#endif
+};
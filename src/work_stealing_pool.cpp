@@ -0,0 +1,120 @@
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < threadCount; i++) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  // Queue 0 belongs to whichever thread calls parallelFor.
+  for (size_t i = 1; i < threadCount; i++) {
+    m_workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto &worker : m_workers) {
+    worker.join();
+  }
+}
+
+bool WorkStealingPool::popOrSteal(size_t self, Range &range) {
+  {
+    Queue &own = *m_queues[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.ranges.empty()) {
+      range = own.ranges.back();
+      own.ranges.pop_back();
+      return true;
+    }
+  }
+  for (size_t offset = 1; offset < m_queues.size(); offset++) {
+    Queue &victim = *m_queues[(self + offset) % m_queues.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.ranges.empty()) {
+      range = victim.ranges.front();
+      victim.ranges.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::runAvailable(size_t self) {
+  Range range;
+  while (popOrSteal(self, range)) {
+    (*m_fn)(range.begin, range.end);
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_done.notify_all();
+    }
+  }
+}
+
+void WorkStealingPool::workerLoop(size_t self) {
+  uint64_t seenGeneration = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock,
+                  [&] { return m_stop || m_generation != seenGeneration; });
+      if (m_stop) {
+        return;
+      }
+      seenGeneration = m_generation;
+    }
+    runAvailable(self);
+  }
+}
+
+void WorkStealingPool::parallelFor(size_t count, size_t grain,
+                                   const RangeFn &fn) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max<size_t>(grain, 1);
+  if (m_workers.empty() || count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  size_t rangeCount = (count + grain - 1) / grain;
+  m_fn = &fn;
+  m_pending.store(rangeCount, std::memory_order_release);
+
+  // Deal contiguous runs of ranges to each queue so a thread's own work is
+  // cache friendly and stealing only kicks in for the tail.
+  size_t perQueue = (rangeCount + m_queues.size() - 1) / m_queues.size();
+  for (size_t q = 0; q < m_queues.size(); q++) {
+    std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+    size_t first = q * perQueue;
+    size_t last = std::min(rangeCount, first + perQueue);
+    // Pushed in reverse so the owner pops them front to back.
+    for (size_t r = last; r-- > first;) {
+      m_queues[q]->ranges.push_back(
+          {r * grain, std::min(count, (r + 1) * grain)});
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generation++;
+  }
+  m_wake.notify_all();
+
+  runAvailable(0);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [&] {
+    return m_pending.load(std::memory_order_acquire) == 0;
+  });
+  m_fn = nullptr;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool for fork/join style parallel loops. Each thread
+// (including the one calling parallelFor) owns a deque of index ranges; it
+// drains its own deque from the back and steals from the front of the others
+// once it runs dry, so uneven per-item cost balances itself out.
+class WorkStealingPool {
+public:
+  using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+  // threadCount includes the calling thread. 0 picks
+  // std::thread::hardware_concurrency().
+  explicit WorkStealingPool(size_t threadCount = 0);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  size_t threadCount() const { return m_queues.size(); }
+
+  // Calls fn over [0, count) split into ranges of at most grain items and
+  // returns once every range has run. Ranges may run on any thread, in any
+  // order. Not reentrant: fn must not call parallelFor on the same pool.
+  void parallelFor(size_t count, size_t grain, const RangeFn &fn);
+
+private:
+  struct Range {
+    size_t begin;
+    size_t end;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Range> ranges;
+  };
+
+  bool popOrSteal(size_t self, Range &range);
+  void runAvailable(size_t self);
+  void workerLoop(size_t self);
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  uint64_t m_generation = 0;
+  bool m_stop = false;
+
+  const RangeFn *m_fn = nullptr;
+  std::atomic<size_t> m_pending{0};
+};
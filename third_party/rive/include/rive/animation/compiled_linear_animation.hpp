@@ -0,0 +1,82 @@
+#ifndef _RIVE_COMPILED_LINEAR_ANIMATION_HPP_
+#define _RIVE_COMPILED_LINEAR_ANIMATION_HPP_
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rive
+{
+class Artboard;
+class Core;
+class InterpolatorHost;
+class InterpolatingKeyFrame;
+class KeyFrameInterpolator;
+class LinearAnimation;
+
+/// A LinearAnimation flattened against a specific artboard instance. Keyed
+/// objects are resolved once and every keyed property becomes a track whose
+/// keyframe times and values live in contiguous arrays. Applying produces
+/// exactly the same property writes, in the same order, as
+/// LinearAnimation::apply.
+///
+/// The compiled form holds no playhead state; callers own one cursor per
+/// track (see trackCount()) so consecutive applies at nearby times find
+/// their keyframe pair in constant time instead of a binary search.
+class CompiledLinearAnimation
+{
+public:
+    CompiledLinearAnimation(const LinearAnimation* animation,
+                            Artboard* artboard);
+
+    const LinearAnimation* animation() const { return m_animation; }
+    size_t trackCount() const { return m_tracks.size(); }
+
+    /// Apply the animation at time with the given mix. cursors must point to
+    /// trackCount() entries, zero initialized before the first call.
+    void apply(float time, float mix, uint32_t* cursors) const;
+
+private:
+    enum class TrackType : uint8_t
+    {
+        number,
+        color,
+        // Bool, id, uint and string keyframes have no interpolation, they
+        // only need the keyframe located so we call them directly.
+        other,
+    };
+
+    struct Track
+    {
+        Core* object;
+        InterpolatorHost* interpolatorHost;
+        int propertyKey;
+        TrackType type;
+        // Set when two keyframes share a time, in which case we mirror
+        // KeyedProperty's binary search exactly to pick the same frame.
+        bool hasDuplicateTimes;
+        uint32_t firstFrame;
+        uint32_t frameCount;
+    };
+
+    uint32_t frameIndex(const Track& track, float seconds, uint32_t& cursor)
+        const;
+    void applyFrame(const Track& track, uint32_t frame, float mix) const;
+    void applyInterpolation(const Track& track,
+                            uint32_t frame,
+                            float seconds,
+                            float mix) const;
+
+    const LinearAnimation* m_animation;
+    std::vector<Track> m_tracks;
+
+    // Per keyframe, indexed by Track::firstFrame + i.
+    std::vector<float> m_seconds;
+    std::vector<float> m_numberValues;
+    std::vector<int> m_colorValues;
+    std::vector<uint8_t> m_holds;
+    std::vector<KeyFrameInterpolator*> m_interpolators;
+    std::vector<InterpolatingKeyFrame*> m_keyFrames;
+};
+} // namespace rive
+
+#endif
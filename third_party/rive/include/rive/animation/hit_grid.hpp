@@ -0,0 +1,66 @@
+#ifndef _RIVE_HIT_GRID_HPP_
+#define _RIVE_HIT_GRID_HPP_
+
+#include "rive/math/aabb.hpp"
+#include "rive/math/vec2d.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace rive
+{
+class HitComponent;
+class Shape;
+
+/// Uniform grid over the world bounds of a state machine's shape hit
+/// components, so pointer events only hit test the shapes whose bounds
+/// contain the pointer. Components without a bounding shape are always
+/// candidates.
+///
+/// Entries follow their shape's boundsVersion(). A shape whose bounds were
+/// invalidated stays a candidate until its bounds have been recomputed (by
+/// its own hit test or anything else) and refresh() moves it to its new
+/// cells, so the grid never computes bounds itself.
+class HitGrid
+{
+public:
+    static constexpr uint32_t notIndexed = 0xffffffff;
+    static constexpr int cellsPerSide = 16;
+
+    void add(HitComponent* component);
+
+    /// Marks the indexed components whose bounds contain position.
+    void query(Vec2D position);
+
+    /// Whether component may be hit at the last queried position.
+    bool isCandidate(HitComponent* component);
+
+    /// Re-bins stale entries whose bounds have been recomputed.
+    void refresh();
+
+private:
+    struct Entry
+    {
+        Shape* shape;
+        AABB bounds;
+        uint32_t version = 0;
+        uint32_t stamp = 0;
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;
+        bool binned = false;
+        bool queuedStale = true;
+    };
+
+    void bin(uint32_t index);
+    void unbin(uint32_t index);
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+    std::vector<Entry> m_entries;
+    std::vector<std::vector<uint32_t>> m_cells;
+    std::vector<uint32_t> m_stale;
+    AABB m_extent;
+    bool m_hasExtent = false;
+    uint32_t m_stamp = 0;
+};
+} // namespace rive
+
+#endif
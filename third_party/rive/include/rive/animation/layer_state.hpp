@@ -11,6 +11,22 @@ class StateTransition;
 class LayerStateImporter;
 class StateMachineLayerImporter;
 class StateInstance;
+class BindableProperty;
+
+/// What the conditions of a state's transitions read. A layer only has to look
+/// for a transition out of the state again once one of these changed.
+struct TransitionDependencies
+{
+    /// Sorted indices of the state machine inputs read by input conditions.
+    std::vector<uint32_t> inputIds;
+    /// Sorted properties read by view model conditions, as imported. Each
+    /// state machine instance compares its own copy of them.
+    std::vector<const BindableProperty*> properties;
+    /// Set when a condition reads something that doesn't report its changes,
+    /// like the artboard's size, so the transitions have to be evaluated on
+    /// every update.
+    bool alwaysEvaluate = true;
+};
 
 class LayerState : public LayerStateBase
 {
@@ -19,7 +35,9 @@ class LayerState : public LayerStateBase
 
 private:
     std::vector<StateTransition*> m_Transitions;
+    TransitionDependencies m_transitionDependencies;
     void addTransition(StateTransition* transition);
+    void buildTransitionDependencies();
 
 public:
     ~LayerState() override;
@@ -38,6 +56,12 @@ public:
         return nullptr;
     }
 
+    /// Built once the transitions and their conditions are added.
+    const TransitionDependencies& transitionDependencies() const
+    {
+        return m_transitionDependencies;
+    }
+
     /// Make an instance of this state that can be advanced and applied by
     /// the state machine when it is active or being transitioned from.
     virtual std::unique_ptr<StateInstance> makeInstance(
@@ -8,6 +8,7 @@
 
 namespace rive
 {
+class CompiledLinearAnimation;
 class LinearAnimation;
 class NestedEventNotifier;
 
@@ -59,11 +60,9 @@ public:
 
     // Applies the animation instance to its artboard instance. The mix (a value
     // between 0 and 1) is the strength at which the animation is mixed with
-    // other animations applied to the artboard.
-    void apply(float mix = 1.0f) const
-    {
-        m_animation->apply(m_artboardInstance, m_time, mix);
-    }
+    // other animations applied to the artboard. Uses the artboard instance's
+    // compiled form of the animation so keyframe lookup is incremental.
+    void apply(float mix = 1.0f) const;
 
     // Set when the animation is advanced, true if the animation has stopped
     // (oneShot), reached the end (loop), or changed direction (pingPong)
@@ -120,6 +119,11 @@ private:
     float m_direction;
     bool m_didLoop;
     int m_loopValue = -1;
+
+    // Resolved lazily on first apply; cursors hold each track's last
+    // keyframe position.
+    mutable const CompiledLinearAnimation* m_compiled = nullptr;
+    mutable std::vector<uint32_t> m_trackCursors;
 };
 } // namespace rive
 #endif
@@ -40,9 +40,9 @@ public:
 private:
     StateMachineInstance* m_machineInstance;
     const StateMachineInput* m_input;
-#ifdef WITH_RIVE_TOOLS
+    // Position in the state machine's inputs, which is what conditions refer
+    // to it by.
     uint64_t m_index = 0;
-#endif
 };
 
 class SMIBool : public SMIInput
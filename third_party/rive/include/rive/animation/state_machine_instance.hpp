@@ -5,10 +5,13 @@
 #include <stddef.h>
 #include <vector>
 #include <unordered_map>
+#include "rive/animation/hit_grid.hpp"
 #include "rive/animation/linear_animation_instance.hpp"
 #include "rive/animation/state_instance.hpp"
 #include "rive/animation/state_transition.hpp"
 #include "rive/core/field_types/core_callback_type.hpp"
+#include "rive/data_bind/bindable_property_observer.hpp"
+#include "rive/data_bind/data_bind_queue.hpp"
 #include "rive/hit_result.hpp"
 #include "rive/listener_type.hpp"
 #include "rive/nested_animation.hpp"
@@ -45,12 +48,14 @@ typedef void (*InputChanged)(StateMachineInstance*, uint64_t);
 
 class StateMachineInstance : public Scene,
                              public NestedEventNotifier,
-                             public NestedEventListener
+                             public NestedEventListener,
+                             public BindablePropertyObserver
 {
     friend class SMIInput;
     friend class KeyedProperty;
     friend class HitComponent;
     friend class StateMachineLayerInstance;
+    friend class StateTransition;
 
 private:
     /// Provide a hitListener if you want to process a down or an up for the
@@ -70,6 +75,9 @@ private:
         StateInstance* stateFromInstance,
         StateMachineLayerInstance* layerInstance);
 
+    // Marks the layers whose current transitions read the input dirty.
+    void inputChanged(size_t index);
+
     bool m_ownsDataContext = false;
     DataContext* m_DataContext = nullptr;
     void addToHitLookup(Component* target,
@@ -120,6 +128,34 @@ public:
 
     bool advanceAndApply(float secs) override;
     void advancedDataContext();
+
+    struct TransitionCounters
+    {
+        /// Times a layer looked for a transition out of its states.
+        uint64_t layersEvaluated = 0;
+        /// Times a layer didn't, as nothing its transitions read changed.
+        uint64_t layersSkipped = 0;
+        /// Transition conditions evaluated while looking.
+        uint64_t conditionsEvaluated = 0;
+    };
+    const TransitionCounters& transitionCounters() const
+    {
+        return m_transitionCounters;
+    }
+    void resetTransitionCounters()
+    {
+        m_transitionCounters = TransitionCounters();
+    }
+    // Evaluates every layer's transitions on each update, like before they
+    // were indexed by what their conditions read. For benchmarking.
+    void forceTransitionEvaluation(bool value)
+    {
+        m_forceTransitionEvaluation = value;
+    }
+
+    void bindablePropertyChanged(const BindableProperty* original) override;
+    const DataBindQueue& dataBindQueue() const { return m_dataBindQueue; }
+    DataBindQueue& dataBindQueue() { return m_dataBindQueue; }
     std::string name() const override;
     HitResult pointerMove(Vec2D position) override;
     HitResult pointerDown(Vec2D position) override;
@@ -192,10 +228,13 @@ private:
     size_t m_layerCount;
     StateMachineLayerInstance* m_layers;
     std::vector<std::unique_ptr<HitComponent>> m_hitComponents;
+    mutable HitGrid m_hitGrid;
     std::vector<std::unique_ptr<ListenerGroup>> m_listenerGroups;
     StateMachineInstance* m_parentStateMachineInstance = nullptr;
     NestedArtboard* m_parentNestedArtboard = nullptr;
     std::vector<DataBind*> m_dataBinds;
+    // Worklist of m_dataBinds.
+    DataBindQueue m_dataBindQueue;
     std::unordered_map<BindableProperty*, BindableProperty*>
         m_bindablePropertyInstances;
     std::unordered_map<BindableProperty*, DataBind*>
@@ -203,6 +242,8 @@ private:
     std::unordered_map<BindableProperty*, DataBind*>
         m_bindableDataBindsToSource;
     uint8_t m_drawOrderChangeCounter = 0;
+    TransitionCounters m_transitionCounters;
+    bool m_forceTransitionEvaluation = false;
     void internalDataContext(DataContext* dataContext);
     void clearDataContext();
 
@@ -229,8 +270,17 @@ public:
     virtual HitResult processEvent(Vec2D position,
                                    ListenerType hitType,
                                    bool canHit) = 0;
-    virtual void prepareEvent(Vec2D position, ListenerType hitType) = 0;
+    /// isCandidate is false when the HitGrid already knows position can't
+    /// hit this component.
+    virtual void prepareEvent(Vec2D position,
+                              ListenerType hitType,
+                              bool isCandidate) = 0;
     virtual bool hitTest(Vec2D position) const = 0;
+    /// Shape whose world bounds must contain a position for hitTest to pass,
+    /// or null if the component can't be bounded that way.
+    virtual Shape* boundingShape() const { return nullptr; }
+    /// Slot in the owning state machine's HitGrid.
+    uint32_t hitGridIndex = HitGrid::notIndexed;
 #ifdef TESTING
     int earlyOutCount = 0;
 #endif
@@ -35,6 +35,7 @@ public:
     void useInLayer(const StateMachineInstance* stateMachineInstance,
                     StateMachineLayerInstance* layerInstance) const override;
     DataType instanceDataType(const StateMachineInstance* stateMachineInstance);
+    BindableProperty* bindableProperty() const { return m_bindableProperty; }
 
 protected:
     BindableProperty* m_bindableProperty;
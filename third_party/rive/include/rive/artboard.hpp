@@ -5,9 +5,12 @@
 #include "rive/animation/linear_animation.hpp"
 #include "rive/animation/state_machine.hpp"
 #include "rive/core_context.hpp"
+#include "rive/core/core_arena.hpp"
 #include "rive/data_bind/data_bind.hpp"
 #include "rive/data_bind/data_context.hpp"
 #include "rive/data_bind/data_bind_context.hpp"
+#include "rive/data_bind/data_bind_queue.hpp"
+#include "rive/display_list.hpp"
 #include "rive/viewmodel/viewmodel_instance_value.hpp"
 #include "rive/viewmodel/viewmodel_instance_viewmodel.hpp"
 #include "rive/generated/artboard_base.hpp"
@@ -20,7 +23,9 @@
 #include "rive/math/raw_path.hpp"
 #include "rive/typed_children.hpp"
 
+#include <atomic>
 #include <queue>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -28,6 +33,7 @@ namespace rive
 {
 class ArtboardComponentList;
 class ArtboardHost;
+class CompiledLinearAnimation;
 class File;
 class Drawable;
 class Factory;
@@ -58,6 +64,39 @@ class Artboard : public ArtboardBase, public CoreContext
     friend class Component;
 
 private:
+    // Structure captured when a source artboard initializes, indexed by
+    // position in m_Objects, so instances can clone and initialize without
+    // searching or re-sorting anything whose shape is identical.
+    struct Topology
+    {
+        // Dependency order as indices, and the number of dependent edges the
+        // order was sorted with.
+        std::vector<uint32_t> dependencyOrder;
+        size_t dependencyEdges = 0;
+        // Drawable order as indices.
+        std::vector<uint32_t> drawables;
+        size_t drawableObjects = 0;
+        // Data binds to clone, in clone order, as (object index, index in
+        // m_DataBinds).
+        std::vector<std::pair<uint32_t, uint32_t>> dataBinds;
+        // Arena bytes the last instance needed, used to size the next one.
+        mutable std::atomic<size_t> arenaBytes{0};
+
+        // Indices may instead name a component embedded in the object at
+        // that index rather than the object itself.
+        static constexpr uint32_t indexMask = 0x3fffffffu;
+        static constexpr uint32_t layoutProxyFlag = 0x80000000u;
+        static constexpr uint32_t pathComposerFlag = 0x40000000u;
+    };
+
+    // Declared first so it is destroyed last, after every object cloned into
+    // it has been deleted.
+    std::unique_ptr<CoreArena> m_objectArena;
+    std::unique_ptr<Topology> m_ownedTopology;
+    // The source's topology for instances, m_ownedTopology for sources.
+    // Null when it couldn't be captured or an instance didn't match it.
+    const Topology* m_topology = nullptr;
+
     std::vector<Core*> m_Objects;
     std::vector<LinearAnimation*> m_Animations;
     std::vector<StateMachine*> m_StateMachines;
@@ -70,11 +109,24 @@ private:
     std::vector<Joystick*> m_Joysticks;
     std::vector<DataBind*> m_DataBinds;
     std::vector<DataBind*> m_AllDataBinds;
+    // Worklist of m_AllDataBinds. The binds writing to their source are
+    // sorted to the front and polled on every update.
+    DataBindQueue m_dataBindQueue;
     DataContext* m_DataContext = nullptr;
     bool m_ownsDataContext = false;
     bool m_JoysticksApplyBeforeUpdate = true;
 
-    unsigned int m_DirtDepth = 0;
+    // Positions in m_DependencyOrder of the components with dirt, lowest
+    // first, so an update pass only visits dirty components. A position is
+    // queued at most once.
+    std::priority_queue<unsigned int,
+                        std::vector<unsigned int>,
+                        std::greater<unsigned int>>
+        m_dirtyComponents;
+    std::vector<bool> m_queuedComponents;
+    // Components that dirtied themselves while updating, left for the next
+    // step of the current updateComponents.
+    std::vector<unsigned int> m_deferredComponents;
     Factory* m_Factory = nullptr;
     Drawable* m_FirstDrawable = nullptr;
     bool m_IsInstance = false;
@@ -90,6 +142,10 @@ private:
     void cloneObjectDataBinds(const Core* object,
                               Core* clone,
                               Artboard* artboard) const;
+    void cloneObjects(Artboard* artboard) const;
+    void captureTopology(size_t drawableObjects);
+    Core* topologyObject(uint32_t index) const;
+    bool applyTopologyDependencyOrder();
 
     // Variable that tracks whenever the draw order changes. It is used by the
     // state machine controllers to sort their hittable components when they are
@@ -101,6 +157,7 @@ private:
 #endif
 
     void sortDependencies();
+    void queueDirtyComponents();
     void sortDrawOrder();
     void updateDataBinds();
     void updateRenderPath() override;
@@ -148,6 +205,38 @@ public:
     /// Update components that depend on each other in DAG order.
     bool updateComponents();
 
+    struct UpdateCounters
+    {
+        /// Dirty components updateComponents took off its worklist.
+        uint64_t componentsVisited = 0;
+        /// Components whose update() ran.
+        uint64_t componentsUpdated = 0;
+    };
+
+    /// Totals since the artboard was created or resetUpdateCounters() was
+    /// last called. Reset once per frame to get per frame counts.
+    const UpdateCounters& updateCounters() const { return m_updateCounters; }
+    void resetUpdateCounters() { m_updateCounters = UpdateCounters(); }
+
+    struct LayoutCounters
+    {
+        /// Layout passes that called into Yoga.
+        uint64_t passes = 0;
+        /// Passes skipped because no style, intrinsic size or available
+        /// size changed.
+        uint64_t skippedPasses = 0;
+        /// Layout nodes Yoga produced a new layout for.
+        uint64_t nodesVisited = 0;
+        /// Time spent in layout passes, skipped ones included.
+        double seconds = 0.0;
+    };
+
+    /// Totals since the artboard was created or resetLayoutCounters() was
+    /// last called, like updateCounters().
+    const LayoutCounters& layoutCounters() const { return m_layoutCounters; }
+    void resetLayoutCounters() { m_layoutCounters = LayoutCounters(); }
+    void layoutNodeVisited() { m_layoutCounters.nodesVisited++; }
+
     // Update layouts and components. Returns true if it updated something.
     bool updatePass(bool isRoot);
 
@@ -183,8 +272,87 @@ public:
         kHideBG,
         kHideFG,
     };
+    // Draws the artboard. Once a draw finds the artboard unchanged since the
+    // previous one, it records what it draws into a display list, and later
+    // draws replay that list until something changes (see markDrawChanged).
     void draw(Renderer* renderer, DrawOption option);
     void draw(Renderer* renderer) override;
+
+    // Notes that the next draw may differ from the last one, dropping the
+    // recorded display list here and in every artboard hosting this one.
+    // Called for any component dirt; call it after changing render objects
+    // directly.
+    void markDrawChanged();
+
+    // The list later draws replay while the artboard is unchanged, or null.
+    const rcp<DisplayList>& displayList() const { return m_displayList; }
+
+    // Walks the drawables on every draw, never recording or replaying a
+    // display list. For benchmarking.
+    void forceDrawTraversal(bool value) { m_forceDrawTraversal = value; }
+
+    // Instances of this artboard clone and sort from scratch instead of
+    // reusing its captured topology. For comparing the two.
+    void forceFullInstancing(bool value) { m_forceFullInstancing = value; }
+
+    struct DisplayListCounters
+    {
+        /// Draws that walked the drawables without recording.
+        uint64_t drawsTraversed = 0;
+        /// Draws that walked the drawables and recorded a display list.
+        uint64_t drawsRecorded = 0;
+        /// Draws that replayed the display list.
+        uint64_t drawsReplayed = 0;
+    };
+
+    /// Totals since the artboard was created or resetDisplayListCounters()
+    /// was last called, like updateCounters(). Counts this artboard's draws
+    /// only, not those of the artboards it hosts.
+    const DisplayListCounters& displayListCounters() const
+    {
+        return m_displayListCounters;
+    }
+    void resetDisplayListCounters()
+    {
+        m_displayListCounters = DisplayListCounters();
+    }
+
+    // Culls the drawables outside viewport, given in the coordinates draw()
+    // draws in (those of bounds()), e.g. the part of the artboard a render
+    // target shows. Artboards that clip also cull to their bounds. Nested
+    // artboards get the part of the viewport they cover. Without a viewport
+    // nothing is culled.
+    void viewport(const AABB& value);
+    // Stops culling to a viewport.
+    void clearViewport();
+    // Sets the viewport to the part of host's cull region this artboard
+    // covers when host draws it with transform, or clears it when there is
+    // nothing to cull. For nested artboards and list items.
+    void viewportFromHost(const Artboard* host, const Mat2D& transform);
+
+    // Writes the region outside of which drawables are culled, in their
+    // world space, and returns true, or returns false if nothing is culled.
+    bool cullRegion(AABB* region) const;
+
+    // Draws every drawable, culling none. For benchmarking.
+    void forceDrawAll(bool value);
+
+    struct CullingCounters
+    {
+        /// Visible drawables drawn.
+        uint64_t drawablesDrawn = 0;
+        /// Visible drawables skipped for being outside the cull region.
+        uint64_t drawablesCulled = 0;
+    };
+
+    /// Totals since the artboard was created or resetCullingCounters() was
+    /// last called, like updateCounters(). Counts this artboard's drawables
+    /// only, replayed draws included.
+    const CullingCounters& cullingCounters() const
+    {
+        return m_cullingCounters;
+    }
+    void resetCullingCounters() { m_cullingCounters = CullingCounters(); }
     void addToRenderPath(RenderPath* path, const Mat2D& transform);
 
 #ifdef TESTING
@@ -209,6 +377,8 @@ public:
     }
     const std::vector<DataBind*> dataBinds() const { return m_DataBinds; }
     const std::vector<DataBind*> allDataBinds() const { return m_AllDataBinds; }
+    const DataBindQueue& dataBindQueue() const { return m_dataBindQueue; }
+    DataBindQueue& dataBindQueue() { return m_dataBindQueue; }
     DataContext* dataContext() { return m_DataContext; }
     NestedArtboard* nestedArtboard(const std::string& name) const;
     NestedArtboard* nestedArtboardAtPath(const std::string& path) const;
@@ -237,7 +407,9 @@ public:
     void bindViewModelInstance(rcp<ViewModelInstance> viewModelInstance);
     void addDataBind(DataBind* dataBind);
     void populateDataBinds(std::vector<DataBind*>* dataBinds);
-    void sortDataBinds();
+    // Moves the binds that write to their source to the front of
+    // m_AllDataBinds and returns how many there are.
+    size_t sortDataBinds();
     void collectDataBinds();
 
     bool hasAudio() const;
@@ -328,27 +500,7 @@ public:
         artboardClone->m_IsInstance = true;
         artboardClone->m_originalWidth = m_originalWidth;
         artboardClone->m_originalHeight = m_originalHeight;
-        cloneObjectDataBinds(this, artboardClone.get(), artboardClone.get());
-
-        std::vector<Core*>& cloneObjects = artboardClone->m_Objects;
-        cloneObjects.push_back(artboardClone.get());
-
-        if (!m_Objects.empty())
-        {
-            // Skip first object (artboard).
-            auto itr = m_Objects.begin();
-            while (++itr != m_Objects.end())
-            {
-                auto object = *itr;
-                cloneObjects.push_back(object == nullptr ? nullptr
-                                                         : object->clone());
-                // For each object, clone its data bind objects and target their
-                // clones
-                cloneObjectDataBinds(object,
-                                     cloneObjects.back(),
-                                     artboardClone.get());
-            }
-        }
+        cloneObjects(artboardClone.get());
 
         for (auto animation : m_Animations)
         {
@@ -415,6 +567,31 @@ public:
 #endif
 private:
     float m_volume = 1.0f;
+    UpdateCounters m_updateCounters;
+    LayoutCounters m_layoutCounters;
+    // Whether anything that's drawn may have changed since the last draw.
+    bool m_drawChanged = true;
+    bool m_forceDrawTraversal = false;
+    bool m_forceFullInstancing = false;
+    rcp<DisplayList> m_displayList;
+    DrawOption m_displayListOption = DrawOption::kNormal;
+    DisplayListCounters m_displayListCounters;
+    void drawTraversal(Renderer* renderer, DrawOption option);
+
+    bool m_hasViewport = false;
+    AABB m_viewport;
+    bool m_forceDrawAll = false;
+    // Whether the drawables' cached draw bounds may be out of date.
+    bool m_drawBoundsStale = true;
+    CullingCounters m_cullingCounters;
+    // What the draw that recorded m_displayList drew and culled.
+    CullingCounters m_displayListCulling;
+    void updateDrawBounds();
+#ifdef WITH_RIVE_LAYOUT
+    // Calculates the layout and applies the new bounds, if anything that
+    // affects layout changed.
+    void updateLayout();
+#endif
 #ifdef WITH_RIVE_TOOLS
     ArtboardCallback m_layoutChangedCallback = nullptr;
     ArtboardCallback m_layoutDirtyCallback = nullptr;
@@ -466,6 +643,23 @@ public:
     SMINumber* getNumber(const std::string& name, const std::string& path);
     SMITrigger* getTrigger(const std::string& name, const std::string& path);
     TextValueRun* getTextRun(const std::string& name, const std::string& path);
+
+    /// Returns animation flattened against this instance's objects, compiling
+    /// it the first time it's requested. Shared by every
+    /// LinearAnimationInstance playing that animation on this artboard.
+    const CompiledLinearAnimation* compiledAnimation(
+        const LinearAnimation* animation);
+
+    /// Puts every property an animation keys back to its value in source,
+    /// the artboard this was instanced from, and restarts the animations of
+    /// nested artboards, which are reset the same way. State machines
+    /// playing this artboard aren't touched; make new ones to start over.
+    void resetToSetupPose(const Artboard* source);
+
+private:
+    std::unordered_map<const LinearAnimation*,
+                       std::unique_ptr<CompiledLinearAnimation>>
+        m_compiledAnimations;
 };
 } // namespace rive
 
@@ -8,11 +8,13 @@
 #include "rive/data_bind/data_bind_list_item_consumer.hpp"
 #include "rive/layout/layout_node_provider.hpp"
 #include "rive/viewmodel/viewmodel_instance_list_item.hpp"
+#include <algorithm>
 #include <stdio.h>
 #include <unordered_map>
 namespace rive
 {
 class File;
+class LayoutData;
 
 class ArtboardComponentList : public ArtboardComponentListBase,
                               public ArtboardHost,
@@ -42,7 +44,11 @@ public:
     {
         if (index < m_listItems.size())
         {
-            return m_artboardInstancesMap[listItem(index)].get();
+            auto itr = m_artboardInstancesMap.find(listItem(index));
+            if (itr != m_artboardInstancesMap.end())
+            {
+                return itr->second.get();
+            }
         }
         return nullptr;
     }
@@ -50,7 +56,11 @@ public:
     {
         if (index < m_listItems.size())
         {
-            return m_stateMachinesMap[listItem(index)].get();
+            auto itr = m_stateMachinesMap.find(listItem(index));
+            if (itr != m_stateMachinesMap.end())
+            {
+                return itr->second.get();
+            }
         }
         return nullptr;
     }
@@ -82,13 +92,52 @@ public:
     void updateLayoutBounds(bool animate = true) override;
     void markLayoutNodeDirty(
         bool shouldForceUpdateLayoutBounds = false) override;
-    bool isLayoutProvider() override { return true; }
+    bool isLayoutProvider() override { return !m_virtualized; }
     size_t numLayoutNodes() override { return m_listItems.size(); }
     void reset();
     void file(File*);
     File* file() const;
     Core* clone() const override;
 
+    /// In a virtualized list only the items that intersect the visible region
+    /// (the artboard clipped by every clipping layout above the list) plus
+    /// the overscan are instanced, advanced and drawn. Each item keeps a
+    /// placeholder of its artboard's size in the layout, and is instanced
+    /// once the layout has placed it. Items that scroll out return their
+    /// artboard instance to a pool per artboard. The next item that scrolls
+    /// in resets it to its setup pose, binds it and starts a new state
+    /// machine on it, so it draws as a new instance would. A pool holds no
+    /// more than its artboard has visible items.
+    void virtualize(bool value);
+    bool isVirtualized() const { return m_virtualized; }
+    /// How far past the visible region, in the list's space, items are still
+    /// instanced. Covers the frame the visible items lag behind a scroll.
+    void overscan(float value) { m_overscan = std::max(0.0f, value); }
+    float overscan() const { return m_overscan; }
+
+    struct VirtualizationCounters
+    {
+        /// Items that came into view and instanced a new artboard.
+        uint64_t itemsCreated = 0;
+        /// Items that came into view and reused a pooled artboard.
+        uint64_t itemsRecycled = 0;
+        /// Pooled artboards freed for exceeding what the visible items
+        /// could take.
+        uint64_t instancesFreed = 0;
+    };
+    const VirtualizationCounters& virtualizationCounters() const
+    {
+        return m_virtualizationCounters;
+    }
+    void resetVirtualizationCounters()
+    {
+        m_virtualizationCounters = VirtualizationCounters();
+    }
+    /// Items that currently have an artboard instance.
+    size_t instancedCount() const { return m_artboardInstancesMap.size(); }
+    /// Artboard instances waiting in the pools.
+    size_t recycledCount() const;
+
 private:
     void disposeListItem(ViewModelInstanceListItem* listItem);
     std::unique_ptr<ArtboardInstance> createArtboard(
@@ -106,6 +155,42 @@ private:
                        std::unique_ptr<StateMachineInstance>>
         m_stateMachinesMap;
     File* m_file;
+
+    // Where an item of a virtualized list goes, whether or not it's
+    // instanced.
+    struct VirtualizedItem
+    {
+        ~VirtualizedItem();
+        Artboard* artboard = nullptr;
+        AABB bounds;
+        // Whether bounds holds the item's place yet. Until the layout places
+        // it, every placeholder sits at the origin and would look visible.
+        bool hasLayout = false;
+        // Holds the item's place in the parent's layout.
+        LayoutData* layoutData = nullptr;
+    };
+    std::unique_ptr<VirtualizedItem> makeVirtualizedItem(
+        ViewModelInstanceListItem* listItem) const;
+    AABB itemBounds(int index);
+    AABB visibleRegion();
+    void updateVirtualizedItems();
+    void instanceListItem(ViewModelInstanceListItem* listItem);
+    void recycleListItem(ViewModelInstanceListItem* listItem);
+#ifndef WITH_RIVE_LAYOUT
+    void stackVirtualizedItems();
+#endif
+    bool m_virtualized = false;
+    float m_overscan = 0.0f;
+    std::unordered_map<ViewModelInstanceListItem*,
+                       std::unique_ptr<VirtualizedItem>>
+        m_virtualizedItems;
+    std::unordered_map<Artboard*,
+                       std::vector<std::unique_ptr<ArtboardInstance>>>
+        m_recycledInstances;
+    // Visible items per artboard in the last updateVirtualizedItems(), kept
+    // to reuse its storage.
+    std::unordered_map<Artboard*, size_t> m_visibleCounts;
+    VirtualizationCounters m_virtualizationCounters;
 };
 } // namespace rive
 
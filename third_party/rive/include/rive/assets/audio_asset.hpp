@@ -12,6 +12,7 @@ public:
     AudioAsset();
     ~AudioAsset() override;
     bool decode(SimpleArray<uint8_t>&, Factory*) override;
+    bool decode(Span<const uint8_t>, Factory*) override;
     std::string fileExtension() const override;
 
 #ifdef TESTING
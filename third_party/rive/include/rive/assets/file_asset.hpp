@@ -22,6 +22,10 @@ public:
     void decodeCdnUuid(Span<const uint8_t> value) override;
     void copyCdnUuid(const FileAssetBase& object) override;
     virtual bool decode(SimpleArray<uint8_t>&, Factory*) = 0;
+    /// Decode from bytes the asset does not own, which stay valid for the
+    /// lifetime of the File. The default copies them and calls the owning
+    /// decode.
+    virtual bool decode(Span<const uint8_t>, Factory*);
     virtual std::string fileExtension() const = 0;
     StatusCode import(ImportStack& importStack) override;
     const std::vector<FileAssetReferencer*>& fileAssetReferencers()
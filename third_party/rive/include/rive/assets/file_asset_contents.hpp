@@ -9,12 +9,23 @@ namespace rive
 class FileAssetContents : public FileAssetContentsBase
 {
 public:
-    SimpleArray<uint8_t>& bytes();
+    /// The in-band bytes, either owned or borrowed from the imported data.
+    Span<const uint8_t> bytes() const { return m_view; }
+    /// The owned copy of the bytes, empty when they are borrowed.
+    SimpleArray<uint8_t>& ownedBytes() { return m_bytes; }
+    bool isBorrowed() const { return m_bytes.empty() && !m_view.empty(); }
+
+    /// Copies the bytes out of the imported data so they outlive it.
+    void ownBytes();
+
     StatusCode import(ImportStack& importStack) override;
     void decodeBytes(Span<const uint8_t> value) override;
     void copyBytes(const FileAssetContentsBase& object) override;
 
 private:
+    // decodeBytes only records where the bytes live in the imported data,
+    // File::read decides whether they get copied into m_bytes.
+    Span<const uint8_t> m_view;
     SimpleArray<uint8_t> m_bytes;
 };
 } // namespace rive
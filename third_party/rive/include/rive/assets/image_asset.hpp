@@ -26,6 +26,7 @@ public:
     std::size_t decodedByteSize = 0;
 #endif
     bool decode(SimpleArray<uint8_t>&, Factory*) override;
+    bool decode(Span<const uint8_t>, Factory*) override;
     std::string fileExtension() const override;
     RenderImage* renderImage() const { return m_RenderImage.get(); }
     void renderImage(rcp<RenderImage> renderImage);
@@ -0,0 +1,107 @@
+#ifndef _RIVE_IMAGE_DECODE_CACHE_HPP_
+#define _RIVE_IMAGE_DECODE_CACHE_HPP_
+
+#include "rive/factory.hpp"
+#include "rive/span.hpp"
+#include <cstring>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace rive
+{
+// Process wide, thread safe cache of decoded image pixels, keyed by the
+// encoded bytes, so an image embedded in several files is decoded once.
+// Images being decoded are shared too: a second request for the same bytes
+// waits for the first decode instead of starting its own. Lookups go by a
+// hash of the bytes but only match identical bytes, so each cached image
+// keeps a copy of its encoded bytes. The cache is bounded by the size of the
+// pixels and encoded bytes it holds and evicts the least recently used
+// image.
+class ImageDecodeCache
+{
+public:
+    struct Counters
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    static constexpr size_t defaultCapacityBytes = 128 * 1024 * 1024;
+
+    static ImageDecodeCache& shared();
+
+    // Maximum size of the pixels and encoded bytes held, in bytes. Zero
+    // disables the cache (decodes in flight are still shared). Shrinking
+    // evicts right away.
+    void capacity(size_t bytes);
+
+    // Returns the pixels factory->decodeImagePixels(bytes) would, decoding
+    // them only if they aren't cached. Null if the image can't be decoded.
+    std::shared_ptr<const DecodedImage> decode(Span<const uint8_t> bytes,
+                                               Factory* factory);
+
+    Counters counters() const;
+    size_t sizeInBytes() const;
+
+    void clear();
+
+private:
+    // The bytes are the caller's while a key is looked up or its decode is
+    // pending, and the entry's own copy once it's cached.
+    struct Key
+    {
+        uint64_t hash = 0;
+        Span<const uint8_t> bytes;
+
+        bool operator==(const Key& other) const
+        {
+            return hash == other.hash && bytes.size() == other.bytes.size() &&
+                   (bytes.size() == 0 ||
+                    memcmp(bytes.data(), other.bytes.data(), bytes.size()) ==
+                        0);
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return static_cast<size_t>(key.hash);
+        }
+    };
+
+    struct Entry
+    {
+        std::vector<uint8_t> encoded;
+        // Spans encoded.
+        Key key;
+        std::shared_ptr<const DecodedImage> image;
+    };
+    using Pending = std::shared_future<std::shared_ptr<const DecodedImage>>;
+
+    static Key makeKey(Span<const uint8_t> bytes);
+    static size_t entryBytes(const Entry& entry);
+
+    ImageDecodeCache() = default;
+
+    // Must be called with m_mutex held.
+    void add(const Key& key, std::shared_ptr<const DecodedImage> image);
+    void trim();
+
+    mutable std::mutex m_mutex;
+    // Most recently used first.
+    std::list<Entry> m_order;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+    std::unordered_map<Key, Pending, KeyHash> m_pending;
+    size_t m_capacity = defaultCapacityBytes;
+    size_t m_size = 0;
+    Counters m_counters;
+};
+} // namespace rive
+
+#endif
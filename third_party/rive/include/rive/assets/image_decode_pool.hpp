@@ -0,0 +1,115 @@
+#ifndef _RIVE_IMAGE_DECODE_POOL_HPP_
+#define _RIVE_IMAGE_DECODE_POOL_HPP_
+
+#include "rive/assets/image_decode_cache.hpp"
+#include "rive/refcnt.hpp"
+#include "rive/simple_array.hpp"
+#include "rive/span.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rive
+{
+class File;
+class ImageAsset;
+
+// Worker threads that decode the images of files imported with it (see
+// File::import), so the import returns before its images are decoded. Only
+// the decode runs on the workers: finished images are handed to their assets
+// by resolve(), which must be called on the thread that owns the factory,
+// e.g. once per frame. Until then an asset's renderImage() is null.
+class ImageDecodePool : public RefCnt<ImageDecodePool>
+{
+public:
+    static constexpr size_t defaultQueueCapacity = 64;
+
+    struct Counters
+    {
+        uint64_t queued = 0;
+        uint64_t decoded = 0;
+        uint64_t resolved = 0;
+        uint64_t cancelled = 0;
+    };
+
+    // threadCount 0 picks one less than std::thread::hardware_concurrency(),
+    // and at least one. Once queueCapacity images wait for a worker, queueing
+    // another blocks until a worker takes one. cache may be null.
+    explicit ImageDecodePool(size_t threadCount = 0,
+                             size_t queueCapacity = defaultQueueCapacity,
+                             ImageDecodeCache* cache =
+                                 &ImageDecodeCache::shared());
+    ~ImageDecodePool();
+
+    ImageDecodePool(const ImageDecodePool&) = delete;
+    ImageDecodePool& operator=(const ImageDecodePool&) = delete;
+
+    size_t threadCount() const { return m_workers.size(); }
+
+    // Queues asset's image for decoding with factory->decodeImagePixels().
+    // Borrowed bytes must stay valid until the decode is resolved or the
+    // owner cancelled; the SimpleArray overload takes over bytes instead.
+    void queue(const File* owner,
+               ImageAsset* asset,
+               Factory* factory,
+               Span<const uint8_t> bytes);
+    void queue(const File* owner,
+               ImageAsset* asset,
+               Factory* factory,
+               SimpleArray<uint8_t>& bytes);
+
+    // Creates the render images of every finished decode and hands them to
+    // their assets. Returns how many were resolved.
+    size_t resolve();
+
+    // Waits for every queued image to decode, then resolves them all.
+    void finish();
+
+    // Drops owner's queued and finished decodes, waiting for any a worker is
+    // running. Files cancel their own decodes when they're destroyed.
+    void cancel(const File* owner);
+
+    // Images queued, decoding or waiting for resolve().
+    size_t pendingCount() const;
+    // Like pendingCount(), for owner's images only.
+    size_t pendingCount(const File* owner) const;
+
+    Counters counters() const;
+    void resetCounters();
+
+private:
+    struct Job
+    {
+        const File* owner;
+        ImageAsset* asset;
+        Factory* factory;
+        Span<const uint8_t> bytes;
+        SimpleArray<uint8_t> ownedBytes;
+        std::shared_ptr<const DecodedImage> decoded;
+    };
+
+    void queue(Job&& job);
+    void workerLoop(size_t self);
+
+    ImageDecodeCache* m_cache;
+    size_t m_queueCapacity;
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_space;
+    std::condition_variable m_idle;
+    std::deque<Job> m_queue;
+    // The owner of the job each worker is running, and how many are.
+    std::vector<const File*> m_running;
+    size_t m_busy = 0;
+    std::vector<Job> m_finished;
+    Counters m_counters;
+    bool m_stop = false;
+};
+} // namespace rive
+
+#endif
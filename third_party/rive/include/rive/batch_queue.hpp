@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+namespace rive
+{
+// Unbounded single-producer/single-consumer queue of batches, without locks.
+// The producer records into pending() and hands it over with publish(); the
+// consumer reads batches from consume() in publish order. Batch is any type
+// with an empty() query and a "std::atomic<Batch*> next" member.
+//
+// Batches are linked into a list that runs from the oldest recyclable batch,
+// through the consumer's current batch, to the last published one. Once the
+// consumer has moved past a batch it has been read to the end, so the
+// producer can record into it again and steady traffic never allocates.
+template <typename Batch> class BatchQueue
+{
+public:
+    BatchQueue() :
+        m_first(new Batch()),
+        m_headCopy(m_first),
+        m_tail(m_first),
+        m_head(m_first)
+    {}
+
+    ~BatchQueue()
+    {
+        delete m_pending;
+        for (Batch* batch = m_first; batch != nullptr;)
+        {
+            Batch* next = batch->next.load(std::memory_order_relaxed);
+            delete batch;
+            batch = next;
+        }
+    }
+
+    BatchQueue(const BatchQueue&) = delete;
+    BatchQueue& operator=(const BatchQueue&) = delete;
+
+    // Producer: the batch being recorded.
+    Batch& pending()
+    {
+        if (m_pending == nullptr)
+        {
+            m_pending = allocate();
+        }
+        return *m_pending;
+    }
+
+    // Producer: makes the pending batch visible to the consumer. Does nothing
+    // if nothing was recorded.
+    void publish()
+    {
+        if (m_pending == nullptr || m_pending->empty())
+        {
+            return;
+        }
+        m_pending->next.store(nullptr, std::memory_order_relaxed);
+        m_tail->next.store(m_pending, std::memory_order_release);
+        m_tail = m_pending;
+        m_pending = nullptr;
+        m_published.store(m_published.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
+    }
+
+    // Number of batches published so far. The consumer can take a snapshot
+    // of this and pass it to consume() to stop at batches published before
+    // it started.
+    uint64_t publishedCount() const
+    {
+        return m_published.load(std::memory_order_acquire);
+    }
+
+    // Consumer: the batch with data left to read, or null if there is none.
+    // Does not move past the first limit batches.
+    Batch* consume(uint64_t limit = UINT64_MAX)
+    {
+        Batch* head = m_head.load(std::memory_order_relaxed);
+        if (!head->empty())
+        {
+            return head;
+        }
+        if (m_consumed >= limit)
+        {
+            return nullptr;
+        }
+        Batch* next = head->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        assert(!next->empty());
+        m_head.store(next, std::memory_order_release);
+        m_consumed++;
+        return next;
+    }
+
+    // Consumer: true if consume() would return a batch.
+    bool hasData() const
+    {
+        Batch* head = m_head.load(std::memory_order_relaxed);
+        return !head->empty() ||
+               head->next.load(std::memory_order_acquire) != nullptr;
+    }
+
+private:
+    Batch* allocate()
+    {
+        if (m_first == m_headCopy)
+        {
+            m_headCopy = m_head.load(std::memory_order_acquire);
+            if (m_first == m_headCopy)
+            {
+                return new Batch();
+            }
+        }
+        Batch* batch = m_first;
+        m_first = batch->next.load(std::memory_order_relaxed);
+        assert(batch->empty());
+        return batch;
+    }
+
+    // Producer side.
+    Batch* m_first;
+    Batch* m_headCopy;
+    Batch* m_tail;
+    Batch* m_pending = nullptr;
+    std::atomic<uint64_t> m_published{0};
+
+    // Consumer side. m_head is the batch currently being read, or the last
+    // one read; the producer may recycle anything before it.
+    std::atomic<Batch*> m_head;
+    uint64_t m_consumed = 0;
+};
+}; // namespace rive
@@ -19,11 +19,56 @@ class Skin : public SkinBase
 public:
     ~Skin() override;
 
+    /// Runs range(context, begin, end) over [0, count) split into ranges of
+    /// at most grain items, possibly on several threads, and returns once
+    /// every range has run.
+    using ParallelForProc = void (*)(uint32_t count,
+                                     uint32_t grain,
+                                     void* context,
+                                     void (*range)(void* context,
+                                                   uint32_t begin,
+                                                   uint32_t end));
+    /// When set, skins with at least gParallelDeformMinPoints weighted
+    /// points deform them through it.
+    static ParallelForProc gParallelForProc;
+    static uint32_t gParallelDeformMinPoints;
+
 private:
+    // Weighted points (each vertex's position and, for cubic vertices, its
+    // in and out handles) as structure of arrays, padded to a multiple of
+    // four. Positions are already in the skin's world space; bones are
+    // offsets into m_BoneTransforms. Each point's weighted bones come first,
+    // and slotCounts holds how many slots each block of four points uses.
+    struct SkinnedPoints
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<uint32_t> bones[4];
+        std::vector<float> weights[4];
+        std::vector<uint8_t> slotCounts;
+        std::vector<Vec2D*> translations;
+
+        // Empties every array but keeps its storage for the next flatten.
+        void clear();
+    };
+
     Mat2D m_WorldTransform;
     std::vector<Tendon*> m_Tendons;
     float* m_BoneTransforms = nullptr;
     Skinnable* m_Skinnable;
+    SkinnedPoints m_points;
+    const Vertex* const* m_pointsVertices = nullptr;
+    size_t m_pointsVertexCount = 0;
+    bool m_pointsDirty = true;
+    bool m_forcePerVertexDeform = false;
+
+    void flattenPoints(Span<Vertex*> vertices);
+    void updatePointPositions(Span<Vertex*> vertices);
+    void addPoint(Vec2D position,
+                  uint32_t indices,
+                  uint32_t weights,
+                  Vec2D* translation);
+    void deformPoints(uint32_t begin, uint32_t end) const;
 
 protected:
     void addTendon(Tendon* tendon);
@@ -32,6 +77,13 @@ public:
     StatusCode onAddedDirty(CoreContext* context) override;
     void buildDependencies() override;
     void deform(Span<Vertex*> vertices);
+    /// Called when a weighted vertex of this skin moved, so its flattened
+    /// position is refreshed before the next deform. Only positions are
+    /// rewritten; bones and weights are kept from the last flatten.
+    void markPointsDirty() { m_pointsDirty = true; }
+    /// Deform through each vertex's virtual Vertex::deform instead of the
+    /// flattened points, for comparing the two.
+    void forcePerVertexDeform(bool value) { m_forcePerVertexDeform = value; }
     void onDirty(ComponentDirt dirt) override;
     void update(ComponentDirt value) override;
 
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include "rive/batch_queue.hpp"
 #include "rive/object_stream.hpp"
 #include "rive/refcnt.hpp"
 #include "rive/math/vec2d.hpp"
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
@@ -129,9 +131,32 @@ public:
         {}
     };
 
-    CommandQueue();
+    // How commands and messages travel between the client and the server.
+    enum class Transport
+    {
+        // Single-producer/single-consumer batch queues. The server thread is
+        // only signaled when it is asleep waiting for commands.
+        lockFree,
+        // Every command and message takes a mutex, and every command notifies
+        // the server.
+        locked,
+    };
+
+    // Commands must be recorded from a single client thread, and the server
+    // must run on a single thread, which is what the lock-free transport
+    // relies on. createDrawKey() may be called from any thread.
+    CommandQueue(Transport transport = Transport::lockFree);
     ~CommandQueue();
 
+    Transport transport() const { return m_transport; }
+
+    // Commands recorded between beginBatch() and commitBatch() reach the
+    // server together, e.g. everything recorded for one frame. Otherwise each
+    // command is handed over as soon as it is recorded. Batches may nest; the
+    // outermost commitBatch() hands them over.
+    void beginBatch();
+    void commitBatch();
+
     FileHandle loadFile(std::vector<uint8_t> rivBytes,
                         rcp<FileAssetLoader>,
                         FileListener* listener = nullptr,
@@ -281,9 +306,8 @@ private:
         pointerUp,
         pointerExit,
         disconnect,
-        // This will cause processCommands to return once received. We want to
-        // ensure that we do not indefinetly block the calling thread. This is
-        // how we achieve that.
+        // This will cause processCommands to return once received, even if
+        // there are more commands to consume.
         commandLoopBreak,
         // messages
         listArtboards,
@@ -292,8 +316,6 @@ private:
 
     enum class Message
     {
-        // Same as commandLoopBreak for processMessages
-        messageLoopBreak,
         artboardsListed,
         stateMachinesListed,
         fileDeleted,
@@ -304,23 +326,116 @@ private:
 
     friend class CommandServer;
 
+    // Commands and their payloads, recorded by the client and read by the
+    // server in the same order.
+    struct CommandBatch
+    {
+        std::atomic<CommandBatch*> next{nullptr};
+        PODStream commandStream;
+        ObjectStream<std::vector<uint8_t>> byteVectors;
+        ObjectStream<std::string> names;
+        ObjectStream<CommandServerCallback> callbacks;
+        ObjectStream<CommandServerDrawCallback> drawCallbacks;
+
+        bool empty() const { return commandStream.empty(); }
+    };
+
+    // Messages and their payloads, recorded by the server.
+    struct MessageBatch
+    {
+        std::atomic<MessageBatch*> next{nullptr};
+        PODStream messageStream;
+        ObjectStream<std::string> messageNames;
+
+        bool empty() const { return messageStream.empty(); }
+    };
+
+    // A lock on a queue's mutex that is only taken with the locked
+    // transport. Mirrors the parts of std::unique_lock the readers use.
+    class TransportLock
+    {
+    public:
+        TransportLock(std::mutex& mutex, Transport transport) :
+            m_lock(mutex, std::defer_lock),
+            m_enabled(transport == Transport::locked)
+        {
+            lock();
+        }
+
+        void lock()
+        {
+            if (m_enabled)
+                m_lock.lock();
+        }
+
+        void unlock()
+        {
+            if (m_enabled)
+                m_lock.unlock();
+        }
+
+        bool owns_lock() const { return m_lock.owns_lock(); }
+
+    private:
+        std::unique_lock<std::mutex> m_lock;
+        const bool m_enabled;
+    };
+
+    // Records one command into the pending command batch, see
+    // command_queue.cpp.
+    class AutoCommandBatch;
+
+    // Records one message into the pending message batch. With the locked
+    // transport it is published right away; with the lock-free one the server
+    // publishes everything once per processCommands().
+    class AutoMessageBatch
+    {
+    public:
+        AutoMessageBatch(CommandQueue* queue) :
+            m_queue(queue), m_lock(queue->m_messageMutex, queue->m_transport)
+        {}
+
+        ~AutoMessageBatch()
+        {
+            if (m_queue->m_transport == Transport::locked)
+                m_queue->m_messages.publish();
+        }
+
+        MessageBatch* operator->() { return &m_queue->m_messages.pending(); }
+
+    private:
+        CommandQueue* m_queue;
+        TransportLock m_lock;
+    };
+
+    // Client side: hands the pending command batch to the server and wakes it
+    // if it's waiting.
+    void publishCommands();
+
+    // Server side: blocks until there is a command batch to read.
+    void waitForCommands();
+
+    // Server side: hands the pending message batch to the client.
+    void publishMessages();
+
+    const Transport m_transport;
+
     uint64_t m_currentFileHandleIdx = 0;
     uint64_t m_currentArtboardHandleIdx = 0;
     uint64_t m_currentStateMachineHandleIdx = 0;
-    uint64_t m_currentDrawKeyIdx = 0;
+    std::atomic<uint64_t> m_currentDrawKeyIdx{0};
+    int m_batchDepth = 0;
 
+    // Guards the command queue with the locked transport. With the lock-free
+    // one it only backs the server's sleep, see waitForCommands().
     std::mutex m_commandMutex;
     std::condition_variable m_commandConditionVariable;
-    PODStream m_commandStream;
-    ObjectStream<std::vector<uint8_t>> m_byteVectors;
-    ObjectStream<std::string> m_names;
-    ObjectStream<CommandServerCallback> m_callbacks;
-    ObjectStream<CommandServerDrawCallback> m_drawCallbacks;
+    std::atomic<bool> m_serverWaiting{false};
+    BatchQueue<CommandBatch> m_commands;
 
-    // Messages streams
+    // Messages queue, guarded by m_messageMutex with the locked transport.
     std::mutex m_messageMutex;
-    PODStream m_messageStream;
-    ObjectStream<std::string> m_messageNames;
+    BatchQueue<MessageBatch> m_messages;
 
     // Listeners
     std::unordered_map<FileHandle, FileListener*> m_fileListeners;
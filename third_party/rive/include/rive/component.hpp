@@ -19,7 +19,7 @@ class Component : public ComponentBase
 private:
     ContainerComponent* m_Parent = nullptr;
 
-    unsigned int m_GraphOrder;
+    unsigned int m_GraphOrder = 0;
     Artboard* m_Artboard = nullptr;
 
 protected:
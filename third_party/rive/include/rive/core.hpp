@@ -23,6 +23,12 @@ public:
     const uint32_t emptyId = -1;
     static const int invalidPropertyKey = 0;
     virtual ~Core() {}
+
+    /// Core objects are allocated from the thread's current CoreArena when
+    /// one is in scope, otherwise from the heap.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+
     virtual uint16_t coreType() const = 0;
     virtual bool isTypeOf(uint16_t typeKey) const = 0;
     virtual bool deserialize(uint16_t propertyKey, BinaryReader& reader) = 0;
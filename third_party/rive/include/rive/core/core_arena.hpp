@@ -0,0 +1,64 @@
+#ifndef _RIVE_CORE_ARENA_HPP_
+#define _RIVE_CORE_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rive
+{
+/// Bump allocator for Core objects that share a lifetime, like the clones
+/// that make up an ArtboardInstance. While a Scope is active on a thread,
+/// every Core allocated on that thread comes out of the arena. Deleting such
+/// an object still runs its destructor but releases no memory; everything is
+/// freed in bulk when the arena is destroyed, which must happen after all of
+/// its objects have been deleted.
+class CoreArena
+{
+public:
+    /// capacityHint sizes the first chunk. Allocations past it spill into
+    /// further chunks, each twice the size of the previous one.
+    explicit CoreArena(size_t capacityHint);
+    ~CoreArena();
+
+    CoreArena(const CoreArena&) = delete;
+    CoreArena& operator=(const CoreArena&) = delete;
+
+    /// Returns size bytes aligned to alignof(std::max_align_t).
+    void* allocate(size_t size);
+
+    /// Total bytes handed out so far, including alignment padding.
+    size_t bytesAllocated() const { return m_bytesAllocated; }
+
+    /// The arena Core allocations on this thread currently come from, or
+    /// null when they go to the heap.
+    static CoreArena* current();
+
+    /// Routes Core allocations on this thread to an arena (or back to the
+    /// heap when arena is null) until the scope ends. Scopes nest.
+    class Scope
+    {
+    public:
+        explicit Scope(CoreArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CoreArena* m_previous;
+    };
+
+private:
+    void addChunk(size_t minimumSize);
+
+    std::vector<std::unique_ptr<uint8_t[]>> m_chunks;
+    uint8_t* m_cursor = nullptr;
+    uint8_t* m_end = nullptr;
+    size_t m_nextChunkSize;
+    size_t m_bytesAllocated = 0;
+};
+} // namespace rive
+
+#endif
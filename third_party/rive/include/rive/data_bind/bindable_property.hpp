@@ -1,12 +1,35 @@
 #ifndef _RIVE_BINDABLE_PROPERTY_HPP_
 #define _RIVE_BINDABLE_PROPERTY_HPP_
 #include "rive/generated/data_bind/bindable_property_base.hpp"
+#include "rive/data_bind/bindable_property_observer.hpp"
 #include "rive/data_bind/data_bind.hpp"
 #include <stdio.h>
 namespace rive
 {
 class BindableProperty : public BindablePropertyBase
-{};
+{
+public:
+    // Has observer told whenever the value of this copy of original changes.
+    void observe(BindablePropertyObserver* observer,
+                 const BindableProperty* original)
+    {
+        m_observer = observer;
+        m_original = original;
+    }
+
+protected:
+    void notifyValueChanged()
+    {
+        if (m_observer != nullptr)
+        {
+            m_observer->bindablePropertyChanged(m_original);
+        }
+    }
+
+private:
+    BindablePropertyObserver* m_observer = nullptr;
+    const BindableProperty* m_original = nullptr;
+};
 } // namespace rive
 
 #endif
\ No newline at end of file
@@ -8,6 +8,9 @@ class BindablePropertyAsset : public BindablePropertyAssetBase
 {
 public:
     constexpr static uint32_t defaultValue = -1;
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
@@ -8,6 +8,9 @@ class BindablePropertyBoolean : public BindablePropertyBooleanBase
 {
 public:
     constexpr static bool defaultValue = false;
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
@@ -8,6 +8,9 @@ class BindablePropertyColor : public BindablePropertyColorBase
 {
 public:
     constexpr static int defaultValue = 0;
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
@@ -8,6 +8,9 @@ class BindablePropertyEnum : public BindablePropertyEnumBase
 {
 public:
     constexpr static uint16_t defaultValue = 0;
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
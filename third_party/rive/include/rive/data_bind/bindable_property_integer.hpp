@@ -8,6 +8,9 @@ class BindablePropertyInteger : public BindablePropertyIntegerBase
 {
 public:
     constexpr static uint32_t defaultValue = 0;
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
@@ -8,6 +8,9 @@ class BindablePropertyNumber : public BindablePropertyNumberBase
 {
 public:
     constexpr static float defaultValue = 0;
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
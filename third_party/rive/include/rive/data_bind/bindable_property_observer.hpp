@@ -0,0 +1,16 @@
+#ifndef _RIVE_BINDABLE_PROPERTY_OBSERVER_HPP_
+#define _RIVE_BINDABLE_PROPERTY_OBSERVER_HPP_
+namespace rive
+{
+class BindableProperty;
+
+// Told when an observed BindableProperty's value changes.
+class BindablePropertyObserver
+{
+public:
+    virtual ~BindablePropertyObserver() {}
+    virtual void bindablePropertyChanged(const BindableProperty* original) = 0;
+};
+} // namespace rive
+
+#endif
@@ -9,6 +9,9 @@ class BindablePropertyString : public BindablePropertyStringBase
 {
 public:
     static constexpr const char* defaultValue = "";
+
+protected:
+    void propertyValueChanged() override { notifyValueChanged(); }
 };
 } // namespace rive
 
@@ -29,6 +29,9 @@ public:
     virtual void update();
     void copy(const DataConverter& object);
     virtual bool advance(float elapsedTime);
+    // Whether advance() can change the output, so binds using this
+    // converter have to advance every frame.
+    virtual bool advances() const { return false; }
 
 private:
     std::vector<DataBind*> m_dataBinds;
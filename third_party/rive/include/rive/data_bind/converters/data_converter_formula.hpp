@@ -8,6 +8,7 @@
 #include <unordered_map>
 namespace rive
 {
+class FormulaTokenValue;
 
 class DataConverterFormula : public DataConverterFormulaBase
 {
@@ -18,6 +19,9 @@ public:
     void addOutputToken(FormulaToken*, int);
     void initialize();
     void isInstance(bool value) { m_isInstance = value; }
+    /// Evaluate by walking the output queue token by token instead of
+    /// running the compiled program. Meant for benchmarks and debugging.
+    void forceInterpreter(bool value) { m_forceInterpreter = value; }
 
 protected:
     DataValue* convert(DataValue* value, DataBind* dataBind) override;
@@ -29,17 +33,48 @@ protected:
     void update() override;
 
 private:
+    enum class FormulaOpcode : uint8_t
+    {
+        pushConstant,
+        pushInput,
+        pushValue,
+        operation,
+        function,
+    };
+
+    // One step of the compiled program. Operations and functions only
+    // appear where the stack is deep enough for them, with their argument
+    // count already clamped to the stack depth.
+    struct FormulaInstruction
+    {
+        FormulaOpcode opcode;
+        int type = 0;
+        int argumentsCount = 0;
+        float constant = 0.0f;
+        FormulaTokenValue* token = nullptr;
+    };
+
     int getPrecedence(FormulaToken*);
     float getRandom(int);
     float applyOperation(float left, float right, int operationType);
-    float applyFunction(std::vector<float>& stack,
-                        int functionTypeIndex,
-                        int totalArguments);
+    // arguments holds the function's arguments in stack order, so the last
+    // argument pushed is arguments[count - 1].
+    float applyFunction(const float* arguments,
+                        int count,
+                        int functionTypeIndex);
+    void compile();
+    float interpret(float inputValue);
+    float evaluate(float inputValue);
     std::vector<FormulaToken*> m_tokens;
     std::vector<FormulaToken*> m_outputQueue;
     std::vector<float> m_randoms;
     std::unordered_map<FormulaToken*, int> m_argumentsCount;
+    std::vector<FormulaInstruction> m_program;
+    std::vector<float> m_stack;
     bool m_isInstance = false;
+    bool m_compiled = false;
+    bool m_programReturnsInput = false;
+    bool m_forceInterpreter = false;
 };
 } // namespace rive
 
@@ -27,6 +27,7 @@ public:
     void unbind() override;
     void update() override;
     bool advance(float elapsedSeconds) override;
+    bool advances() const override;
 
 private:
     std::vector<DataConverterGroupItem*> m_items;
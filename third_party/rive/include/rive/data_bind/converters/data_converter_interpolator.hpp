@@ -32,6 +32,7 @@ public:
     DataValue* convert(DataValue* value, DataBind* dataBind) override;
     DataValue* reverseConvert(DataValue* value, DataBind* dataBind) override;
     bool advance(float elapsedTime) override;
+    bool advances() const override { return true; }
     void copy(const DataConverterInterpolatorBase& object);
     void durationChanged() override;
 
@@ -12,6 +12,7 @@ namespace rive
 {
 class File;
 class DataBindContextValue;
+class DataBindQueue;
 #ifdef WITH_RIVE_TOOLS
 class DataBind;
 typedef void (*DataBindChanged)();
@@ -39,6 +40,11 @@ public:
     bool toSource();
     bool toTarget();
     bool advance(float elapsedTime);
+    // Whether advance() can do anything, that is the converter animates.
+    bool advances() const;
+    // The queue this bind adds itself to, at index, when it gets dirt.
+    void queue(DataBindQueue* queue, uint32_t index);
+    void dequeue(DataBindQueue* queue);
     void suppressDirt(bool value) { m_suppressDirt = value; };
     void file(File* value) { m_file = value; };
     File* file() const { return m_file; };
@@ -53,6 +59,8 @@ protected:
     bool bindsOnce();
     bool m_suppressDirt = false;
     File* m_file;
+    DataBindQueue* m_queue = nullptr;
+    uint32_t m_queueIndex = 0;
 #ifdef WITH_RIVE_TOOLS
 public:
     void onChanged(DataBindChanged callback) { m_changedCallback = callback; }
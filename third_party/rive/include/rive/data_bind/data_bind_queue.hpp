@@ -0,0 +1,73 @@
+#ifndef _RIVE_DATA_BIND_QUEUE_HPP_
+#define _RIVE_DATA_BIND_QUEUE_HPP_
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace rive
+{
+class DataBind;
+
+// Worklist of the data binds of an artboard or state machine instance that
+// have dirt. A bind queues itself the first time a view model property or
+// converter it reads dirties it, so updating and advancing the binds costs
+// what changed rather than how many binds there are.
+class DataBindQueue
+{
+public:
+    struct Counters
+    {
+        /// Binds update() took off the worklist or polled.
+        uint64_t visited = 0;
+        /// Binds whose dirt was applied.
+        uint64_t updated = 0;
+    };
+
+    // Makes this the queue of binds, replacing the binds previously
+    // attached. A bind's position in the queue is its index in binds.
+    // The first pollCount binds are synced to their source on every
+    // update, as their targets change without dirtying them.
+    void attach(const std::vector<DataBind*>& binds, size_t pollCount = 0);
+    // Stops the attached binds from queueing themselves. Destroying the
+    // queue doesn't, as the binds may already be gone by then, so owners
+    // call this while the binds are still alive.
+    void detach();
+
+    // Called by a bind at index when it gets dirt.
+    void queue(uint32_t index);
+
+    // Applies the dirt of the queued binds in order. When syncSource is
+    // set, each visited bind first updates its source binding. Binds that
+    // get dirt after their position was passed wait for the next update.
+    void update(bool syncSource);
+
+    // Advances the binds whose converters animate. Returns true if any of
+    // them still needs to advance.
+    bool advance(float elapsedSeconds);
+
+    // Visits and advances every bind on each call, like the scan this
+    // replaces. For benchmarking.
+    void forceFullScan(bool value) { m_forceFullScan = value; }
+
+    const Counters& counters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters(); }
+
+private:
+    void visit(uint32_t index, bool syncSource);
+
+    std::vector<DataBind*> m_binds;
+    std::vector<DataBind*> m_advancingBinds;
+    size_t m_pollCount = 0;
+    std::priority_queue<uint32_t,
+                        std::vector<uint32_t>,
+                        std::greater<uint32_t>>
+        m_dirtyBinds;
+    std::vector<bool> m_queuedBinds;
+    std::vector<uint32_t> m_deferredBinds;
+    Counters m_counters;
+    bool m_forceFullScan = false;
+};
+} // namespace rive
+
+#endif
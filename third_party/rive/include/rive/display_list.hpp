@@ -0,0 +1,108 @@
+#ifndef _RIVE_DISPLAY_LIST_HPP_
+#define _RIVE_DISPLAY_LIST_HPP_
+
+#include "rive/math/mat2d.hpp"
+#include "rive/refcnt.hpp"
+#include "rive/renderer.hpp"
+#include <vector>
+
+namespace rive
+{
+// The renderer calls of one draw, in order, so they can be issued again on
+// any renderer without walking what drew them. Paths, paints, images and
+// buffers are referenced rather than copied: replaying draws them as they are
+// now, so a list only reproduces its draw while they're left as they were,
+// e.g. by an artboard that hasn't changed since (see Artboard::draw).
+class DisplayList : public RefCnt<DisplayList>
+{
+public:
+    enum class Command : uint8_t
+    {
+        save,
+        restore,
+        transform,
+        drawPath,
+        clipPath,
+        drawImage,
+        drawImageMesh,
+    };
+
+    size_t commandCount() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+
+    // Issues the recorded calls on renderer.
+    void replay(Renderer* renderer) const;
+    // Issues the recorded calls on renderer under transform, leaving the
+    // renderer's own transform as it was.
+    void replay(Renderer* renderer, const Mat2D& transform) const;
+
+private:
+    friend class RecordingRenderer;
+
+    struct ImageDraw
+    {
+        rcp<const RenderImage> image;
+        ImageSampler sampler;
+        BlendMode blendMode;
+        float opacity;
+    };
+
+    struct ImageMeshDraw
+    {
+        ImageDraw image;
+        rcp<RenderBuffer> vertices;
+        rcp<RenderBuffer> uvCoords;
+        rcp<RenderBuffer> indices;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+    };
+
+    void shrinkToFit();
+
+    // Each command takes its arguments, in order, from the array for its
+    // kind: drawPath and clipPath from m_paths, drawPath from m_paints too.
+    std::vector<Command> m_commands;
+    std::vector<Mat2D> m_transforms;
+    std::vector<rcp<RenderPath>> m_paths;
+    std::vector<rcp<RenderPaint>> m_paints;
+    std::vector<ImageDraw> m_images;
+    std::vector<ImageMeshDraw> m_imageMeshes;
+};
+
+// Records the calls made on it into a DisplayList. When given a target, the
+// calls are forwarded to it as well, so a draw can be recorded while it's
+// drawn.
+class RecordingRenderer : public Renderer
+{
+public:
+    explicit RecordingRenderer(Renderer* target = nullptr);
+
+    // Returns the calls recorded so far and starts a new list.
+    rcp<DisplayList> finish();
+
+    void save() override;
+    void restore() override;
+    void transform(const Mat2D& transform) override;
+    void drawPath(RenderPath* path, RenderPaint* paint) override;
+    void clipPath(RenderPath* path) override;
+    void drawImage(const RenderImage* image,
+                   ImageSampler sampler,
+                   BlendMode blendMode,
+                   float opacity) override;
+    void drawImageMesh(const RenderImage* image,
+                       ImageSampler sampler,
+                       rcp<RenderBuffer> vertices_f32,
+                       rcp<RenderBuffer> uvCoords_f32,
+                       rcp<RenderBuffer> indices_u16,
+                       uint32_t vertexCount,
+                       uint32_t indexCount,
+                       BlendMode blendMode,
+                       float opacity) override;
+
+private:
+    Renderer* m_target;
+    rcp<DisplayList> m_list;
+};
+} // namespace rive
+
+#endif
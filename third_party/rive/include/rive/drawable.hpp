@@ -5,6 +5,7 @@
 #include "rive/renderer.hpp"
 #include "rive/clip_result.hpp"
 #include "rive/drawable_flag.hpp"
+#include "rive/math/aabb.hpp"
 #include <vector>
 
 namespace rive
@@ -27,11 +28,21 @@ private:
     Drawable* prev = nullptr;
     Drawable* next = nullptr;
 
+    /// Cached computeDrawBounds(), refreshed by the artboard before a draw
+    /// that culls when anything changed since the last refresh.
+    AABB m_drawBounds;
+    bool m_hasDrawBounds = false;
+
 public:
     BlendMode blendMode() const { return (BlendMode)blendModeValue(); }
     ClipResult applyClip(Renderer* renderer) const;
     virtual void draw(Renderer* renderer) = 0;
     virtual Core* hitTest(HitInfo*, const Mat2D&) = 0;
+
+    /// Conservative world space bounds of everything draw() draws, so the
+    /// artboard can cull drawables outside the region it draws. Returns false
+    /// if they aren't known, which keeps the drawable from being culled.
+    virtual bool computeDrawBounds(AABB* bounds) { return false; }
     void addClippingShape(ClippingShape* shape);
     inline const std::vector<ClippingShape*>& clippingShapes() const
     {
@@ -14,12 +14,22 @@
 
 #include <stdio.h>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace rive
 {
 
 class RawPath;
 
+// An image decoded to premultiplied RGBA8 pixels, not yet uploaded.
+struct DecodedImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
 class Factory
 {
 public:
@@ -60,6 +70,18 @@ public:
 
     virtual rcp<RenderImage> decodeImage(Span<const uint8_t>) = 0;
 
+    // decodeImage split in two, so the decode can run on another thread and
+    // only the upload stays on the factory's. Factories that return true from
+    // canDecodeImagePixels() must allow decodeImagePixels() from any thread.
+    // makeImage() runs on the factory's thread, like decodeImage().
+    virtual bool canDecodeImagePixels() const { return false; }
+    virtual std::unique_ptr<DecodedImage> decodeImagePixels(
+        Span<const uint8_t>)
+    {
+        return nullptr;
+    }
+    virtual rcp<RenderImage> makeImage(const DecodedImage&) { return nullptr; }
+
     rcp<Font> decodeFont(Span<const uint8_t>);
 
     rcp<AudioSource> decodeAudio(Span<const uint8_t>);
@@ -2,6 +2,7 @@
 #define _RIVE_FILE_HPP_
 
 #include "rive/artboard.hpp"
+#include "rive/assets/image_decode_pool.hpp"
 #include "rive/backboard.hpp"
 #include "rive/factory.hpp"
 #include "rive/file_asset_loader.hpp"
@@ -12,6 +13,7 @@
 #include "rive/viewmodel/viewmodel_instance_viewmodel.hpp"
 #include "rive/viewmodel/viewmodel_instance_list_item.hpp"
 #include "rive/animation/keyframe_interpolator.hpp"
+#include <mutex>
 #include <vector>
 #include <set>
 #include <unordered_map>
@@ -22,6 +24,7 @@
 namespace rive
 {
 class BinaryReader;
+class ImportStack;
 class RuntimeHeader;
 class Factory;
 class ScrollPhysics;
@@ -51,7 +54,9 @@ public:
     /// Minor version number supported by the runtime.
     static const int minorVersion = 0;
 
-    File(Factory*, rcp<FileAssetLoader>);
+    File(Factory*,
+         rcp<FileAssetLoader>,
+         rcp<ImageDecodePool> imageDecodePool = nullptr);
 
 public:
     ~File();
@@ -62,6 +67,10 @@ public:
     /// @param result is an optional status result.
     /// @param assetLoader is an optional helper to load assets which
     /// cannot be found in-band.
+    /// @param imageDecodePool optionally decodes in-band images on worker
+    /// threads instead of during the import. Their render images stay null
+    /// until the pool resolves them, see ImageDecodePool::resolve(). Ignored
+    /// when the factory can't decode without uploading.
     /// @returns a pointer to the file, or null on failure.
     static std::unique_ptr<File> import(Span<const uint8_t> data,
                                         Factory* factory,
@@ -71,10 +80,44 @@ public:
         return import(data, factory, result, ref_rcp(assetLoader));
     }
 
-    static std::unique_ptr<File> import(Span<const uint8_t> data,
-                                        Factory*,
-                                        ImportResult* result,
-                                        rcp<FileAssetLoader> assetLoader);
+    static std::unique_ptr<File> import(
+        Span<const uint8_t> data,
+        Factory*,
+        ImportResult* result,
+        rcp<FileAssetLoader> assetLoader,
+        rcp<ImageDecodePool> imageDecodePool = nullptr);
+
+    ///
+    /// Imports a Rive file without copying its in-band asset bytes. Assets
+    /// reference their ranges of data directly, so data must stay valid and
+    /// unchanged for as long as the returned File, or anything decoded from
+    /// its assets, is alive. Intended for memory-mapped files.
+    static std::unique_ptr<File> importBorrowed(
+        Span<const uint8_t> data,
+        Factory*,
+        ImportResult* result = nullptr,
+        rcp<FileAssetLoader> assetLoader = nullptr,
+        rcp<ImageDecodePool> imageDecodePool = nullptr);
+
+    ///
+    /// Imports a Rive file but defers reading each artboard until it is
+    /// first requested through artboard(), artboardAt(), artboardNamed() and
+    /// friends. Up front only the file level objects (backboard, assets, view
+    /// models, enums, converters) are read; artboards are indexed by a pass
+    /// that skips over their objects. Like importBorrowed, data must stay
+    /// valid and unchanged for the lifetime of the returned File. Files that
+    /// interleave file level objects with artboards are imported eagerly.
+    /// The const accessors import on first use; imports hold a lock on the
+    /// File, so the accessors can be called from several threads.
+    static std::unique_ptr<File> importLazy(
+        Span<const uint8_t> data,
+        Factory*,
+        ImportResult* result = nullptr,
+        rcp<FileAssetLoader> assetLoader = nullptr,
+        rcp<ImageDecodePool> imageDecodePool = nullptr);
+
+    /// @returns true if some of the file's artboards have not been read yet.
+    bool hasLazyArtboards() const;
 
     /// @returns the file's backboard. All files have exactly one backboard.
     Backboard* backboard() const { return m_backboard; }
@@ -150,7 +193,7 @@ public:
     const std::vector<DataEnum*>& enums() const;
     FileAsset* asset(size_t index);
 
-    std::vector<Artboard*> artboards() { return m_artboards; };
+    std::vector<Artboard*> artboards();
 
 #ifdef WITH_RIVE_TOOLS
     /// Strips FileAssetContents for FileAssets of given typeKeys.
@@ -172,7 +215,26 @@ public:
 #endif
 
 private:
-    ImportResult read(BinaryReader&, const RuntimeHeader&);
+    static std::unique_ptr<File> import(Span<const uint8_t> data,
+                                        Factory*,
+                                        ImportResult* result,
+                                        rcp<FileAssetLoader> assetLoader,
+                                        rcp<ImageDecodePool> imageDecodePool,
+                                        bool borrowAssetBytes,
+                                        bool lazyArtboards);
+    ImportResult read(BinaryReader&,
+                      const RuntimeHeader&,
+                      bool borrowAssetBytes);
+    ImportResult readLazy(BinaryReader&, const RuntimeHeader&);
+    ImportResult readObjects(BinaryReader&,
+                             const RuntimeHeader&,
+                             ImportStack&,
+                             bool borrowAssetBytes,
+                             std::vector<Artboard*>& artboards);
+
+    /// Reads the artboard at index from its recorded byte range.
+    Artboard* importLazyArtboard(size_t index);
+    void importLazyArtboards();
 
     /// The file's backboard. All Rive files have a single backboard
     /// where the artboards live.
@@ -187,8 +249,31 @@ private:
     std::vector<ScrollPhysics*> m_scrollPhysics;
 
     /// List of artboards in the file. Each artboard encapsulates a set of
-    /// Rive components and animations.
-    std::vector<Artboard*> m_artboards;
+    /// Rive components and animations. With importLazy, entries stay null
+    /// until the artboard is first requested.
+    mutable std::vector<Artboard*> m_artboards;
+
+    enum class LazyState : uint8_t
+    {
+        pending,
+        importing,
+        done,
+    };
+
+    /// Where each not yet imported artboard lives in the borrowed file bytes,
+    /// indexed like m_artboards. Empty for eagerly imported files.
+    struct LazyArtboard
+    {
+        Span<const uint8_t> bytes;
+        std::string name;
+        LazyState state = LazyState::pending;
+    };
+    std::vector<LazyArtboard> m_lazyArtboards;
+    std::unique_ptr<RuntimeHeader> m_lazyHeader;
+    /// Guards m_lazyArtboards and m_artboards while artboards are imported
+    /// lazily. Recursive because resolving an artboard may import the
+    /// artboards it nests.
+    mutable std::recursive_mutex m_lazyMutex;
 
     /// List of view models in the file. They may outlive the file if viewmodel
     /// instances are still needed after the file is destroyed
@@ -208,6 +293,9 @@ private:
     /// with the file.
     rcp<FileAssetLoader> m_assetLoader;
 
+    /// Decodes the file's in-band images when imported with one.
+    rcp<ImageDecodePool> m_imageDecodePool;
+
     rcp<ViewModelInstance> copyViewModelInstance(
         ViewModelInstance* viewModelInstance,
         std::unordered_map<ViewModelInstance*, rcp<ViewModelInstance>>
@@ -33,6 +33,9 @@ private:
     std::vector<ScrollPhysics*> m_physics;
     int m_NextArtboardId;
     File* m_file;
+    // Set when importing a single artboard of a lazily imported file, nested
+    // artboards outside the lookup are then requested from it.
+    const File* m_lazyFile = nullptr;
 
 public:
     BackboardImporter(Backboard* backboard);
@@ -47,6 +50,16 @@ public:
         DataConverterGroupItem* referencer);
     void addInterpolator(KeyFrameInterpolator* interpolator);
     void addPhysics(ScrollPhysics* physics);
+
+    /// Restores the file level lookups of an import that already resolved so
+    /// the artboard with id artboardId can be imported on its own later
+    /// (File::importLazy).
+    void resume(int artboardId,
+                const File* lazyFile,
+                const std::vector<FileAsset*>& assets,
+                const std::vector<DataConverter*>& converters,
+                const std::vector<KeyFrameInterpolator*>& interpolators,
+                const std::vector<ScrollPhysics*>& physics);
     std::vector<ScrollPhysics*> physics() { return m_physics; }
     std::vector<FileAsset*>* assets() { return &m_FileAssets; }
     void file(File* value);
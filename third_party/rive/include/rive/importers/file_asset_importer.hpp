@@ -8,10 +8,12 @@
 
 namespace rive
 {
+class File;
 class FileAsset;
 class FileAssetContents;
 class FileAssetLoader;
 class Factory;
+class ImageDecodePool;
 
 class FileAssetImporter : public ImportStackObject
 {
@@ -19,11 +21,18 @@ private:
     FileAsset* m_FileAsset;
     rcp<FileAssetLoader> m_FileAssetLoader;
     Factory* m_Factory;
+    // Set when image decodes are handed to a pool instead of running inline.
+    ImageDecodePool* m_ImageDecodePool;
+    const File* m_File;
     // we will delete this when we go out of scope
     std::unique_ptr<FileAssetContents> m_Content;
 
 public:
-    FileAssetImporter(FileAsset*, rcp<FileAssetLoader>, Factory*);
+    FileAssetImporter(FileAsset*,
+                      rcp<FileAssetLoader>,
+                      Factory*,
+                      ImageDecodePool* imageDecodePool = nullptr,
+                      const File* file = nullptr);
     void onFileAssetContents(std::unique_ptr<FileAssetContents> contents);
     StatusCode resolve() override;
 };
@@ -157,10 +157,33 @@ private:
     bool m_forceUpdateLayoutBounds = false;
 
 #ifdef WITH_RIVE_LAYOUT
+    struct IntrinsicMeasurement
+    {
+        float width;
+        LayoutMeasureMode widthMode;
+        float height;
+        LayoutMeasureMode heightMode;
+        Vec2D size;
+    };
+    // Every measurement Yoga asked for since the node was last marked dirty.
+    // Yoga only reuses results from these, so if re-measuring all of them
+    // gives the same sizes the node doesn't need to be laid out again.
+    std::vector<IntrinsicMeasurement> m_intrinsicMeasurements;
+    bool m_intrinsicMeasurementsOverflowed = false;
+    // Available size passed to the last YGNodeCalculateLayout.
+    float m_calculatedWidth = NAN;
+    float m_calculatedHeight = NAN;
+
+    bool intrinsicSizeChanged();
+    void markYogaNodeDirty();
+
 protected:
     void propagateSizeToChildren(ContainerComponent* component);
     bool applyInterpolation(float elapsedSeconds, bool animate = true);
-    void calculateLayout();
+    // Lays out the tree rooted at this component. Returns false without
+    // calling into Yoga if no node is dirty and the available size hasn't
+    // changed.
+    bool calculateLayout();
     bool styleDisplayHidden();
 #endif
 
@@ -259,7 +282,15 @@ public:
 #ifdef WITH_RIVE_LAYOUT
 
     void* layoutNode(int index) override;
+    // Applies the style to the Yoga node, marking it dirty only if
+    // something that affects layout changed.
     void syncStyle();
+    // Called by Yoga's measure function, records the measurement for
+    // intrinsicSizeChanged.
+    Vec2D measureIntrinsicSize(float width,
+                               LayoutMeasureMode widthMode,
+                               float height,
+                               LayoutMeasureMode heightMode);
     void syncLayoutChildren();
     void clearLayoutChildren();
     virtual void propagateSize();
@@ -154,6 +154,34 @@ public:
     std::vector<uint32_t> m_segmentCounts;
 };
 
+// Keeps the contours measured for a path until it is asked to measure
+// different geometry. Effects that animate only their own parameters (trim
+// start/end, dash offsets) can then re-extract segments every frame without
+// re-measuring the source path.
+class ContourMeasureCache
+{
+public:
+    // Returns the contours of path, re-measuring only if its points, verbs or
+    // the tolerance differ from the previous call.
+    const std::vector<rcp<ContourMeasure>>& measure(
+        const RawPath* path,
+        float tol = ContourMeasureIter::kDefaultTolerance);
+
+    const std::vector<rcp<ContourMeasure>>& contours() const
+    {
+        return m_contours;
+    }
+
+    // Forces the next measure() to re-measure.
+    void clear();
+
+private:
+    RawPath m_source;
+    float m_tolerance = 0.0f;
+    bool m_isValid = false;
+    std::vector<rcp<ContourMeasure>> m_contours;
+};
+
 } // namespace rive
 
 #endif
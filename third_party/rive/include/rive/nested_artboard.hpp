@@ -36,6 +36,8 @@ public:
     StatusCode onAddedClean(CoreContext* context) override;
     void draw(Renderer* renderer) override;
     Core* hitTest(HitInfo*, const Mat2D&) override;
+    // Known when the nested artboard clips to its bounds.
+    bool computeDrawBounds(AABB* bounds) override;
     void addNestedAnimation(NestedAnimation* nestedAnimation);
 
     void nest(Artboard* artboard);
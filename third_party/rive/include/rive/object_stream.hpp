@@ -7,16 +7,19 @@
 #include "rive/refcnt.hpp"
 
 #include <cassert>
-#include <deque>
+#include <cstring>
+#include <type_traits>
+#include <vector>
 
 namespace rive
 {
 // Stream for recording objects of a specific type, using C++-style "<<" ">>"
-// operators.
+// operators. Storage is kept once the stream has been read to the end, so a
+// stream that is filled and drained repeatedly stops allocating.
 template <typename T> class ObjectStream
 {
 public:
-    bool empty() const { return m_stream.empty(); }
+    bool empty() const { return m_readIndex == m_stream.size(); }
 
     ObjectStream& operator<<(T obj)
     {
@@ -27,13 +30,18 @@ public:
     ObjectStream& operator>>(T& dst)
     {
         assert(!empty());
-        dst = std::move(m_stream.front());
-        m_stream.pop_front();
+        dst = std::move(m_stream[m_readIndex++]);
+        if (empty())
+        {
+            m_stream.clear();
+            m_readIndex = 0;
+        }
         return *this;
     }
 
 private:
-    std::deque<T> m_stream;
+    std::vector<T> m_stream;
+    size_t m_readIndex = 0;
 };
 
 // Stream for recording objects of any trivially-copyable type, using C++-style
@@ -42,7 +50,7 @@ private:
 class PODStream
 {
 public:
-    bool empty() const { return m_byteStream.empty(); }
+    bool empty() const { return m_readIndex == m_byteStream.size(); }
 
     template <typename T> PODStream& operator<<(T obj)
     {
@@ -57,11 +65,14 @@ public:
     {
         static_assert(std::is_pod<T>(),
                       "PODStream only accepts plain-old-data types");
-        assert(m_byteStream.size() >= sizeof(T));
-        char* data = reinterpret_cast<char*>(&dst);
-        std::copy(m_byteStream.begin(), m_byteStream.begin() + sizeof(T), data);
-        m_byteStream.erase(m_byteStream.begin(),
-                           m_byteStream.begin() + sizeof(T));
+        assert(m_byteStream.size() - m_readIndex >= sizeof(T));
+        memcpy(&dst, m_byteStream.data() + m_readIndex, sizeof(T));
+        m_readIndex += sizeof(T);
+        if (empty())
+        {
+            m_byteStream.clear();
+            m_readIndex = 0;
+        }
         return *this;
     }
 
@@ -79,6 +90,7 @@ public:
     }
 
 private:
-    std::deque<char> m_byteStream;
+    std::vector<char> m_byteStream;
+    size_t m_readIndex = 0;
 };
 }; // namespace rive
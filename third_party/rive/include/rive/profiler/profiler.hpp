@@ -0,0 +1,118 @@
+#ifndef _RIVE_PROFILER_HPP_
+#define _RIVE_PROFILER_HPP_
+
+// Scoped timing zones for finding where a frame went. Everything here
+// compiles out unless RIVE_PROFILER is defined, so the macros can stay in hot
+// paths:
+//
+//   void Artboard::draw(Renderer* renderer)
+//   {
+//       RIVE_PROF_SCOPE();
+//       ...
+//   }
+//
+// RIVE_PROF_SCOPE() names the zone after the enclosing function,
+// RIVE_PROF_SCOPENAME("name") takes a string literal.
+
+#ifdef RIVE_PROFILER
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace rive
+{
+// Process wide recorder of profiler zones. Each thread appends the zones it
+// closes to its own fixed size ring buffer, so recording threads never wait
+// on each other, and only the most recent kEventsPerThread zones of every
+// thread are kept.
+class Profiler
+{
+public:
+    static constexpr size_t kEventsPerThread = 1 << 16;
+
+    struct Event
+    {
+        // Must outlive the profiler, e.g. a string literal or __func__.
+        const char* name;
+        uint64_t startNanos;
+        uint64_t durationNanos;
+    };
+
+    // Percentiles of one zone's durations, over the events currently held in
+    // the ring buffers.
+    struct ZoneStats
+    {
+        const char* name;
+        uint64_t count;
+        double p50Micros;
+        double p95Micros;
+        double p99Micros;
+        double maxMicros;
+        double totalMicros;
+    };
+
+    // Nanoseconds since the profiler started.
+    static uint64_t nowNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - epoch())
+            .count();
+    }
+
+    static void record(const char* name,
+                       uint64_t startNanos,
+                       uint64_t durationNanos);
+
+    // Zones sorted by the time spent in them, most first.
+    static std::vector<ZoneStats> zoneStats();
+
+    // Writes every recorded zone as a chrome://tracing (Trace Event Format)
+    // JSON document.
+    static void writeChromeTrace(std::ostream&);
+
+    // Drops every recorded zone.
+    static void clear();
+
+private:
+    static std::chrono::steady_clock::time_point epoch();
+};
+
+// Records the time between its construction and destruction as a zone.
+class ProfilerZone
+{
+public:
+    explicit ProfilerZone(const char* name) :
+        m_name(name), m_startNanos(Profiler::nowNanos())
+    {}
+    ~ProfilerZone()
+    {
+        Profiler::record(m_name,
+                         m_startNanos,
+                         Profiler::nowNanos() - m_startNanos);
+    }
+
+    ProfilerZone(const ProfilerZone&) = delete;
+    ProfilerZone& operator=(const ProfilerZone&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_startNanos;
+};
+} // namespace rive
+
+#define RIVE_PROF_CONCAT_(a, b) a##b
+#define RIVE_PROF_CONCAT(a, b) RIVE_PROF_CONCAT_(a, b)
+#define RIVE_PROF_SCOPENAME(name)                                              \
+    ::rive::ProfilerZone RIVE_PROF_CONCAT(riveProfilerZone_, __LINE__)(name)
+#define RIVE_PROF_SCOPE() RIVE_PROF_SCOPENAME(__func__)
+
+#else
+
+#define RIVE_PROF_SCOPENAME(name)
+#define RIVE_PROF_SCOPE()
+
+#endif
+
+#endif
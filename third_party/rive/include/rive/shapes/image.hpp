@@ -27,6 +27,7 @@ public:
     ImageAsset* imageAsset() const { return (ImageAsset*)m_fileAsset; }
     void draw(Renderer* renderer) override;
     Core* hitTest(HitInfo*, const Mat2D&) override;
+    bool computeDrawBounds(AABB* bounds) override;
     StatusCode import(ImportStack& importStack) override;
     void setAsset(FileAsset*) override;
     uint32_t assetId() override;
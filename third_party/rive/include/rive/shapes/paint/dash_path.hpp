@@ -29,7 +29,7 @@ protected:
 
 protected:
     ShapePaintPath m_path;
-    std::vector<rcp<ContourMeasure>> m_contours;
+    ContourMeasureCache m_contours;
 
 public:
     float pathLength() const;
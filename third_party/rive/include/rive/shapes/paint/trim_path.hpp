@@ -40,7 +40,7 @@ protected:
     void invalidateTrim();
     void trimPath(const RawPath* source);
     ShapePaintPath m_path;
-    std::vector<rcp<ContourMeasure>> m_contours;
+    ContourMeasureCache m_contours;
 };
 } // namespace rive
 
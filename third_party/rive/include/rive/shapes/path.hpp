@@ -73,9 +73,7 @@ public:
     FlattenedPath* makeFlat(bool transformToParent);
 #endif
 
-#ifdef TESTING
     std::vector<PathVertex*>& vertices() { return m_Vertices; }
-#endif
 
     void buildPath(RawPath&) const;
 };
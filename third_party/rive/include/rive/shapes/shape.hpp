@@ -22,6 +22,7 @@ private:
     PathComposer m_PathComposer;
     std::vector<Path*> m_Paths;
     AABB m_WorldBounds;
+    uint32_t m_boundsVersion = 0;
     float m_WorldLength = -1;
 
     bool m_WantDifferencePath = false;
@@ -43,6 +44,7 @@ public:
     void update(ComponentDirt value) override;
     void draw(Renderer* renderer) override;
     Core* hitTest(HitInfo*, const Mat2D&) override;
+    bool computeDrawBounds(AABB* bounds) override;
 
     const PathComposer* pathComposer() const { return &m_PathComposer; }
     PathComposer* pathComposer() { return &m_PathComposer; }
@@ -77,7 +79,17 @@ public:
         drawableFlags(drawableFlags() & ~static_cast<unsigned short>(
                                             DrawableFlag::WorldBoundsClean));
         m_WorldLength = -1;
+        m_boundsVersion++;
     }
+    /// Whether worldBounds() is cached and cheap to read.
+    bool worldBoundsClean() const
+    {
+        return (static_cast<DrawableFlag>(drawableFlags()) &
+                DrawableFlag::WorldBoundsClean) ==
+               DrawableFlag::WorldBoundsClean;
+    }
+    /// Changes every time the world bounds are invalidated.
+    uint32_t boundsVersion() const { return m_boundsVersion; }
 
     AABB computeWorldBounds(const Mat2D* xform = nullptr) const;
     AABB computeLocalBounds() const;
@@ -42,6 +42,10 @@ public:
 
     void propagateOpacity(float opacity);
 
+    /// How far the visible paints can draw outside the world bounds of the
+    /// path they paint: strokes up to their miter limit, and feathers.
+    float paintOutset() const;
+
     virtual const Mat2D& shapeWorldTransform() const = 0;
 
 #ifdef TESTING
@@ -85,10 +85,16 @@ public:
         SimpleArrayTesting::mallocCount++;
 #endif
     }
-    SimpleArray(const T* ptr, size_t size) : SimpleArray(size)
+    // Copy constructs into uninitialized storage; default constructing first
+    // would leak whatever non-POD elements allocate in their constructors.
+    SimpleArray(const T* ptr, size_t size) :
+        m_ptr(static_cast<T*>(malloc(size * sizeof(T)))), m_size(size)
     {
         assert(ptr <= ptr + size);
         SimpleArrayHelper<T>::CopyConstructArray(ptr, ptr + size, m_ptr);
+#ifdef TESTING
+        SimpleArrayTesting::mallocCount++;
+#endif
     }
 
     constexpr SimpleArray(const SimpleArray<T>& other) :
@@ -46,6 +46,7 @@ public:
 
 private:
     HBFont(hb_font_t* font,
+           uint32_t typefaceId,
            std::unordered_map<uint32_t, float> axisValues,
            std::unordered_map<uint32_t, uint32_t> featureValues,
            std::vector<hb_feature_t> features);
@@ -66,6 +67,10 @@ public:
 private:
     hb_draw_funcs_t* m_drawFuncs;
 
+    // Unique per decoded typeface and shared by the fonts made from it with
+    // withOptions, so equivalent fonts share a shaping key.
+    uint32_t m_typefaceId;
+
     // Feature value lookup based on tag.
     std::unordered_map<uint32_t, uint32_t> m_featureValues;
 
@@ -0,0 +1,102 @@
+#ifndef _RIVE_SHAPING_CACHE_HPP_
+#define _RIVE_SHAPING_CACHE_HPP_
+
+#include "rive/text_engine.hpp"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace rive
+{
+// Process wide, thread safe cache of shaped paragraphs and glyph outlines,
+// shared by every Text and artboard instance. Entries are keyed by the
+// fonts' shapingKey() so identical labels drawn with equivalent fonts are
+// only shaped, and each glyph only drawn, once. Both caches are bounded and
+// evict the least recently used entry.
+class ShapingCache
+{
+public:
+    struct Counters
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    static constexpr size_t defaultParagraphCapacity = 1024;
+    static constexpr size_t defaultGlyphCapacity = 8192;
+
+    static ShapingCache& shared();
+
+    // Maximum number of entries in each cache. Zero disables that cache.
+    // Shrinking evicts entries right away.
+    void capacity(size_t paragraphs, size_t glyphs);
+
+    // Looks up the paragraphs Font::shapeText would return for text and
+    // runs. Returns false if they aren't cached or can't be.
+    bool findParagraphs(Span<const Unichar> text,
+                        Span<const TextRun> runs,
+                        int textDirectionFlag,
+                        SimpleArray<Paragraph>& paragraphs);
+    void addParagraphs(Span<const Unichar> text,
+                       Span<const TextRun> runs,
+                       int textDirectionFlag,
+                       const SimpleArray<Paragraph>& paragraphs);
+
+    // Looks up the outline font->getPath(glyph) would return.
+    bool findGlyphPath(const Font* font, GlyphID glyph, RawPath& path);
+    void addGlyphPath(const Font* font, GlyphID glyph, const RawPath& path);
+
+    Counters paragraphCounters() const;
+    Counters glyphCounters() const;
+
+    void clear();
+
+private:
+    using Key = std::vector<uint32_t>;
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct ParagraphEntry
+    {
+        // The fonts of the runs that were shaped. Glyph runs referencing
+        // them are pointed at the requesting runs' fonts on a hit.
+        std::vector<rcp<Font>> runFonts;
+        SimpleArray<Paragraph> paragraphs;
+    };
+
+    // Least recently used map: order runs from the most to the least
+    // recently used entry and index finds an entry's position in it.
+    template <typename Value> struct LruMap
+    {
+        using Entry = std::pair<Key, Value>;
+        std::list<Entry> order;
+        std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash>
+            index;
+        size_t capacity = 0;
+        Counters counters;
+
+        Value* find(const Key& key);
+        void add(Key&& key, Value&& value);
+        void trim();
+        void clear();
+    };
+
+    static bool makeParagraphKey(Span<const Unichar> text,
+                                 Span<const TextRun> runs,
+                                 int textDirectionFlag,
+                                 Key& key);
+
+    ShapingCache();
+
+    mutable std::mutex m_mutex;
+    LruMap<ParagraphEntry> m_paragraphs;
+    LruMap<RawPath> m_glyphs;
+};
+} // namespace rive
+
+#endif
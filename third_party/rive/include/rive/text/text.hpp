@@ -66,6 +66,8 @@ public:
 
     void draw(Renderer* renderer) override;
     Core* hitTest(HitInfo*, const Mat2D&) override;
+    // Known for clipped text only, as glyphs can overflow their bounds.
+    bool computeDrawBounds(AABB* bounds) override;
     void addRun(TextValueRun* run);
     void addModifierGroup(TextModifierGroup* group);
     void markShapeDirty(bool sendToLayout);
@@ -28,6 +28,8 @@ protected:
 private:
     RawPath m_worldPath;
     RawPath m_localPath;
+    // The local path m_pathMeasure was built from.
+    RawPath m_measuredPath;
     PathMeasure m_pathMeasure;
 
     void modifierShapeDirty();
@@ -9,6 +9,7 @@
 #include "rive/refcnt.hpp"
 #include "rive/span.hpp"
 #include "rive/simple_array.hpp"
+#include <vector>
 
 namespace rive
 {
@@ -224,10 +225,17 @@ public:
     //
     virtual RawPath getPath(GlyphID) const = 0;
 
+    // Results are shared through the ShapingCache when every run's font has
+    // a shaping key.
     SimpleArray<Paragraph> shapeText(Span<const Unichar> text,
                                      Span<const TextRun> runs,
                                      int textDirectionFlag = -1) const;
 
+    // Identifies the typeface, variation axes and features this font shapes
+    // with. Fonts with the same non-empty key shape text and draw glyphs
+    // identically. Empty if the font's results can't be cached.
+    const std::vector<uint32_t>& shapingKey() const { return m_shapingKey; }
+
     // If the platform can supply fallback font(s), set this function pointer.
     // It will be called with a span of unichars, and the platform attempts to
     // return a font that can draw (at least some of) them. If no font is
@@ -243,6 +251,9 @@ public:
 protected:
     Font(const LineMetrics& lm) : m_lineMetrics(lm) {}
 
+    // Set by subclasses that can describe what they shape with.
+    std::vector<uint32_t> m_shapingKey;
+
     virtual SimpleArray<Paragraph> onShapeText(Span<const Unichar> text,
                                                Span<const TextRun> runs,
                                                int textDirectionFlag) const = 0;
@@ -13,6 +13,9 @@ class ViewModelInstance : public ViewModelInstanceBase,
 {
 private:
     std::vector<ViewModelInstanceValue*> m_PropertyValues;
+    // The values of m_PropertyValues that reset or forward something in
+    // advanced(), so advancing skips plain values.
+    std::vector<ViewModelInstanceValue*> m_advancingValues;
     ViewModel* m_ViewModel;
 
 public:
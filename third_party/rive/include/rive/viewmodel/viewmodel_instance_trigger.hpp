@@ -18,6 +18,7 @@ protected:
 
 public:
     void advanced() override;
+    bool advances() const override { return true; }
 #ifdef WITH_RIVE_TOOLS
     void onChanged(ViewModelTriggerChanged callback)
     {
@@ -30,6 +30,9 @@ public:
     void removeDependent(Dirtyable* value);
     virtual void setRoot(rcp<ViewModelInstance> value);
     virtual void advanced(){};
+    // Whether advanced() does anything, so the instance only calls it on
+    // the values that need it.
+    virtual bool advances() const { return false; }
     const std::string& name() const;
 };
 } // namespace rive
@@ -23,6 +23,7 @@ public:
     }
     void setRoot(rcp<ViewModelInstance> value) override;
     void advanced() override;
+    bool advances() const override { return true; }
 };
 } // namespace rive
 
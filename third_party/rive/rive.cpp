@@ -393,6 +393,7 @@
 #include "source/animation/keyframe_double.cpp"
 #include "source/animation/listener_input_change.cpp"
 #include "source/animation/hittable.cpp"
+#include "source/animation/hit_grid.cpp"
 #include "source/animation/blend_animation_direct.cpp"
 #include "source/animation/transition_property_comparator.cpp"
 #include "source/animation/cubic_ease_interpolator.cpp"
@@ -505,6 +506,7 @@
 #include "source/data_bind/context/context_value_boolean.cpp"
 #include "source/data_bind/data_bind.cpp"
 #include "source/data_bind/data_bind_list_item_consumer.cpp"
+#include "source/data_bind/data_bind_queue.cpp"
 #include "source/data_bind/converters/data_converter_boolean_negate.cpp"
 #include "source/data_bind/converters/data_converter_system_normalizer.cpp"
 #include "source/data_bind/converters/data_converter_string_remove_zeros.cpp"
@@ -556,6 +558,7 @@
 #include "source/text/text_value_run.cpp"
 #include "source/text/text_selection_path.cpp"
 #include "source/text/cursor.cpp"
+#include "source/text/shaping_cache.cpp"
 #include "source/text/text_input_text.cpp"
 #include "source/text/utf.cpp"
 #include "source/text/raw_text.cpp"
@@ -569,6 +572,8 @@
 #include "source/command_queue.cpp"
 #include "source/assets/audio_asset.cpp"
 #include "source/assets/image_asset.cpp"
+#include "source/assets/image_decode_cache.cpp"
+#include "source/assets/image_decode_pool.cpp"
 #include "source/assets/font_asset.cpp"
 #include "source/assets/file_asset_contents.cpp"
 #include "source/assets/file_asset_referencer.cpp"
@@ -578,8 +583,13 @@
 #include "source/solo.cpp"
 #include "source/static_scene.cpp"
 #include "source/renderer.cpp"
+#include "source/display_list.cpp"
 #include "source/audio_event.cpp"
 #include "source/nested_artboard_leaf.cpp"
+#include "source/utils/no_op_factory.cpp"
+#include "source/profiler/profiler.cpp"
+#include "source/animation/compiled_linear_animation.cpp"
+#include "source/core/core_arena.cpp"
 
 #if __clang__
  #pragma clang diagnostic pop
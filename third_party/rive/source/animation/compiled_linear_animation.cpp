@@ -0,0 +1,322 @@
+#include "rive/animation/compiled_linear_animation.hpp"
+#include "rive/animation/interpolating_keyframe.hpp"
+#include "rive/animation/keyed_object.hpp"
+#include "rive/animation/keyed_property.hpp"
+#include "rive/animation/keyframe_color.hpp"
+#include "rive/animation/keyframe_double.hpp"
+#include "rive/animation/keyframe_interpolator.hpp"
+#include "rive/animation/linear_animation.hpp"
+#include "rive/artboard.hpp"
+#include "rive/generated/core_registry.hpp"
+#include "rive/shapes/paint/color.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace rive;
+
+CompiledLinearAnimation::CompiledLinearAnimation(
+    const LinearAnimation* animation,
+    Artboard* artboard) :
+    m_animation(animation)
+{
+    for (size_t i = 0; i < animation->numKeyedObjects(); i++)
+    {
+        const KeyedObject* keyedObject = animation->getObject(i);
+        Core* object = artboard->resolve(keyedObject->objectId());
+        if (object == nullptr)
+        {
+            continue;
+        }
+        InterpolatorHost* interpolatorHost = InterpolatorHost::from(object);
+
+        for (size_t j = 0; j < keyedObject->numKeyedProperties(); j++)
+        {
+            const KeyedProperty* property = keyedObject->getProperty(j);
+            int propertyKey = property->propertyKey();
+            size_t frameCount = property->numKeyFrames();
+            if (CoreRegistry::isCallback(propertyKey) || frameCount == 0)
+            {
+                continue;
+            }
+
+            Track track;
+            track.object = object;
+            track.interpolatorHost = interpolatorHost;
+            track.propertyKey = propertyKey;
+            track.hasDuplicateTimes = false;
+            track.firstFrame = static_cast<uint32_t>(m_seconds.size());
+            track.frameCount = static_cast<uint32_t>(frameCount);
+
+            bool allNumbers = true;
+            bool allColors = true;
+            for (size_t k = 0; k < frameCount; k++)
+            {
+                auto keyFrame = static_cast<InterpolatingKeyFrame*>(
+                    property->getKeyFrame(k));
+                float seconds = keyFrame->seconds();
+                if (k > 0 && seconds == m_seconds.back())
+                {
+                    track.hasDuplicateTimes = true;
+                }
+                m_seconds.push_back(seconds);
+                m_holds.push_back(keyFrame->interpolationType() == 0 ? 1 : 0);
+                m_interpolators.push_back(keyFrame->interpolator());
+                m_keyFrames.push_back(keyFrame);
+
+                float numberValue = 0.0f;
+                int colorValue = 0;
+                if (keyFrame->is<KeyFrameDouble>())
+                {
+                    numberValue = keyFrame->as<KeyFrameDouble>()->value();
+                    allColors = false;
+                }
+                else if (keyFrame->is<KeyFrameColor>())
+                {
+                    colorValue = keyFrame->as<KeyFrameColor>()->value();
+                    allNumbers = false;
+                }
+                else
+                {
+                    allNumbers = allColors = false;
+                }
+                m_numberValues.push_back(numberValue);
+                m_colorValues.push_back(colorValue);
+            }
+            track.type = allNumbers  ? TrackType::number
+                         : allColors ? TrackType::color
+                                     : TrackType::other;
+            m_tracks.push_back(track);
+        }
+    }
+}
+
+// Same search as KeyedProperty::closestFrameIndex, used when a track has
+// duplicate keyframe times and the exact frame picked matters.
+static uint32_t closestFrameIndex(const float* frameSeconds,
+                                  uint32_t count,
+                                  float seconds)
+{
+    int start = 0;
+    int end = static_cast<int>(count) - 1;
+    if (seconds > frameSeconds[end])
+    {
+        return count;
+    }
+    while (start <= end)
+    {
+        int mid = (start + end) >> 1;
+        float closestSeconds = frameSeconds[mid];
+        if (closestSeconds < seconds)
+        {
+            start = mid + 1;
+        }
+        else if (closestSeconds > seconds)
+        {
+            end = mid - 1;
+        }
+        else
+        {
+            return static_cast<uint32_t>(mid);
+        }
+    }
+    return static_cast<uint32_t>(start);
+}
+
+uint32_t CompiledLinearAnimation::frameIndex(const Track& track,
+                                             float seconds,
+                                             uint32_t& cursor) const
+{
+    const float* frameSeconds = m_seconds.data() + track.firstFrame;
+    uint32_t count = track.frameCount;
+    if (track.hasDuplicateTimes)
+    {
+        return closestFrameIndex(frameSeconds, count, seconds);
+    }
+
+    // With unique times the binary search lands on the lower bound of
+    // seconds: the first frame at or after it. Check whether the previous
+    // result (or its neighbor) still is that frame before searching.
+    uint32_t idx = std::min(cursor, count);
+    if (idx < count && frameSeconds[idx] < seconds)
+    {
+        idx++;
+        if (idx < count && frameSeconds[idx] < seconds)
+        {
+            idx = static_cast<uint32_t>(
+                std::lower_bound(frameSeconds + idx + 1,
+                                 frameSeconds + count,
+                                 seconds) -
+                frameSeconds);
+        }
+    }
+    else if (idx > 0 && !(frameSeconds[idx - 1] < seconds))
+    {
+        idx--;
+        if (idx > 0 && !(frameSeconds[idx - 1] < seconds))
+        {
+            idx = static_cast<uint32_t>(
+                std::lower_bound(frameSeconds, frameSeconds + idx, seconds) -
+                frameSeconds);
+        }
+    }
+    cursor = idx;
+    return idx;
+}
+
+// These mirror applyDouble/applyColor in keyframe_double.cpp and
+// keyframe_color.cpp operation for operation so results are identical.
+static void applyNumber(Core* object, int propertyKey, float mix, float value)
+{
+    if (mix == 1.0f)
+    {
+        CoreRegistry::setDouble(object, propertyKey, value);
+    }
+    else
+    {
+        float mixi = 1.0f - mix;
+        CoreRegistry::setDouble(
+            object,
+            propertyKey,
+            CoreRegistry::getDouble(object, propertyKey) * mixi + value * mix);
+    }
+}
+
+static void applyColorValue(Core* object, int propertyKey, float mix, int value)
+{
+    if (mix == 1.0f)
+    {
+        CoreRegistry::setColor(object, propertyKey, value);
+    }
+    else
+    {
+        auto mixedColor =
+            colorLerp(CoreRegistry::getColor(object, propertyKey), value, mix);
+        CoreRegistry::setColor(object, propertyKey, mixedColor);
+    }
+}
+
+void CompiledLinearAnimation::applyFrame(const Track& track,
+                                         uint32_t frame,
+                                         float mix) const
+{
+    uint32_t index = track.firstFrame + frame;
+    switch (track.type)
+    {
+        case TrackType::number:
+            applyNumber(track.object,
+                        track.propertyKey,
+                        mix,
+                        m_numberValues[index]);
+            break;
+        case TrackType::color:
+            applyColorValue(track.object,
+                            track.propertyKey,
+                            mix,
+                            m_colorValues[index]);
+            break;
+        case TrackType::other:
+            m_keyFrames[index]->apply(track.object, track.propertyKey, mix);
+            break;
+    }
+}
+
+void CompiledLinearAnimation::applyInterpolation(const Track& track,
+                                                 uint32_t frame,
+                                                 float seconds,
+                                                 float mix) const
+{
+    uint32_t from = track.firstFrame + frame;
+    uint32_t to = from + 1;
+    switch (track.type)
+    {
+        case TrackType::number:
+        {
+            float fromValue = m_numberValues[from];
+            float toValue = m_numberValues[to];
+            float f = (seconds - m_seconds[from]) /
+                      (m_seconds[to] - m_seconds[from]);
+            float frameValue;
+            if (KeyFrameInterpolator* interpolator = m_interpolators[from])
+            {
+                frameValue = interpolator->transformValue(fromValue, toValue, f);
+            }
+            else
+            {
+                frameValue = fromValue + (toValue - fromValue) * f;
+            }
+            applyNumber(track.object, track.propertyKey, mix, frameValue);
+            break;
+        }
+        case TrackType::color:
+        {
+            float f = (seconds - m_seconds[from]) /
+                      (m_seconds[to] - m_seconds[from]);
+            if (KeyFrameInterpolator* interpolator = m_interpolators[from])
+            {
+                f = interpolator->transform(f);
+            }
+            applyColorValue(
+                track.object,
+                track.propertyKey,
+                mix,
+                colorLerp(m_colorValues[from], m_colorValues[to], f));
+            break;
+        }
+        case TrackType::other:
+            m_keyFrames[from]->applyInterpolation(track.object,
+                                                  track.propertyKey,
+                                                  seconds,
+                                                  m_keyFrames[to],
+                                                  mix);
+            break;
+    }
+}
+
+void CompiledLinearAnimation::apply(float time,
+                                    float mix,
+                                    uint32_t* cursors) const
+{
+    if (m_animation->quantize())
+    {
+        float ffps = (float)m_animation->fps();
+        time = std::floor(time * ffps) / ffps;
+    }
+
+    for (size_t i = 0; i < m_tracks.size(); i++)
+    {
+        const Track& track = m_tracks[i];
+        float actualMix = mix;
+        if (track.interpolatorHost != nullptr &&
+            track.interpolatorHost->overridesKeyedInterpolation(
+                track.propertyKey))
+        {
+            actualMix = 1.0f;
+        }
+
+        uint32_t idx = frameIndex(track, time, cursors[i]);
+        if (idx == 0)
+        {
+            applyFrame(track, 0, actualMix);
+        }
+        else if (idx < track.frameCount)
+        {
+            uint32_t from = idx - 1;
+            if (time == m_seconds[track.firstFrame + idx])
+            {
+                applyFrame(track, idx, actualMix);
+            }
+            else if (m_holds[track.firstFrame + from])
+            {
+                applyFrame(track, from, actualMix);
+            }
+            else
+            {
+                applyInterpolation(track, from, time, actualMix);
+            }
+        }
+        else
+        {
+            applyFrame(track, track.frameCount - 1, actualMix);
+        }
+    }
+}
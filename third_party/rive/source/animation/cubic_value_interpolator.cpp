@@ -2,35 +2,28 @@
 
 using namespace rive;
 
-CubicValueInterpolator::CubicValueInterpolator() : m_D(0.0f), m_ValueTo(0.0f)
-{
-    computeParameters();
-}
-void CubicValueInterpolator::computeParameters()
-{
-    float y1 = m_D;
-    float y2 = CubicValueInterpolator::y1();
-    float y3 = CubicValueInterpolator::y2();
-    float y4 = m_ValueTo;
-
-    m_A = y4 + 3 * (y2 - y3) - y1;
-    m_B = 3 * (y3 - y2 * 2 + y1);
-    m_C = 3 * (y2 - y1);
-    // m_D = y1;
-}
+CubicValueInterpolator::CubicValueInterpolator() {}
 
 float CubicValueInterpolator::transformValue(float valueFrom,
                                              float valueTo,
                                              float factor)
 {
-    if (m_D != valueFrom || m_ValueTo != valueTo)
-    {
-        m_D = valueFrom;
-        m_ValueTo = valueTo;
-        computeParameters();
-    }
+    // The coefficients depend on the values being interpolated and a single
+    // interpolator is shared by every keyframe (in every artboard instance)
+    // that references it, so they're derived per call instead of cached on
+    // the object. Caching made concurrent advances of separate instances
+    // race on the same members.
+    float y1 = valueFrom;
+    float y2 = CubicValueInterpolator::y1();
+    float y3 = CubicValueInterpolator::y2();
+    float y4 = valueTo;
+
+    float a = y4 + 3 * (y2 - y3) - y1;
+    float b = 3 * (y3 - y2 * 2 + y1);
+    float c = 3 * (y2 - y1);
+
     float t = m_solver.getT(factor);
-    return ((m_A * t + m_B) * t + m_C) * t + m_D;
+    return ((a * t + b) * t + c) * t + y1;
 }
 
 float CubicValueInterpolator::transform(float factor) const
@@ -38,9 +31,3 @@ float CubicValueInterpolator::transform(float factor) const
     assert(false);
     return factor;
 }
-
-StatusCode CubicValueInterpolator::onAddedDirty(CoreContext* context)
-{
-    computeParameters();
-    return Super::onAddedDirty(context);
-}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "rive/animation/hit_grid.hpp"
+#include "rive/animation/state_machine_instance.hpp"
+#include "rive/shapes/shape.hpp"
+#include <cmath>
+
+using namespace rive;
+
+void HitGrid::add(HitComponent* component)
+{
+    Shape* shape = component->boundingShape();
+    if (shape == nullptr)
+    {
+        return;
+    }
+    component->hitGridIndex = (uint32_t)m_entries.size();
+    Entry entry;
+    entry.shape = shape;
+    m_entries.push_back(entry);
+    m_stale.push_back(component->hitGridIndex);
+}
+
+int HitGrid::cellX(float x) const
+{
+    float cell =
+        (x - m_extent.minX) / m_extent.width() * (float)cellsPerSide;
+    // Positions outside the extent (or NaN) fall in the edge cells, which
+    // also hold every entry that reaches past that edge.
+    if (!(cell > 0.0f))
+    {
+        return 0;
+    }
+    return cell >= cellsPerSide ? cellsPerSide - 1 : (int)cell;
+}
+
+int HitGrid::cellY(float y) const
+{
+    float cell =
+        (y - m_extent.minY) / m_extent.height() * (float)cellsPerSide;
+    if (!(cell > 0.0f))
+    {
+        return 0;
+    }
+    return cell >= cellsPerSide ? cellsPerSide - 1 : (int)cell;
+}
+
+void HitGrid::bin(uint32_t index)
+{
+    Entry& entry = m_entries[index];
+    const AABB& bounds = entry.bounds;
+    entry.binned = true;
+    // Empty or NaN bounds contain nothing, so they need no cells.
+    if (!(bounds.minX <= bounds.maxX && bounds.minY <= bounds.maxY))
+    {
+        entry.minX = entry.minY = 0;
+        entry.maxX = entry.maxY = -1;
+        return;
+    }
+    entry.minX = cellX(bounds.minX);
+    entry.minY = cellY(bounds.minY);
+    entry.maxX = cellX(bounds.maxX);
+    entry.maxY = cellY(bounds.maxY);
+    for (int y = entry.minY; y <= entry.maxY; y++)
+    {
+        for (int x = entry.minX; x <= entry.maxX; x++)
+        {
+            m_cells[y * cellsPerSide + x].push_back(index);
+        }
+    }
+}
+
+void HitGrid::unbin(uint32_t index)
+{
+    Entry& entry = m_entries[index];
+    for (int y = entry.minY; y <= entry.maxY; y++)
+    {
+        for (int x = entry.minX; x <= entry.maxX; x++)
+        {
+            auto& cell = m_cells[y * cellsPerSide + x];
+            for (size_t i = 0; i < cell.size(); i++)
+            {
+                if (cell[i] == index)
+                {
+                    cell[i] = cell.back();
+                    cell.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+    entry.binned = false;
+}
+
+void HitGrid::query(Vec2D position)
+{
+    m_stamp++;
+    if (!m_hasExtent)
+    {
+        return;
+    }
+    for (uint32_t index :
+         m_cells[cellY(position.y) * cellsPerSide + cellX(position.x)])
+    {
+        Entry& entry = m_entries[index];
+        // The same test Shape::hitTestAABB starts with.
+        if (entry.bounds.contains(position))
+        {
+            entry.stamp = m_stamp;
+        }
+    }
+}
+
+bool HitGrid::isCandidate(HitComponent* component)
+{
+    uint32_t index = component->hitGridIndex;
+    if (index == notIndexed)
+    {
+        return true;
+    }
+    Entry& entry = m_entries[index];
+    if (!entry.binned || entry.version != entry.shape->boundsVersion())
+    {
+        if (!entry.queuedStale)
+        {
+            entry.queuedStale = true;
+            m_stale.push_back(index);
+        }
+        return true;
+    }
+    return entry.stamp == m_stamp;
+}
+
+void HitGrid::refresh()
+{
+    if (m_stale.empty())
+    {
+        return;
+    }
+    if (!m_hasExtent)
+    {
+        // Size the grid to the first bounds that are available.
+        AABB extent = AABB::forExpansion();
+        for (uint32_t index : m_stale)
+        {
+            Shape* shape = m_entries[index].shape;
+            if (!shape->worldBoundsClean())
+            {
+                continue;
+            }
+            AABB bounds = shape->worldBounds();
+            if (std::isfinite(bounds.minX) && std::isfinite(bounds.minY) &&
+                std::isfinite(bounds.maxX) && std::isfinite(bounds.maxY) &&
+                bounds.minX <= bounds.maxX && bounds.minY <= bounds.maxY)
+            {
+                AABB::expandTo(extent, bounds.min());
+                AABB::expandTo(extent, bounds.max());
+            }
+        }
+        if (!(extent.width() > 0.0f && extent.height() > 0.0f))
+        {
+            return;
+        }
+        m_extent = extent;
+        m_cells.resize(cellsPerSide * cellsPerSide);
+        m_hasExtent = true;
+    }
+    for (size_t i = 0; i < m_stale.size();)
+    {
+        uint32_t index = m_stale[i];
+        Entry& entry = m_entries[index];
+        if (!entry.shape->worldBoundsClean())
+        {
+            i++;
+            continue;
+        }
+        if (entry.binned)
+        {
+            unbin(index);
+        }
+        entry.bounds = entry.shape->worldBounds();
+        entry.version = entry.shape->boundsVersion();
+        bin(index);
+        entry.queuedStale = false;
+        m_stale[i] = m_stale.back();
+        m_stale.pop_back();
+    }
+}
@@ -1,10 +1,14 @@
 #include "rive/animation/layer_state.hpp"
 #include "rive/animation/transition_bool_condition.hpp"
+#include "rive/animation/transition_property_viewmodel_comparator.hpp"
+#include "rive/animation/transition_value_comparator.hpp"
+#include "rive/animation/transition_viewmodel_condition.hpp"
 #include "rive/importers/import_stack.hpp"
 #include "rive/importers/state_machine_layer_importer.hpp"
 #include "rive/generated/animation/state_machine_layer_base.hpp"
 #include "rive/animation/state_transition.hpp"
 #include "rive/animation/system_state_instance.hpp"
+#include <algorithm>
 
 using namespace rive;
 
@@ -39,9 +43,69 @@ StatusCode LayerState::onAddedClean(CoreContext* context)
             return code;
         }
     }
+    buildTransitionDependencies();
     return StatusCode::Ok;
 }
 
+void LayerState::buildTransitionDependencies()
+{
+    TransitionDependencies dependencies;
+    dependencies.alwaysEvaluate = false;
+    auto addComparator = [&](const TransitionComparator* comparator) {
+        if (comparator == nullptr || comparator->is<TransitionValueComparator>())
+        {
+            // Compares against a constant.
+            return;
+        }
+        if (comparator->is<TransitionPropertyViewModelComparator>())
+        {
+            dependencies.properties.push_back(
+                comparator->as<TransitionPropertyViewModelComparator>()
+                    ->bindableProperty());
+            return;
+        }
+        dependencies.alwaysEvaluate = true;
+    };
+    for (auto transition : m_Transitions)
+    {
+        // Disabled transitions never get to their conditions.
+        if (transition->isDisabled())
+        {
+            continue;
+        }
+        for (size_t i = 0, count = transition->conditionCount(); i < count;
+             i++)
+        {
+            auto condition = transition->condition(i);
+            if (condition->is<TransitionInputCondition>())
+            {
+                dependencies.inputIds.push_back(
+                    condition->as<TransitionInputCondition>()->inputId());
+            }
+            else if (condition->is<TransitionViewModelCondition>())
+            {
+                auto viewModelCondition =
+                    condition->as<TransitionViewModelCondition>();
+                addComparator(viewModelCondition->leftComparator());
+                addComparator(viewModelCondition->rightComparator());
+            }
+            else
+            {
+                dependencies.alwaysEvaluate = true;
+            }
+        }
+    }
+    auto& inputIds = dependencies.inputIds;
+    std::sort(inputIds.begin(), inputIds.end());
+    inputIds.erase(std::unique(inputIds.begin(), inputIds.end()),
+                   inputIds.end());
+    auto& properties = dependencies.properties;
+    std::sort(properties.begin(), properties.end());
+    properties.erase(std::unique(properties.begin(), properties.end()),
+                     properties.end());
+    m_transitionDependencies = std::move(dependencies);
+}
+
 StatusCode LayerState::import(ImportStack& importStack)
 {
     auto layerImporter = importStack.latest<StateMachineLayerImporter>(
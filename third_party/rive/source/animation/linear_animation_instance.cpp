@@ -1,7 +1,9 @@
 #include "rive/animation/linear_animation_instance.hpp"
 #include "rive/animation/linear_animation.hpp"
+#include "rive/animation/compiled_linear_animation.hpp"
 #include "rive/animation/loop.hpp"
 #include "rive/animation/keyed_callback_reporter.hpp"
+#include "rive/profiler/profiler.hpp"
 #include <cmath>
 #include <cassert>
 
@@ -33,15 +35,39 @@ LinearAnimationInstance::LinearAnimationInstance(
     m_spilledTime(lhs.m_spilledTime),
     m_direction(lhs.m_direction),
     m_didLoop(lhs.m_didLoop),
-    m_loopValue(lhs.m_loopValue)
+    m_loopValue(lhs.m_loopValue),
+    m_compiled(lhs.m_compiled),
+    m_trackCursors(lhs.m_trackCursors)
 {}
 
 LinearAnimationInstance::~LinearAnimationInstance() {}
 
+void LinearAnimationInstance::apply(float mix) const
+{
+    if (!m_artboardInstance->isInstance())
+    {
+        // Compiled tracks are cached on the instance, a source artboard
+        // takes the direct path.
+        m_animation->apply(m_artboardInstance, m_time, mix);
+        return;
+    }
+    if (m_compiled == nullptr)
+    {
+        m_compiled = m_artboardInstance->compiledAnimation(m_animation);
+        m_trackCursors.assign(m_compiled->trackCount(), 0);
+    }
+    m_compiled->apply(m_time, mix, m_trackCursors.data());
+}
+
 bool LinearAnimationInstance::advanceAndApply(float seconds)
 {
+    RIVE_PROF_SCOPENAME("LinearAnimationInstance::advanceAndApply");
     bool more = this->advance(seconds, this);
     this->apply();
+    if (more)
+    {
+        m_artboardInstance->markDrawChanged();
+    }
     if (m_artboardInstance->advance(seconds))
     {
         more = true;
@@ -18,6 +18,7 @@ const std::string& SMIInput::name() const { return m_input->name(); }
 void SMIInput::valueChanged()
 {
     m_machineInstance->markNeedsAdvance();
+    m_machineInstance->inputChanged(m_index);
 #ifdef WITH_RIVE_TOOLS
     auto callback = m_machineInstance->m_inputChangedCallback;
     if (callback != nullptr)
@@ -39,6 +39,8 @@
 #include "rive/text/text.hpp"
 #include "rive/math/math_types.hpp"
 #include "rive/audio_event.hpp"
+#include "rive/profiler/profiler.hpp"
+#include <algorithm>
 #include <unordered_map>
 #include <chrono>
 
@@ -64,6 +66,7 @@ public:
         assert(m_layer == nullptr);
         m_anyStateInstance =
             layer->anyState()->makeInstance(instance).release();
+        m_anyStateDependencies = &layer->anyState()->transitionDependencies();
         m_layer = layer;
         changeState(m_layer->entryState());
 
@@ -108,7 +111,13 @@ public:
         {
             m_stateMachineChangedOnAdvance = false;
         }
+        bool stateKeptGoing = m_currentState->keepGoing();
         m_currentState->advance(seconds, m_stateMachineInstance);
+        if (stateKeptGoing && !m_currentState->keepGoing())
+        {
+            // The state completed.
+            m_needsEvaluation = true;
+        }
         updateMix(seconds);
 
         if (m_stateFrom != nullptr && m_mix < 1.0f && !m_holdAnimationFrom)
@@ -155,14 +164,60 @@ public:
             return false;
         }
 
+        auto& counters = m_stateMachineInstance->m_transitionCounters;
+        if (!m_needsEvaluation &&
+            !m_stateMachineInstance->m_forceTransitionEvaluation)
+        {
+            counters.layersSkipped++;
+            return false;
+        }
+        counters.layersEvaluated++;
+        // Changes from here on are seen by the next update.
+        m_needsEvaluation = false;
         m_waitingForExit = false;
 
-        if (tryChangeState(m_anyStateInstance))
+        bool changed = tryChangeState(m_anyStateInstance) ||
+                       tryChangeState(m_currentState);
+        // Exit times are checked once the other conditions pass, so keep
+        // evaluating until they're reached.
+        if (m_waitingForExit || m_anyStateDependencies->alwaysEvaluate ||
+            (m_currentDependencies != nullptr &&
+             m_currentDependencies->alwaysEvaluate))
         {
-            return true;
+            m_needsEvaluation = true;
         }
+        return changed;
+    }
 
-        return tryChangeState(m_currentState);
+    // Called when an input changed. Marks the layer for evaluation if its
+    // current transitions read it.
+    void inputChanged(uint32_t inputId)
+    {
+        auto reads = [inputId](const TransitionDependencies* dependencies) {
+            return dependencies != nullptr &&
+                   std::binary_search(dependencies->inputIds.begin(),
+                                      dependencies->inputIds.end(),
+                                      inputId);
+        };
+        if (reads(m_anyStateDependencies) || reads(m_currentDependencies))
+        {
+            m_needsEvaluation = true;
+        }
+    }
+
+    // Same as inputChanged for the value of a view model property.
+    void propertyChanged(const BindableProperty* property)
+    {
+        auto reads = [property](const TransitionDependencies* dependencies) {
+            return dependencies != nullptr &&
+                   std::binary_search(dependencies->properties.begin(),
+                                      dependencies->properties.end(),
+                                      property);
+        };
+        if (reads(m_anyStateDependencies) || reads(m_currentDependencies))
+        {
+            m_needsEvaluation = true;
+        }
     }
 
     void fireEvents(StateMachineFireOccurance occurs,
@@ -212,6 +267,9 @@ public:
             stateTo == nullptr
                 ? nullptr
                 : stateTo->makeInstance(m_artboardInstance).release();
+        m_currentDependencies =
+            stateTo == nullptr ? nullptr : &stateTo->transitionDependencies();
+        m_needsEvaluation = true;
 
         // Fire start events for the state we're changing to.
         if (m_currentState != nullptr)
@@ -482,6 +540,13 @@ private:
     StateInstance* m_currentState = nullptr;
     StateInstance* m_stateFrom = nullptr;
 
+    // What the transitions out of the any state and the current state read.
+    const TransitionDependencies* m_anyStateDependencies = nullptr;
+    const TransitionDependencies* m_currentDependencies = nullptr;
+    // Set when the transitions have to be evaluated on the next update,
+    // because the state changed or something they read did.
+    bool m_needsEvaluation = true;
+
     const StateTransition* m_transition = nullptr;
     std::unique_ptr<AnimationReset> m_animationReset = nullptr;
     bool m_transitionCompleted = false;
@@ -812,7 +877,9 @@ public:
         return testBounds(component->parent(), position, skipOnUnclipped);
     }
 
-    void prepareEvent(Vec2D position, ListenerType hitType) override
+    void prepareEvent(Vec2D position,
+                      ListenerType hitType,
+                      bool isCandidate) override
     {
         if (canEarlyOut &&
             (hitType != ListenerType::down || !hasDownListener) &&
@@ -823,7 +890,7 @@ public:
 #endif
             return;
         }
-        isHovered = hitTest(position);
+        isHovered = isCandidate && hitTest(position);
 
         // // iterate all listeners associated with this hit shape
         if (isHovered)
@@ -929,6 +996,15 @@ public:
     {
         return testBounds(m_component, position, true);
     }
+
+    // testBounds fails early when a Shape's world bounds miss the position.
+    Shape* boundingShape() const override
+    {
+        return m_component != nullptr &&
+                       m_component->coreType() == Shape::typeKey
+                   ? m_component->as<Shape>()
+                   : nullptr;
+    }
 };
 
 // Wrapper around HitExpandable to garbage collect text run contours.
@@ -1080,7 +1156,10 @@ public:
         }
         return hitResult;
     }
-    void prepareEvent(Vec2D position, ListenerType hitType) override {}
+    void prepareEvent(Vec2D position,
+                      ListenerType hitType,
+                      bool isCandidate) override
+    {}
 };
 
 class HitComponentList : public HitComponent
@@ -1195,7 +1274,10 @@ public:
         }
         return hitResult;
     }
-    void prepareEvent(Vec2D position, ListenerType hitType) override {}
+    void prepareEvent(Vec2D position,
+                      ListenerType hitType,
+                      bool isCandidate) override
+    {}
 };
 
 } // namespace rive
@@ -1215,10 +1297,14 @@ HitResult StateMachineInstance::updateListeners(Vec2D position,
         listenerGroup.get()->reset();
     }
     // Next prepare the event to set the common hover status for each group
+    m_hitGrid.query(position);
     for (const auto& hitShape : m_hitComponents)
     {
-        hitShape->prepareEvent(position, hitType);
+        hitShape->prepareEvent(position,
+                               hitType,
+                               m_hitGrid.isCandidate(hitShape.get()));
     }
+    m_hitGrid.refresh();
     bool hitSomething = false;
     bool hitOpaque = false;
     // Finally process the events
@@ -1250,16 +1336,19 @@ bool StateMachineInstance::hitTest(Vec2D position) const
             m_artboardInstance->originY() * m_artboardInstance->layoutHeight());
     }
 
+    m_hitGrid.query(position);
+    bool hit = false;
     for (const auto& hitShape : m_hitComponents)
     {
-        // TODO: quick reject.
-
-        if (hitShape->hitTest(position))
+        if (m_hitGrid.isCandidate(hitShape.get()) &&
+            hitShape->hitTest(position))
         {
-            return true;
+            hit = true;
+            break;
         }
     }
-    return false;
+    m_hitGrid.refresh();
+    return hit;
 }
 
 HitResult StateMachineInstance::pointerMove(Vec2D position)
@@ -1410,13 +1499,11 @@ StateMachineInstance::StateMachineInstance(const StateMachine* machine,
                 // Sanity check.
                 break;
         }
-#ifdef WITH_RIVE_TOOLS
         auto instance = m_inputInstances[i];
         if (instance != nullptr)
         {
             instance->m_index = i;
         }
-#endif
     }
 
     m_layerCount = machine->layerCount();
@@ -1459,6 +1546,7 @@ StateMachineInstance::StateMachineInstance(const StateMachine* machine,
                 bindablePropertyClone = bindablePropertyInstance->second;
             }
             dataBindClone->target(bindablePropertyClone);
+            bindablePropertyClone->observe(this, bindableProperty);
             // We are only storing in this unordered map data binds that are
             // targetting the source. For now, this is only the case for
             // listener actions.
@@ -1479,6 +1567,7 @@ StateMachineInstance::StateMachineInstance(const StateMachine* machine,
             dataBindClone->target(dataBind->target());
         }
     }
+    m_dataBindQueue.attach(m_dataBinds);
 
     // Initialize listeners. Store a lookup table of shape id to hit shape
     // representation (an object that stores all the listeners triggered by the
@@ -1587,11 +1676,16 @@ StateMachineInstance::StateMachineInstance(const StateMachine* machine,
             this);
         m_hitComponents.push_back(std::move(hc));
     }
+    for (const auto& hitComponent : m_hitComponents)
+    {
+        m_hitGrid.add(hitComponent.get());
+    }
     sortHitComponents();
 }
 
 StateMachineInstance::~StateMachineInstance()
 {
+    m_dataBindQueue.detach();
     clearDataContext();
     for (auto inst : m_inputInstances)
     {
@@ -1679,18 +1773,7 @@ void StateMachineInstance::sortHitComponents()
     }
 }
 
-void StateMachineInstance::updateDataBinds()
-{
-    for (auto dataBind : m_dataBinds)
-    {
-        auto d = dataBind->dirt();
-        if (d != ComponentDirt::None)
-        {
-            dataBind->dirt(ComponentDirt::None);
-            dataBind->update(d);
-        }
-    }
-}
+void StateMachineInstance::updateDataBinds() { m_dataBindQueue.update(false); }
 
 bool StateMachineInstance::tryChangeState()
 {
@@ -1728,12 +1811,9 @@ bool StateMachineInstance::advance(float seconds, bool newFrame)
         }
     }
 
-    for (auto& dataBind : m_dataBinds)
+    if (m_dataBindQueue.advance(seconds))
     {
-        if (dataBind->advance(seconds))
-        {
-            m_needsAdvance = true;
-        }
+        m_needsAdvance = true;
     }
 
     for (auto inst : m_inputInstances)
@@ -1741,6 +1821,12 @@ bool StateMachineInstance::advance(float seconds, bool newFrame)
         inst->advanced();
     }
 
+    if (m_needsAdvance)
+    {
+        // Applied values can change render objects without dirtying the
+        // artboard, so its display list can't be replayed.
+        m_artboardInstance->markDrawChanged();
+    }
     return m_needsAdvance || !m_reportedEvents.empty();
 }
 
@@ -1754,6 +1840,7 @@ void StateMachineInstance::advancedDataContext()
 
 bool StateMachineInstance::advanceAndApply(float seconds)
 {
+    RIVE_PROF_SCOPENAME("StateMachineInstance::advanceAndApply");
     bool keepGoing = this->advance(seconds, true);
     if (m_artboardInstance->advanceInternal(
             seconds,
@@ -1795,6 +1882,23 @@ bool StateMachineInstance::advanceAndApply(float seconds)
 }
 
 void StateMachineInstance::markNeedsAdvance() { m_needsAdvance = true; }
+
+void StateMachineInstance::inputChanged(size_t index)
+{
+    for (size_t i = 0; i < m_layerCount; i++)
+    {
+        m_layers[i].inputChanged(static_cast<uint32_t>(index));
+    }
+}
+
+void StateMachineInstance::bindablePropertyChanged(
+    const BindableProperty* original)
+{
+    for (size_t i = 0; i < m_layerCount; i++)
+    {
+        m_layers[i].propertyChanged(original);
+    }
+}
 bool StateMachineInstance::needsAdvance() const { return m_needsAdvance; }
 
 std::string StateMachineInstance::name() const { return m_machine->name(); }
@@ -156,6 +156,7 @@ AllowTransition StateTransition::allowed(
 
     for (auto condition : m_Conditions)
     {
+        stateMachineInstance->m_transitionCounters.conditionsEvaluated++;
         if (!condition->evaluate(stateMachineInstance, layerInstance))
         {
             return AllowTransition::no;
@@ -2,6 +2,7 @@
 #include "rive/artboard_component_list.hpp"
 #include "rive/backboard.hpp"
 #include "rive/animation/linear_animation_instance.hpp"
+#include "rive/animation/compiled_linear_animation.hpp"
 #include "rive/dependency_sorter.hpp"
 #include "rive/data_bind/data_bind.hpp"
 #include "rive/data_bind/data_bind_context.hpp"
@@ -33,7 +34,10 @@
 #include "rive/event.hpp"
 #include "rive/assets/audio_asset.hpp"
 #include "rive/layout/layout_data.hpp"
+#include "rive/profiler/profiler.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <unordered_map>
 
 using namespace rive;
@@ -60,6 +64,7 @@ Artboard::~Artboard()
         audioEngine->stop(this);
     }
 #endif
+    m_dataBindQueue.detach();
     clearDataContext();
     for (auto object : m_Objects)
     {
@@ -334,9 +339,35 @@ StatusCode Artboard::initialize()
             }
         }
     }
+    size_t drawableObjects = m_Drawables.size();
+    if (m_topology != nullptr &&
+        m_topology->drawableObjects == drawableObjects)
+    {
+        // Same objects as the source, so the proxies land in the same spots.
+        std::vector<Drawable*> drawables;
+        drawables.reserve(m_topology->drawables.size());
+        for (auto index : m_topology->drawables)
+        {
+            Core* object = topologyObject(index);
+            if (object == nullptr || !object->is<Drawable>())
+            {
+                m_topology = nullptr;
+                break;
+            }
+            drawables.push_back(object->as<Drawable>());
+        }
+        if (m_topology != nullptr)
+        {
+            m_Drawables = std::move(drawables);
+        }
+    }
+    else
+    {
+        m_topology = nullptr;
+    }
     // Iterate over the drawables in order to inject proxies for layouts
     std::vector<LayoutComponent*> layouts;
-    for (int i = 0; i < m_Drawables.size(); i++)
+    for (int i = 0; m_topology == nullptr && i < m_Drawables.size(); i++)
     {
         auto drawable = m_Drawables[i];
         LayoutComponent* currentLayout = nullptr;
@@ -378,7 +409,12 @@ StatusCode Artboard::initialize()
         layouts.pop_back();
     }
 
-    sortDependencies();
+    if (m_topology == nullptr || !applyTopologyDependencyOrder())
+    {
+        m_topology = nullptr;
+        sortDependencies();
+    }
+    queueDirtyComponents();
 
     std::vector<DrawRules*> rulesList;
     // Build the rules in the right order. We use the map componentDrawRules
@@ -434,9 +470,165 @@ StatusCode Artboard::initialize()
     {
         m_DrawTargets.push_back(static_cast<DrawTarget*>(*itr++));
     }
+    if (!isInstance())
+    {
+        captureTopology(drawableObjects);
+    }
     return StatusCode::Ok;
 }
 
+Core* Artboard::topologyObject(uint32_t index) const
+{
+    Core* object = m_Objects[index & Topology::indexMask];
+    if (object == nullptr)
+    {
+        return nullptr;
+    }
+    if ((index & Topology::layoutProxyFlag) != 0)
+    {
+        return object->is<LayoutComponent>()
+                   ? object->as<LayoutComponent>()->proxy()
+                   : nullptr;
+    }
+    if ((index & Topology::pathComposerFlag) != 0)
+    {
+        return object->is<Shape>() ? object->as<Shape>()->pathComposer()
+                                   : nullptr;
+    }
+    return object;
+}
+
+void Artboard::captureTopology(size_t drawableObjects)
+{
+    m_topology = nullptr;
+    m_ownedTopology = nullptr;
+    if (m_Objects.empty() || m_Objects[0] != this ||
+        m_Objects.size() > Topology::indexMask)
+    {
+        return;
+    }
+
+    std::unordered_map<const Core*, uint32_t> indices;
+    indices.reserve(m_Objects.size());
+    for (uint32_t i = 0; i < m_Objects.size(); i++)
+    {
+        auto object = m_Objects[i];
+        if (object == nullptr)
+        {
+            continue;
+        }
+        indices[object] = i;
+        if (object->is<LayoutComponent>())
+        {
+            indices[object->as<LayoutComponent>()->proxy()] =
+                i | Topology::layoutProxyFlag;
+        }
+        if (object->is<Shape>())
+        {
+            indices[object->as<Shape>()->pathComposer()] =
+                i | Topology::pathComposerFlag;
+        }
+    }
+
+    auto topology = rivestd::make_unique<Topology>();
+    topology->dependencyOrder.reserve(m_DependencyOrder.size());
+    for (auto component : m_DependencyOrder)
+    {
+        auto itr = indices.find(component);
+        if (itr == indices.end())
+        {
+            return;
+        }
+        topology->dependencyOrder.push_back(itr->second);
+        topology->dependencyEdges += component->dependents().size();
+    }
+
+    topology->drawables.reserve(m_Drawables.size());
+    for (auto drawable : m_Drawables)
+    {
+        auto itr = indices.find(drawable);
+        if (itr == indices.end())
+        {
+            return;
+        }
+        topology->drawables.push_back(itr->second);
+    }
+    topology->drawableObjects = drawableObjects;
+
+    // cloneObjectDataBinds visits objects in order and, for each, the data
+    // binds targeting it in order. Null targets match every null object.
+    for (uint32_t i = 0; i < m_DataBinds.size(); i++)
+    {
+        auto target = m_DataBinds[i]->target();
+        if (target == nullptr)
+        {
+            for (uint32_t j = 0; j < m_Objects.size(); j++)
+            {
+                if (m_Objects[j] == nullptr)
+                {
+                    topology->dataBinds.emplace_back(j, i);
+                }
+            }
+            continue;
+        }
+        auto itr = indices.find(target);
+        if (itr != indices.end() && (itr->second & ~Topology::indexMask) == 0)
+        {
+            topology->dataBinds.emplace_back(itr->second, i);
+        }
+    }
+    std::stable_sort(topology->dataBinds.begin(),
+                     topology->dataBinds.end(),
+                     [](const std::pair<uint32_t, uint32_t>& a,
+                        const std::pair<uint32_t, uint32_t>& b) {
+                         return a.first < b.first;
+                     });
+
+    m_ownedTopology = std::move(topology);
+    m_topology = m_ownedTopology.get();
+}
+
+bool Artboard::applyTopologyDependencyOrder()
+{
+    const auto& order = m_topology->dependencyOrder;
+    m_DependencyOrder.resize(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        Core* object = topologyObject(order[i]);
+        if (object == nullptr || !object->is<Component>())
+        {
+            return false;
+        }
+        Component* component = object->as<Component>();
+        component->m_GraphOrder = static_cast<unsigned int>(i);
+        m_DependencyOrder[i] = component;
+    }
+
+    // The order is only reusable if every dependent edge still points
+    // forward into it and there are as many edges as the source sorted.
+    size_t edges = 0;
+    for (auto component : m_DependencyOrder)
+    {
+        for (auto dependent : component->dependents())
+        {
+            unsigned int graphOrder = dependent->m_GraphOrder;
+            if (graphOrder <= component->m_GraphOrder ||
+                graphOrder >= m_DependencyOrder.size() ||
+                m_DependencyOrder[graphOrder] != dependent)
+            {
+                return false;
+            }
+        }
+        edges += component->dependents().size();
+    }
+    if (edges != m_topology->dependencyEdges)
+    {
+        return false;
+    }
+    m_Dirt |= ComponentDirt::Components;
+    return true;
+}
+
 void Artboard::sortDrawOrder()
 {
     m_drawOrderChangeCounter =
@@ -543,6 +735,21 @@ void Artboard::sortDependencies()
     m_Dirt |= ComponentDirt::Components;
 }
 
+void Artboard::queueDirtyComponents()
+{
+    m_dirtyComponents = {};
+    m_deferredComponents.clear();
+    m_queuedComponents.assign(m_DependencyOrder.size(), false);
+    for (unsigned int i = 0; i < m_DependencyOrder.size(); i++)
+    {
+        if (m_DependencyOrder[i]->m_Dirt != ComponentDirt::None)
+        {
+            m_queuedComponents[i] = true;
+            m_dirtyComponents.push(i);
+        }
+    }
+}
+
 void Artboard::addObject(Core* object) { m_Objects.push_back(object); }
 
 void Artboard::addAnimation(LinearAnimation* object)
@@ -581,19 +788,25 @@ uint32_t Artboard::idOf(Core* object) const
 void Artboard::onComponentDirty(Component* component)
 {
     m_Dirt |= ComponentDirt::Components;
+    markDrawChanged();
 
-    /// If the order of the component is less than the current dirt
-    /// depth, update the dirt depth so that the update loop can break
-    /// out early and re-run (something up the tree is dirty).
-    if (component->graphOrder() < m_DirtDepth)
+    /// Queue the component for the next update pass. Components that aren't
+    /// in the dependency order yet are queued by queueDirtyComponents once
+    /// it's sorted.
+    unsigned int graphOrder = component->graphOrder();
+    if (graphOrder < m_queuedComponents.size() &&
+        m_DependencyOrder[graphOrder] == component &&
+        !m_queuedComponents[graphOrder])
     {
-        m_DirtDepth = component->graphOrder();
+        m_queuedComponents[graphOrder] = true;
+        m_dirtyComponents.push(graphOrder);
     }
 }
 
 void Artboard::onDirty(ComponentDirt dirt)
 {
     m_Dirt |= ComponentDirt::Components;
+    markDrawChanged();
 }
 
 #ifdef WITH_RIVE_LAYOUT
@@ -618,6 +831,21 @@ bool Artboard::sharesLayoutWithHost() const
     return m_host != nullptr && m_host->isLayoutProvider();
 }
 
+static DataBind* cloneDataBindWithTarget(const DataBind* dataBind,
+                                         Core* target)
+{
+    auto dataBindClone = static_cast<DataBind*>(dataBind->clone());
+    dataBindClone->target(target);
+    dataBindClone->file(dataBind->file());
+    if (dataBind->converter() != nullptr)
+    {
+
+        dataBindClone->converter(
+            dataBind->converter()->clone()->as<DataConverter>());
+    }
+    return dataBindClone;
+}
+
 void Artboard::cloneObjectDataBinds(const Core* object,
                                     Core* clone,
                                     Artboard* artboard) const
@@ -627,22 +855,60 @@ void Artboard::cloneObjectDataBinds(const Core* object,
     {
         if (dataBind->target() == object)
         {
-            auto dataBindClone = static_cast<DataBind*>(dataBind->clone());
-            dataBindClone->target(clone);
-            dataBindClone->file(dataBind->file());
-            if (dataBind->converter() != nullptr)
-            {
+            artboard->m_DataBinds.push_back(
+                cloneDataBindWithTarget(dataBind, clone));
+        }
+    }
+}
 
-                dataBindClone->converter(
-                    dataBind->converter()->clone()->as<DataConverter>());
-            }
-            artboard->m_DataBinds.push_back(dataBindClone);
+void Artboard::cloneObjects(Artboard* artboard) const
+{
+    const Topology* topology = m_forceFullInstancing ? nullptr : m_topology;
+    artboard->m_topology = topology;
+    artboard->m_objectArena = rivestd::make_unique<CoreArena>(
+        topology != nullptr
+            ? topology->arenaBytes.load(std::memory_order_relaxed)
+            : 0);
+    CoreArena::Scope arenaScope(artboard->m_objectArena.get());
+
+    std::vector<Core*>& cloneObjects = artboard->m_Objects;
+    cloneObjects.reserve(std::max<size_t>(m_Objects.size(), 1));
+    cloneObjects.push_back(artboard);
+    if (topology == nullptr)
+    {
+        cloneObjectDataBinds(this, artboard, artboard);
+    }
+
+    // Skip first object (artboard).
+    for (size_t i = 1; i < m_Objects.size(); i++)
+    {
+        auto object = m_Objects[i];
+        cloneObjects.push_back(object == nullptr ? nullptr : object->clone());
+        if (topology == nullptr)
+        {
+            // For each object, clone its data bind objects and target their
+            // clones
+            cloneObjectDataBinds(object, cloneObjects.back(), artboard);
+        }
+    }
+
+    if (topology != nullptr)
+    {
+        artboard->m_DataBinds.reserve(topology->dataBinds.size());
+        for (const auto& entry : topology->dataBinds)
+        {
+            artboard->m_DataBinds.push_back(
+                cloneDataBindWithTarget(m_DataBinds[entry.second],
+                                        cloneObjects[entry.first]));
         }
+        topology->arenaBytes.store(artboard->m_objectArena->bytesAllocated(),
+                                   std::memory_order_relaxed);
     }
 }
 void Artboard::host(ArtboardHost* artboardHost)
 {
     m_host = artboardHost;
+    markDrawChanged();
 #ifdef WITH_RIVE_LAYOUT
     if (!sharesLayoutWithHost())
     {
@@ -747,29 +1013,13 @@ void Artboard::update(ComponentDirt value)
         // point, it seems redundant.
         if (syncStyleChanges() && (m_updatesOwnLayout || cascadeChanged))
         {
-            calculateLayout();
-            updateLayoutBounds(
-                /*animation*/ true); // maybe use a static to allow
-                                     // the editor to set this.
+            updateLayout();
         }
     }
 #endif
 }
 
-void Artboard::updateDataBinds()
-{
-    for (auto dataBind : m_AllDataBinds)
-    {
-        dataBind->updateSourceBinding();
-        auto d = dataBind->dirt();
-        if (d == ComponentDirt::None)
-        {
-            continue;
-        }
-        dataBind->dirt(ComponentDirt::None);
-        dataBind->update(d);
-    }
-}
+void Artboard::updateDataBinds() { m_dataBindQueue.update(true); }
 
 bool Artboard::updateComponents()
 {
@@ -779,17 +1029,36 @@ bool Artboard::updateComponents()
     }
     const int maxSteps = 100;
     int step = 0;
-    auto count = m_DependencyOrder.size();
     while (hasDirt(ComponentDirt::Components) && step < maxSteps)
     {
         m_Dirt = m_Dirt & ~ComponentDirt::Components;
 
-        // Track dirt depth here so that if something else marks
-        // dirty, we restart.
-        for (unsigned int i = 0; i < count; i++)
+        // Update the queued components in DAG order. If an update adds dirt
+        // to something before it, early out and re-run from there in the
+        // next step. Components that dirty themselves also wait for the
+        // next step.
+        bool visitedAny = false;
+        unsigned int last = 0;
+        while (!m_dirtyComponents.empty())
         {
+            unsigned int i = m_dirtyComponents.top();
+            if (visitedAny && i <= last)
+            {
+                if (i < last)
+                {
+                    break;
+                }
+                m_dirtyComponents.pop();
+                m_deferredComponents.push_back(i);
+                continue;
+            }
+            m_dirtyComponents.pop();
+            m_queuedComponents[i] = false;
+            visitedAny = true;
+            last = i;
+            m_updateCounters.componentsVisited++;
+
             auto component = m_DependencyOrder[i];
-            m_DirtDepth = i;
             auto d = component->m_Dirt;
             if (d == ComponentDirt::None ||
                 (d & ComponentDirt::Collapsed) == ComponentDirt::Collapsed)
@@ -798,15 +1067,13 @@ bool Artboard::updateComponents()
             }
             component->m_Dirt = ComponentDirt::None;
             component->update(d);
-
-            // If the update changed the dirt depth by adding dirt
-            // to something before us (in the DAG), early out and
-            // re-run the update.
-            if (m_DirtDepth < i)
-            {
-                break;
-            }
+            m_updateCounters.componentsUpdated++;
         }
+        for (auto i : m_deferredComponents)
+        {
+            m_dirtyComponents.push(i);
+        }
+        m_deferredComponents.clear();
         step++;
     }
     return true;
@@ -920,15 +1187,35 @@ bool Artboard::syncStyleChanges()
     return updated;
 }
 
+#ifdef WITH_RIVE_LAYOUT
+void Artboard::updateLayout()
+{
+    RIVE_PROF_SCOPENAME("Artboard::updateLayout");
+    auto start = std::chrono::steady_clock::now();
+    if (calculateLayout())
+    {
+        m_layoutCounters.passes++;
+        updateLayoutBounds(/*animation*/ true); // maybe use a static to allow
+                                                // the editor to set this.
+    }
+    else
+    {
+        m_layoutCounters.skippedPasses++;
+    }
+    m_layoutCounters.seconds += std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+}
+#endif
+
 bool Artboard::updatePass(bool isRoot)
 {
+    RIVE_PROF_SCOPENAME("Artboard::updatePass");
     bool didUpdate = false;
 #ifdef WITH_RIVE_LAYOUT
     if (syncStyleChanges() && m_updatesOwnLayout)
     {
-        calculateLayout();
-        updateLayoutBounds(/*animation*/ true); // maybe use a static to allow
-                                                // the editor to set this.
+        updateLayout();
     }
 #endif
     if (m_JoysticksApplyBeforeUpdate)
@@ -978,12 +1265,15 @@ bool Artboard::advanceInternal(float elapsedSeconds, AdvanceFlags flags)
             didUpdate = true;
         }
     }
-    for (auto dataBind : m_AllDataBinds)
+    if (m_dataBindQueue.advance(elapsedSeconds))
     {
-        if (dataBind->advance(elapsedSeconds))
-        {
-            didUpdate = true;
-        }
+        didUpdate = true;
+    }
+    if (didUpdate)
+    {
+        // Advancing can change render objects without dirtying anything,
+        // e.g. a paint's color.
+        markDrawChanged();
     }
 
     return didUpdate;
@@ -1044,6 +1334,149 @@ Core* Artboard::hitTest(HitInfo* hinfo, const Mat2D& xform)
 void Artboard::draw(Renderer* renderer) { draw(renderer, DrawOption::kNormal); }
 
 void Artboard::draw(Renderer* renderer, DrawOption option)
+{
+    RIVE_PROF_SCOPENAME("Artboard::draw");
+    bool changed = m_drawChanged;
+    m_drawChanged = false;
+    if (changed || m_forceDrawTraversal)
+    {
+        m_displayList = nullptr;
+    }
+    if (m_displayList != nullptr && m_displayListOption == option)
+    {
+        m_displayList->replay(renderer);
+        m_displayListCounters.drawsReplayed++;
+        m_cullingCounters.drawablesDrawn +=
+            m_displayListCulling.drawablesDrawn;
+        m_cullingCounters.drawablesCulled +=
+            m_displayListCulling.drawablesCulled;
+    }
+    else if (!changed && !m_forceDrawTraversal)
+    {
+        // Nothing changed since the last draw, so this one is likely to be
+        // repeated: record it while drawing it.
+        CullingCounters before = m_cullingCounters;
+        RecordingRenderer recorder(renderer);
+        drawTraversal(&recorder, option);
+        m_displayList = recorder.finish();
+        m_displayListOption = option;
+        m_displayListCounters.drawsRecorded++;
+        m_displayListCulling.drawablesDrawn =
+            m_cullingCounters.drawablesDrawn - before.drawablesDrawn;
+        m_displayListCulling.drawablesCulled =
+            m_cullingCounters.drawablesCulled - before.drawablesCulled;
+    }
+    else
+    {
+        drawTraversal(renderer, option);
+        m_displayListCounters.drawsTraversed++;
+    }
+}
+
+void Artboard::markDrawChanged()
+{
+    for (Artboard* artboard = this; artboard != nullptr;
+         artboard = artboard->parentArtboard())
+    {
+        artboard->m_drawChanged = true;
+        artboard->m_drawBoundsStale = true;
+    }
+}
+
+void Artboard::viewport(const AABB& value)
+{
+    if (m_hasViewport && m_viewport == value)
+    {
+        return;
+    }
+    m_hasViewport = true;
+    m_viewport = value;
+    // Only this artboard's draw changes: whatever set the viewport either
+    // hosts it or is the parent drawing it right now.
+    m_drawChanged = true;
+}
+
+void Artboard::clearViewport()
+{
+    if (!m_hasViewport)
+    {
+        return;
+    }
+    m_hasViewport = false;
+    m_drawChanged = true;
+}
+
+void Artboard::viewportFromHost(const Artboard* host, const Mat2D& transform)
+{
+    // An artboard clipping to bounds inside the region has nothing to cull,
+    // and keeps replaying its display list while the region moves around
+    // it.
+    AABB region;
+    bool culls = host->cullRegion(&region);
+    if (culls)
+    {
+        region = transform.invertOrIdentity().mapBoundingBox(region);
+        AABB clipBounds = bounds();
+        culls = !clip() || region.minX > clipBounds.minX ||
+                region.minY > clipBounds.minY ||
+                region.maxX < clipBounds.maxX || region.maxY < clipBounds.maxY;
+    }
+    if (culls)
+    {
+        viewport(region);
+    }
+    else
+    {
+        clearViewport();
+    }
+}
+
+void Artboard::forceDrawAll(bool value)
+{
+    if (m_forceDrawAll != value)
+    {
+        m_forceDrawAll = value;
+        markDrawChanged();
+    }
+}
+
+bool Artboard::cullRegion(AABB* region) const
+{
+    // Without a viewport, whatever is drawn may be shown, and whatever a clip
+    // hides the renderer discards anyway, so nothing is worth the bounds.
+    if (m_forceDrawAll || !m_hasViewport)
+    {
+        return false;
+    }
+    AABB drawRegion = m_viewport;
+    if (clip())
+    {
+        // Disjoint bounds leave an inverted region, culling everything.
+        AABB clipBounds = bounds();
+        drawRegion = AABB(std::max(drawRegion.minX, clipBounds.minX),
+                          std::max(drawRegion.minY, clipBounds.minY),
+                          std::min(drawRegion.maxX, clipBounds.maxX),
+                          std::min(drawRegion.maxY, clipBounds.maxY));
+    }
+    // Drawables are drawn after the translation to the frame origin.
+    *region = m_FrameOrigin ? drawRegion.offset(-layoutWidth() * originX(),
+                                                -layoutHeight() * originY())
+                            : drawRegion;
+    return true;
+}
+
+void Artboard::updateDrawBounds()
+{
+    RIVE_PROF_SCOPENAME("Artboard::updateDrawBounds");
+    for (auto drawable : m_Drawables)
+    {
+        drawable->m_hasDrawBounds =
+            drawable->computeDrawBounds(&drawable->m_drawBounds);
+    }
+    m_drawBoundsStale = false;
+}
+
+void Artboard::drawTraversal(Renderer* renderer, DrawOption option)
 {
     if (renderOpacity() == 0)
     {
@@ -1086,6 +1519,12 @@ void Artboard::draw(Renderer* renderer, DrawOption option)
 
     if (option != DrawOption::kHideFG)
     {
+        AABB region;
+        bool culls = cullRegion(&region);
+        if (culls && m_drawBoundsStale)
+        {
+            updateDrawBounds();
+        }
         for (auto drawable = m_FirstDrawable; drawable != nullptr;
              drawable = drawable->prev)
         {
@@ -1093,7 +1532,17 @@ void Artboard::draw(Renderer* renderer, DrawOption option)
             {
                 continue;
             }
+            // Comparisons with NaN bounds fail, keeping the drawable.
+            const AABB& bounds = drawable->m_drawBounds;
+            if (culls && drawable->m_hasDrawBounds &&
+                (bounds.maxX < region.minX || bounds.minX > region.maxX ||
+                 bounds.maxY < region.minY || bounds.minY > region.maxY))
+            {
+                m_cullingCounters.drawablesCulled++;
+                continue;
+            }
             drawable->draw(renderer);
+            m_cullingCounters.drawablesDrawn++;
         }
     }
     if (save)
@@ -1421,7 +1870,7 @@ void Artboard::clearDataContext()
     }
 }
 
-void Artboard::sortDataBinds()
+size_t Artboard::sortDataBinds()
 {
     size_t currentToSourceIndex = 0;
     for (size_t i = 0; i < m_AllDataBinds.size(); i++)
@@ -1437,6 +1886,7 @@ void Artboard::sortDataBinds()
             currentToSourceIndex += 1;
         }
     }
+    return currentToSourceIndex;
 }
 
 float Artboard::volume() const { return m_volume; }
@@ -1472,7 +1922,7 @@ void Artboard::collectDataBinds()
 {
     m_AllDataBinds.clear();
     populateDataBinds(&m_AllDataBinds);
-    sortDataBinds();
+    m_dataBindQueue.attach(m_AllDataBinds, sortDataBinds());
 }
 
 void Artboard::addDataBind(DataBind* dataBind)
@@ -1519,11 +1969,133 @@ void Artboard::bindViewModelInstance(rcp<ViewModelInstance> viewModelInstance,
 
 #include "rive/animation/linear_animation_instance.hpp"
 #include "rive/animation/state_machine_instance.hpp"
+#include "rive/animation/keyed_property.hpp"
+#include "rive/animation/keyframe_bool.hpp"
+#include "rive/animation/keyframe_color.hpp"
+#include "rive/animation/keyframe_double.hpp"
+#include "rive/animation/keyframe_id.hpp"
+#include "rive/animation/keyframe_string.hpp"
+#include "rive/animation/keyframe_uint.hpp"
+#include "rive/generated/core_registry.hpp"
 
 ArtboardInstance::ArtboardInstance() {}
 
 ArtboardInstance::~ArtboardInstance() {}
 
+const CompiledLinearAnimation* ArtboardInstance::compiledAnimation(
+    const LinearAnimation* animation)
+{
+    auto itr = m_compiledAnimations.find(animation);
+    if (itr != m_compiledAnimations.end())
+    {
+        return itr->second.get();
+    }
+    auto compiled =
+        rivestd::make_unique<CompiledLinearAnimation>(animation, this);
+    auto result = compiled.get();
+    m_compiledAnimations[animation] = std::move(compiled);
+    return result;
+}
+
+// Copies property from setup to object, skipping values that already match
+// so unchanged properties don't dirty anything. Bool and id fields share a
+// field type, so the keyframes tell which one the property holds.
+static void resetProperty(Core* object,
+                          Core* setup,
+                          const KeyedProperty* property)
+{
+    int key = property->propertyKey();
+    KeyFrame* keyFrame = property->first();
+    if (keyFrame == nullptr)
+    {
+        return;
+    }
+    if (keyFrame->is<KeyFrameDouble>())
+    {
+        float value = CoreRegistry::getDouble(setup, key);
+        if (CoreRegistry::getDouble(object, key) != value)
+        {
+            CoreRegistry::setDouble(object, key, value);
+        }
+    }
+    else if (keyFrame->is<KeyFrameColor>())
+    {
+        int value = CoreRegistry::getColor(setup, key);
+        if (CoreRegistry::getColor(object, key) != value)
+        {
+            CoreRegistry::setColor(object, key, value);
+        }
+    }
+    else if (keyFrame->is<KeyFrameBool>())
+    {
+        bool value = CoreRegistry::getBool(setup, key);
+        if (CoreRegistry::getBool(object, key) != value)
+        {
+            CoreRegistry::setBool(object, key, value);
+        }
+    }
+    else if (keyFrame->is<KeyFrameId>() || keyFrame->is<KeyFrameUint>())
+    {
+        uint32_t value = CoreRegistry::getUint(setup, key);
+        if (CoreRegistry::getUint(object, key) != value)
+        {
+            CoreRegistry::setUint(object, key, value);
+        }
+    }
+    else if (keyFrame->is<KeyFrameString>())
+    {
+        std::string value = CoreRegistry::getString(setup, key);
+        if (CoreRegistry::getString(object, key) != value)
+        {
+            CoreRegistry::setString(object, key, value);
+        }
+    }
+}
+
+void ArtboardInstance::resetToSetupPose(const Artboard* source)
+{
+    for (size_t a = 0; a < animationCount(); a++)
+    {
+        const LinearAnimation* animation = this->animation(a);
+        for (size_t i = 0; i < animation->numKeyedObjects(); i++)
+        {
+            const KeyedObject* keyedObject = animation->getObject(i);
+            Core* object = resolve(keyedObject->objectId());
+            Core* setup = source->resolve(keyedObject->objectId());
+            if (object == nullptr || setup == nullptr)
+            {
+                continue;
+            }
+            for (size_t j = 0; j < keyedObject->numKeyedProperties(); j++)
+            {
+                resetProperty(object, setup, keyedObject->getProperty(j));
+            }
+        }
+    }
+
+    // Nested artboards are cloned in the source's order.
+    auto nested = nestedArtboards();
+    auto sourceNested = source->nestedArtboards();
+    if (nested.size() != sourceNested.size())
+    {
+        return;
+    }
+    for (size_t i = 0; i < nested.size(); i++)
+    {
+        auto nestedInstance = nested[i]->artboardInstance();
+        auto nestedSource = sourceNested[i]->sourceArtboard();
+        if (nestedInstance == nullptr || nestedSource == nullptr)
+        {
+            continue;
+        }
+        nestedInstance->resetToSetupPose(nestedSource);
+        for (auto nestedAnimation : nested[i]->nestedAnimations())
+        {
+            nestedAnimation->initializeAnimation(nestedInstance);
+        }
+    }
+}
+
 std::unique_ptr<LinearAnimationInstance> ArtboardInstance::animationAt(
     size_t index)
 {
@@ -11,6 +11,18 @@ using namespace rive;
 ArtboardComponentList::ArtboardComponentList() {}
 ArtboardComponentList::~ArtboardComponentList() { reset(); }
 
+ArtboardComponentList::VirtualizedItem::~VirtualizedItem()
+{
+#ifdef WITH_RIVE_TOOLS
+    if (layoutData != nullptr)
+    {
+        layoutData->unref();
+    }
+#else
+    delete layoutData;
+#endif
+}
+
 void ArtboardComponentList::reset()
 {
     for (auto& artboard : m_artboardInstancesMap)
@@ -27,13 +39,64 @@ void ArtboardComponentList::reset()
     }
     m_artboardInstancesMap.clear();
     m_stateMachinesMap.clear();
+    m_recycledInstances.clear();
+    m_virtualizedItems.clear();
     m_listItems.clear();
     m_artboardsMap.clear();
 }
 
+void ArtboardComponentList::virtualize(bool value)
+{
+    if (m_virtualized == value)
+    {
+        return;
+    }
+    // Start over with the same items, so they get instanced (or not) the way
+    // the new mode does it.
+    std::vector<ViewModelInstanceListItem*> items(m_listItems);
+    for (auto item : items)
+    {
+        item->ref();
+    }
+#ifdef WITH_RIVE_LAYOUT
+    // Detach the layout nodes before reset() frees them.
+    if (parent() != nullptr && parent()->is<LayoutComponent>())
+    {
+        parent()->as<LayoutComponent>()->clearLayoutChildren();
+    }
+#endif
+    reset();
+    m_virtualized = value;
+    updateList(listSourcePropertyKey, &items);
+    for (auto item : items)
+    {
+        item->unref();
+    }
+}
+
+size_t ArtboardComponentList::recycledCount() const
+{
+    size_t count = 0;
+    for (auto& pool : m_recycledInstances)
+    {
+        count += pool.second.size();
+    }
+    return count;
+}
+
 #ifdef WITH_RIVE_LAYOUT
 void* ArtboardComponentList::layoutNode(int index)
 {
+    if (m_virtualized)
+    {
+        auto itr = m_virtualizedItems.find(listItem(index));
+        if (itr != m_virtualizedItems.end() &&
+            itr->second->layoutData != nullptr)
+        {
+            return static_cast<void*>(&itr->second->layoutData->node);
+        }
+        return nullptr;
+    }
     auto artboard = artboardInstance(index);
     if (artboard != nullptr)
     {
@@ -64,6 +127,28 @@ void ArtboardComponentList::markLayoutNodeDirty(
 void ArtboardComponentList::updateLayoutBounds(bool animate)
 {
 #ifdef WITH_RIVE_LAYOUT
+    if (m_virtualized)
+    {
+        // The instances lay themselves out, their place comes from the
+        // placeholders.
+        for (auto& entry : m_virtualizedItems)
+        {
+            YGNode& node = entry.second->layoutData->node;
+            if (!node.getHasNewLayout())
+            {
+                continue;
+            }
+            node.setHasNewLayout(false);
+            auto layout = node.getLayout();
+            entry.second->bounds =
+                AABB::fromLTWH(layout.position[YGEdgeLeft],
+                               layout.position[YGEdgeTop],
+                               layout.dimensions[YGDimensionWidth],
+                               layout.dimensions[YGDimensionHeight]);
+            entry.second->hasLayout = true;
+        }
+        return;
+    }
     for (int i = 0; i < artboardCount(); i++)
     {
         auto artboard = artboardInstance(i);
@@ -77,6 +162,12 @@ void ArtboardComponentList::updateLayoutBounds(bool animate)
 
 bool ArtboardComponentList::syncStyleChanges()
 {
+    if (m_virtualized)
+    {
+        // Instances of a virtualized list sync their own styles when they
+        // advance.
+        return false;
+    }
     bool changed = false;
     for (int i = 0; i < artboardCount(); i++)
     {
@@ -121,6 +212,12 @@ Artboard* ArtboardComponentList::findArtboard(
 
 void ArtboardComponentList::disposeListItem(ViewModelInstanceListItem* listItem)
 {
+    if (m_virtualized)
+    {
+        recycleListItem(listItem);
+        listItem->unref();
+        return;
+    }
     auto artboard = m_artboardInstancesMap[listItem].get();
     if (artboard != nullptr)
     {
@@ -168,6 +265,50 @@ std::unique_ptr<StateMachineInstance> ArtboardComponentList::
     return nullptr;
 }
 
+std::unique_ptr<ArtboardComponentList::VirtualizedItem> ArtboardComponentList::
+    makeVirtualizedItem(ViewModelInstanceListItem* listItem) const
+{
+    auto item = rivestd::make_unique<VirtualizedItem>();
+    item->artboard = findArtboard(listItem);
+    float width = item->artboard != nullptr ? item->artboard->width() : 0.0f;
+    float height = item->artboard != nullptr ? item->artboard->height() : 0.0f;
+    item->bounds = AABB::fromLTWH(0.0f, 0.0f, width, height);
+#ifdef WITH_RIVE_LAYOUT
+    // The placeholder takes the artboard's design size, whatever its
+    // instance's layout would size it to.
+    item->layoutData = new LayoutData();
+    YGStyle& style = item->layoutData->style;
+    style.dimensions()[YGDimensionWidth] = YGValue{width, YGUnitPoint};
+    style.dimensions()[YGDimensionHeight] = YGValue{height, YGUnitPoint};
+    item->layoutData->node.setStyle(style);
+#endif
+    return item;
+}
+
+#ifndef WITH_RIVE_LAYOUT
+// Without layout there's nothing to place the items, so they're stacked
+// along the parent's main axis.
+void ArtboardComponentList::stackVirtualizedItems()
+{
+    bool isRow = true;
+    if (parent()->is<LayoutComponent>())
+    {
+        isRow = parent()->as<LayoutComponent>()->mainAxisIsRow();
+    }
+    float offset = 0.0f;
+    for (auto listItem : m_listItems)
+    {
+        auto& item = m_virtualizedItems[listItem];
+        float width = item->bounds.width();
+        float height = item->bounds.height();
+        item->bounds = isRow ? AABB::fromLTWH(offset, 0.0f, width, height)
+                             : AABB::fromLTWH(0.0f, offset, width, height);
+        item->hasLayout = true;
+        offset += isRow ? width : height;
+    }
+}
+#endif
+
 void ArtboardComponentList::updateList(
     int propertyKey,
     std::vector<ViewModelInstanceListItem*>* list)
@@ -176,12 +317,20 @@ void ArtboardComponentList::updateList(
     oldItems.assign(m_listItems.begin(), m_listItems.end());
     m_listItems.clear();
     m_listItems.assign(list->begin(), list->end());
+    // Freed once the parent's layout no longer holds their nodes.
+    std::vector<std::unique_ptr<VirtualizedItem>> removedItems;
     for (auto item : oldItems)
     {
         auto it = std::find(m_listItems.begin(), m_listItems.end(), item);
         if (it == m_listItems.end())
         {
             disposeListItem(item);
+            auto virtualized = m_virtualizedItems.find(item);
+            if (virtualized != m_virtualizedItems.end())
+            {
+                removedItems.push_back(std::move(virtualized->second));
+                m_virtualizedItems.erase(virtualized);
+            }
         }
     }
     if (parent()->is<LayoutComponent>())
@@ -204,7 +353,17 @@ void ArtboardComponentList::updateList(
                     index);
             }
         }
-        if (m_artboardInstancesMap[item] == nullptr)
+        if (m_virtualized)
+        {
+            // Items are instanced once they're in view.
+            auto& virtualized = m_virtualizedItems[item];
+            if (virtualized == nullptr)
+            {
+                virtualized = makeVirtualizedItem(item);
+                item->ref();
+            }
+        }
+        else if (m_artboardInstancesMap[item] == nullptr)
         {
             auto artboardCopy = createArtboard(this, item);
             if (artboardCopy != nullptr)
@@ -229,10 +388,163 @@ void ArtboardComponentList::updateList(
         parent()->as<LayoutComponent>()->syncLayoutChildren();
 #endif
     }
+#ifndef WITH_RIVE_LAYOUT
+    if (m_virtualized)
+    {
+        stackVirtualizedItems();
+    }
+#endif
     markLayoutNodeDirty();
     addDirt(ComponentDirt::Components);
 }
 
+AABB ArtboardComponentList::visibleRegion()
+{
+    AABB region = artboard()->bounds();
+    for (auto component = parent(); component != nullptr;
+         component = component->parent())
+    {
+        if (!component->is<LayoutComponent>() || component == artboard())
+        {
+            continue;
+        }
+        auto layout = component->as<LayoutComponent>();
+        if (!layout->clip())
+        {
+            continue;
+        }
+        AABB bounds =
+            layout->worldTransform().mapBoundingBox(layout->localBounds());
+        region = AABB(std::max(region.minX, bounds.minX),
+                      std::max(region.minY, bounds.minY),
+                      std::min(region.maxX, bounds.maxX),
+                      std::min(region.maxY, bounds.maxY));
+    }
+    Mat2D inverse;
+    if (region.width() < 0.0f || region.height() < 0.0f ||
+        !worldTransform().invert(&inverse))
+    {
+        // Nothing is visible.
+        return AABB::forExpansion();
+    }
+    return inverse.mapBoundingBox(region).outset(m_overscan, m_overscan);
+}
+
+void ArtboardComponentList::updateVirtualizedItems()
+{
+    AABB region = visibleRegion();
+    std::vector<ViewModelInstanceListItem*> entering;
+    m_visibleCounts.clear();
+    for (auto listItem : m_listItems)
+    {
+        const VirtualizedItem& item = *m_virtualizedItems[listItem];
+        const AABB& bounds = item.bounds;
+        // Items the layout hasn't placed yet wait for the next advance.
+        bool visible =
+            item.hasLayout && bounds.minX <= region.maxX &&
+            bounds.maxX >= region.minX && bounds.minY <= region.maxY &&
+            bounds.maxY >= region.minY;
+        if (visible)
+        {
+            m_visibleCounts[item.artboard]++;
+        }
+        bool instanced = m_artboardInstancesMap.find(listItem) !=
+                         m_artboardInstancesMap.end();
+        if (visible && !instanced)
+        {
+            entering.push_back(listItem);
+        }
+        else if (!visible && instanced)
+        {
+            recycleListItem(listItem);
+        }
+    }
+    // Items leave first, so entering ones can take their instances.
+    for (auto listItem : entering)
+    {
+        instanceListItem(listItem);
+    }
+    // Keep no more spare instances of an artboard than it has visible items,
+    // enough for all of them to scroll out and be replaced, and free the
+    // rest.
+    for (auto& entry : m_recycledInstances)
+    {
+        auto visibleCount = m_visibleCounts.find(entry.first);
+        size_t keep =
+            visibleCount != m_visibleCounts.end() ? visibleCount->second : 0;
+        auto& pool = entry.second;
+        if (pool.size() > keep)
+        {
+            m_virtualizationCounters.instancesFreed += pool.size() - keep;
+            pool.erase(pool.begin() + keep, pool.end());
+        }
+    }
+    if (!entering.empty())
+    {
+        addDirt(ComponentDirt::Components);
+    }
+}
+
+void ArtboardComponentList::instanceListItem(
+    ViewModelInstanceListItem* listItem)
+{
+    Artboard* source = m_virtualizedItems[listItem]->artboard;
+    if (source == nullptr)
+    {
+        return;
+    }
+    std::unique_ptr<ArtboardInstance> artboardInstance;
+    auto& pool = m_recycledInstances[source];
+    if (!pool.empty())
+    {
+        // Only the clone is worth reusing. Whatever the last item's state
+        // machine animated goes back to the setup pose, and the item gets a
+        // state machine of its own, as it would with a new instance.
+        artboardInstance = std::move(pool.back());
+        pool.pop_back();
+        artboardInstance->resetToSetupPose(source);
+        artboardInstance->bindViewModelInstance(listItem->viewModelInstance(),
+                                                artboard()->dataContext(),
+                                                true);
+        m_virtualizationCounters.itemsRecycled++;
+    }
+    else
+    {
+        artboardInstance = createArtboard(this, listItem);
+        if (artboardInstance == nullptr)
+        {
+            return;
+        }
+        artboardInstance->host(this);
+        m_virtualizationCounters.itemsCreated++;
+    }
+    auto stateMachine =
+        createStateMachineInstance(this, artboardInstance.get());
+    artboardInstance->opacity(renderOpacity());
+    m_artboardInstancesMap[listItem] = std::move(artboardInstance);
+    m_stateMachinesMap[listItem] = std::move(stateMachine);
+}
+
+void ArtboardComponentList::recycleListItem(
+    ViewModelInstanceListItem* listItem)
+{
+    auto artboardItr = m_artboardInstancesMap.find(listItem);
+    if (artboardItr == m_artboardInstancesMap.end())
+    {
+        return;
+    }
+    auto recycled = std::move(artboardItr->second);
+    m_artboardInstancesMap.erase(artboardItr);
+    // The state machine goes with the item, the next one starts its own.
+    m_stateMachinesMap.erase(listItem);
+    // Let go of the item's view model until the next item binds to it.
+    recycled->clearDataContext();
+    // The item isn't drawn anymore.
+    artboard()->markDrawChanged();
+    Artboard* source = m_virtualizedItems[listItem]->artboard;
+    m_recycledInstances[source].push_back(std::move(recycled));
+}
+
 bool ArtboardComponentList::advanceComponent(float elapsedSeconds,
                                              AdvanceFlags flags)
 {
@@ -240,6 +552,10 @@ bool ArtboardComponentList::advanceComponent(float elapsedSeconds,
     {
         return false;
     }
+    if (m_virtualized)
+    {
+        updateVirtualizedItems();
+    }
     bool keepGoing = false;
     bool advanceNested =
         (flags & AdvanceFlags::AdvanceNested) == AdvanceFlags::AdvanceNested;
@@ -300,11 +616,22 @@ AABB ArtboardComponentList::layoutBoundsForNode(int index)
 {
     if (index >= 0 && index < numLayoutNodes())
     {
-        return artboardInstance(index)->layoutBounds();
+        return itemBounds(index);
     }
     return AABB();
 }
 
+AABB ArtboardComponentList::itemBounds(int index)
+{
+    if (m_virtualized)
+    {
+        auto itr = m_virtualizedItems.find(listItem(index));
+        return itr != m_virtualizedItems.end() ? itr->second->bounds : AABB();
+    }
+    auto artboard = artboardInstance(index);
+    return artboard != nullptr ? artboard->layoutBounds() : AABB();
+}
+
 void ArtboardComponentList::markHostingLayoutDirty(
     ArtboardInstance* artboardInstance)
 {
@@ -338,9 +665,14 @@ void ArtboardComponentList::draw(Renderer* renderer)
             if (artboard != nullptr)
             {
                 renderer->save();
-                auto bounds = artboard->layoutBounds();
+                auto bounds = itemBounds(i);
                 auto artboardTransform =
                     Mat2D::fromTranslate(bounds.left(), bounds.top());
+                // Items cull to the part of the host's region they cover,
+                // like nested artboards.
+                artboard->viewportFromHost(
+                    this->artboard(),
+                    worldTransform() * artboardTransform);
                 renderer->transform(artboardTransform);
                 artboard->draw(renderer);
                 renderer->restore();
@@ -429,7 +761,7 @@ bool ArtboardComponentList::worldToLocal(Vec2D world, Vec2D* local, int index)
     {
         return false;
     }
-    auto bounds = artboard->layoutBounds();
+    auto bounds = itemBounds(index);
     auto artboardTransform =
         worldTransform() * Mat2D::fromTranslate(bounds.left(), bounds.top());
     Mat2D toMountedArtboard;
@@ -451,5 +783,7 @@ Core* ArtboardComponentList::clone() const
     auto clone =
         static_cast<ArtboardComponentList*>(ArtboardComponentListBase::clone());
     clone->file(file());
+    clone->m_virtualized = m_virtualized;
+    clone->m_overscan = m_overscan;
     return clone;
 }
\ No newline at end of file
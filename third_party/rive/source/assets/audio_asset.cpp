@@ -16,4 +16,15 @@ bool AudioAsset::decode(SimpleArray<uint8_t>& bytes, Factory* factory)
     return true;
 }
 
+bool AudioAsset::decode(Span<const uint8_t> bytes, Factory* factory)
+{
+#ifdef WITH_RIVE_AUDIO
+    // Reference the bytes, they outlive the File. AudioSource only ever
+    // reads from them.
+    m_audioSource = rcp<AudioSource>(new AudioSource(
+        Span<uint8_t>(const_cast<uint8_t*>(bytes.data()), bytes.size())));
+#endif
+    return true;
+}
+
 std::string AudioAsset::fileExtension() const { return "wav"; }
\ No newline at end of file
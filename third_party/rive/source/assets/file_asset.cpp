@@ -45,6 +45,12 @@ void FileAsset::copyCdnUuid(const FileAssetBase& object)
     assert(false);
 }
 
+bool FileAsset::decode(Span<const uint8_t> bytes, Factory* factory)
+{
+    SimpleArray<uint8_t> ownedBytes(bytes.data(), bytes.size());
+    return decode(ownedBytes, factory);
+}
+
 void FileAsset::decodeCdnUuid(Span<const uint8_t> value)
 {
     m_cdnUuid = std::vector<uint8_t>(value.begin(), value.end());
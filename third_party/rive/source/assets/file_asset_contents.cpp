@@ -21,7 +21,17 @@ StatusCode FileAssetContents::import(ImportStack& importStack)
 
 void FileAssetContents::decodeBytes(Span<const uint8_t> value)
 {
-    m_bytes = SimpleArray<uint8_t>(value.data(), value.size());
+    m_view = value;
+}
+
+void FileAssetContents::ownBytes()
+{
+    if (!isBorrowed())
+    {
+        return;
+    }
+    m_bytes = SimpleArray<uint8_t>(m_view.data(), m_view.size());
+    m_view = m_bytes;
 }
 
 void FileAssetContents::copyBytes(const FileAssetContentsBase& object)
@@ -30,4 +40,3 @@ void FileAssetContents::copyBytes(const FileAssetContentsBase& object)
     assert(false);
 }
 
-SimpleArray<uint8_t>& FileAssetContents::bytes() { return m_bytes; }
@@ -7,6 +7,11 @@
 using namespace rive;
 
 bool FontAsset::decode(SimpleArray<uint8_t>& data, Factory* factory)
+{
+    return decode(Span<const uint8_t>(data), factory);
+}
+
+bool FontAsset::decode(Span<const uint8_t> data, Factory* factory)
 {
     font(factory->decodeFont(data));
     return m_font != nullptr;
@@ -25,6 +25,11 @@ void ImageAsset::decodedAsync()
 #endif
 
 bool ImageAsset::decode(SimpleArray<uint8_t>& data, Factory* factory)
+{
+    return decode(Span<const uint8_t>(data), factory);
+}
+
+bool ImageAsset::decode(Span<const uint8_t> data, Factory* factory)
 {
 #ifdef TESTING
     decodedByteSize = data.size();
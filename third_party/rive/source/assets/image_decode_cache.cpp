@@ -0,0 +1,134 @@
+#include "rive/assets/image_decode_cache.hpp"
+#include <cstring>
+
+using namespace rive;
+
+ImageDecodeCache& ImageDecodeCache::shared()
+{
+    static ImageDecodeCache cache;
+    return cache;
+}
+
+ImageDecodeCache::Key ImageDecodeCache::makeKey(Span<const uint8_t> bytes)
+{
+    // FNV-1a over the bytes, eight at a time.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes.data() + i, sizeof(word));
+        hash ^= word;
+        hash *= 0x100000001b3ull;
+    }
+    for (; i < bytes.size(); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return {hash, bytes};
+}
+
+size_t ImageDecodeCache::entryBytes(const Entry& entry)
+{
+    return entry.encoded.size() +
+           (entry.image != nullptr ? entry.image->pixels.size() : 0);
+}
+
+void ImageDecodeCache::capacity(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = bytes;
+    trim();
+}
+
+std::shared_ptr<const DecodedImage> ImageDecodeCache::decode(
+    Span<const uint8_t> bytes,
+    Factory* factory)
+{
+    Key key = makeKey(bytes);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto itr = m_index.find(key);
+    if (itr != m_index.end())
+    {
+        m_counters.hits++;
+        m_order.splice(m_order.begin(), m_order, itr->second);
+        return itr->second->image;
+    }
+    auto pending = m_pending.find(key);
+    if (pending != m_pending.end())
+    {
+        m_counters.hits++;
+        Pending decoding = pending->second;
+        lock.unlock();
+        return decoding.get();
+    }
+    m_counters.misses++;
+    std::promise<std::shared_ptr<const DecodedImage>> promise;
+    // The key spans the caller's bytes, which outlive the pending decode.
+    m_pending.emplace(key, promise.get_future().share());
+    lock.unlock();
+
+    std::shared_ptr<const DecodedImage> image =
+        factory->decodeImagePixels(bytes);
+
+    lock.lock();
+    m_pending.erase(key);
+    if (image != nullptr)
+    {
+        add(key, image);
+    }
+    promise.set_value(image);
+    return image;
+}
+
+void ImageDecodeCache::add(const Key& key,
+                           std::shared_ptr<const DecodedImage> image)
+{
+    size_t bytes = key.bytes.size() + image->pixels.size();
+    if (bytes > m_capacity || m_index.find(key) != m_index.end())
+    {
+        return;
+    }
+    m_order.emplace_front();
+    Entry& entry = m_order.front();
+    entry.encoded.assign(key.bytes.begin(), key.bytes.end());
+    entry.key = {key.hash,
+                 Span<const uint8_t>(entry.encoded.data(),
+                                     entry.encoded.size())};
+    entry.image = std::move(image);
+    m_index.emplace(entry.key, m_order.begin());
+    m_size += bytes;
+    trim();
+}
+
+void ImageDecodeCache::trim()
+{
+    while (m_size > m_capacity)
+    {
+        m_size -= entryBytes(m_order.back());
+        m_index.erase(m_order.back().key);
+        m_order.pop_back();
+        m_counters.evictions++;
+    }
+}
+
+ImageDecodeCache::Counters ImageDecodeCache::counters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+}
+
+size_t ImageDecodeCache::sizeInBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+void ImageDecodeCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.clear();
+    m_order.clear();
+    m_size = 0;
+}
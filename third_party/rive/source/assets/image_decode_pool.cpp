@@ -0,0 +1,185 @@
+#include "rive/assets/image_decode_pool.hpp"
+#include "rive/assets/image_asset.hpp"
+#include <algorithm>
+
+using namespace rive;
+
+ImageDecodePool::ImageDecodePool(size_t threadCount,
+                                 size_t queueCapacity,
+                                 ImageDecodeCache* cache) :
+    m_cache(cache), m_queueCapacity(std::max<size_t>(queueCapacity, 1))
+{
+    if (threadCount == 0)
+    {
+        size_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 1;
+    }
+    m_running.assign(threadCount, nullptr);
+    m_workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        m_workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ImageDecodePool::~ImageDecodePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ImageDecodePool::queue(const File* owner,
+                            ImageAsset* asset,
+                            Factory* factory,
+                            Span<const uint8_t> bytes)
+{
+    queue({owner, asset, factory, bytes, {}, nullptr});
+}
+
+void ImageDecodePool::queue(const File* owner,
+                            ImageAsset* asset,
+                            Factory* factory,
+                            SimpleArray<uint8_t>& bytes)
+{
+    Job job = {owner, asset, factory, {}, std::move(bytes), nullptr};
+    job.bytes = job.ownedBytes;
+    queue(std::move(job));
+}
+
+void ImageDecodePool::queue(Job&& job)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_space.wait(lock,
+                     [this]() { return m_queue.size() < m_queueCapacity; });
+        m_queue.push_back(std::move(job));
+        m_counters.queued++;
+    }
+    m_wake.notify_one();
+}
+
+void ImageDecodePool::workerLoop(size_t self)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_stop)
+        {
+            return;
+        }
+        Job job = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_running[self] = job.owner;
+        m_busy++;
+        lock.unlock();
+        m_space.notify_one();
+
+        job.decoded = m_cache != nullptr
+                          ? m_cache->decode(job.bytes, job.factory)
+                          : std::shared_ptr<const DecodedImage>(
+                                job.factory->decodeImagePixels(job.bytes));
+        // The encoded bytes aren't needed anymore.
+        job.bytes = {};
+        job.ownedBytes = SimpleArray<uint8_t>();
+
+        lock.lock();
+        m_running[self] = nullptr;
+        m_busy--;
+        m_finished.push_back(std::move(job));
+        m_counters.decoded++;
+        m_idle.notify_all();
+    }
+}
+
+size_t ImageDecodePool::resolve()
+{
+    std::vector<Job> finished;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        finished.swap(m_finished);
+    }
+    for (Job& job : finished)
+    {
+        if (job.decoded != nullptr)
+        {
+            job.asset->renderImage(job.factory->makeImage(*job.decoded));
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_counters.resolved += finished.size();
+    return finished.size();
+}
+
+void ImageDecodePool::finish()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock,
+                    [this]() { return m_queue.empty() && m_busy == 0; });
+    }
+    resolve();
+}
+
+void ImageDecodePool::cancel(const File* owner)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t queued = m_queue.size();
+    m_queue.erase(std::remove_if(m_queue.begin(),
+                                 m_queue.end(),
+                                 [owner](const Job& job) {
+                                     return job.owner == owner;
+                                 }),
+                  m_queue.end());
+    m_counters.cancelled += queued - m_queue.size();
+    if (m_queue.size() < queued)
+    {
+        m_space.notify_all();
+    }
+    m_idle.wait(lock, [this, owner]() {
+        return std::find(m_running.begin(), m_running.end(), owner) ==
+               m_running.end();
+    });
+    size_t finished = m_finished.size();
+    m_finished.erase(std::remove_if(m_finished.begin(),
+                                    m_finished.end(),
+                                    [owner](const Job& job) {
+                                        return job.owner == owner;
+                                    }),
+                     m_finished.end());
+    m_counters.cancelled += finished - m_finished.size();
+}
+
+size_t ImageDecodePool::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size() + m_busy + m_finished.size();
+}
+
+size_t ImageDecodePool::pendingCount(const File* owner) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto ownedBy = [owner](const Job& job) { return job.owner == owner; };
+    return std::count_if(m_queue.begin(), m_queue.end(), ownedBy) +
+           std::count(m_running.begin(), m_running.end(), owner) +
+           std::count_if(m_finished.begin(), m_finished.end(), ownedBy);
+}
+
+ImageDecodePool::Counters ImageDecodePool::counters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+}
+
+void ImageDecodePool::resetCounters()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_counters = {};
+}
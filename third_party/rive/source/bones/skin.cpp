@@ -1,13 +1,22 @@
 #include "rive/bones/skin.hpp"
 #include "rive/bones/bone.hpp"
+#include "rive/bones/cubic_weight.hpp"
 #include "rive/bones/skinnable.hpp"
 #include "rive/bones/tendon.hpp"
+#include "rive/shapes/cubic_vertex.hpp"
 #include "rive/shapes/vertex.hpp"
 #include "rive/shapes/path_vertex.hpp"
 #include "rive/constraints/constraint.hpp"
+#include "rive/math/simd.hpp"
 
 using namespace rive;
 
+Skin::ParallelForProc Skin::gParallelForProc = nullptr;
+uint32_t Skin::gParallelDeformMinPoints = 4096;
+
+// Blocks of four points per parallel range.
+static constexpr uint32_t parallelDeformGrain = 256;
+
 Skin::~Skin() { delete[] m_BoneTransforms; }
 
 StatusCode Skin::onAddedDirty(CoreContext* context)
@@ -78,11 +87,217 @@ void Skin::buildDependencies()
 
 void Skin::deform(Span<Vertex*> vertices)
 {
+    if (m_forcePerVertexDeform)
+    {
+        for (auto vertex : vertices)
+        {
+            vertex->deform(m_WorldTransform, m_BoneTransforms);
+        }
+        return;
+    }
+
+    if (m_pointsVertices != vertices.data() ||
+        m_pointsVertexCount != vertices.size())
+    {
+        flattenPoints(vertices);
+    }
+    else if (m_pointsDirty)
+    {
+        updatePointPositions(vertices);
+    }
+    auto count = static_cast<uint32_t>(m_points.x.size());
+    if (gParallelForProc != nullptr &&
+        m_points.translations.size() >= gParallelDeformMinPoints)
+    {
+        gParallelForProc(count / 4,
+                         parallelDeformGrain,
+                         this,
+                         [](void* context, uint32_t begin, uint32_t end) {
+                             static_cast<const Skin*>(context)->deformPoints(
+                                 begin * 4,
+                                 end * 4);
+                         });
+        return;
+    }
+    deformPoints(0, count);
+}
+
+void Skin::SkinnedPoints::clear()
+{
+    x.clear();
+    y.clear();
+    for (int i = 0; i < 4; i++)
+    {
+        bones[i].clear();
+        weights[i].clear();
+    }
+    slotCounts.clear();
+    translations.clear();
+}
+
+void Skin::flattenPoints(Span<Vertex*> vertices)
+{
+    m_points.clear();
     for (auto vertex : vertices)
     {
-        vertex->deform(m_WorldTransform, m_BoneTransforms);
+        if (!vertex->hasWeight())
+        {
+            continue;
+        }
+        auto weight = vertex->weight<Weight>();
+        addPoint(Vec2D(vertex->x(), vertex->y()),
+                 weight->indices(),
+                 weight->values(),
+                 &weight->translation());
+        if (vertex->is<CubicVertex>())
+        {
+            auto cubicVertex = vertex->as<CubicVertex>();
+            auto cubicWeight = vertex->weight<CubicWeight>();
+            addPoint(cubicVertex->inPoint(),
+                     cubicWeight->inIndices(),
+                     cubicWeight->inValues(),
+                     &cubicWeight->inTranslation());
+            addPoint(cubicVertex->outPoint(),
+                     cubicWeight->outIndices(),
+                     cubicWeight->outValues(),
+                     &cubicWeight->outTranslation());
+        }
+    }
+    // Padding points have no weights and nowhere to write to.
+    while (m_points.x.size() % 4 != 0)
+    {
+        m_points.x.push_back(0.0f);
+        m_points.y.push_back(0.0f);
+        for (int i = 0; i < 4; i++)
+        {
+            m_points.bones[i].push_back(0);
+            m_points.weights[i].push_back(0.0f);
+        }
     }
+    for (size_t i = 0; i < m_points.x.size(); i += 4)
+    {
+        uint8_t slots = 0;
+        for (uint8_t slot = 0; slot < 4; slot++)
+        {
+            for (size_t lane = 0; lane < 4; lane++)
+            {
+                if (m_points.weights[slot][i + lane] != 0.0f)
+                {
+                    slots = slot + 1;
+                }
+            }
+        }
+        m_points.slotCounts.push_back(slots);
+    }
+    m_pointsVertices = vertices.data();
+    m_pointsVertexCount = vertices.size();
+    m_pointsDirty = false;
+}
+
+void Skin::updatePointPositions(Span<Vertex*> vertices)
+{
+    // Same vertices as the last flatten, so the points are visited in the
+    // order flattenPoints added them and only their positions change.
+    size_t i = 0;
+    auto setPosition = [&](Vec2D position) {
+        Vec2D worldPosition = m_WorldTransform * position;
+        m_points.x[i] = worldPosition.x;
+        m_points.y[i] = worldPosition.y;
+        i++;
+    };
+    for (auto vertex : vertices)
+    {
+        if (!vertex->hasWeight())
+        {
+            continue;
+        }
+        setPosition(Vec2D(vertex->x(), vertex->y()));
+        if (vertex->is<CubicVertex>())
+        {
+            auto cubicVertex = vertex->as<CubicVertex>();
+            setPosition(cubicVertex->inPoint());
+            setPosition(cubicVertex->outPoint());
+        }
+    }
+    m_pointsDirty = false;
 }
+
+void Skin::addPoint(Vec2D position,
+                    uint32_t indices,
+                    uint32_t weights,
+                    Vec2D* translation)
+{
+    // The world transform is fixed at bind time, so apply it once here
+    // rather than on every deform.
+    Vec2D worldPosition = m_WorldTransform * position;
+    m_points.x.push_back(worldPosition.x);
+    m_points.y.push_back(worldPosition.y);
+    // Weighted bones are packed into the first slots, in their original
+    // order so they're summed in the same order as Weight::deform. The rest
+    // point at the identity transform in slot 0 with no weight, which adds
+    // nothing.
+    int slot = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t weight = (weights >> (i * 8)) & 0xFF;
+        uint32_t bone = (indices >> (i * 8)) & 0xFF;
+        if (weight == 0 || bone > m_Tendons.size())
+        {
+            continue;
+        }
+        m_points.bones[slot].push_back(bone * 6);
+        m_points.weights[slot].push_back(weight / 255.0f);
+        slot++;
+    }
+    for (; slot < 4; slot++)
+    {
+        m_points.bones[slot].push_back(0);
+        m_points.weights[slot].push_back(0.0f);
+    }
+    m_points.translations.push_back(translation);
+}
+
+void Skin::deformPoints(uint32_t begin, uint32_t end) const
+{
+    const float* transforms = m_BoneTransforms;
+    for (uint32_t i = begin; i < end; i += 4)
+    {
+        // Blend the bone transforms of four points at once, the same way
+        // Weight::deform does for one.
+        float4 xx = 0.0f, xy = 0.0f, yx = 0.0f, yy = 0.0f, tx = 0.0f,
+               ty = 0.0f;
+        int slots = m_points.slotCounts[i / 4];
+        for (int slot = 0; slot < slots; slot++)
+        {
+            const uint32_t* bones = &m_points.bones[slot][i];
+            const float* a = transforms + bones[0];
+            const float* b = transforms + bones[1];
+            const float* c = transforms + bones[2];
+            const float* d = transforms + bones[3];
+            float4 weight = simd::load4f(&m_points.weights[slot][i]);
+            xx += float4{a[0], b[0], c[0], d[0]} * weight;
+            xy += float4{a[1], b[1], c[1], d[1]} * weight;
+            yx += float4{a[2], b[2], c[2], d[2]} * weight;
+            yy += float4{a[3], b[3], c[3], d[3]} * weight;
+            tx += float4{a[4], b[4], c[4], d[4]} * weight;
+            ty += float4{a[5], b[5], c[5], d[5]} * weight;
+        }
+        float4 x = simd::load4f(&m_points.x[i]);
+        float4 y = simd::load4f(&m_points.y[i]);
+        float deformedX[4];
+        float deformedY[4];
+        simd::store(deformedX, xx * x + yx * y + tx);
+        simd::store(deformedY, xy * x + yy * y + ty);
+
+        size_t lanes = std::min<size_t>(4, m_points.translations.size() - i);
+        for (size_t lane = 0; lane < lanes; lane++)
+        {
+            *m_points.translations[i + lane] =
+                Vec2D(deformedX[lane], deformedY[lane]);
+        }
+    }
+}
+
 void Skin::addTendon(Tendon* tendon) { m_Tendons.push_back(tendon); }
 
 void Skin::onDirty(ComponentDirt dirt)
@@ -6,35 +6,93 @@
 
 namespace rive
 {
-namespace
-{
-// RAII utility to lock a mutex, and call notify_one() on a condition variable
-// immediately before unlocking.
-class AutoLockAndNotify
+// Records one command into the pending batch and, unless the client is
+// batching, hands it to the server. With the locked transport the command
+// mutex is held throughout and the server is notified at the end.
+class CommandQueue::AutoCommandBatch
 {
 public:
-    AutoLockAndNotify(std::mutex& mutex, std::condition_variable& cv) :
-        m_mutex(mutex), m_cv(cv)
+    AutoCommandBatch(CommandQueue* queue) : m_queue(queue)
     {
-        m_mutex.lock();
+        if (m_queue->m_transport == Transport::locked)
+            m_queue->m_commandMutex.lock();
+        m_batch = &m_queue->m_commands.pending();
     }
 
-    ~AutoLockAndNotify()
+    ~AutoCommandBatch()
     {
-        m_cv.notify_one();
-        m_mutex.unlock();
+        if (m_queue->m_batchDepth == 0)
+            m_queue->publishCommands();
+        if (m_queue->m_transport == Transport::locked)
+        {
+            m_queue->m_commandConditionVariable.notify_one();
+            m_queue->m_commandMutex.unlock();
+        }
     }
 
+    CommandBatch* operator->() { return m_batch; }
+
 private:
-    std::mutex& m_mutex;
-    std::condition_variable& m_cv;
+    CommandQueue* m_queue;
+    CommandBatch* m_batch;
 };
-}; // namespace
 
-CommandQueue::CommandQueue() {}
+CommandQueue::CommandQueue(Transport transport) : m_transport(transport) {}
 
 CommandQueue::~CommandQueue() {}
 
+void CommandQueue::beginBatch() { m_batchDepth++; }
+
+void CommandQueue::commitBatch()
+{
+    assert(m_batchDepth > 0);
+    if (--m_batchDepth > 0)
+        return;
+    if (m_transport == Transport::locked)
+    {
+        std::lock_guard<std::mutex> lock(m_commandMutex);
+        publishCommands();
+        m_commandConditionVariable.notify_one();
+    }
+    else
+    {
+        publishCommands();
+    }
+}
+
+void CommandQueue::publishCommands()
+{
+    m_commands.publish();
+    if (m_transport == Transport::locked)
+        return;
+    // Pairs with the fence in waitForCommands(): either the server sees this
+    // batch before it sleeps or we see that it is asleep and wake it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_serverWaiting.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(m_commandMutex);
+        m_commandConditionVariable.notify_one();
+    }
+}
+
+void CommandQueue::waitForCommands()
+{
+    if (m_commands.hasData())
+        return;
+    std::unique_lock<std::mutex> lock(m_commandMutex);
+    m_serverWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!m_commands.hasData())
+        m_commandConditionVariable.wait(lock);
+    m_serverWaiting.store(false, std::memory_order_relaxed);
+}
+
+void CommandQueue::publishMessages()
+{
+    TransportLock lock(m_messageMutex, m_transport);
+    m_messages.publish();
+}
+
 FileHandle CommandQueue::loadFile(std::vector<uint8_t> rivBytes,
                                   rcp<FileAssetLoader> loader,
                                   FileListener* listener,
@@ -49,22 +107,22 @@ FileHandle CommandQueue::loadFile(std::vector<uint8_t> rivBytes,
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::loadFile;
-    m_commandStream << handle;
-    m_commandStream << requestId;
-    m_commandStream << loader;
-    m_byteVectors << std::move(rivBytes);
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::loadFile;
+    batch->commandStream << handle;
+    batch->commandStream << requestId;
+    batch->commandStream << loader;
+    batch->byteVectors << std::move(rivBytes);
 
     return handle;
 }
 
 void CommandQueue::deleteFile(FileHandle fileHandle, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::deleteFile;
-    m_commandStream << fileHandle;
-    m_commandStream << requestId;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::deleteFile;
+    batch->commandStream << fileHandle;
+    batch->commandStream << requestId;
 }
 
 ArtboardHandle CommandQueue::instantiateArtboardNamed(
@@ -83,12 +141,12 @@ ArtboardHandle CommandQueue::instantiateArtboardNamed(
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::instantiateArtboard;
-    m_commandStream << handle;
-    m_commandStream << fileHandle;
-    m_commandStream << requestId;
-    m_names << std::move(name);
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::instantiateArtboard;
+    batch->commandStream << handle;
+    batch->commandStream << fileHandle;
+    batch->commandStream << requestId;
+    batch->names << std::move(name);
 
     return handle;
 }
@@ -96,10 +154,10 @@ ArtboardHandle CommandQueue::instantiateArtboardNamed(
 void CommandQueue::deleteArtboard(ArtboardHandle artboardHandle,
                                   uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::deleteArtboard;
-    m_commandStream << artboardHandle;
-    m_commandStream << requestId;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::deleteArtboard;
+    batch->commandStream << artboardHandle;
+    batch->commandStream << requestId;
 }
 
 StateMachineHandle CommandQueue::instantiateStateMachineNamed(
@@ -118,12 +176,12 @@ StateMachineHandle CommandQueue::instantiateStateMachineNamed(
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::instantiateStateMachine;
-    m_commandStream << handle;
-    m_commandStream << artboardHandle;
-    m_commandStream << requestId;
-    m_names << std::move(name);
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::instantiateStateMachine;
+    batch->commandStream << handle;
+    batch->commandStream << artboardHandle;
+    batch->commandStream << requestId;
+    batch->names << std::move(name);
 
     return handle;
 }
@@ -131,79 +189,79 @@ StateMachineHandle CommandQueue::instantiateStateMachineNamed(
 void CommandQueue::pointerMove(StateMachineHandle stateMachineHandle,
                                Vec2D position)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::pointerMove;
-    m_commandStream << stateMachineHandle;
-    m_commandStream << position;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::pointerMove;
+    batch->commandStream << stateMachineHandle;
+    batch->commandStream << position;
 }
 
 void CommandQueue::pointerDown(StateMachineHandle stateMachineHandle,
                                Vec2D position)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::pointerDown;
-    m_commandStream << stateMachineHandle;
-    m_commandStream << position;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::pointerDown;
+    batch->commandStream << stateMachineHandle;
+    batch->commandStream << position;
 }
 
 void CommandQueue::pointerUp(StateMachineHandle stateMachineHandle,
                              Vec2D position)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::pointerUp;
-    m_commandStream << stateMachineHandle;
-    m_commandStream << position;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::pointerUp;
+    batch->commandStream << stateMachineHandle;
+    batch->commandStream << position;
 }
 
 void CommandQueue::pointerExit(StateMachineHandle stateMachineHandle,
                                Vec2D position)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::pointerExit;
-    m_commandStream << stateMachineHandle;
-    m_commandStream << position;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::pointerExit;
+    batch->commandStream << stateMachineHandle;
+    batch->commandStream << position;
 }
 
 void CommandQueue::advanceStateMachine(StateMachineHandle stateMachineHandle,
                                        float timeToAdvance,
                                        uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::advanceStateMachine;
-    m_commandStream << stateMachineHandle;
-    m_commandStream << requestId;
-    m_commandStream << timeToAdvance;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::advanceStateMachine;
+    batch->commandStream << stateMachineHandle;
+    batch->commandStream << requestId;
+    batch->commandStream << timeToAdvance;
 }
 
 void CommandQueue::deleteStateMachine(StateMachineHandle stateMachineHandle,
                                       uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::deleteStateMachine;
-    m_commandStream << stateMachineHandle;
-    m_commandStream << requestId;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::deleteStateMachine;
+    batch->commandStream << stateMachineHandle;
+    batch->commandStream << requestId;
 }
 
 DrawKey CommandQueue::createDrawKey()
 {
-    // lock here so we can do this from several threads safely
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    auto key = reinterpret_cast<DrawKey>(++m_currentDrawKeyIdx);
+    // atomic so we can do this from several threads safely
+    auto key = reinterpret_cast<DrawKey>(
+        m_currentDrawKeyIdx.fetch_add(1, std::memory_order_relaxed) + 1);
     return key;
 }
 
 void CommandQueue::draw(DrawKey drawKey, CommandServerDrawCallback callback)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::draw;
-    m_commandStream << drawKey;
-    m_drawCallbacks << std::move(callback);
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::draw;
+    batch->commandStream << drawKey;
+    batch->drawCallbacks << std::move(callback);
 }
 #ifdef TESTING
 void CommandQueue::testing_commandLoopBreak()
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::commandLoopBreak;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::commandLoopBreak;
 }
 
 CommandQueue::FileListener* CommandQueue::testing_getFileListener(
@@ -236,68 +294,63 @@ CommandQueue::StateMachineListener* CommandQueue::
 #endif
 void CommandQueue::runOnce(CommandServerCallback callback)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::runOnce;
-    m_callbacks << std::move(callback);
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::runOnce;
+    batch->callbacks << std::move(callback);
 }
 
 void CommandQueue::disconnect()
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::disconnect;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::disconnect;
 }
 
 void CommandQueue::requestArtboardNames(FileHandle fileHandle,
                                         uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::listArtboards;
-    m_commandStream << fileHandle;
-    m_commandStream << requestId;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::listArtboards;
+    batch->commandStream << fileHandle;
+    batch->commandStream << requestId;
 }
 
 void CommandQueue::requestStateMachineNames(ArtboardHandle artboardHandle,
                                             uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::listStateMachines;
-    m_commandStream << artboardHandle;
-    m_commandStream << requestId;
+    AutoCommandBatch batch(this);
+    batch->commandStream << Command::listStateMachines;
+    batch->commandStream << artboardHandle;
+    batch->commandStream << requestId;
 }
 
 void CommandQueue::processMessages()
 {
-    std::unique_lock<std::mutex> lock(m_messageMutex);
+    TransportLock lock(m_messageMutex, m_transport);
 
-    if (m_messageStream.empty())
-        return;
+    // Only read what was published before we started. This way if new messages
+    // come in while we're processing the existing ones, we won't loop forever.
+    uint64_t lastBatch = m_messages.publishedCount();
 
-    // Mark where we will end processing messages. This way if new messages come
-    // in while we're processing the existing ones, we won't loop forever.
-    m_messageStream << Message::messageLoopBreak;
-
-    do
+    while (MessageBatch* batch = m_messages.consume(lastBatch))
     {
+        PODStream& messageStream = batch->messageStream;
         Message message;
-        m_messageStream >> message;
+        messageStream >> message;
 
         switch (message)
         {
-            case Message::messageLoopBreak:
-                lock.unlock();
-                return;
             case Message::artboardsListed:
             {
                 size_t numArtboards;
                 FileHandle handle;
                 uint64_t requestId;
-                m_messageStream >> handle;
-                m_messageStream >> requestId;
-                m_messageStream >> numArtboards;
+                messageStream >> handle;
+                messageStream >> requestId;
+                messageStream >> numArtboards;
                 std::vector<std::string> artboardNames(numArtboards);
                 for (auto& name : artboardNames)
                 {
-                    m_messageNames >> name;
+                    batch->messageNames >> name;
                 }
                 lock.unlock();
 
@@ -315,13 +368,13 @@ void CommandQueue::processMessages()
                 size_t numStateMachines;
                 ArtboardHandle handle;
                 uint64_t requestId;
-                m_messageStream >> handle;
-                m_messageStream >> requestId;
-                m_messageStream >> numStateMachines;
+                messageStream >> handle;
+                messageStream >> requestId;
+                messageStream >> numStateMachines;
                 std::vector<std::string> stateMachineNames(numStateMachines);
                 for (auto& name : stateMachineNames)
                 {
-                    m_messageNames >> name;
+                    batch->messageNames >> name;
                 }
                 lock.unlock();
 
@@ -340,8 +393,8 @@ void CommandQueue::processMessages()
             {
                 FileHandle handle;
                 uint64_t requestId;
-                m_messageStream >> handle;
-                m_messageStream >> requestId;
+                messageStream >> handle;
+                messageStream >> requestId;
                 lock.unlock();
                 auto itr = m_fileListeners.find(handle);
                 if (itr != m_fileListeners.end())
@@ -354,8 +407,8 @@ void CommandQueue::processMessages()
             {
                 ArtboardHandle handle;
                 uint64_t requestId;
-                m_messageStream >> handle;
-                m_messageStream >> requestId;
+                messageStream >> handle;
+                messageStream >> requestId;
                 lock.unlock();
                 auto itr = m_artboardListeners.find(handle);
                 if (itr != m_artboardListeners.end())
@@ -368,8 +421,8 @@ void CommandQueue::processMessages()
             {
                 StateMachineHandle handle;
                 uint64_t requestId;
-                m_messageStream >> handle;
-                m_messageStream >> requestId;
+                messageStream >> handle;
+                messageStream >> requestId;
                 lock.unlock();
                 auto itr = m_stateMachineListeners.find(handle);
                 if (itr != m_stateMachineListeners.end())
@@ -382,8 +435,8 @@ void CommandQueue::processMessages()
             {
                 StateMachineHandle handle;
                 uint64_t requestId;
-                m_messageStream >> handle;
-                m_messageStream >> requestId;
+                messageStream >> handle;
+                messageStream >> requestId;
                 lock.unlock();
                 auto itr = m_stateMachineListeners.find(handle);
                 if (itr != m_stateMachineListeners.end())
@@ -401,7 +454,7 @@ void CommandQueue::processMessages()
 
         assert(!lock.owns_lock());
         lock.lock();
-    } while (!m_messageStream.empty());
+    }
 }
 
 }; // namespace rive
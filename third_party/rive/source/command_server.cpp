@@ -53,14 +53,7 @@ void CommandServer::serveUntilDisconnect()
 
 bool CommandServer::waitCommands()
 {
-    PODStream& commandStream = m_commandQueue->m_commandStream;
-    if (commandStream.empty())
-    {
-        std::unique_lock<std::mutex> lock(m_commandQueue->m_commandMutex);
-        while (commandStream.empty())
-            m_commandQueue->m_commandConditionVariable.wait(lock);
-    }
-
+    m_commandQueue->waitForCommands();
     return processCommands();
 }
 
@@ -69,24 +62,29 @@ bool CommandServer::processCommands()
     assert(m_wasDisconnectReceived == false);
     assert(std::this_thread::get_id() == m_threadID);
 
-    PODStream& commandStream = m_commandQueue->m_commandStream;
-    std::unique_lock<std::mutex> lock(m_commandQueue->m_commandMutex);
-
-    // Early out if we don't have anything to process.
-    if (commandStream.empty())
-        return !m_wasDisconnectReceived;
+    CommandQueue::TransportLock lock(m_commandQueue->m_commandMutex,
+                                     m_commandQueue->m_transport);
 
-    // Ensure we stop processing messages and get to the draw loop.
-    // This avoids a race condition where we never stop processing messages and
-    // therefore never draw anything.
-    commandStream << CommandQueue::Command::commandLoopBreak;
+    // Ensure we stop processing messages and get to the draw loop: only read
+    // batches that were published before we started. This avoids a race
+    // condition where we never stop processing messages and therefore never
+    // draw anything.
+    uint64_t lastBatch = m_commandQueue->m_commands.publishedCount();
 
     // The map should be empty at this point.
     assert(m_uniqueDraws.empty());
 
     bool shouldProcessCommands = true;
-    do
+    while (shouldProcessCommands)
     {
+        CommandQueue::CommandBatch* batch =
+            m_commandQueue->m_commands.consume(lastBatch);
+        if (batch == nullptr)
+        {
+            lock.unlock();
+            break;
+        }
+        PODStream& commandStream = batch->commandStream;
         CommandQueue::Command command;
         commandStream >> command;
         switch (command)
@@ -100,7 +98,7 @@ bool CommandServer::processCommands()
                 commandStream >> handle;
                 commandStream >> requestId;
                 commandStream >> loader;
-                m_commandQueue->m_byteVectors >> rivBytes;
+                batch->byteVectors >> rivBytes;
                 lock.unlock();
                 std::unique_ptr<rive::File> file =
                     rive::File::import(rivBytes,
@@ -126,12 +124,10 @@ bool CommandServer::processCommands()
                 commandStream >> requestId;
                 lock.unlock();
                 m_files.erase(handle);
-                std::unique_lock<std::mutex> messageLock(
-                    m_commandQueue->m_messageMutex);
-                m_commandQueue->m_messageStream
-                    << CommandQueue::Message::fileDeleted;
-                m_commandQueue->m_messageStream << handle;
-                m_commandQueue->m_messageStream << requestId;
+                CommandQueue::AutoMessageBatch messages(m_commandQueue.get());
+                messages->messageStream << CommandQueue::Message::fileDeleted;
+                messages->messageStream << handle;
+                messages->messageStream << requestId;
                 break;
             }
 
@@ -144,7 +140,7 @@ bool CommandServer::processCommands()
                 commandStream >> handle;
                 commandStream >> fileHandle;
                 commandStream >> requestId;
-                m_commandQueue->m_names >> name;
+                batch->names >> name;
                 lock.unlock();
                 if (rive::File* file = getFile(fileHandle))
                 {
@@ -172,12 +168,11 @@ bool CommandServer::processCommands()
                 commandStream >> requestId;
                 lock.unlock();
                 m_artboards.erase(handle);
-                std::unique_lock<std::mutex> messageLock(
-                    m_commandQueue->m_messageMutex);
-                m_commandQueue->m_messageStream
+                CommandQueue::AutoMessageBatch messages(m_commandQueue.get());
+                messages->messageStream
                     << CommandQueue::Message::artboardDeleted;
-                m_commandQueue->m_messageStream << handle;
-                m_commandQueue->m_messageStream << requestId;
+                messages->messageStream << handle;
+                messages->messageStream << requestId;
                 break;
             }
 
@@ -190,7 +185,7 @@ bool CommandServer::processCommands()
                 commandStream >> handle;
                 commandStream >> artboardHandle;
                 commandStream >> requestId;
-                m_commandQueue->m_names >> name;
+                batch->names >> name;
                 lock.unlock();
                 if (rive::ArtboardInstance* artboard =
                         getArtboardInstance(artboardHandle))
@@ -226,12 +221,12 @@ bool CommandServer::processCommands()
                 {
                     if (!stateMachine->advanceAndApply(timeToAdvance))
                     {
-                        std::unique_lock<std::mutex> messageLock(
-                            m_commandQueue->m_messageMutex);
-                        m_commandQueue->m_messageStream
+                        CommandQueue::AutoMessageBatch messages(
+                            m_commandQueue.get());
+                        messages->messageStream
                             << CommandQueue::Message::stateMachineSettled;
-                        m_commandQueue->m_messageStream << handle;
-                        m_commandQueue->m_messageStream << requestId;
+                        messages->messageStream << handle;
+                        messages->messageStream << requestId;
                     }
                 }
                 else
@@ -253,19 +248,18 @@ bool CommandServer::processCommands()
                 commandStream >> requestId;
                 lock.unlock();
                 m_stateMachines.erase(handle);
-                std::unique_lock<std::mutex> messageLock(
-                    m_commandQueue->m_messageMutex);
-                m_commandQueue->m_messageStream
+                CommandQueue::AutoMessageBatch messages(m_commandQueue.get());
+                messages->messageStream
                     << CommandQueue::Message::stateMachineDeleted;
-                m_commandQueue->m_messageStream << handle;
-                m_commandQueue->m_messageStream << requestId;
+                messages->messageStream << handle;
+                messages->messageStream << requestId;
                 break;
             }
 
             case CommandQueue::Command::runOnce:
             {
                 CommandServerCallback callback;
-                m_commandQueue->m_callbacks >> callback;
+                batch->callbacks >> callback;
                 lock.unlock();
                 callback(this);
                 break;
@@ -276,7 +270,7 @@ bool CommandServer::processCommands()
                 DrawKey drawKey;
                 CommandServerDrawCallback drawCallback;
                 commandStream >> drawKey;
-                m_commandQueue->m_drawCallbacks >> drawCallback;
+                batch->drawCallbacks >> drawCallback;
                 lock.unlock();
                 m_uniqueDraws[drawKey] = std::move(drawCallback);
                 break;
@@ -301,16 +295,16 @@ bool CommandServer::processCommands()
                 {
                     auto artboards = file->artboards();
 
-                    std::unique_lock<std::mutex> messageLock(
-                        m_commandQueue->m_messageMutex);
-                    m_commandQueue->m_messageStream
+                    CommandQueue::AutoMessageBatch messages(
+                        m_commandQueue.get());
+                    messages->messageStream
                         << CommandQueue::Message::artboardsListed;
-                    m_commandQueue->m_messageStream << handle;
-                    m_commandQueue->m_messageStream << requestId;
-                    m_commandQueue->m_messageStream << artboards.size();
+                    messages->messageStream << handle;
+                    messages->messageStream << requestId;
+                    messages->messageStream << artboards.size();
                     for (auto artboard : artboards)
                     {
-                        m_commandQueue->m_messageNames << artboard->name();
+                        messages->messageNames << artboard->name();
                     }
                 }
 
@@ -328,16 +322,16 @@ bool CommandServer::processCommands()
                 if (artboard)
                 {
                     auto numStateMachines = artboard->stateMachineCount();
-                    std::unique_lock<std::mutex> messageLock(
-                        m_commandQueue->m_messageMutex);
-                    m_commandQueue->m_messageStream
+                    CommandQueue::AutoMessageBatch messages(
+                        m_commandQueue.get());
+                    messages->messageStream
                         << CommandQueue::Message::stateMachinesListed;
-                    m_commandQueue->m_messageStream << handle;
-                    m_commandQueue->m_messageStream << requestId;
-                    m_commandQueue->m_messageStream << numStateMachines;
+                    messages->messageStream << handle;
+                    messages->messageStream << requestId;
+                    messages->messageStream << numStateMachines;
                     for (int i = 0; i < numStateMachines; ++i)
                     {
-                        m_commandQueue->m_messageNames
+                        messages->messageNames
                             << artboard->stateMachineNameAt(i);
                     }
                 }
@@ -429,14 +423,18 @@ bool CommandServer::processCommands()
             {
                 lock.unlock();
                 m_wasDisconnectReceived = true;
+                m_commandQueue->publishMessages();
                 return false;
             }
         }
 
         // Should have unlocked by now.
         assert(!lock.owns_lock());
-        lock.lock();
-    } while (!commandStream.empty() && shouldProcessCommands);
+        if (shouldProcessCommands)
+            lock.lock();
+    }
+
+    m_commandQueue->publishMessages();
 
     for (const auto& drawPair : m_uniqueDraws)
     {
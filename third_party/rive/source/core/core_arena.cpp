@@ -0,0 +1,85 @@
+#include "rive/core/core_arena.hpp"
+#include "rive/core.hpp"
+#include <algorithm>
+#include <new>
+
+using namespace rive;
+
+static thread_local CoreArena* s_currentCoreArena = nullptr;
+
+static constexpr size_t coreAllocationAlignment = alignof(std::max_align_t);
+static constexpr size_t minimumArenaChunkSize = 4 * 1024;
+
+static size_t alignCoreAllocation(size_t size)
+{
+    return (size + coreAllocationAlignment - 1) &
+           ~(coreAllocationAlignment - 1);
+}
+
+CoreArena::CoreArena(size_t capacityHint) :
+    m_nextChunkSize(
+        std::max(alignCoreAllocation(capacityHint), minimumArenaChunkSize))
+{}
+
+CoreArena::~CoreArena() {}
+
+void CoreArena::addChunk(size_t minimumSize)
+{
+    size_t size = std::max(m_nextChunkSize, minimumSize);
+    m_chunks.emplace_back(new uint8_t[size]);
+    m_cursor = m_chunks.back().get();
+    m_end = m_cursor + size;
+    m_nextChunkSize = size * 2;
+}
+
+void* CoreArena::allocate(size_t size)
+{
+    size = alignCoreAllocation(size);
+    if (static_cast<size_t>(m_end - m_cursor) < size)
+    {
+        addChunk(size);
+    }
+    void* result = m_cursor;
+    m_cursor += size;
+    m_bytesAllocated += size;
+    return result;
+}
+
+CoreArena* CoreArena::current() { return s_currentCoreArena; }
+
+CoreArena::Scope::Scope(CoreArena* arena) : m_previous(s_currentCoreArena)
+{
+    s_currentCoreArena = arena;
+}
+
+CoreArena::Scope::~Scope() { s_currentCoreArena = m_previous; }
+
+// Every Core allocation is prefixed with the arena it came from (null for
+// the heap) so delete knows whether there is memory to release.
+static constexpr size_t coreAllocationHeader = coreAllocationAlignment;
+static_assert(coreAllocationHeader >= sizeof(CoreArena*),
+              "Core allocation header must fit an arena pointer.");
+
+void* Core::operator new(size_t size)
+{
+    CoreArena* arena = s_currentCoreArena;
+    size_t blockSize = coreAllocationHeader + size;
+    uint8_t* block = static_cast<uint8_t*>(
+        arena != nullptr ? arena->allocate(blockSize)
+                         : ::operator new(blockSize));
+    *reinterpret_cast<CoreArena**>(block) = arena;
+    return block + coreAllocationHeader;
+}
+
+void Core::operator delete(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    uint8_t* block = static_cast<uint8_t*>(ptr) - coreAllocationHeader;
+    if (*reinterpret_cast<CoreArena**>(block) == nullptr)
+    {
+        ::operator delete(block);
+    }
+}
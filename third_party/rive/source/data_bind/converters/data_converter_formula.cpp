@@ -12,6 +12,7 @@
 #include "rive/animation/arithmetic_operation.hpp"
 #include "rive/function_type.hpp"
 #include "rive/math/math_types.hpp"
+#include <algorithm>
 #include <cmath>
 
 using namespace rive;
@@ -74,9 +75,8 @@ int DataConverterFormula::getPrecedence(FormulaToken* token)
 void DataConverterFormula::initialize()
 {
     // convert the formula to Reverse Polish Notation using a version of
-    // the Shunting yard algorithm
-    // Some optimizations could be done here by precomputing constant parts
-    // of the equation
+    // the Shunting yard algorithm. The queue is compiled into a program,
+    // with constant parts of the equation precomputed, on first use.
     std::vector<FormulaToken*> operationsStack;
     int tokenIndex = 0;
     for (auto& token : m_tokens)
@@ -232,37 +232,23 @@ float DataConverterFormula::getRandom(int randomIndex)
     return m_randoms[randomIndex];
 }
 
-float DataConverterFormula::applyFunction(std::vector<float>& stack,
-                                          int functionTypeIndex,
-                                          int totalArguments)
+float DataConverterFormula::applyFunction(const float* arguments,
+                                          int count,
+                                          int functionTypeIndex)
 {
-
-    std::vector<float> functionArguments;
-    int index = 0;
-    int currentRandom = 0;
-    while (index < totalArguments)
-    {
-        if (stack.size() > 0)
-        {
-            auto functionArgument = stack.back();
-            stack.pop_back();
-            functionArguments.push_back(functionArgument);
-        }
-        index++;
-    }
     auto functionType = (FunctionType)functionTypeIndex;
     switch (functionType)
     {
         case FunctionType::min:
         {
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                float minValue = functionArguments[0];
-                for (auto i = 1; i < functionArguments.size(); i++)
+                float minValue = arguments[count - 1];
+                for (auto i = count - 2; i >= 0; i--)
                 {
-                    if (functionArguments[i] < minValue)
+                    if (arguments[i] < minValue)
                     {
-                        minValue = functionArguments[i];
+                        minValue = arguments[i];
                     }
                 }
                 return minValue;
@@ -271,14 +257,14 @@ float DataConverterFormula::applyFunction(std::vector<float>& stack,
         break;
         case FunctionType::max:
         {
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                float maxValue = functionArguments[0];
-                for (auto i = 1; i < functionArguments.size(); i++)
+                float maxValue = arguments[count - 1];
+                for (auto i = count - 2; i >= 0; i--)
                 {
-                    if (functionArguments[i] > maxValue)
+                    if (arguments[i] > maxValue)
                     {
-                        maxValue = functionArguments[i];
+                        maxValue = arguments[i];
                     }
                 }
                 return maxValue;
@@ -286,114 +272,113 @@ float DataConverterFormula::applyFunction(std::vector<float>& stack,
         }
         break;
         case FunctionType::round:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return roundf(functionArguments.back());
+                return roundf(arguments[0]);
             }
             break;
         case FunctionType::ceil:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return ceilf(functionArguments.back());
+                return ceilf(arguments[0]);
             }
             break;
         case FunctionType::floor:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return floorf(functionArguments.back());
+                return floorf(arguments[0]);
             }
             break;
         case FunctionType::sqrt:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return sqrtf(functionArguments.back());
+                return sqrtf(arguments[0]);
             }
             break;
         case FunctionType::pow:
         {
-            if (functionArguments.size() > 1)
+            if (count > 1)
             {
-                auto exponent = functionArguments[functionArguments.size() - 2];
-                auto x = functionArguments.back();
+                auto exponent = arguments[1];
+                auto x = arguments[0];
                 return powf(x, exponent);
             }
         }
         break;
         case FunctionType::exp:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return exp(functionArguments.back());
+                return exp(arguments[0]);
             }
             break;
         case FunctionType::log:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return log(functionArguments.back());
+                return log(arguments[0]);
             }
             break;
         case FunctionType::cosine:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return cos(functionArguments.back());
+                return cos(arguments[0]);
             }
             break;
         case FunctionType::sine:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return sin(functionArguments.back());
+                return sin(arguments[0]);
             }
             break;
         case FunctionType::tangent:
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return tan(functionArguments.back());
+                return tan(arguments[0]);
             }
             break;
         case FunctionType::acosine:
 
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return acos(functionArguments.back());
+                return acos(arguments[0]);
             }
             break;
         case FunctionType::asine:
 
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return asin(functionArguments.back());
+                return asin(arguments[0]);
             }
             break;
         case FunctionType::atangent:
 
-            if (functionArguments.size() > 0)
+            if (count > 0)
             {
-                return atan(functionArguments.back());
+                return atan(arguments[0]);
             }
             break;
         case FunctionType::atangent2:
         {
-            if (functionArguments.size() > 1)
+            if (count > 1)
             {
-                auto argument1 = functionArguments.back();
-                auto argument2 =
-                    functionArguments[functionArguments.size() - 2];
+                auto argument1 = arguments[0];
+                auto argument2 = arguments[1];
                 return atan2(argument1, argument2);
             }
         }
         break;
         case FunctionType::random:
         {
-            float randomValue = getRandom(currentRandom++);
+            float randomValue = getRandom(0);
             float lowerBound = 0;
             float upperBound = 1;
-            if (functionArguments.size() == 1)
+            if (count == 1)
             {
-                upperBound = functionArguments.back();
+                upperBound = arguments[0];
             }
-            else if (functionArguments.size() > 1)
+            else if (count > 1)
             {
-                lowerBound = functionArguments.back();
-                upperBound = functionArguments[functionArguments.size() - 2];
+                lowerBound = arguments[0];
+                upperBound = arguments[1];
             }
             return lowerBound + (upperBound - lowerBound) * randomValue;
         }
@@ -404,65 +389,239 @@ float DataConverterFormula::applyFunction(std::vector<float>& stack,
     return 0;
 }
 
-DataValue* DataConverterFormula::convert(DataValue* value, DataBind* dataBind)
+void DataConverterFormula::compile()
 {
-    if (value->is<DataValueNumber>() || value->is<DataValueSymbolListIndex>())
-    {
-        float inputValue =
-            value->is<DataValueNumber>()
-                ? value->as<DataValueNumber>()->value()
-                : (float)(value->as<DataValueSymbolListIndex>()->value());
-        float resultValue = inputValue;
+    m_compiled = true;
+    m_program.clear();
 
-        std::vector<float> stack;
-        for (auto& token : m_outputQueue)
+    // The stack depth before each token does not depend on the values, so it
+    // is tracked here along with which entries are known constants. Each
+    // constant entry was pushed by the last pushConstant instruction emitted
+    // for it, which lets operations on constants be folded by replacing
+    // those instructions with the result.
+    std::vector<bool> isConstant;
+    size_t maxDepth = 0;
+    for (auto& token : m_outputQueue)
+    {
+        if (token->dataBinds().size() > 0 &&
+            !token->is<FormulaTokenValue>())
         {
-            if (token->is<FormulaTokenOperation>())
+            // Bound operation or function types can change between
+            // evaluations, leave this formula to the interpreter.
+            m_program.clear();
+            m_forceInterpreter = true;
+            return;
+        }
+        FormulaInstruction instruction;
+        int argumentsCount = 0;
+        bool constantArguments = true;
+        if (token->is<FormulaTokenOperation>())
+        {
+            if (isConstant.size() <= 1)
             {
-                if (stack.size() > 1)
-                {
-                    auto right = stack.back();
-                    stack.pop_back();
-                    auto left = stack.back();
-                    stack.pop_back();
-                    float operationResult = applyOperation(
-                        left,
-                        right,
-                        token->as<FormulaTokenOperation>()->operationType());
-                    stack.push_back(operationResult);
-                }
+                continue;
             }
-            else if (token->is<FormulaTokenFunction>())
+            instruction.opcode = FormulaOpcode::operation;
+            instruction.type =
+                token->as<FormulaTokenOperation>()->operationType();
+            argumentsCount = 2;
+        }
+        else if (token->is<FormulaTokenFunction>())
+        {
+            auto argumentsCountSearch = m_argumentsCount.find(token);
+            argumentsCount = argumentsCountSearch == m_argumentsCount.end()
+                                 ? 0
+                                 : argumentsCountSearch->second;
+            argumentsCount =
+                std::min(argumentsCount, (int)isConstant.size());
+            instruction.opcode = FormulaOpcode::function;
+            instruction.type =
+                token->as<FormulaTokenFunction>()->functionType();
+            constantArguments =
+                (FunctionType)instruction.type != FunctionType::random;
+        }
+        else if (token->is<FormulaTokenInput>())
+        {
+            instruction.opcode = FormulaOpcode::pushInput;
+            constantArguments = false;
+        }
+        else if (token->is<FormulaTokenValue>())
+        {
+            auto valueToken = token->as<FormulaTokenValue>();
+            if (valueToken->dataBinds().size() > 0)
             {
-                auto argumentsCount = m_argumentsCount.find(token);
-                float operationResult = applyFunction(
-                    stack,
-                    token->as<FormulaTokenFunction>()->functionType(),
-                    argumentsCount == m_argumentsCount.end()
-                        ? 0
-                        : argumentsCount->second);
-                stack.push_back(operationResult);
+                instruction.opcode = FormulaOpcode::pushValue;
+                instruction.token = valueToken;
+                constantArguments = false;
             }
-            else if (token->is<FormulaTokenInput>())
+            else
             {
-                stack.push_back(inputValue);
+                instruction.opcode = FormulaOpcode::pushConstant;
+                instruction.constant = valueToken->operationValue();
             }
-            else if (token->is<FormulaTokenValue>())
+        }
+        else
+        {
+            continue;
+        }
+        instruction.argumentsCount = argumentsCount;
+
+        size_t argumentsStart = isConstant.size() - argumentsCount;
+        for (size_t i = argumentsStart; i < isConstant.size(); i++)
+        {
+            constantArguments = constantArguments && isConstant[i];
+        }
+        isConstant.resize(argumentsStart);
+        bool computes = instruction.opcode == FormulaOpcode::operation ||
+                        instruction.opcode == FormulaOpcode::function;
+        if (computes && constantArguments)
+        {
+            size_t programStart = m_program.size() - argumentsCount;
+            std::vector<float> arguments;
+            for (size_t i = programStart; i < m_program.size(); i++)
             {
-                stack.push_back(
-                    token->as<FormulaTokenValue>()->operationValue());
+                arguments.push_back(m_program[i].constant);
             }
+            m_program.resize(programStart);
+            float result =
+                instruction.opcode == FormulaOpcode::operation
+                    ? applyOperation(arguments[0],
+                                     arguments[1],
+                                     instruction.type)
+                    : applyFunction(arguments.data(),
+                                    argumentsCount,
+                                    instruction.type);
+            instruction = FormulaInstruction();
+            instruction.opcode = FormulaOpcode::pushConstant;
+            instruction.constant = result;
+        }
+        m_program.push_back(instruction);
+        isConstant.push_back(instruction.opcode ==
+                             FormulaOpcode::pushConstant);
+        maxDepth = std::max(maxDepth, isConstant.size());
+    }
+
+    // If the formula is well formed, the stack at the end has to be of size
+    // 1, otherwise the input is passed through.
+    m_programReturnsInput = isConstant.size() != 1;
+    if (m_programReturnsInput)
+    {
+        m_program.clear();
+    }
+    m_stack.resize(maxDepth);
+}
+
+float DataConverterFormula::evaluate(float inputValue)
+{
+    if (!m_compiled)
+    {
+        compile();
+    }
+    if (m_forceInterpreter)
+    {
+        return interpret(inputValue);
+    }
+    if (m_programReturnsInput)
+    {
+        return inputValue;
+    }
+    float* stack = m_stack.data();
+    int size = 0;
+    for (const auto& instruction : m_program)
+    {
+        switch (instruction.opcode)
+        {
+            case FormulaOpcode::pushConstant:
+                stack[size++] = instruction.constant;
+                break;
+            case FormulaOpcode::pushInput:
+                stack[size++] = inputValue;
+                break;
+            case FormulaOpcode::pushValue:
+                stack[size++] = instruction.token->operationValue();
+                break;
+            case FormulaOpcode::operation:
+                size--;
+                stack[size - 1] = applyOperation(stack[size - 1],
+                                                 stack[size],
+                                                 instruction.type);
+                break;
+            case FormulaOpcode::function:
+                size -= instruction.argumentsCount;
+                stack[size] = applyFunction(stack + size,
+                                            instruction.argumentsCount,
+                                            instruction.type);
+                size++;
+                break;
         }
+    }
+    return stack[0];
+}
 
-        // If the formula is well formed, the stack at the end has to be of size
-        // 1
-        if (stack.size() == 1)
+float DataConverterFormula::interpret(float inputValue)
+{
+    float resultValue = inputValue;
+    std::vector<float> stack;
+    for (auto& token : m_outputQueue)
+    {
+        if (token->is<FormulaTokenOperation>())
         {
-            resultValue = stack.back();
-            stack.pop_back();
+            if (stack.size() > 1)
+            {
+                auto right = stack.back();
+                stack.pop_back();
+                auto left = stack.back();
+                stack.pop_back();
+                float operationResult = applyOperation(
+                    left,
+                    right,
+                    token->as<FormulaTokenOperation>()->operationType());
+                stack.push_back(operationResult);
+            }
         }
+        else if (token->is<FormulaTokenFunction>())
+        {
+            auto argumentsCount = m_argumentsCount.find(token);
+            int count = std::min(argumentsCount == m_argumentsCount.end()
+                                     ? 0
+                                     : argumentsCount->second,
+                                 (int)stack.size());
+            size_t argumentsStart = stack.size() - count;
+            float operationResult = applyFunction(
+                stack.data() + argumentsStart,
+                count,
+                token->as<FormulaTokenFunction>()->functionType());
+            stack.resize(argumentsStart);
+            stack.push_back(operationResult);
+        }
+        else if (token->is<FormulaTokenInput>())
+        {
+            stack.push_back(inputValue);
+        }
+        else if (token->is<FormulaTokenValue>())
+        {
+            stack.push_back(token->as<FormulaTokenValue>()->operationValue());
+        }
+    }
 
-        m_output.value(resultValue);
+    // If the formula is well formed, the stack at the end has to be of size
+    // 1
+    if (stack.size() == 1)
+    {
+        resultValue = stack.back();
+    }
+    return resultValue;
+}
+
+DataValue* DataConverterFormula::convert(DataValue* value, DataBind* dataBind)
+{
+    if (value->is<DataValueNumber>() || value->is<DataValueSymbolListIndex>())
+    {
+        float inputValue =
+            value->is<DataValueNumber>()
+                ? value->as<DataValueNumber>()->value()
+                : (float)(value->as<DataValueSymbolListIndex>()->value());
+        m_output.value(evaluate(inputValue));
     }
     else
     {
@@ -112,4 +112,17 @@ bool DataConverterGroup::advance(float elapsedSeconds)
         }
     }
     return didUpdate;
+}
+
+bool DataConverterGroup::advances() const
+{
+    for (auto& item : m_items)
+    {
+        auto converter = item->converter();
+        if (converter != nullptr && converter->advances())
+        {
+            return true;
+        }
+    }
+    return false;
 }
\ No newline at end of file
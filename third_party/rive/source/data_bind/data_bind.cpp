@@ -1,4 +1,5 @@
 #include "rive/data_bind/data_bind.hpp"
+#include "rive/data_bind/data_bind_queue.hpp"
 #include "rive/artboard.hpp"
 #include "rive/data_bind_flags.hpp"
 #include "rive/generated/core_registry.hpp"
@@ -284,6 +285,10 @@ void DataBind::addDirt(ComponentDirt value, bool recurse)
     }
 
     m_Dirt |= value;
+    if (m_queue != nullptr)
+    {
+        m_queue->queue(m_queueIndex);
+    }
 #ifdef WITH_RIVE_TOOLS
     if (m_changedCallback != nullptr)
     {
@@ -344,4 +349,24 @@ bool DataBind::advance(float elapsedTime)
         return converter()->advance(elapsedTime);
     }
     return false;
+}
+
+bool DataBind::advances() const
+{
+    return m_dataConverter != nullptr && m_dataConverter->advances();
+}
+
+void DataBind::queue(DataBindQueue* queue, uint32_t index)
+{
+    m_queue = queue;
+    m_queueIndex = index;
+}
+
+void DataBind::dequeue(DataBindQueue* queue)
+{
+    if (m_queue == queue)
+    {
+        m_queue = nullptr;
+        m_queueIndex = 0;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "rive/data_bind/data_bind_queue.hpp"
+#include "rive/data_bind/data_bind.hpp"
+
+using namespace rive;
+
+void DataBindQueue::attach(const std::vector<DataBind*>& binds,
+                           size_t pollCount)
+{
+    detach();
+    m_binds = binds;
+    m_pollCount = pollCount;
+    m_queuedBinds.assign(m_binds.size(), false);
+    for (uint32_t i = 0; i < m_binds.size(); i++)
+    {
+        auto dataBind = m_binds[i];
+        dataBind->queue(this, i);
+        if (dataBind->advances())
+        {
+            m_advancingBinds.push_back(dataBind);
+        }
+        if (dataBind->dirt() != ComponentDirt::None)
+        {
+            queue(i);
+        }
+    }
+}
+
+void DataBindQueue::detach()
+{
+    for (auto dataBind : m_binds)
+    {
+        dataBind->dequeue(this);
+    }
+    m_binds.clear();
+    m_advancingBinds.clear();
+    m_pollCount = 0;
+    m_dirtyBinds = {};
+    m_queuedBinds.clear();
+    m_deferredBinds.clear();
+}
+
+void DataBindQueue::queue(uint32_t index)
+{
+    if (m_queuedBinds[index])
+    {
+        return;
+    }
+    m_queuedBinds[index] = true;
+    m_dirtyBinds.push(index);
+}
+
+void DataBindQueue::visit(uint32_t index, bool syncSource)
+{
+    m_counters.visited++;
+    auto dataBind = m_binds[index];
+    if (syncSource)
+    {
+        dataBind->updateSourceBinding();
+    }
+    auto d = dataBind->dirt();
+    if (d == ComponentDirt::None)
+    {
+        return;
+    }
+    dataBind->dirt(ComponentDirt::None);
+    dataBind->update(d);
+    m_counters.updated++;
+}
+
+void DataBindQueue::update(bool syncSource)
+{
+    if (m_forceFullScan)
+    {
+        m_dirtyBinds = {};
+        m_queuedBinds.assign(m_binds.size(), false);
+        for (uint32_t i = 0; i < m_binds.size(); i++)
+        {
+            visit(i, syncSource);
+        }
+        return;
+    }
+    // Polled binds come first, so visiting them in order and then the
+    // queued ones above them keeps the order of a full scan.
+    bool visitedAny = false;
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < m_pollCount; i++)
+    {
+        visit(i, syncSource);
+        visitedAny = true;
+        last = i;
+    }
+    while (!m_dirtyBinds.empty())
+    {
+        uint32_t i = m_dirtyBinds.top();
+        m_dirtyBinds.pop();
+        if (visitedAny && i <= last)
+        {
+            // Dirtied after its turn; it's picked up by the next update,
+            // unless a poll already applied its dirt.
+            if (m_binds[i]->dirt() == ComponentDirt::None)
+            {
+                m_queuedBinds[i] = false;
+            }
+            else
+            {
+                m_deferredBinds.push_back(i);
+            }
+            continue;
+        }
+        m_queuedBinds[i] = false;
+        visitedAny = true;
+        last = i;
+        visit(i, syncSource);
+    }
+    for (auto i : m_deferredBinds)
+    {
+        m_dirtyBinds.push(i);
+    }
+    m_deferredBinds.clear();
+}
+
+bool DataBindQueue::advance(float elapsedSeconds)
+{
+    bool didAdvance = false;
+    for (auto dataBind : m_forceFullScan ? m_binds : m_advancingBinds)
+    {
+        if (dataBind->advance(elapsedSeconds))
+        {
+            didAdvance = true;
+        }
+    }
+    return didAdvance;
+}
@@ -0,0 +1,176 @@
+#include "rive/display_list.hpp"
+
+using namespace rive;
+
+void DisplayList::replay(Renderer* renderer) const
+{
+    const Mat2D* transform = m_transforms.data();
+    const rcp<RenderPath>* path = m_paths.data();
+    const rcp<RenderPaint>* paint = m_paints.data();
+    const ImageDraw* image = m_images.data();
+    const ImageMeshDraw* mesh = m_imageMeshes.data();
+    for (Command command : m_commands)
+    {
+        switch (command)
+        {
+            case Command::save:
+                renderer->save();
+                break;
+            case Command::restore:
+                renderer->restore();
+                break;
+            case Command::transform:
+                renderer->transform(*transform++);
+                break;
+            case Command::drawPath:
+                renderer->drawPath((path++)->get(), (paint++)->get());
+                break;
+            case Command::clipPath:
+                renderer->clipPath((path++)->get());
+                break;
+            case Command::drawImage:
+                renderer->drawImage(image->image.get(),
+                                    image->sampler,
+                                    image->blendMode,
+                                    image->opacity);
+                image++;
+                break;
+            case Command::drawImageMesh:
+                renderer->drawImageMesh(mesh->image.image.get(),
+                                        mesh->image.sampler,
+                                        mesh->vertices,
+                                        mesh->uvCoords,
+                                        mesh->indices,
+                                        mesh->vertexCount,
+                                        mesh->indexCount,
+                                        mesh->image.blendMode,
+                                        mesh->image.opacity);
+                mesh++;
+                break;
+        }
+    }
+}
+
+void DisplayList::replay(Renderer* renderer, const Mat2D& transform) const
+{
+    renderer->save();
+    renderer->transform(transform);
+    replay(renderer);
+    renderer->restore();
+}
+
+void DisplayList::shrinkToFit()
+{
+    m_commands.shrink_to_fit();
+    m_transforms.shrink_to_fit();
+    m_paths.shrink_to_fit();
+    m_paints.shrink_to_fit();
+    m_images.shrink_to_fit();
+    m_imageMeshes.shrink_to_fit();
+}
+
+RecordingRenderer::RecordingRenderer(Renderer* target) :
+    m_target(target), m_list(make_rcp<DisplayList>())
+{}
+
+rcp<DisplayList> RecordingRenderer::finish()
+{
+    rcp<DisplayList> list = std::move(m_list);
+    list->shrinkToFit();
+    m_list = make_rcp<DisplayList>();
+    return list;
+}
+
+void RecordingRenderer::save()
+{
+    m_list->m_commands.push_back(DisplayList::Command::save);
+    if (m_target != nullptr)
+    {
+        m_target->save();
+    }
+}
+
+void RecordingRenderer::restore()
+{
+    m_list->m_commands.push_back(DisplayList::Command::restore);
+    if (m_target != nullptr)
+    {
+        m_target->restore();
+    }
+}
+
+void RecordingRenderer::transform(const Mat2D& transform)
+{
+    m_list->m_commands.push_back(DisplayList::Command::transform);
+    m_list->m_transforms.push_back(transform);
+    if (m_target != nullptr)
+    {
+        m_target->transform(transform);
+    }
+}
+
+void RecordingRenderer::drawPath(RenderPath* path, RenderPaint* paint)
+{
+    m_list->m_commands.push_back(DisplayList::Command::drawPath);
+    m_list->m_paths.push_back(ref_rcp(path));
+    m_list->m_paints.push_back(ref_rcp(paint));
+    if (m_target != nullptr)
+    {
+        m_target->drawPath(path, paint);
+    }
+}
+
+void RecordingRenderer::clipPath(RenderPath* path)
+{
+    m_list->m_commands.push_back(DisplayList::Command::clipPath);
+    m_list->m_paths.push_back(ref_rcp(path));
+    if (m_target != nullptr)
+    {
+        m_target->clipPath(path);
+    }
+}
+
+void RecordingRenderer::drawImage(const RenderImage* image,
+                                  ImageSampler sampler,
+                                  BlendMode blendMode,
+                                  float opacity)
+{
+    m_list->m_commands.push_back(DisplayList::Command::drawImage);
+    m_list->m_images.push_back({ref_rcp(image), sampler, blendMode, opacity});
+    if (m_target != nullptr)
+    {
+        m_target->drawImage(image, sampler, blendMode, opacity);
+    }
+}
+
+void RecordingRenderer::drawImageMesh(const RenderImage* image,
+                                      ImageSampler sampler,
+                                      rcp<RenderBuffer> vertices_f32,
+                                      rcp<RenderBuffer> uvCoords_f32,
+                                      rcp<RenderBuffer> indices_u16,
+                                      uint32_t vertexCount,
+                                      uint32_t indexCount,
+                                      BlendMode blendMode,
+                                      float opacity)
+{
+    m_list->m_commands.push_back(DisplayList::Command::drawImageMesh);
+    m_list->m_imageMeshes.push_back(
+        {{ref_rcp(image), sampler, blendMode, opacity},
+         vertices_f32,
+         uvCoords_f32,
+         indices_u16,
+         vertexCount,
+         indexCount});
+    if (m_target != nullptr)
+    {
+        m_target->drawImageMesh(image,
+                                sampler,
+                                std::move(vertices_f32),
+                                std::move(uvCoords_f32),
+                                std::move(indices_u16),
+                                vertexCount,
+                                indexCount,
+                                blendMode,
+                                opacity);
+    }
+}
@@ -163,14 +163,23 @@ static Core* readRuntimeObject(BinaryReader& reader,
     return object;
 }
 
-File::File(Factory* factory, rcp<FileAssetLoader> assetLoader) :
-    m_factory(factory), m_assetLoader(std::move(assetLoader))
+File::File(Factory* factory,
+           rcp<FileAssetLoader> assetLoader,
+           rcp<ImageDecodePool> imageDecodePool) :
+    m_factory(factory),
+    m_assetLoader(std::move(assetLoader)),
+    m_imageDecodePool(std::move(imageDecodePool))
 {
     assert(factory);
 }
 
 File::~File()
 {
+    // Decodes still in flight point at our assets.
+    if (m_imageDecodePool != nullptr)
+    {
+        m_imageDecodePool->cancel(this);
+    }
     for (auto artboard : m_artboards)
     {
         delete artboard;
@@ -214,7 +223,55 @@ File::~File()
 std::unique_ptr<File> File::import(Span<const uint8_t> bytes,
                                    Factory* factory,
                                    ImportResult* result,
-                                   rcp<FileAssetLoader> assetLoader)
+                                   rcp<FileAssetLoader> assetLoader,
+                                   rcp<ImageDecodePool> imageDecodePool)
+{
+    return import(bytes,
+                  factory,
+                  result,
+                  std::move(assetLoader),
+                  std::move(imageDecodePool),
+                  false,
+                  false);
+}
+
+std::unique_ptr<File> File::importBorrowed(Span<const uint8_t> bytes,
+                                           Factory* factory,
+                                           ImportResult* result,
+                                           rcp<FileAssetLoader> assetLoader,
+                                           rcp<ImageDecodePool> imageDecodePool)
+{
+    return import(bytes,
+                  factory,
+                  result,
+                  std::move(assetLoader),
+                  std::move(imageDecodePool),
+                  true,
+                  false);
+}
+
+std::unique_ptr<File> File::importLazy(Span<const uint8_t> bytes,
+                                       Factory* factory,
+                                       ImportResult* result,
+                                       rcp<FileAssetLoader> assetLoader,
+                                       rcp<ImageDecodePool> imageDecodePool)
+{
+    return import(bytes,
+                  factory,
+                  result,
+                  std::move(assetLoader),
+                  std::move(imageDecodePool),
+                  true,
+                  true);
+}
+
+std::unique_ptr<File> File::import(Span<const uint8_t> bytes,
+                                   Factory* factory,
+                                   ImportResult* result,
+                                   rcp<FileAssetLoader> assetLoader,
+                                   rcp<ImageDecodePool> imageDecodePool,
+                                   bool borrowAssetBytes,
+                                   bool lazyArtboards)
 {
     BinaryReader reader(bytes);
     RuntimeHeader header;
@@ -241,9 +298,13 @@ std::unique_ptr<File> File::import(Span<const uint8_t> bytes,
         }
         return nullptr;
     }
-    auto file = rivestd::make_unique<File>(factory, std::move(assetLoader));
+    auto file = rivestd::make_unique<File>(factory,
+                                           std::move(assetLoader),
+                                           std::move(imageDecodePool));
 
-    auto readResult = file->read(reader, header);
+    auto readResult = lazyArtboards
+                          ? file->readLazy(reader, header)
+                          : file->read(reader, header, borrowAssetBytes);
     if (result)
     {
         *result = readResult;
@@ -255,9 +316,25 @@ std::unique_ptr<File> File::import(Span<const uint8_t> bytes,
     return file;
 }
 
-ImportResult File::read(BinaryReader& reader, const RuntimeHeader& header)
+ImportResult File::read(BinaryReader& reader,
+                        const RuntimeHeader& header,
+                        bool borrowAssetBytes)
 {
     ImportStack importStack;
+    auto result =
+        readObjects(reader, header, importStack, borrowAssetBytes, m_artboards);
+    return result == ImportResult::success &&
+                   importStack.resolve() == StatusCode::Ok
+               ? ImportResult::success
+               : ImportResult::malformed;
+}
+
+ImportResult File::readObjects(BinaryReader& reader,
+                               const RuntimeHeader& header,
+                               ImportStack& importStack,
+                               bool borrowAssetBytes,
+                               std::vector<Artboard*>& artboards)
+{
     // TODO: @hernan consider moving this to a special importer. It's not that
     // simple because Core doesn't have a typeKey, so it should be treated as
     // a special case. In any case, it's not that bad having it here for now.
@@ -270,6 +347,12 @@ ImportResult File::read(BinaryReader& reader, const RuntimeHeader& header)
             importStack.readNullObject();
             continue;
         }
+        if (!borrowAssetBytes && object->is<FileAssetContents>())
+        {
+            // Assets may hold on to their bytes (audio does), so copy them
+            // unless the caller guarantees the data outlives the file.
+            object->as<FileAssetContents>()->ownBytes();
+        }
         if (!object->is<DataBind>())
         {
             lastBindableObject = object;
@@ -289,7 +372,7 @@ ImportResult File::read(BinaryReader& reader, const RuntimeHeader& header)
                 {
                     Artboard* ab = object->as<Artboard>();
                     ab->m_Factory = m_factory;
-                    m_artboards.push_back(ab);
+                    artboards.push_back(ab);
                 }
                 break;
                 case ImageAsset::typeKey:
@@ -424,7 +507,9 @@ ImportResult File::read(BinaryReader& reader, const RuntimeHeader& header)
                 stackObject = rivestd::make_unique<FileAssetImporter>(
                     object->as<FileAsset>(),
                     m_assetLoader,
-                    m_factory);
+                    m_factory,
+                    m_imageDecodePool.get(),
+                    this);
                 stackType = FileAsset::typeKey;
                 break;
             case ViewModel::typeKey:
@@ -517,43 +602,275 @@ ImportResult File::read(BinaryReader& reader, const RuntimeHeader& header)
         }
     }
 
-    return !reader.hasError() && importStack.resolve() == StatusCode::Ok
-               ? ImportResult::success
-               : ImportResult::malformed;
+    return reader.hasError() ? ImportResult::malformed : ImportResult::success;
 }
 
-Artboard* File::artboard(std::string name) const
+// Objects that register themselves with the file rather than an artboard.
+// Lazy import requires all of them to come before the first artboard.
+static bool isFileLevelObject(const Core* object)
+{
+    return object->is<Backboard>() || object->is<FileAsset>() ||
+           object->is<ViewModel>() || object->is<ViewModelInstance>() ||
+           object->is<DataEnum>() || object->is<DataConverter>() ||
+           object->is<ScrollPhysics>();
+}
+
+// Steps over one object without instancing it and returns its type key.
+// Returns -1 if a property can't be skipped. fieldIds caches the field type
+// of each property key seen so far (-2 when not looked up yet).
+static int skipRuntimeObject(BinaryReader& reader,
+                             const RuntimeHeader& header,
+                             std::vector<int8_t>& fieldIds)
 {
-    for (const auto& artboard : m_artboards)
+    auto coreObjectKey = reader.readVarUintAs<int>();
+    while (true)
     {
-        if (artboard->name() == name)
+        auto propertyKey = reader.readVarUintAs<uint16_t>();
+        if (propertyKey == 0)
+        {
+            break;
+        }
+        if (reader.hasError())
+        {
+            return -1;
+        }
+        if (propertyKey >= fieldIds.size())
         {
-            return artboard;
+            fieldIds.resize(propertyKey + 1, -2);
+        }
+        int id = fieldIds[propertyKey];
+        if (id == -2)
+        {
+            id = CoreRegistry::propertyFieldId(propertyKey);
+            if (id == -1)
+            {
+                id = header.propertyFieldId(propertyKey);
+            }
+            fieldIds[propertyKey] = static_cast<int8_t>(id);
+        }
+        switch (id)
+        {
+            case CoreUintType::id:
+                reader.readVarUint64();
+                break;
+            case CoreStringType::id:
+                reader.readBytes();
+                break;
+            case CoreDoubleType::id:
+                reader.readFloat32();
+                break;
+            case CoreColorType::id:
+                reader.readUint32();
+                break;
+            default:
+                return -1;
         }
     }
-    return nullptr;
+    return reader.hasError() ? -1 : coreObjectKey;
 }
 
-Artboard* File::artboard() const
+ImportResult File::readLazy(BinaryReader& reader, const RuntimeHeader& header)
 {
-    if (m_artboards.empty())
+    // Index pass: find where each artboard's objects start and end. An
+    // artboard runs until the next artboard or the end of the file.
+    const uint8_t* fileLevelEnd = nullptr;
+    std::vector<LazyArtboard> lazyArtboards;
+    // Per type key: -1 not classified yet, else whether it's file level.
+    std::vector<int8_t> fileLevelTypes;
+    std::vector<int8_t> fieldIds;
+    BinaryReader scanner = reader;
+    while (!scanner.reachedEnd())
     {
-        return nullptr;
+        const uint8_t* objectStart = scanner.position();
+        int typeKey = skipRuntimeObject(scanner, header, fieldIds);
+        if (typeKey == -1)
+        {
+            // Let the regular import report the problem.
+            return read(reader, header, true);
+        }
+        if (typeKey == Artboard::typeKey)
+        {
+            if (!lazyArtboards.empty())
+            {
+                lazyArtboards.back().bytes = Span<const uint8_t>(
+                    lazyArtboards.back().bytes.data(),
+                    objectStart - lazyArtboards.back().bytes.data());
+            }
+            else
+            {
+                fileLevelEnd = objectStart;
+            }
+            // Only the artboard object itself is read now, for its name.
+            BinaryReader artboardReader(
+                Span<const uint8_t>(objectStart,
+                                    scanner.position() - objectStart));
+            Core* artboard = readRuntimeObject(artboardReader, header);
+            LazyArtboard lazy;
+            lazy.bytes = Span<const uint8_t>(objectStart, 0);
+            if (artboard != nullptr)
+            {
+                lazy.name = artboard->as<Artboard>()->name();
+                delete artboard;
+            }
+            lazyArtboards.push_back(lazy);
+            continue;
+        }
+        if (lazyArtboards.empty())
+        {
+            continue;
+        }
+        if ((size_t)typeKey >= fileLevelTypes.size())
+        {
+            fileLevelTypes.resize(typeKey + 1, -1);
+        }
+        if (fileLevelTypes[typeKey] == -1)
+        {
+            Core* probe = CoreRegistry::makeCoreInstance(typeKey);
+            fileLevelTypes[typeKey] =
+                probe != nullptr && isFileLevelObject(probe) ? 1 : 0;
+            delete probe;
+        }
+        if (fileLevelTypes[typeKey] == 1)
+        {
+            // Interleaved with artboards, reading artboards on their own
+            // would change what they see.
+            return read(reader, header, true);
+        }
+    }
+    if (lazyArtboards.empty())
+    {
+        return read(reader, header, true);
+    }
+    lazyArtboards.back().bytes =
+        Span<const uint8_t>(lazyArtboards.back().bytes.data(),
+                            scanner.position() -
+                                lazyArtboards.back().bytes.data());
+
+    // Read the file level objects as usual, artboards come later.
+    BinaryReader fileLevelReader(
+        Span<const uint8_t>(reader.position(),
+                            fileLevelEnd - reader.position()));
+    ImportResult result = read(fileLevelReader, header, true);
+    if (result != ImportResult::success)
+    {
+        return result;
     }
-    return m_artboards[0];
+    m_lazyArtboards = std::move(lazyArtboards);
+    m_artboards.assign(m_lazyArtboards.size(), nullptr);
+    m_lazyHeader = rivestd::make_unique<RuntimeHeader>(header);
+    return ImportResult::success;
 }
 
+bool File::hasLazyArtboards() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+    for (const auto& lazy : m_lazyArtboards)
+    {
+        if (lazy.state == LazyState::pending)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Artboard* File::importLazyArtboard(size_t index)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+    LazyArtboard& lazy = m_lazyArtboards[index];
+    if (lazy.state != LazyState::pending)
+    {
+        return m_artboards[index];
+    }
+    lazy.state = LazyState::importing;
+
+    ImportStack importStack;
+    auto backboardImporter =
+        rivestd::make_unique<BackboardImporter>(m_backboard);
+    backboardImporter->file(this);
+    backboardImporter->resume(static_cast<int>(index),
+                              this,
+                              m_fileAssets,
+                              m_DataConverters,
+                              m_keyframeInterpolators,
+                              m_scrollPhysics);
+    importStack.makeLatest(Backboard::typeKey, std::move(backboardImporter));
+
+    BinaryReader reader(lazy.bytes);
+    std::vector<Artboard*> artboards;
+    ImportResult result =
+        readObjects(reader, *m_lazyHeader, importStack, true, artboards);
+    Artboard* artboard = artboards.size() == 1 ? artboards.front() : nullptr;
+    // Published before resolving so nested artboards that lead back here
+    // find it instead of importing it again.
+    m_artboards[index] = artboard;
+    if (result != ImportResult::success ||
+        importStack.resolve() != StatusCode::Ok || artboard == nullptr)
+    {
+        fprintf(stderr, "Failed to import artboard %zu\n", index);
+        m_artboards[index] = nullptr;
+        for (auto ab : artboards)
+        {
+            delete ab;
+        }
+    }
+    lazy.state = LazyState::done;
+    return m_artboards[index];
+}
+
+void File::importLazyArtboards()
+{
+    for (size_t i = 0; i < m_lazyArtboards.size(); i++)
+    {
+        importLazyArtboard(i);
+    }
+}
+
+std::vector<Artboard*> File::artboards()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_lazyMutex);
+    importLazyArtboards();
+    return m_artboards;
+}
+
+Artboard* File::artboard(std::string name) const
+{
+    for (size_t i = 0; i < m_artboards.size(); i++)
+    {
+        // A lazy file's names are indexed up front and never change, so
+        // they can be read without the lock.
+        if (!m_lazyArtboards.empty() ? m_lazyArtboards[i].name == name
+                                     : m_artboards[i] != nullptr &&
+                                           m_artboards[i]->name() == name)
+        {
+            return this->artboard(i);
+        }
+    }
+    return nullptr;
+}
+
+Artboard* File::artboard() const { return artboard((size_t)0); }
+
 Artboard* File::artboard(size_t index) const
 {
     if (index >= m_artboards.size())
     {
         return nullptr;
     }
+    if (!m_lazyArtboards.empty())
+    {
+        // Importing on first request is invisible to callers, hence const.
+        return const_cast<File*>(this)->importLazyArtboard(index);
+    }
     return m_artboards[index];
 }
 
 std::string File::artboardNameAt(size_t index) const
 {
+    if (index < m_artboards.size() && !m_lazyArtboards.empty())
+    {
+        return m_lazyArtboards[index].name;
+    }
     auto ab = this->artboard(index);
     return ab ? ab->name() : "";
 }
@@ -858,9 +1175,11 @@ ViewModelInstanceListItem* File::viewModelInstanceListItem(
     // It will return the first one it finds, but there could be more.
     // We should decide if we want to be more restrictive and only return
     // an artboard if one and only one is found.
+    importLazyArtboards();
     for (auto& artboard : m_artboards)
     {
-        if (artboard->viewModelId() == viewModelInstance->viewModelId())
+        if (artboard != nullptr &&
+            artboard->viewModelId() == viewModelInstance->viewModelId())
         {
             return viewModelInstanceListItem(viewModelInstance, artboard);
         }
@@ -81,6 +81,16 @@ StatusCode BackboardImporter::resolve()
                 nestedArtboard->nest(artboard);
             }
         }
+        else if (m_lazyFile != nullptr)
+        {
+            // Imports the nested artboard now if it hasn't been yet.
+            auto artboard =
+                m_lazyFile->artboard((size_t)nestedArtboard->artboardId());
+            if (artboard != nullptr)
+            {
+                nestedArtboard->nest(artboard);
+            }
+        }
     }
     for (auto referencer : m_FileAssetReferencers)
     {
@@ -170,4 +180,22 @@ void BackboardImporter::addPhysics(ScrollPhysics* physics)
     m_physics.push_back(physics);
 }
 
+void BackboardImporter::resume(
+    int artboardId,
+    const File* lazyFile,
+    const std::vector<FileAsset*>& assets,
+    const std::vector<DataConverter*>& converters,
+    const std::vector<KeyFrameInterpolator*>& interpolators,
+    const std::vector<ScrollPhysics*>& physics)
+{
+    // Asset ids were already made unique by the first import, and the
+    // interpolators already initialized, so take the lists as they are.
+    m_NextArtboardId = artboardId;
+    m_lazyFile = lazyFile;
+    m_FileAssets = assets;
+    m_DataConverters = converters;
+    m_interpolators = interpolators;
+    m_physics = physics;
+}
+
 void BackboardImporter::file(File* value) { m_file = value; }
\ No newline at end of file
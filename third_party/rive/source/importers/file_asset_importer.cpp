@@ -1,6 +1,9 @@
 #include "rive/importers/file_asset_importer.hpp"
 #include "rive/assets/file_asset_contents.hpp"
 #include "rive/assets/file_asset.hpp"
+#include "rive/assets/image_asset.hpp"
+#include "rive/assets/image_decode_pool.hpp"
+#include "rive/factory.hpp"
 #include "rive/file_asset_loader.hpp"
 #include "rive/span.hpp"
 #include <cstdint>
@@ -9,10 +12,14 @@ using namespace rive;
 
 FileAssetImporter::FileAssetImporter(FileAsset* fileAsset,
                                      rcp<FileAssetLoader> assetLoader,
-                                     Factory* factory) :
+                                     Factory* factory,
+                                     ImageDecodePool* imageDecodePool,
+                                     const File* file) :
     m_FileAsset(fileAsset),
     m_FileAssetLoader(std::move(assetLoader)),
-    m_Factory(factory)
+    m_Factory(factory),
+    m_ImageDecodePool(imageDecodePool),
+    m_File(file)
 {}
 
 // if file asset contents are found when importing a rive file, store those for
@@ -43,7 +50,32 @@ StatusCode FileAssetImporter::resolve()
     // If we do not, but we have found in band contents, load those
     else if (bytes.size() > 0)
     {
-        m_FileAsset->decode(m_Content->bytes(), m_Factory);
+        // Images decode on the pool's workers when the factory can decode
+        // without uploading; their render images are set once resolved.
+        if (m_ImageDecodePool != nullptr && m_FileAsset->is<ImageAsset>() &&
+            m_Factory->canDecodeImagePixels())
+        {
+            auto imageAsset = m_FileAsset->as<ImageAsset>();
+            if (m_Content->isBorrowed())
+            {
+                m_ImageDecodePool->queue(m_File, imageAsset, m_Factory, bytes);
+            }
+            else
+            {
+                m_ImageDecodePool->queue(m_File,
+                                         imageAsset,
+                                         m_Factory,
+                                         m_Content->ownedBytes());
+            }
+        }
+        else if (m_Content->isBorrowed())
+        {
+            m_FileAsset->decode(bytes, m_Factory);
+        }
+        else
+        {
+            m_FileAsset->decode(m_Content->ownedBytes(), m_Factory);
+        }
     }
 
     // Note that it's ok for an asset to not resolve (or to resolve async).
@@ -367,14 +367,62 @@ static YGSize measureFunc(YGNode* node,
                           YGMeasureMode heightMode)
 {
     Vec2D size = ((LayoutComponent*)node->getContext())
-                     ->measureLayout(width,
-                                     (LayoutMeasureMode)widthMode,
-                                     height,
-                                     (LayoutMeasureMode)heightMode);
+                     ->measureIntrinsicSize(width,
+                                            (LayoutMeasureMode)widthMode,
+                                            height,
+                                            (LayoutMeasureMode)heightMode);
 
     return YGSize{size.x, size.y};
 }
 
+// Yoga caches fewer results per node than this. Past it any intrinsic size
+// change is assumed to affect layout.
+static constexpr size_t maxIntrinsicMeasurements = 16;
+
+Vec2D LayoutComponent::measureIntrinsicSize(float width,
+                                            LayoutMeasureMode widthMode,
+                                            float height,
+                                            LayoutMeasureMode heightMode)
+{
+    Vec2D size = measureLayout(width, widthMode, height, heightMode);
+    if (m_intrinsicMeasurements.size() < maxIntrinsicMeasurements)
+    {
+        m_intrinsicMeasurements.push_back(
+            {width, widthMode, height, heightMode, size});
+    }
+    else
+    {
+        m_intrinsicMeasurementsOverflowed = true;
+    }
+    return size;
+}
+
+bool LayoutComponent::intrinsicSizeChanged()
+{
+    if (m_intrinsicMeasurementsOverflowed)
+    {
+        return true;
+    }
+    for (const IntrinsicMeasurement& measurement : m_intrinsicMeasurements)
+    {
+        if (measureLayout(measurement.width,
+                          measurement.widthMode,
+                          measurement.height,
+                          measurement.heightMode) != measurement.size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LayoutComponent::markYogaNodeDirty()
+{
+    m_intrinsicMeasurements.clear();
+    m_intrinsicMeasurementsOverflowed = false;
+    m_layoutData->node.markDirtyAndPropagate();
+}
+
 Vec2D LayoutComponent::measureLayout(float width,
                                      LayoutMeasureMode widthMode,
                                      float height,
@@ -445,12 +493,19 @@ void* LayoutComponent::layoutNode(int index)
 
 void LayoutComponent::syncStyle()
 {
-    if (m_style == nullptr || m_layoutData == nullptr)
+    if (m_layoutData == nullptr)
     {
         return;
     }
+    if (m_style == nullptr)
+    {
+        // Nothing to compare against, assume the change affects layout.
+        markYogaNodeDirty();
+        return;
+    }
     YGNode& ygNode = m_layoutData->node;
     YGStyle& ygStyle = m_layoutData->style;
+    bool hadMeasureFunc = ygNode.hasMeasureFunc();
     if (m_style->intrinsicallySized() && isLeaf())
     {
         ygNode.setContext(this);
@@ -799,7 +854,20 @@ void LayoutComponent::syncStyle()
     ygStyle.flexWrap() = m_style->flexWrap();
     ygStyle.direction() = m_style->direction();
 
-    ygNode.setStyle(ygStyle);
+    // Many changes (animated non-layout properties of text, paths and
+    // nested artboards) mark the layout dirty without moving anything. Only
+    // dirty the Yoga node, and so re-run layout for this part of the tree,
+    // if its style or intrinsic size actually changed.
+    if (ygNode.hasMeasureFunc() != hadMeasureFunc ||
+        ygNode.getStyle() != ygStyle)
+    {
+        ygNode.setStyle(ygStyle);
+        markYogaNodeDirty();
+    }
+    else if (ygNode.hasMeasureFunc() && intrinsicSizeChanged())
+    {
+        markYogaNodeDirty();
+    }
 }
 
 void LayoutComponent::clearLayoutChildren()
@@ -894,12 +962,25 @@ void LayoutComponent::propagateSizeToChildren(ContainerComponent* component)
     }
 }
 
-void LayoutComponent::calculateLayout()
+bool LayoutComponent::calculateLayout()
 {
-    YGNodeCalculateLayout(&m_layoutData->node,
-                          width(),
-                          height(),
+    YGNode& node = m_layoutData->node;
+    float availableWidth = width();
+    float availableHeight = height();
+    // Dirt propagates to the root, so a clean root means Yoga would only
+    // return its cached results.
+    if (!node.isDirty() && availableWidth == m_calculatedWidth &&
+        availableHeight == m_calculatedHeight)
+    {
+        return false;
+    }
+    m_calculatedWidth = availableWidth;
+    m_calculatedHeight = availableHeight;
+    YGNodeCalculateLayout(&node,
+                          availableWidth,
+                          availableHeight,
                           YGDirection::YGDirectionInherit);
+    return true;
 }
 
 bool LayoutComponent::styleDisplayHidden()
@@ -964,6 +1045,7 @@ void LayoutComponent::updateLayoutBounds(bool animate)
         return;
     }
     node.setHasNewLayout(false);
+    artboard()->layoutNodeVisited();
 
     if (m_style != nullptr && styleDisplayHidden() != m_displayHidden)
     {
@@ -1280,6 +1362,7 @@ bool LayoutComponent::applyInterpolation(float elapsedSeconds, bool animate)
     if (f != 1)
     {
         // Do we really need to mark the layout node dirty!!??
+        markYogaNodeDirty();
         markLayoutNodeDirty();
         return true;
     }
@@ -1300,8 +1383,11 @@ void LayoutComponent::markLayoutNodeDirty(bool shouldForceUpdateLayoutBounds)
     if (shouldForceUpdateLayoutBounds == true)
     {
         m_forceUpdateLayoutBounds = shouldForceUpdateLayoutBounds;
+        // The bounds only get re-applied after a new layout, so make sure
+        // there is one even if the style ends up unchanged.
+        markYogaNodeDirty();
     }
-    m_layoutData->node.markDirtyAndPropagate();
+    // syncStyle marks the Yoga node dirty if the change affects layout.
     artboard()->markLayoutDirty(this);
 }
 
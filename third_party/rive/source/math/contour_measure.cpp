@@ -6,6 +6,7 @@
 #include "rive/math/raw_path_utils.hpp"
 #include "rive/math/contour_measure.hpp"
 #include "rive/math/math_types.hpp"
+#include "rive/math/simd.hpp"
 #include "rive/math/wangs_formula.hpp"
 #include <cmath>
 #include <limits>
@@ -332,9 +333,83 @@ static inline unsigned toDot30(float x)
     return (unsigned)(x * (1 << 30));
 }
 
+// Arbirtary limit to keep our segmenting tractable.
+constexpr static uint32_t kMaxSegments = 100;
+
 // These add[SegmentType]Segs routines append intermediate segments for the
 // curve. They assume the caller has set the initial segment (with t == 0), so
 // they only add intermediates.
+//
+// The curve's points are evaluated four at a time into separate x and y
+// arrays, which lets the chord lengths also be computed four at a time. t
+// still steps by dt and distances are summed one segment at a time, so the
+// results match evaluating one point at a time exactly.
+
+// coeffs are the curve's polynomial coefficients, highest power first.
+template <int N>
+static float add_curve_segs(ContourMeasure::Segment* segs,
+                            const Vec2D (&coeffs)[N],
+                            Vec2D p0,
+                            Vec2D pLast,
+                            uint32_t segmentCount,
+                            uint32_t ptIndex,
+                            float distance,
+                            SegmentType type)
+{
+    assert(segmentCount > 0 && segmentCount <= kMaxSegments);
+
+    // Point i is at t[i]. The extra slots pad the final group of four.
+    float t[kMaxSegments + 4], x[kMaxSegments + 4], y[kMaxSegments + 4];
+    float lengths[kMaxSegments + 4];
+
+    const float dt = 1.f / (float)segmentCount;
+    float nextT = dt;
+    for (uint32_t i = 1; i < segmentCount; ++i)
+    {
+        t[i] = nextT;
+        nextT += dt;
+    }
+    for (uint32_t i = segmentCount; i < segmentCount + 3; ++i)
+    {
+        t[i] = 1.0f;
+    }
+
+    for (uint32_t i = 1; i < segmentCount; i += 4)
+    {
+        const float4 ts = simd::load4f(t + i);
+        float4 xs = coeffs[0].x, ys = coeffs[0].y;
+        for (int j = 1; j < N; ++j)
+        {
+            xs = xs * ts + coeffs[j].x;
+            ys = ys * ts + coeffs[j].y;
+        }
+        simd::store(x + i, xs);
+        simd::store(y + i, ys);
+    }
+    x[0] = p0.x;
+    y[0] = p0.y;
+    for (uint32_t i = segmentCount; i < segmentCount + 4; ++i)
+    {
+        x[i] = pLast.x;
+        y[i] = pLast.y;
+    }
+
+    for (uint32_t i = 0; i < segmentCount; i += 4)
+    {
+        const float4 dx = simd::load4f(x + i + 1) - simd::load4f(x + i);
+        const float4 dy = simd::load4f(y + i + 1) - simd::load4f(y + i);
+        simd::store(lengths + i, simd::sqrt(dx * dx + dy * dy));
+    }
+
+    for (uint32_t i = 1; i < segmentCount; ++i)
+    {
+        distance += lengths[i - 1];
+        *segs++ = {distance, ptIndex, toDot30(t[i]), type};
+    }
+    distance += lengths[segmentCount - 1];
+    *segs++ = {distance, ptIndex, kMaxDot30, type};
+    return distance;
+}
 
 float ContourMeasureIter::addQuadSegs(ContourMeasure::Segment* segs,
                                       const Vec2D pts[],
@@ -342,22 +417,16 @@ float ContourMeasureIter::addQuadSegs(ContourMeasure::Segment* segs,
                                       uint32_t ptIndex,
                                       float distance) const
 {
-    const float dt = 1.f / (float)segmentCount;
     const EvalQuad eval(pts);
-
-    float t = dt;
-    Vec2D prev = pts[0];
-    for (uint32_t i = 1; i < segmentCount; ++i)
-    {
-        auto next = eval(t);
-        distance += (next - prev).length();
-        *segs++ = {distance, ptIndex, toDot30(t), SegmentType::kQuad};
-        prev = next;
-        t += dt;
-    }
-    distance += (pts[2] - prev).length();
-    *segs++ = {distance, ptIndex, kMaxDot30, SegmentType::kQuad};
-    return distance;
+    const Vec2D coeffs[] = {eval.a, eval.b, eval.c};
+    return add_curve_segs(segs,
+                          coeffs,
+                          pts[0],
+                          pts[2],
+                          segmentCount,
+                          ptIndex,
+                          distance,
+                          SegmentType::kQuad);
 }
 
 float ContourMeasureIter::addCubicSegs(ContourMeasure::Segment* segs,
@@ -366,22 +435,16 @@ float ContourMeasureIter::addCubicSegs(ContourMeasure::Segment* segs,
                                        uint32_t ptIndex,
                                        float distance) const
 {
-    const float dt = 1.f / (float)segmentCount;
     const EvalCubic eval(pts);
-
-    float t = dt;
-    Vec2D prev = pts[0];
-    for (uint32_t i = 1; i < segmentCount; ++i)
-    {
-        auto next = eval(t);
-        distance += (next - prev).length();
-        *segs++ = {distance, ptIndex, toDot30(t), SegmentType::kCubic};
-        prev = next;
-        t += dt;
-    }
-    distance += (pts[3] - prev).length();
-    *segs++ = {distance, ptIndex, kMaxDot30, SegmentType::kCubic};
-    return distance;
+    const Vec2D coeffs[] = {eval.a, eval.b, eval.c, eval.d};
+    return add_curve_segs(segs,
+                          coeffs,
+                          pts[0],
+                          pts[3],
+                          segmentCount,
+                          ptIndex,
+                          distance,
+                          SegmentType::kCubic);
 }
 
 void ContourMeasureIter::rewind(const RawPath* path, float tolerance)
@@ -432,8 +495,6 @@ rcp<ContourMeasure> ContourMeasureIter::tryNext()
     RawPath::Iter endOfContour = m_end;
     for (auto it = m_iter; it != m_end; ++it)
     {
-        // Arbirtary limit to keep our segmenting tractable.
-        constexpr static uint32_t kMaxSegments = 100;
         switch (it.verb())
         {
             case PathVerb::move:
@@ -593,3 +654,29 @@ rcp<ContourMeasure> ContourMeasureIter::next()
     assert(!cm || !std::isnan(cm->length()));
     return cm;
 }
+
+const std::vector<rcp<ContourMeasure>>& ContourMeasureCache::measure(
+    const RawPath* path,
+    float tol)
+{
+    if (m_isValid && tol == m_tolerance && *path == m_source)
+    {
+        return m_contours;
+    }
+    m_contours.clear();
+    ContourMeasureIter iter(path, tol);
+    while (auto meas = iter.next())
+    {
+        m_contours.push_back(meas);
+    }
+    m_source = *path;
+    m_tolerance = tol;
+    m_isValid = true;
+    return m_contours;
+}
+
+void ContourMeasureCache::clear()
+{
+    m_isValid = false;
+    m_contours.clear();
+}
@@ -74,12 +74,25 @@ void NestedArtboard::draw(Renderer* renderer)
     }
     if (clipResult != ClipResult::emptyClip)
     {
+        // Cull the nested artboard's drawables to what's left of the region
+        // this artboard draws.
+        m_Artboard->viewportFromHost(artboard(), worldTransform());
         renderer->transform(worldTransform());
         m_Artboard->draw(renderer);
     }
     renderer->restore();
 }
 
+bool NestedArtboard::computeDrawBounds(AABB* bounds)
+{
+    if (m_Artboard == nullptr || !m_Artboard->clip())
+    {
+        return false;
+    }
+    *bounds = worldTransform().mapBoundingBox(m_Artboard->bounds());
+    return true;
+}
+
 Core* NestedArtboard::hitTest(HitInfo* hinfo, const Mat2D& xform)
 {
     if (m_Artboard == nullptr)
@@ -0,0 +1,249 @@
+#include "rive/profiler/profiler.hpp"
+
+#ifdef RIVE_PROFILER
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace rive;
+
+namespace
+{
+// A thread's ring buffer. Its mutex is only contended while the buffers are
+// being read.
+struct ProfilerThreadBuffer
+{
+    std::mutex mutex;
+    uint32_t threadIndex = 0;
+    uint64_t writeCount = 0;
+    std::vector<Profiler::Event> events;
+    // Guarded by the registry's mutex.
+    bool inUse = false;
+};
+
+// Buffers outlive their threads, so zones of threads that already exited can
+// still be exported. A new thread takes over the buffer of an exited one.
+struct ProfilerRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfilerThreadBuffer>> buffers;
+};
+
+ProfilerRegistry& profilerRegistry()
+{
+    // Leaked, since threads may record while static destructors run.
+    static ProfilerRegistry* registry = new ProfilerRegistry;
+    return *registry;
+}
+
+struct ProfilerThreadBufferLease
+{
+    ProfilerThreadBuffer* buffer = nullptr;
+
+    ~ProfilerThreadBufferLease()
+    {
+        if (buffer != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(profilerRegistry().mutex);
+            buffer->inUse = false;
+        }
+    }
+};
+
+thread_local ProfilerThreadBufferLease t_lease;
+
+ProfilerThreadBuffer* currentThreadBuffer()
+{
+    if (t_lease.buffer != nullptr)
+    {
+        return t_lease.buffer;
+    }
+    ProfilerRegistry& reg = profilerRegistry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers)
+    {
+        if (!buffer->inUse)
+        {
+            t_lease.buffer = buffer.get();
+            break;
+        }
+    }
+    if (t_lease.buffer == nullptr)
+    {
+        auto buffer = std::make_unique<ProfilerThreadBuffer>();
+        buffer->threadIndex = static_cast<uint32_t>(reg.buffers.size());
+        buffer->events.resize(Profiler::kEventsPerThread);
+        t_lease.buffer = buffer.get();
+        reg.buffers.push_back(std::move(buffer));
+    }
+    t_lease.buffer->inUse = true;
+    return t_lease.buffer;
+}
+
+struct ProfilerThreadEvents
+{
+    uint32_t threadIndex;
+    std::vector<Profiler::Event> events;
+};
+
+// Copies every buffer's events, oldest first.
+std::vector<ProfilerThreadEvents> snapshotThreadEvents()
+{
+    std::vector<ProfilerThreadEvents> threads;
+    ProfilerRegistry& reg = profilerRegistry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        uint64_t count =
+            std::min<uint64_t>(buffer->writeCount, Profiler::kEventsPerThread);
+        if (count == 0)
+        {
+            continue;
+        }
+        ProfilerThreadEvents thread;
+        thread.threadIndex = buffer->threadIndex;
+        thread.events.reserve(count);
+        for (uint64_t i = buffer->writeCount - count; i < buffer->writeCount;
+             ++i)
+        {
+            thread.events.push_back(
+                buffer->events[i % Profiler::kEventsPerThread]);
+        }
+        threads.push_back(std::move(thread));
+    }
+    return threads;
+}
+
+// Nearest rank percentile of sorted durations.
+double percentileMicros(const std::vector<uint64_t>& sorted, double p)
+{
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::max<size_t>(rank, 1) - 1] / 1000.0;
+}
+
+void writeTraceString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (; *str != '\0'; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+        {
+            out << '\\';
+        }
+        out << *str;
+    }
+    out << '"';
+}
+} // namespace
+
+std::chrono::steady_clock::time_point Profiler::epoch()
+{
+    static const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    return start;
+}
+
+void Profiler::record(const char* name,
+                      uint64_t startNanos,
+                      uint64_t durationNanos)
+{
+    ProfilerThreadBuffer* buffer = currentThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->events[buffer->writeCount++ % kEventsPerThread] = {name,
+                                                               startNanos,
+                                                               durationNanos};
+}
+
+std::vector<Profiler::ZoneStats> Profiler::zoneStats()
+{
+    // Grouped by content, since the same name may live at several addresses.
+    std::unordered_map<std::string, std::vector<uint64_t>> durations;
+    std::unordered_map<std::string, const char*> names;
+    for (const ProfilerThreadEvents& thread : snapshotThreadEvents())
+    {
+        for (const Event& event : thread.events)
+        {
+            std::string key(event.name);
+            durations[key].push_back(event.durationNanos);
+            names.emplace(key, event.name);
+        }
+    }
+
+    std::vector<ZoneStats> stats;
+    stats.reserve(durations.size());
+    for (auto& entry : durations)
+    {
+        std::vector<uint64_t>& sorted = entry.second;
+        std::sort(sorted.begin(), sorted.end());
+        ZoneStats zone;
+        zone.name = names[entry.first];
+        zone.count = sorted.size();
+        zone.p50Micros = percentileMicros(sorted, 0.50);
+        zone.p95Micros = percentileMicros(sorted, 0.95);
+        zone.p99Micros = percentileMicros(sorted, 0.99);
+        zone.maxMicros = sorted.back() / 1000.0;
+        uint64_t totalNanos = 0;
+        for (uint64_t duration : sorted)
+        {
+            totalNanos += duration;
+        }
+        zone.totalMicros = totalNanos / 1000.0;
+        stats.push_back(zone);
+    }
+    std::sort(stats.begin(),
+              stats.end(),
+              [](const ZoneStats& a, const ZoneStats& b) {
+                  return a.totalMicros > b.totalMicros;
+              });
+    return stats;
+}
+
+void Profiler::writeChromeTrace(std::ostream& out)
+{
+    std::vector<ProfilerThreadEvents> threads = snapshotThreadEvents();
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+    out.precision(3);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const ProfilerThreadEvents& thread : threads)
+    {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread.threadIndex << ",\"args\":{\"name\":\"thread "
+            << thread.threadIndex << "\"}}";
+        for (const Event& event : thread.events)
+        {
+            // Timestamps are in microseconds.
+            out << ",\n{\"name\":";
+            writeTraceString(out, event.name);
+            out << ",\"cat\":\"rive\",\"ph\":\"X\",\"ts\":"
+                << event.startNanos / 1000.0
+                << ",\"dur\":" << event.durationNanos / 1000.0
+                << ",\"pid\":1,\"tid\":" << thread.threadIndex << "}";
+        }
+    }
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Profiler::clear()
+{
+    ProfilerRegistry& reg = profilerRegistry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->writeCount = 0;
+    }
+}
+#endif
@@ -1,6 +1,8 @@
 #include "rive/math/mat2d.hpp"
 #include "rive/renderer.hpp"
 #include "rive/text_engine.hpp"
+#include "rive/profiler/profiler.hpp"
+#include "rive/text/shaping_cache.hpp"
 
 using namespace rive;
 
@@ -143,6 +145,7 @@ SimpleArray<Paragraph> Font::shapeText(Span<const Unichar> text,
                                        Span<const TextRun> runs,
                                        int textDirectionFlag) const
 {
+    RIVE_PROF_SCOPENAME("Font::shapeText");
 #ifdef DEBUG
     size_t count = 0;
     for (const TextRun& tr : runs)
@@ -153,6 +156,15 @@ SimpleArray<Paragraph> Font::shapeText(Span<const Unichar> text,
     assert(count <= text.size());
 #endif
 
+#ifdef WITH_RIVE_TEXT
+    ShapingCache& cache = ShapingCache::shared();
+    SimpleArray<Paragraph> cached;
+    if (cache.findParagraphs(text, runs, textDirectionFlag, cached))
+    {
+        return cached;
+    }
+#endif
+
     SimpleArray<Paragraph> paragraphs =
         onShapeText(text, runs, textDirectionFlag);
     bool wantWhiteSpace = false;
@@ -214,6 +226,9 @@ SimpleArray<Paragraph> Font::shapeText(Span<const Unichar> text,
             assert(gr.glyphs.size() + 1 == gr.xpos.size());
         }
     }
+#endif
+#ifdef WITH_RIVE_TEXT
+    cache.addParagraphs(text, runs, textDirectionFlag, paragraphs);
 #endif
     return paragraphs;
 }
@@ -63,6 +63,29 @@ void Image::draw(Renderer* renderer)
     renderer->restore();
 }
 
+bool Image::computeDrawBounds(AABB* bounds)
+{
+    rive::ImageAsset* asset = this->imageAsset();
+    if (asset == nullptr || asset->renderImage() == nullptr)
+    {
+        // Nothing is drawn until the image arrives, which marks the image's
+        // transform dirty.
+        *bounds = AABB::forExpansion();
+        return true;
+    }
+    float width = (float)asset->renderImage()->width();
+    float height = (float)asset->renderImage()->height();
+    if (m_Mesh != nullptr || width == 0.0f || height == 0.0f)
+    {
+        // Mesh vertices can be anywhere, and an image still decoding has no
+        // size yet.
+        return false;
+    }
+    *bounds = worldTransform().mapBoundingBox(
+        AABB::fromLTWH(-width * originX(), -height * originY(), width, height));
+    return true;
+}
+
 Core* Image::hitTest(HitInfo* hinfo, const Mat2D& xform)
 {
     // TODO: handle clip?
@@ -123,6 +146,12 @@ void Image::setAsset(FileAsset* asset)
 
 void Image::assetUpdated()
 {
+    // The image may arrive after the mesh was set up, e.g. from an
+    // ImageDecodePool, and the mesh's uvs depend on it.
+    if (m_Mesh != nullptr)
+    {
+        m_Mesh->onAssetLoaded(imageAsset()->renderImage());
+    }
     updateImageScale();
     markWorldTransformDirty();
 }
@@ -1,10 +1,16 @@
 #include "rive/shapes/mesh_vertex.hpp"
+#include "rive/bones/skin.hpp"
 #include "rive/shapes/mesh.hpp"
 
 using namespace rive;
 void MeshVertex::markGeometryDirty()
 {
-    parent()->as<Mesh>()->markDrawableDirty();
+    auto mesh = parent()->as<Mesh>();
+    if (hasWeight() && mesh->skin() != nullptr)
+    {
+        mesh->skin()->markPointsDirty();
+    }
+    mesh->markDrawableDirty();
 }
 
 StatusCode MeshVertex::onAddedDirty(CoreContext* context)
@@ -7,7 +7,7 @@ using namespace rive;
 
 void PathDasher::invalidateSourcePath()
 {
-    m_contours.clear();
+    // applyDash only re-measures the contours if the geometry changed.
     invalidateDash();
 }
 
@@ -30,20 +30,14 @@ ShapePaintPath* PathDasher::applyDash(const RawPath* source,
                                       Dash* offset,
                                       Span<Dash*> dashes)
 {
-    if (m_contours.empty())
-    {
-        // 0.5f / 8.0f is a value that seems to look good on dashes with small
-        // gaps and scaled
-        ContourMeasureIter iter(source, 0.0625f);
-        while (auto meas = iter.next())
-        {
-            m_contours.push_back(meas);
-        }
-    }
+    // 0.5f / 8.0f is a value that seems to look good on dashes with small
+    // gaps and scaled
+    const std::vector<rcp<ContourMeasure>>& contours =
+        m_contours.measure(source, 0.0625f);
 
     // Make sure dashes have some length.
     bool hasValidDash = false;
-    for (const rcp<ContourMeasure>& contour : m_contours)
+    for (const rcp<ContourMeasure>& contour : contours)
     {
         for (auto dash : dashes)
         {
@@ -62,7 +56,7 @@ ShapePaintPath* PathDasher::applyDash(const RawPath* source,
     {
         int dashIndex = 0;
         auto rawPath = m_path.mutableRawPath();
-        for (const rcp<ContourMeasure>& contour : m_contours)
+        for (const rcp<ContourMeasure>& contour : contours)
         {
             float dashed = 0.0f;
             float distance = offset->normalizedLength(contour->length());
@@ -117,7 +111,7 @@ ShapePaintPath* PathDasher::applyDash(const RawPath* source,
 float PathDasher::pathLength() const
 {
     float totalLength = 0.0f;
-    for (auto contour : m_contours)
+    for (auto contour : m_contours.contours())
     {
         totalLength += contour->length();
     }
@@ -19,21 +19,16 @@ void TrimPath::trimPath(const RawPath* source)
     auto rawPath = m_path.mutableRawPath();
     auto renderOffset = std::fmod(std::fmod(offset(), 1.0f) + 1.0f, 1.0f);
 
-    // Build up contours if they're empty.
-    if (m_contours.empty())
-    {
-        ContourMeasureIter iter(source);
-        while (auto meas = iter.next())
-        {
-            m_contours.push_back(meas);
-        }
-    }
+    // The contours are only re-measured when the source geometry changes, so
+    // animating start, end or offset just extracts new segments.
+    const std::vector<rcp<ContourMeasure>>& contours =
+        m_contours.measure(source);
     switch (mode())
     {
         case TrimPathMode::sequential:
         {
             float totalLength = 0.0f;
-            for (auto contour : m_contours)
+            for (auto contour : contours)
             {
                 totalLength += contour->length();
             }
@@ -53,13 +48,13 @@ void TrimPath::trimPath(const RawPath* source)
                 endLength -= totalLength;
             }
 
-            int i = 0, subPathCount = (int)m_contours.size();
+            int i = 0, subPathCount = (int)contours.size();
             std::vector<int> indices;
             std::vector<float> lengths;
             while (endLength > 0)
             {
                 auto currentContourIndex = i % subPathCount;
-                auto contour = m_contours[currentContourIndex];
+                auto contour = contours[currentContourIndex];
                 auto contourLength = contour->length();
 
                 if (startLength < contourLength)
@@ -96,7 +91,7 @@ void TrimPath::trimPath(const RawPath* source)
                                                 : startingIndex) %
                              indices.size();
                 auto contourIndex = indices[index];
-                auto contour = m_contours[contourIndex];
+                auto contour = contours[contourIndex];
                 auto contourLength = contour->length();
                 auto lengthIndex = index * 2;
                 auto startLength = lengths[lengthIndex];
@@ -125,7 +120,7 @@ void TrimPath::trimPath(const RawPath* source)
 
         case TrimPathMode::synchronized:
         {
-            for (auto contour : m_contours)
+            for (auto contour : contours)
             {
                 auto contourLength = contour->length();
                 auto startLength = contourLength * (start() + renderOffset);
@@ -167,10 +162,9 @@ void TrimPath::trimPath(const RawPath* source)
 
 void TrimPath::invalidateEffect()
 {
+    // This is usually sent when the path is changed, the contours are
+    // re-measured by trimPath if the geometry actually differs.
     invalidateTrim();
-    // This is usually sent when the path is changed so we need to also
-    // invalidate the contours, not just the trim effect.
-    m_contours.clear();
 }
 
 void TrimPath::invalidateTrim()
@@ -1,4 +1,6 @@
 #include "rive/shapes/path_vertex.hpp"
+#include "rive/bones/skin.hpp"
+#include "rive/bones/skinnable.hpp"
 #include "rive/shapes/path.hpp"
 
 using namespace rive;
@@ -26,5 +28,13 @@ void PathVertex::markGeometryDirty()
         // that are not part of the core context.
         return;
     }
+    if (hasWeight())
+    {
+        auto skinnable = Skinnable::from(parent());
+        if (skinnable != nullptr && skinnable->skin() != nullptr)
+        {
+            skinnable->skin()->markPointsDirty();
+        }
+    }
     parent()->as<Path>()->markPathDirty();
 }
\ No newline at end of file
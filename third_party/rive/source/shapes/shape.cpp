@@ -142,6 +142,31 @@ void Shape::draw(Renderer* renderer)
     }
 }
 
+bool Shape::computeDrawBounds(AABB* bounds)
+{
+    // The bounds of the paths' control points hold their curves, and are
+    // cheaper to find than worldBounds() when the paths change every frame.
+    // Shapes without a path get inverted bounds and are always culled.
+    AABB world = AABB::forExpansion();
+    for (auto path : m_Paths)
+    {
+        if (path->isCollapsed())
+        {
+            continue;
+        }
+        const RawPath& rawPath = path->rawPath();
+        world.expand(path->pathTransform().mapBoundingBox(
+            rawPath.points().data(),
+            rawPath.points().size()));
+    }
+    float outset = paintOutset();
+    *bounds = AABB(world.minX - outset,
+                   world.minY - outset,
+                   world.maxX + outset,
+                   world.maxY + outset);
+    return true;
+}
+
 bool Shape::hitTestAABB(const Vec2D& position)
 {
     return worldBounds().contains(position);
@@ -4,6 +4,8 @@
 #include "rive/component.hpp"
 #include "rive/layout_component.hpp"
 #include "rive/foreground_layout_drawable.hpp"
+#include "rive/math/math_types.hpp"
+#include "rive/shapes/paint/feather.hpp"
 #include "rive/shapes/paint/stroke.hpp"
 #include "rive/shapes/shape.hpp"
 #include "rive/text/text_style_paint.hpp"
@@ -73,3 +75,59 @@ void ShapePaintContainer::propagateOpacity(float opacity)
         shapePaint->renderOpacity(opacity);
     }
 }
+
+float ShapePaintContainer::paintOutset() const
+{
+    // Matches how far the renderer outsets a path's bounds for its paint.
+    constexpr float miterLimit = 4.0f;
+    constexpr float featherStdDevs = 3.0f;
+    float maxScale = -1.0f;
+    auto worldScale = [&]() {
+        if (maxScale < 0.0f)
+        {
+            maxScale = shapeWorldTransform().findMaxScale();
+        }
+        return maxScale;
+    };
+    float outset = 0.0f;
+    for (auto paint : m_ShapePaints)
+    {
+        if (!paint->isVisible())
+        {
+            continue;
+        }
+        float paintOutset = 0.0f;
+        if (paint->is<Stroke>())
+        {
+            auto stroke = paint->as<Stroke>();
+            paintOutset = stroke->thickness() * 0.5f;
+            if ((StrokeJoin)stroke->join() == StrokeJoin::miter)
+            {
+                paintOutset *= miterLimit;
+            }
+            else if ((StrokeCap)stroke->cap() == StrokeCap::square)
+            {
+                paintOutset *= math::SQRT2;
+            }
+            if (stroke->transformAffectsStroke())
+            {
+                paintOutset *= worldScale();
+            }
+        }
+        Feather* feather = paint->feather();
+        if (feather != nullptr && !feather->inner())
+        {
+            float featherOutset =
+                feather->strength() * (featherStdDevs / 2.0f) +
+                std::max(std::abs(feather->offsetX()),
+                         std::abs(feather->offsetY()));
+            if (feather->space() == TransformSpace::local)
+            {
+                featherOutset *= worldScale();
+            }
+            paintOutset += featherOutset;
+        }
+        outset = std::max(outset, paintOutset);
+    }
+    return outset;
+}
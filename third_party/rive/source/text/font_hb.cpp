@@ -9,9 +9,13 @@
 
 #include "rive/factory.hpp"
 #include "rive/renderer_utils.hpp"
+#include "rive/text/shaping_cache.hpp"
 
 #include "hb.h"
 #include "hb-ot.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <unordered_set>
 
 extern "C"
@@ -141,18 +145,50 @@ static rive::Font::LineMetrics make_lmx(hb_font_t* font)
     return {-extents.ascender * gInvScale, -extents.descender * gInvScale};
 }
 
-HBFont::HBFont(hb_font_t* font) : HBFont(font, {}, {}, {}) {}
+static uint32_t nextTypefaceId()
+{
+    static std::atomic<uint32_t> typefaceCount{0};
+    return ++typefaceCount;
+}
+
+HBFont::HBFont(hb_font_t* font) : HBFont(font, nextTypefaceId(), {}, {}, {})
+{}
 
 HBFont::HBFont(hb_font_t* font,
+               uint32_t typefaceId,
                std::unordered_map<hb_tag_t, float> axisValues,
                std::unordered_map<hb_tag_t, uint32_t> featureValues,
                std::vector<hb_feature_t> features) :
     Font(make_lmx(font)),
     m_font(font),
     m_features(features),
+    m_typefaceId(typefaceId),
     m_featureValues(featureValues),
     m_axisValues(axisValues)
 {
+    // Typeface, then the axis and feature settings sorted by tag.
+    std::vector<std::pair<hb_tag_t, float>> axes(m_axisValues.begin(),
+                                                 m_axisValues.end());
+    std::sort(axes.begin(), axes.end());
+    std::vector<std::pair<hb_tag_t, uint32_t>> featureSettings(
+        m_featureValues.begin(),
+        m_featureValues.end());
+    std::sort(featureSettings.begin(), featureSettings.end());
+    m_shapingKey.push_back(m_typefaceId);
+    m_shapingKey.push_back((uint32_t)axes.size());
+    for (auto& axis : axes)
+    {
+        uint32_t valueBits;
+        memcpy(&valueBits, &axis.second, sizeof(valueBits));
+        m_shapingKey.push_back(axis.first);
+        m_shapingKey.push_back(valueBits);
+    }
+    for (auto& feature : featureSettings)
+    {
+        m_shapingKey.push_back(feature.first);
+        m_shapingKey.push_back(feature.second);
+    }
+
     m_drawFuncs = hb_draw_funcs_create();
     hb_draw_funcs_set_move_to_func(m_drawFuncs,
                                    rpath_move_to,
@@ -373,14 +409,23 @@ rive::rcp<rive::Font> HBFont::withOptions(
                               HB_FEATURE_GLOBAL_END});
     }
 
-    return rive::rcp<rive::Font>(
-        new HBFont(font, axisValues, featureValues, hbFeatures));
+    return rive::rcp<rive::Font>(new HBFont(font,
+                                            m_typefaceId,
+                                            axisValues,
+                                            featureValues,
+                                            hbFeatures));
 }
 
 rive::RawPath HBFont::getPath(rive::GlyphID glyph) const
 {
     rive::RawPath rpath;
+    rive::ShapingCache& cache = rive::ShapingCache::shared();
+    if (cache.findGlyphPath(this, glyph, rpath))
+    {
+        return rpath;
+    }
     hb_font_draw_glyph(m_font, glyph, m_drawFuncs, &rpath);
+    cache.addGlyphPath(this, glyph, rpath);
     return rpath;
 }
 
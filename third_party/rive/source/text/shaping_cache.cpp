@@ -0,0 +1,247 @@
+#include "rive/text/shaping_cache.hpp"
+
+#ifdef WITH_RIVE_TEXT
+#include <cstring>
+
+using namespace rive;
+
+static uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static void appendPointer(std::vector<uint32_t>& key, const void* pointer)
+{
+    uint64_t bits =
+        static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    key.push_back(static_cast<uint32_t>(bits));
+    key.push_back(static_cast<uint32_t>(bits >> 32));
+}
+
+size_t ShapingCache::KeyHash::operator()(const Key& key) const
+{
+    // FNV-1a over the key's words.
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint32_t word : key)
+    {
+        hash ^= word;
+        hash *= 0x100000001b3ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+template <typename Value>
+Value* ShapingCache::LruMap<Value>::find(const Key& key)
+{
+    auto itr = index.find(key);
+    if (itr == index.end())
+    {
+        counters.misses++;
+        return nullptr;
+    }
+    counters.hits++;
+    order.splice(order.begin(), order, itr->second);
+    return &itr->second->second;
+}
+
+template <typename Value>
+void ShapingCache::LruMap<Value>::add(Key&& key, Value&& value)
+{
+    if (capacity == 0 || index.find(key) != index.end())
+    {
+        return;
+    }
+    order.emplace_front(std::move(key), std::move(value));
+    index.emplace(order.front().first, order.begin());
+    trim();
+}
+
+template <typename Value> void ShapingCache::LruMap<Value>::trim()
+{
+    while (order.size() > capacity)
+    {
+        index.erase(order.back().first);
+        order.pop_back();
+        counters.evictions++;
+    }
+}
+
+template <typename Value> void ShapingCache::LruMap<Value>::clear()
+{
+    index.clear();
+    order.clear();
+}
+
+ShapingCache::ShapingCache()
+{
+    m_paragraphs.capacity = defaultParagraphCapacity;
+    m_glyphs.capacity = defaultGlyphCapacity;
+}
+
+ShapingCache& ShapingCache::shared()
+{
+    static ShapingCache cache;
+    return cache;
+}
+
+void ShapingCache::capacity(size_t paragraphs, size_t glyphs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paragraphs.capacity = paragraphs;
+    m_paragraphs.trim();
+    m_glyphs.capacity = glyphs;
+    m_glyphs.trim();
+}
+
+bool ShapingCache::makeParagraphKey(Span<const Unichar> text,
+                                    Span<const TextRun> runs,
+                                    int textDirectionFlag,
+                                    Key& key)
+{
+    // Fallback fonts are picked by the client's callback, so results are
+    // only shared while the same one is installed.
+    key.push_back(static_cast<uint32_t>(textDirectionFlag));
+    key.push_back(Font::gFallbackProcEnabled ? 1 : 0);
+    appendPointer(key, reinterpret_cast<const void*>(Font::gFallbackProc));
+    key.push_back(static_cast<uint32_t>(runs.size()));
+    for (const TextRun& run : runs)
+    {
+        if (run.font == nullptr || run.font->shapingKey().empty())
+        {
+            return false;
+        }
+        const std::vector<uint32_t>& fontKey = run.font->shapingKey();
+        key.push_back(static_cast<uint32_t>(fontKey.size()));
+        key.insert(key.end(), fontKey.begin(), fontKey.end());
+        key.push_back(floatBits(run.size));
+        key.push_back(floatBits(run.lineHeight));
+        key.push_back(floatBits(run.letterSpacing));
+        key.push_back(run.unicharCount);
+        key.push_back(run.script);
+        key.push_back(run.styleId);
+        key.push_back(run.level);
+    }
+    key.insert(key.end(), text.begin(), text.end());
+    return true;
+}
+
+bool ShapingCache::findParagraphs(Span<const Unichar> text,
+                                  Span<const TextRun> runs,
+                                  int textDirectionFlag,
+                                  SimpleArray<Paragraph>& paragraphs)
+{
+    Key key;
+    if (!makeParagraphKey(text, runs, textDirectionFlag, key))
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_paragraphs.capacity == 0)
+    {
+        return false;
+    }
+    ParagraphEntry* entry = m_paragraphs.find(key);
+    if (entry == nullptr)
+    {
+        return false;
+    }
+    paragraphs = SimpleArray<Paragraph>(entry->paragraphs.data(),
+                                        entry->paragraphs.size());
+    for (Paragraph& paragraph : paragraphs)
+    {
+        for (GlyphRun& glyphRun : paragraph.runs)
+        {
+            for (size_t i = 0; i < entry->runFonts.size(); i++)
+            {
+                if (glyphRun.font == entry->runFonts[i])
+                {
+                    glyphRun.font = runs[i].font;
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void ShapingCache::addParagraphs(Span<const Unichar> text,
+                                 Span<const TextRun> runs,
+                                 int textDirectionFlag,
+                                 const SimpleArray<Paragraph>& paragraphs)
+{
+    Key key;
+    if (!makeParagraphKey(text, runs, textDirectionFlag, key))
+    {
+        return;
+    }
+    ParagraphEntry entry;
+    for (const TextRun& run : runs)
+    {
+        entry.runFonts.push_back(run.font);
+    }
+    entry.paragraphs =
+        SimpleArray<Paragraph>(paragraphs.data(), paragraphs.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paragraphs.add(std::move(key), std::move(entry));
+}
+
+bool ShapingCache::findGlyphPath(const Font* font,
+                                 GlyphID glyph,
+                                 RawPath& path)
+{
+    if (font->shapingKey().empty())
+    {
+        return false;
+    }
+    Key key = font->shapingKey();
+    key.push_back(glyph);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_glyphs.capacity == 0)
+    {
+        return false;
+    }
+    RawPath* cached = m_glyphs.find(key);
+    if (cached == nullptr)
+    {
+        return false;
+    }
+    path = *cached;
+    return true;
+}
+
+void ShapingCache::addGlyphPath(const Font* font,
+                                GlyphID glyph,
+                                const RawPath& path)
+{
+    if (font->shapingKey().empty())
+    {
+        return;
+    }
+    Key key = font->shapingKey();
+    key.push_back(glyph);
+    RawPath copy = path;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_glyphs.add(std::move(key), std::move(copy));
+}
+
+ShapingCache::Counters ShapingCache::paragraphCounters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_paragraphs.counters;
+}
+
+ShapingCache::Counters ShapingCache::glyphCounters() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_glyphs.counters;
+}
+
+void ShapingCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paragraphs.clear();
+    m_glyphs.clear();
+}
+#endif
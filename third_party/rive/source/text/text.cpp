@@ -529,6 +529,16 @@ void Text::draw(Renderer* renderer)
     renderer->restore();
 }
 
+bool Text::computeDrawBounds(AABB* bounds)
+{
+    if (overflow() != TextOverflow::clipped || m_clipRect.empty())
+    {
+        return false;
+    }
+    *bounds = m_shapeWorldTransform.mapBoundingBox(m_clipRect.bounds());
+    return true;
+}
+
 void Text::addRun(TextValueRun* run) { m_runs.push_back(run); }
 
 void Text::addModifierGroup(TextModifierGroup* group)
@@ -949,6 +959,7 @@ void Text::originYChanged()
 // Text disabled.
 void Text::draw(Renderer* renderer) {}
 Core* Text::hitTest(HitInfo*, const Mat2D&) { return nullptr; }
+bool Text::computeDrawBounds(AABB* bounds) { return false; }
 void Text::addRun(TextValueRun* run) {}
 void Text::addModifierGroup(TextModifierGroup* group) {}
 void Text::markShapeDirty(bool sendToLayout) {}
@@ -92,11 +92,19 @@ void TextFollowPathModifier::reset(const Mat2D* inverseText)
     if (m_Target == nullptr)
     {
         m_pathMeasure = PathMeasure();
+        m_measuredPath.rewind();
         return;
     }
     m_localPath.rewind();
     m_localPath.addPath(m_worldPath, inverseText);
+    // Text is reshaped whenever start, end or offset change, only measure the
+    // path again if its geometry did.
+    if (m_localPath == m_measuredPath && !m_measuredPath.empty())
+    {
+        return;
+    }
     m_pathMeasure = PathMeasure(&m_localPath, 0.1f);
+    m_measuredPath = m_localPath;
 }
 
 TransformComponents TextFollowPathModifier::transformGlyph(
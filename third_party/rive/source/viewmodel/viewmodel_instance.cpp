@@ -20,6 +20,7 @@ ViewModelInstance::~ViewModelInstance()
         value->unref();
     }
     m_PropertyValues.clear();
+    m_advancingValues.clear();
     if (m_ViewModel != nullptr)
     {
         m_ViewModel->unref();
@@ -29,6 +30,10 @@ ViewModelInstance::~ViewModelInstance()
 void ViewModelInstance::addValue(ViewModelInstanceValue* value)
 {
     m_PropertyValues.push_back(value);
+    if (value->advances())
+    {
+        m_advancingValues.push_back(value);
+    }
 }
 
 ViewModelInstanceValue* ViewModelInstance::propertyValue(const uint32_t id)
@@ -172,7 +177,7 @@ ViewModelInstanceValue* ViewModelInstance::propertyFromPath(
 
 void ViewModelInstance::advanced()
 {
-    for (auto value : m_PropertyValues)
+    for (auto value : m_advancingValues)
     {
         value->advanced();
     }
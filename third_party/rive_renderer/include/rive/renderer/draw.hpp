@@ -23,6 +23,7 @@ namespace rive::gpu
 class Draw;
 class RenderContext;
 class Gradient;
+class InteriorTriangulation;
 
 // High level abstraction of a single object to be drawn (path, imageRect, or
 // imageMesh). These get built up for an entire frame in order to count GPU
@@ -253,7 +254,13 @@ public:
         return m_coverageBufferRange;
     }
 
-    GrInnerFanTriangulator* triangulator() const { return m_triangulator; }
+    const InteriorTriangulation* triangulation() const
+    {
+        return m_triangulation;
+    }
+
+    // Whether the interior triangles get drawn with their weights negated.
+    bool negatesInteriorWinding() const { return m_negatesInteriorWinding; }
 
     bool allocateResources(RenderContext::LogicalFlush*) override;
     void countSubpasses() override;
@@ -270,6 +277,10 @@ public:
                                uint32_t* tessVertexCount,
                                uint32_t* tessBaseVertex);
 
+    // Writes this draw's contours and cubics through tessWriter. Reads no
+    // state shared with other draws, so draws can write on separate threads.
+    void writeTessellationData(RenderContext::TessellationWriter*);
+
     void releaseRefs() override;
 
 protected:
@@ -297,7 +308,7 @@ protected:
     uint32_t allocateTessellationVertices(RenderContext::LogicalFlush* flush,
                                           uint32_t tessVertexCount)
     {
-        if (m_triangulator != nullptr)
+        if (m_triangulation != nullptr)
             return flush->allocateOuterCubicTessVertices(tessVertexCount);
         else
             return flush->allocateMidpointFanTessVertices(tessVertexCount);
@@ -332,8 +343,8 @@ protected:
 
     enum class InteriorTriangulationOp : bool
     {
-        // Fills in m_resourceCounts and runs a GrInnerFanTriangulator on the
-        // path's interior polygon.
+        // Fills in m_resourceCounts and finds the triangulation of the path's
+        // interior polygon in the TriangulationCache, or makes one.
         countDataAndTriangulate,
 
         // Pushes the contours and cubics to the renderContext for an
@@ -348,7 +359,7 @@ protected:
     // adding complexity to only run Wang's formula and chop once would save
     // about ~5% of the total CPU time. (And large paths are GPU-bound anyway.)
     void iterateInteriorTriangulation(InteriorTriangulationOp op,
-                                      TrivialBlockAllocator*,
+                                      RenderContext*,
                                       RawPath* scratchPath,
                                       TriangulatorAxis,
                                       RenderContext::TessellationWriter*);
@@ -363,15 +374,18 @@ protected:
     gpu::ContourDirections m_contourDirections;
     uint32_t m_contourFlags = 0;
 
-    // Only used when rendering coverage via the atlas.
-    gpu::AtlasTransform m_atlasTransform;
+    // Only used when rendering coverage via the atlas. Still zeroed otherwise,
+    // since pushPath() writes it to the path buffer either way.
+    gpu::AtlasTransform m_atlasTransform{};
     TAABB<uint16_t> m_atlasScissor; // Scissor rect when rendering to the atlas.
     bool m_atlasScissorEnabled;
 
-    // clockwiseAtomic only.
-    gpu::CoverageBufferRange m_coverageBufferRange;
+    // clockwiseAtomic only. Zeroed otherwise, like m_atlasTransform.
+    gpu::CoverageBufferRange m_coverageBufferRange{};
 
-    GrInnerFanTriangulator* m_triangulator = nullptr;
+    // Holds a ref, released in releaseRefs().
+    InteriorTriangulation* m_triangulation = nullptr;
+    bool m_negatesInteriorWinding = false;
 
     StrokeJoin m_strokeJoin;
     StrokeCap m_strokeCap;
@@ -34,6 +34,9 @@ public:
 
     size_t pushCount() const { return m_end - m_array; }
 
+    // The items pushed since the last reset() or rewind(), popped or not.
+    const T* data() const { return m_array; }
+
     T& push_back()
     {
         assert(m_end < m_array + m_capacity);
@@ -379,8 +379,7 @@ enum class PaintType : uint32_t
 // Specifies the location of a simple or complex horizontal color ramp within
 // the gradient texture. A simple color ramp is two texels wide, beginning at
 // the specified row and column. A complex color ramp spans the entire width of
-// the gradient texture, on the row:
-//     "GradTextureLayout::complexOffsetY + ColorRampLocation::row".
+// the gradient texture, on the specified row.
 struct ColorRampLocation
 {
     constexpr static uint16_t kComplexGradientMarker = 0xffff;
@@ -435,15 +434,13 @@ private:
     Mat2D m_inverseMatrix;
 };
 
-// Specifies the height of the gradient texture, and the row at which we
-// transition from simple color ramps to complex.
+// Specifies the height of the gradient texture.
 //
-// This information is computed at flush time, once we know exactly how many
-// color ramps of each type will be in the gradient texture.
+// This information is computed at flush time, once we know exactly how tall
+// the gradient texture will be.
 struct GradTextureLayout
 {
-    uint32_t complexOffsetY; // Row of the first complex gradient.
-    float inverseHeight;     // 1 / textureHeight
+    float inverseHeight; // 1 / textureHeight
 };
 
 // Once all curves in a contour have been tessellated, we render the tessellated
@@ -1093,6 +1090,10 @@ struct FlushDescriptor
     uint32_t tessVertexSpanCount = 0;
     size_t firstTessVertexSpan = 0;
     uint32_t gradDataHeight = 0;
+    // The gradient texture holds ramps from earlier flushes that later draws
+    // still sample. Rows this flush doesn't draw into must be preserved,
+    // instead of discarded, when rendering the gradient spans.
+    bool preserveGradTexture = false;
     uint32_t tessDataHeight = 0;
     // Override path fill rules with "clockwise".
     bool clockwiseFillOverride = false;
@@ -1560,6 +1561,13 @@ public:
     }
     void skip_back() { push(); }
 
+    // Reserves the next count items and returns a mapping of just those, so
+    // they can be written separately, e.g. on another thread.
+    WriteOnlyMappedMemory split_back(size_t count)
+    {
+        return WriteOnlyMappedMemory(push(count), count);
+    }
+
 private:
     RIVE_ALWAYS_INLINE T& push()
     {
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/renderer/render_context_helper_impl.hpp"
+#include "rive/renderer/render_target.hpp"
+#include <vector>
+
+namespace rive::gpu
+{
+// RenderTarget with no backing storage, for RenderContextHeadlessImpl.
+class RenderTargetHeadless : public RenderTarget
+{
+public:
+    RenderTargetHeadless(uint32_t width, uint32_t height) :
+        RenderTarget(width, height)
+    {}
+};
+
+// CPU-only implementation of RenderContextImpl. Buffers are mapped to host
+// memory and each logical flush is recorded instead of being executed, so
+// RenderContext's batching, resource layout, tessellation and gradient work
+// all run without a GPU, e.g. for profiling or on machines without one.
+class RenderContextHeadlessImpl : public RenderContextHelperImpl
+{
+public:
+    struct ContextOptions
+    {
+        // Report no support for the corresponding interlock modes, to exercise
+        // the atomic and msaa paths of the front end.
+        bool disableRasterOrdering = false;
+        bool disableFragmentShaderAtomics = false;
+        // Zero each buffer when it is mapped and hash its bytes when it is
+        // unmapped, so two runs can check they wrote identical resources.
+        bool hashMappedBuffers = false;
+        // Draw the gradient spans into a host copy of the gradient texture and
+        // hash it after every logical flush, so two runs can check they left
+        // identical ramps in it.
+        bool emulateGradientTexture = false;
+    };
+
+    static std::unique_ptr<RenderContext> MakeContext(const ContextOptions&);
+    static std::unique_ptr<RenderContext> MakeContext()
+    {
+        return MakeContext(ContextOptions());
+    }
+
+    // Copy of a DrawBatch, without its pointers into per-frame memory.
+    struct RecordedBatch
+    {
+        DrawType drawType;
+        ShaderMiscFlags shaderMiscFlags;
+        uint32_t elementCount;
+        uint32_t baseElement;
+        BlendMode firstBlendMode;
+        BarrierFlags barriers;
+        DrawContents drawContents;
+        ShaderFeatures shaderFeatures;
+        uint32_t imageDrawDataOffset;
+        bool hasImageTexture;
+    };
+
+    struct RecordedFlush
+    {
+        // The descriptor passed to flush(), with renderTarget,
+        // externalCommandBuffer and the batch lists cleared since they only
+        // live for the frame.
+        FlushDescriptor desc;
+        std::vector<RecordedBatch> drawBatches;
+        std::vector<AtlasDrawBatch> atlasFillBatches;
+        std::vector<AtlasDrawBatch> atlasStrokeBatches;
+    };
+
+    struct Counters
+    {
+        uint64_t frames = 0;
+        uint64_t flushes = 0;
+        uint64_t drawBatches = 0;
+        // Bytes the front end wrote to mapped buffers.
+        uint64_t bytesMapped = 0;
+        // Hash of those bytes, in unmap order, with hashMappedBuffers.
+        uint64_t mappedBytesHash = 0xcbf29ce484222325ull;
+        // Hash of the gradient texture after each logical flush, with
+        // emulateGradientTexture.
+        uint64_t gradientTextureHash = 0xcbf29ce484222325ull;
+    };
+
+    // Logical flushes of the most recent frame.
+    const std::vector<RecordedFlush>& flushes() const { return m_flushes; }
+
+    // Totals since the context was made or resetCounters() was last called.
+    const Counters& counters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters(); }
+
+    uint32_t gradientTextureWidth() const { return m_gradientTextureWidth; }
+    uint32_t gradientTextureHeight() const { return m_gradientTextureHeight; }
+    uint32_t tessellationTextureWidth() const { return m_tessTextureWidth; }
+    uint32_t tessellationTextureHeight() const { return m_tessTextureHeight; }
+
+    rcp<RenderBuffer> makeRenderBuffer(RenderBufferType,
+                                       RenderBufferFlags,
+                                       size_t) override;
+
+    rcp<Texture> makeImageTexture(uint32_t width,
+                                  uint32_t height,
+                                  uint32_t mipLevelCount,
+                                  const uint8_t imageDataRGBAPremul[]) override;
+
+    void resizeGradientTexture(uint32_t width, uint32_t height) override;
+    void resizeTessellationTexture(uint32_t width, uint32_t height) override;
+    void resizeAtlasTexture(uint32_t, uint32_t) override {}
+    void resizeCoverageBuffer(size_t) override {}
+
+    void prepareToFlush(uint64_t nextFrameNumber,
+                        uint64_t safeFrameNumber) override;
+    void flush(const FlushDescriptor&) override;
+
+private:
+    class HeadlessBufferRing;
+
+    RenderContextHeadlessImpl(const ContextOptions&);
+
+    // Rasterizes the flush's GradientSpans the way color_ramp.glsl does.
+    void drawGradientSpans(const FlushDescriptor&);
+
+    std::unique_ptr<BufferRing> makeUniformBufferRing(
+        size_t capacityInBytes) override;
+    std::unique_ptr<BufferRing> makeStorageBufferRing(
+        size_t capacityInBytes,
+        gpu::StorageBufferStructure) override;
+    std::unique_ptr<BufferRing> makeVertexBufferRing(
+        size_t capacityInBytes) override;
+
+    const ContextOptions m_options;
+    std::vector<RecordedFlush> m_flushes;
+    Counters m_counters;
+    uint32_t m_gradientTextureWidth = 0;
+    uint32_t m_gradientTextureHeight = 0;
+    std::vector<uint32_t> m_gradientTexels; // With emulateGradientTexture.
+    uint32_t m_tessTextureWidth = 0;
+    uint32_t m_tessTextureHeight = 0;
+};
+} // namespace rive::gpu
@@ -35,26 +35,8 @@ class Draw;
 class Gradient;
 class RenderContextImpl;
 class PathDraw;
-
-// Used as a key for complex gradients.
-class GradientContentKey
-{
-public:
-    inline GradientContentKey(rcp<const Gradient> gradient);
-    inline GradientContentKey(GradientContentKey&& other);
-    bool operator==(const GradientContentKey&) const;
-    const Gradient* gradient() const { return m_gradient.get(); }
-
-private:
-    rcp<const Gradient> m_gradient;
-};
-
-// Hashes all stops and all colors in a complex gradient.
-class DeepHashGradient
-{
-public:
-    size_t operator()(const GradientContentKey&) const;
-};
+class TriangulationCache;
+class GradientRampCache;
 
 // Even though Draw is block-allocated, we still need to call releaseRefs() on
 // each individual instance before releasing the block. This smart pointer
@@ -82,6 +64,62 @@ public:
 
     const gpu::PlatformFeatures& platformFeatures() const;
 
+    // Runs range(context, begin, end) over [0, count) split into ranges of at
+    // most grain items, possibly on several threads, and returns once every
+    // range has run.
+    using ParallelForProc = void (*)(uint32_t count,
+                                     uint32_t grain,
+                                     void* context,
+                                     void (*range)(void* context,
+                                                   uint32_t begin,
+                                                   uint32_t end));
+
+    // Sets how frames with FrameDescriptor::parallelWriteResources split up
+    // their resource writing. Null writes on the calling thread.
+    void setParallelForProc(ParallelForProc proc) { m_parallelForProc = proc; }
+
+    // Large fills get drawn as an interior triangulation plus their outer
+    // curves. The triangulations of the most recently drawn paths are kept
+    // across frames, and reused for as long as the path and the subdivision
+    // its transform calls for stay the same. A capacity of 0 re-triangulates
+    // every frame.
+    void setTriangulationCacheCapacity(size_t pathCount);
+
+    struct TriangulationCacheCounters
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    // Lookups since the context was made or the counters were last reset.
+    const TriangulationCacheCounters& triangulationCacheCounters() const;
+    void resetTriangulationCacheCounters();
+
+    // Color ramps keep their place in the gradient texture across flushes, and
+    // only get drawn into it when they're new or their texels were recycled.
+    // The capacity is in rows of the gradient texture; a row holds one ramp
+    // with more than two stops, or 256 two-stop ramps. A capacity of 0 draws
+    // every ramp again in every logical flush. Must be called between frames.
+    void setGradientRampCacheCapacity(size_t rowCount);
+
+    struct GradientRampCacheCounters
+    {
+        // Ramps a logical flush used that the texture already held.
+        uint64_t rampsReused = 0;
+        // Ramps drawn into the texture.
+        uint64_t rampsWritten = 0;
+    };
+
+    // Ramps used by logical flushes since the context was made or the counters
+    // were last reset.
+    const GradientRampCacheCounters& gradientRampCacheCounters() const;
+    void resetGradientRampCacheCounters();
+
+    // Forgets which ramps the gradient texture holds, so every ramp gets drawn
+    // again on its next use, e.g. after the backend lost the texture's
+    // contents. Must be called between frames.
+    void invalidateGradientRamps();
+
     // Options for controlling how and where a frame is rendered.
     struct FrameDescriptor
     {
@@ -102,6 +140,11 @@ public:
         // Override all paths' fill rules (winding or even/odd) to emulate
         // clockwiseAtomic mode.
         bool clockwiseFillOverride = false;
+
+        // Write each path's tessellation data on several threads, through the
+        // context's ParallelForProc (see setParallelForProc()). The resource
+        // buffers come out identical either way. Ignored if no proc is set.
+        bool parallelWriteResources = false;
 #ifdef WITH_RIVE_TOOLS
         // Synthesize compilation failures to make sure the device handles them
         // gracefully. (e.g., by falling back on an uber shader or at least not
@@ -273,6 +316,12 @@ public:
                                        RenderBufferFlags,
                                        size_t) override;
     rcp<RenderImage> decodeImage(Span<const uint8_t>) override;
+    // With RIVE_DECODERS, images can be decoded on other threads, without
+    // the platform decoder. Only makeImage() touches the GPU.
+    bool canDecodeImagePixels() const override;
+    std::unique_ptr<DecodedImage> decodeImagePixels(
+        Span<const uint8_t>) override;
+    rcp<RenderImage> makeImage(const DecodedImage&) override;
 
 private:
     friend class Draw;
@@ -376,10 +425,22 @@ private:
     // (clockwiseAtomic mode only.)
     uint32_t m_coverageBufferPrefix = 0;
 
+    ParallelForProc m_parallelForProc = nullptr;
+
+    // Scratch TessVertexSpans for LogicalFlushes that write their paths'
+    // tessellation data in parallel.
+    std::vector<gpu::TessVertexSpan> m_parallelTessSpans;
+
     // Used by LogicalFlushes for re-ordering high level draws.
     std::vector<int64_t> m_indirectDrawList;
     std::unique_ptr<IntersectionBoard> m_intersectionBoard;
 
+    // Interior triangulations kept across frames.
+    const std::unique_ptr<TriangulationCache> m_triangulationCache;
+
+    // Color ramps kept in the gradient texture across flushes.
+    const std::unique_ptr<GradientRampCache> m_gradientRampCache;
+
     WriteOnlyMappedMemory<gpu::FlushUniforms> m_flushUniformData;
     WriteOnlyMappedMemory<gpu::PathData> m_pathData;
     WriteOnlyMappedMemory<gpu::PaintData> m_paintData;
@@ -649,6 +710,18 @@ private:
                                            bool closed,
                                            uint32_t vertexIndex0);
 
+        // Writes the TessVertexSpans and contours of a PathDraw at the given
+        // tessellation locations (see TessellationWriter). When
+        // writeResources() is writing in parallel, only reserves the draw's
+        // contours here and writes its data once every draw has been pushed.
+        void pushTessellationData(PathDraw*,
+                                  uint32_t pathID,
+                                  gpu::ContourDirections,
+                                  uint32_t forwardTessVertexCount,
+                                  uint32_t forwardTessLocation,
+                                  uint32_t mirroredTessVertexCount,
+                                  uint32_t mirroredTessLocation);
+
         // Writes padding vertices to the tessellation texture, with an invalid
         // contour ID that is guaranteed to not be the same ID as any neighbors.
         void pushPaddingVertices(uint32_t count, uint32_t tessLocation);
@@ -707,6 +780,10 @@ private:
 
         ClipInfo& getWritableClipInfo(uint32_t clipID);
 
+        // Writes the tessellation data pushTessellationData() deferred, on
+        // the context's ParallelForProc.
+        void writePendingTessellationData();
+
         // Either appends a new drawBatch to m_drawList or merges into
         // m_drawList.tail(). Updates the batch's ShaderFeatures according to
         // the passed parameters.
@@ -735,20 +812,29 @@ private:
 
         // Simple gradients have one stop at t=0 and one stop at t=1. They're
         // implemented with 2 texels.
-        std::unordered_map<uint64_t, uint32_t>
-            m_simpleGradients; // [color0, color1] -> texelsIdx.
-        std::vector<gpu::TwoTexelRamp> m_pendingSimpleGradDraws;
+        struct PendingSimpleGradDraw
+        {
+            gpu::TwoTexelRamp colorRamp;
+            gpu::ColorRampLocation location;
+            uint64_t generation; // See GradientRampCache.
+        };
+        std::vector<PendingSimpleGradDraw> m_pendingSimpleGradDraws;
 
         // Complex gradients have stop(s) between t=0 and t=1. In theory they
         // should be scaled to a ramp where every stop lands exactly on a pixel
         // center, but for now we just always scale them to the entire gradient
         // texture width.
-        std::unordered_map<GradientContentKey, uint16_t, DeepHashGradient>
-            m_complexGradients; // [colors[0..n], stops[0..n]] -> rowIdx
-        std::vector<const Gradient*> m_pendingComplexGradDraws;
+        struct PendingComplexGradDraw
+        {
+            const Gradient* gradient;
+            gpu::ColorRampLocation location;
+            uint64_t generation; // See GradientRampCache.
+        };
+        std::vector<PendingComplexGradDraw> m_pendingComplexGradDraws;
 
-        // Simple and complex gradients both get uploaded to the GPU as sets of
-        // "GradientSpan" instances.
+        // Every ramp this flush uses is pending until layoutResources(), which
+        // drops the ones the gradient texture already holds. The rest get
+        // uploaded to the GPU as sets of "GradientSpan" instances.
         size_t m_pendingGradSpanCount;
 
         std::vector<ClipInfo> m_clips;
@@ -780,6 +866,29 @@ private:
         uint32_t m_currentPathID;
         uint32_t m_currentContourID;
 
+        // Tessellation data of a PathDraw that is written after all draws
+        // have been pushed, into the draw's reserved contours and a range of
+        // m_ctx->m_parallelTessSpans.
+        struct PendingTessellationData
+        {
+            PathDraw* draw;
+            uint32_t pathID;
+            gpu::ContourDirections contourDirections;
+            uint32_t forwardTessVertexCount;
+            uint32_t forwardTessLocation;
+            uint32_t mirroredTessVertexCount;
+            uint32_t mirroredTessLocation;
+            // The draw's contour IDs follow this one.
+            uint32_t contourIDBase;
+            WriteOnlyMappedMemory<gpu::ContourData> contourData;
+            size_t firstScratchSpan;
+            size_t maxSpanCount;
+            WriteOnlyMappedMemory<gpu::TessVertexSpan> tessSpanData;
+        };
+        std::vector<PendingTessellationData> m_pendingTessellationData;
+        size_t m_pendingTessSpanCount = 0;
+        bool m_deferTessellationData = false;
+
         // Atlas for offscreen feathering.
         std::unique_ptr<skgpu::RectanizerSkyline> m_atlasRectanizer;
         uint32_t m_atlasMaxX = 0;
@@ -830,6 +939,22 @@ private:
                            uint32_t mirroredTessVertexCount = 0,
                            uint32_t mirroredTessLocation = 0);
 
+        // Writes spans to tessSpanData and contours to contourData, numbering
+        // the contours from contourIDBase + 1, instead of pushing them to the
+        // context. Touches no state shared with other paths, so paths can be
+        // written on separate threads.
+        TessellationWriter(LogicalFlush* flush,
+                           uint32_t pathID,
+                           gpu::ContourDirections,
+                           uint32_t forwardTessVertexCount,
+                           uint32_t forwardTessLocation,
+                           uint32_t mirroredTessVertexCount,
+                           uint32_t mirroredTessLocation,
+                           WriteOnlyMappedMemory<gpu::TessVertexSpan>*
+                               tessSpanData,
+                           WriteOnlyMappedMemory<gpu::ContourData>* contourData,
+                           uint32_t contourIDBase);
+
         ~TessellationWriter();
 
         // Returns the index of the next vertex to be written.
@@ -918,6 +1043,10 @@ private:
     private:
         LogicalFlush* const m_flush;
         WriteOnlyMappedMemory<gpu::TessVertexSpan>& m_tessSpanData;
+        // Null when contours are pushed to the context.
+        WriteOnlyMappedMemory<gpu::ContourData>* const m_contourData = nullptr;
+        // Most recent contourID this writer returned.
+        uint32_t m_currentContourID;
         const uint32_t m_pathID;
         const gpu::ContourDirections m_contourDirections;
         uint32_t m_pathTessLocation;
@@ -41,11 +41,14 @@
 #include "source/intersection_board.cpp"
 #include "source/draw.cpp"
 #include "source/gr_triangulator.cpp"
+#include "source/triangulation_cache.cpp"
 #include "source/gradient.cpp"
+#include "source/gradient_ramp_cache.cpp"
 #include "source/sk_rectanizer_skyline.cpp"
 #include "source/gpu.cpp"
 #include "source/rive_render_factory.cpp"
 #include "source/render_context_helper_impl.cpp"
+#include "source/headless/render_context_headless_impl.cpp"
 
 #if __clang__
  #pragma clang diagnostic pop
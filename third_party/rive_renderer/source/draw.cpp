@@ -4,7 +4,7 @@
 
 #include "rive/renderer/draw.hpp"
 
-#include "gr_inner_fan_triangulator.hpp"
+#include "triangulation_cache.hpp"
 #include "rive_render_path.hpp"
 #include "rive_render_paint.hpp"
 #include "rive/math/bezier_utils.hpp"
@@ -699,6 +699,7 @@ void PathDraw::releaseRefs()
     RIVE_DEBUG_CODE(m_pathRef->unlockRawPathMutations();)
     m_pathRef->unref();
     safe_unref(m_gradientRef);
+    safe_unref(m_triangulation);
 }
 
 void PathDraw::initForMidpointFan(RenderContext* context,
@@ -1339,7 +1340,7 @@ void PathDraw::initForInteriorTriangulation(RenderContext* context,
     m_numChops.reset(context->numChopsAllocator(), originalNumChopsSize);
     iterateInteriorTriangulation(
         InteriorTriangulationOp::countDataAndTriangulate,
-        &context->perFrameAllocator(),
+        context,
         scratchPath,
         triangulatorAxis,
         nullptr);
@@ -1483,7 +1484,7 @@ void PathDraw::countSubpasses()
         }
     }
 
-    if (m_triangulator != nullptr)
+    if (m_triangulation != nullptr)
     {
         // Each tessellation draw has a corresponding interior triangles draw.
         m_prepassCount *= 2;
@@ -1530,14 +1531,14 @@ void PathDraw::pushToRenderContext(RenderContext::LogicalFlush* flush,
             else
             {
                 // Interior triangles.
-                assert(m_triangulator != nullptr);
+                assert(m_triangulation != nullptr);
                 assert(subpassIndex == 1);
                 RIVE_DEBUG_CODE(m_numInteriorTriangleVerticesPushed +=)
                 flush->pushInteriorTriangulationDraw(this,
                                                      m_pathID,
                                                      gpu::WindingFaces::all);
                 assert(m_numInteriorTriangleVerticesPushed <=
-                       m_triangulator->maxVertexCount());
+                       m_triangulation->maxVertexCount());
             }
             break;
         }
@@ -1575,7 +1576,7 @@ void PathDraw::pushToRenderContext(RenderContext::LogicalFlush* flush,
                 case -2: // Interior triangles (borrowed).
                 case 1:  // Interior triangles.
                     assert(!isStroke());
-                    assert(m_triangulator != nullptr);
+                    assert(m_triangulation != nullptr);
                     RIVE_DEBUG_CODE(m_numInteriorTriangleVerticesPushed +=)
                     flush->pushInteriorTriangulationDraw(
                         this,
@@ -1586,7 +1587,7 @@ void PathDraw::pushToRenderContext(RenderContext::LogicalFlush* flush,
                             ? gpu::ShaderMiscFlags::borrowedCoveragePrepass
                             : gpu::ShaderMiscFlags::none);
                     assert(m_numInteriorTriangleVerticesPushed <=
-                           m_triangulator->maxVertexCount());
+                           m_triangulation->maxVertexCount());
                     break;
 
                 default:
@@ -1655,7 +1656,7 @@ void PathDraw::pushTessellationDraw(RenderContext::LogicalFlush* flush,
                                     uint32_t tessLocation,
                                     gpu::ShaderMiscFlags shaderMiscFlags)
 {
-    if (m_triangulator != nullptr)
+    if (m_triangulation != nullptr)
     {
         assert(!isStroke());
         flush->pushOuterCubicsDraw(this,
@@ -1772,26 +1773,30 @@ void PathDraw::pushTessellationData(RenderContext::LogicalFlush* flush,
     }
 
     // Write out the TessVertexSpans and path contours.
-    RenderContext::TessellationWriter tessWriter(flush,
-                                                 m_pathID,
-                                                 m_contourDirections,
-                                                 forwardTessVertexCount,
-                                                 forwardTessLocation,
-                                                 mirroredTessVertexCount,
-                                                 mirroredTessLocation);
-
-    if (m_triangulator != nullptr)
+    flush->pushTessellationData(this,
+                                m_pathID,
+                                m_contourDirections,
+                                forwardTessVertexCount,
+                                forwardTessLocation,
+                                mirroredTessVertexCount,
+                                mirroredTessLocation);
+}
+
+void PathDraw::writeTessellationData(
+    RenderContext::TessellationWriter* tessWriter)
+{
+    if (m_triangulation != nullptr)
     {
         iterateInteriorTriangulation(
             InteriorTriangulationOp::pushOuterCubicTessellationData,
             nullptr,
             nullptr,
             TriangulatorAxis::dontCare,
-            &tessWriter);
+            tessWriter);
     }
     else
     {
-        pushMidpointFanTessellationData(&tessWriter);
+        pushMidpointFanTessellationData(tessWriter);
     }
 }
 
@@ -2204,7 +2209,7 @@ void PathDraw::pushEmulatedStrokeCapAsJoinBeforeCubic(
 
 void PathDraw::iterateInteriorTriangulation(
     InteriorTriangulationOp op,
-    TrivialBlockAllocator* allocator,
+    RenderContext* context,
     RawPath* scratchPath,
     TriangulatorAxis triangulatorAxis,
     RenderContext::TessellationWriter* tessWriter)
@@ -2371,29 +2376,35 @@ void PathDraw::iterateInteriorTriangulation(
 
     if (op == InteriorTriangulationOp::countDataAndTriangulate)
     {
-        assert(m_triangulator == nullptr);
+        assert(m_triangulation == nullptr);
         assert(triangulatorAxis != TriangulatorAxis::dontCare);
-        m_triangulator = allocator->make<GrInnerFanTriangulator>(
-            *scratchPath,
-            m_matrix,
+        // clockwise and nonZero paths both get triangulated as nonZero,
+        // because clockwise fill still needs the backwards triangles for
+        // borrowed coverage.
+        FillRule triangulatorFillRule = m_pathFillRule == FillRule::evenOdd
+                                            ? FillRule::evenOdd
+                                            : FillRule::nonZero;
+        auto triangulatorDirection =
             triangulatorAxis == TriangulatorAxis::horizontal
                 ? GrTriangulator::Comparator::Direction::kHorizontal
-                : GrTriangulator::Comparator::Direction::kVertical,
-            // clockwise and nonZero paths both get triangulated as nonZero,
-            // because clockwise fill still needs the backwards triangles for
-            // borrowed coverage.
-            m_pathFillRule == FillRule::evenOdd ? FillRule::evenOdd
-                                                : FillRule::nonZero,
-            allocator);
+                : GrTriangulator::Comparator::Direction::kVertical;
+        m_triangulation = context->m_triangulationCache
+                              ->findOrTriangulate(
+                                  m_pathRef,
+                                  triangulatorFillRule,
+                                  triangulatorDirection,
+                                  m_matrix,
+                                  {m_numChops.data(), m_numChops.pushCount()},
+                                  *scratchPath,
+                                  &context->perFrameAllocator())
+                              .release();
         float matrixDeterminant =
             m_matrix[0] * m_matrix[3] - m_matrix[2] * m_matrix[1];
-        if ((matrixDeterminant < 0) !=
-            static_cast<bool>(m_contourFlags & NEGATE_PATH_FILL_COVERAGE_FLAG))
-        {
-            m_triangulator->negateWinding();
-        }
+        m_negatesInteriorWinding =
+            (matrixDeterminant < 0) !=
+            static_cast<bool>(m_contourFlags & NEGATE_PATH_FILL_COVERAGE_FLAG);
         // We also draw each "grout" triangle using an outerCubic patch.
-        patchCount += m_triangulator->groutList().count();
+        patchCount += m_triangulation->groutTriangles().size();
 
         if (patchCount > 0)
         {
@@ -2410,20 +2421,16 @@ void PathDraw::iterateInteriorTriangulation(
                     ? patchCount * kOuterCurvePatchSegmentSpan * 2
                     : patchCount * kOuterCurvePatchSegmentSpan;
             m_resourceCounts.maxTriangleVertexCount +=
-                m_triangulator->maxVertexCount();
+                m_triangulation->maxVertexCount();
         }
     }
     else
     {
-        assert(m_triangulator != nullptr);
+        assert(m_triangulation != nullptr);
         // Submit grout triangles, retrofitted into outerCubic patches.
-        for (auto* node = m_triangulator->groutList().head(); node;
-             node = node->fNext)
+        for (const auto& grout : m_triangulation->groutTriangles())
         {
-            Vec2D triangleAsCubic[4] = {node->fPts[0],
-                                        node->fPts[1],
-                                        {0, 0},
-                                        node->fPts[2]};
+            Vec2D triangleAsCubic[4] = {grout[0], grout[1], {0, 0}, grout[2]};
             tessWriter->pushCubic(triangleAsCubic,
                                   m_contourDirections,
                                   {0, 0},
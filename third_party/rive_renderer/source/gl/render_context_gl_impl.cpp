@@ -1232,8 +1232,11 @@ void RenderContextGLImpl::flush(const FlushDescriptor& desc)
         glViewport(0, 0, kGradTextureWidth, desc.gradDataHeight);
         glBindFramebuffer(GL_FRAMEBUFFER, m_colorRampFBO);
         m_state->bindProgram(m_colorRampProgram);
-        GLenum colorAttachment0 = GL_COLOR_ATTACHMENT0;
-        glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &colorAttachment0);
+        if (!desc.preserveGradTexture)
+        {
+            GLenum colorAttachment0 = GL_COLOR_ATTACHMENT0;
+            glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &colorAttachment0);
+        }
         glDrawArraysInstanced(GL_TRIANGLE_STRIP,
                               0,
                               gpu::GRAD_SPAN_TRI_STRIP_VERTEX_COUNT,
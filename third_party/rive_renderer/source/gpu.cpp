@@ -544,11 +544,6 @@ void PaintData::set(DrawContents singleDrawContents,
         case PaintType::radialGradient:
         {
             uint32_t row = simplePaintValue.colorRampLocation.row;
-            if (simplePaintValue.colorRampLocation.isComplex())
-            {
-                // Complex gradients rows are offset after the simple gradients.
-                row += gradTextureLayout.complexOffsetY;
-            }
             m_gradTextureY = (static_cast<float>(row) + .5f) *
                              gradTextureLayout.inverseHeight;
             localParams |= shiftedClipID | shiftedBlendMode;
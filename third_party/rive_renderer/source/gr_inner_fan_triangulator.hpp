@@ -51,9 +51,8 @@ public:
     size_t maxVertexCount() const { return m_maxVertexCount; }
 
     size_t polysToTriangles(
-        uint16_t pathID,
         gpu::WindingFaces windingFaces,
-        gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory) const
+        std::vector<GrTriangleVertex>* outVertices) const
 
     {
         if (m_polys == nullptr || m_maxVertexCount == 0)
@@ -62,11 +61,10 @@ public:
         }
         return GrTriangulator::polysToTriangles(m_polys,
                                                 m_maxVertexCount,
-                                                pathID,
                                                 m_shouldReverseTriangles,
                                                 m_shouldNegateWinding,
                                                 windingFaces,
-                                                mappedMemory);
+                                                outVertices);
     }
 
     const GroutTriangleList& groutList() const { return fBreadcrumbList; }
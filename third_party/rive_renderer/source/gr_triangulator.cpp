@@ -118,8 +118,7 @@ static size_t emit_triangle(
     Vertex* v1,
     Vertex* v2,
     int16_t riveWeight,
-    uint16_t pathID,
-    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory)
+    std::vector<GrTriangleVertex>* outVertices)
 {
     TESS_LOG("emit_triangle %g (%g, %g) %d\n",
              v0->fID,
@@ -136,9 +135,9 @@ static size_t emit_triangle(
              v2->fPoint.x,
              v2->fPoint.y,
              v2->fAlpha);
-    mappedMemory->emplace_back(v0->fPoint, riveWeight, pathID);
-    mappedMemory->emplace_back(v1->fPoint, riveWeight, pathID);
-    mappedMemory->emplace_back(v2->fPoint, riveWeight, pathID);
+    outVertices->push_back({v0->fPoint, riveWeight});
+    outVertices->push_back({v1->fPoint, riveWeight});
+    outVertices->push_back({v2->fPoint, riveWeight});
     return 3;
 }
 
@@ -447,11 +446,10 @@ void GrTriangulator::MonotonePoly::addEdge(Edge* edge)
 
 size_t GrTriangulator::emitMonotonePoly(
     const MonotonePoly* monotonePoly,
-    uint16_t pathID,
     bool reverseTriangles,
     bool negateWinding,
     gpu::WindingFaces windingFaces,
-    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory) const
+    std::vector<GrTriangleVertex>* outVertices) const
 {
     // GrTriangulator and Rive unfortunately have opposite winding senses.
     int16_t riveWeight = -monotonePoly->fWinding;
@@ -498,9 +496,8 @@ size_t GrTriangulator::emitMonotonePoly(
                                         curr,
                                         next,
                                         riveWeight,
-                                        pathID,
                                         reverseTriangles,
-                                        mappedMemory);
+                                        outVertices);
             break;
         }
         double ax = static_cast<double>(curr->fPoint.x) - prev->fPoint.x;
@@ -513,9 +510,8 @@ size_t GrTriangulator::emitMonotonePoly(
                                         curr,
                                         next,
                                         riveWeight,
-                                        pathID,
                                         reverseTriangles,
-                                        mappedMemory);
+                                        outVertices);
             v->fPrev->fNext = v->fNext;
             v->fNext->fPrev = v->fPrev;
             count--;
@@ -541,15 +537,14 @@ size_t GrTriangulator::emitTriangle(
     Vertex* curr,
     Vertex* next,
     int16_t riveWeight,
-    uint16_t pathID,
     bool reverseTriangles,
-    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory) const
+    std::vector<GrTriangleVertex>* outVertices) const
 {
     if (reverseTriangles)
     {
         std::swap(prev, next);
     }
-    return emit_triangle(prev, curr, next, riveWeight, pathID, mappedMemory);
+    return emit_triangle(prev, curr, next, riveWeight, outVertices);
 }
 
 GrTriangulator::Poly::Poly(Vertex* v, int winding) :
@@ -635,11 +630,10 @@ Poly* GrTriangulator::Poly::addEdge(Edge* e, Side side, GrTriangulator* tri)
 
 size_t GrTriangulator::emitPoly(
     const Poly* poly,
-    uint16_t pathID,
     bool reverseTriangles,
     bool negateWinding,
     gpu::WindingFaces windingFaces,
-    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory) const
+    std::vector<GrTriangleVertex>* outVertices) const
 {
     if (poly->fCount < 3)
     {
@@ -650,11 +644,10 @@ size_t GrTriangulator::emitPoly(
     for (MonotonePoly* m = poly->fHead; m != nullptr; m = m->fNext)
     {
         vertexCount += emitMonotonePoly(m,
-                                        pathID,
                                         reverseTriangles,
                                         negateWinding,
                                         windingFaces,
-                                        mappedMemory);
+                                        outVertices);
     }
     return vertexCount;
 }
@@ -2453,11 +2446,10 @@ std::tuple<Poly*, bool> GrTriangulator::contoursToPolys(VertexList* contours,
 size_t GrTriangulator::polysToTriangles(
     Poly* polys,
     FillRule overrideFillType,
-    uint16_t pathID,
     bool reverseTriangles,
     bool negateWinding,
     gpu::WindingFaces windingFaces,
-    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory) const
+    std::vector<GrTriangleVertex>* outVertices) const
 {
     size_t vertexCount = 0;
     for (Poly* poly = polys; poly; poly = poly->fNext)
@@ -2465,11 +2457,10 @@ size_t GrTriangulator::polysToTriangles(
         if (apply_fill_type(overrideFillType, poly))
         {
             vertexCount += emitPoly(poly,
-                                    pathID,
                                     reverseTriangles,
                                     negateWinding,
                                     windingFaces,
-                                    mappedMemory);
+                                    outVertices);
         }
     }
     return vertexCount;
@@ -2558,11 +2549,10 @@ size_t GrTriangulator::countMaxTriangleVertices(Poly* polys) const
 size_t GrTriangulator::polysToTriangles(
     Poly* polys,
     uint64_t maxVertexCount,
-    uint16_t pathID,
     bool reverseTriangles,
     bool negateWinding,
     gpu::WindingFaces windingFaces,
-    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>* mappedMemory) const
+    std::vector<GrTriangleVertex>* outVertices) const
 {
     if (0 == maxVertexCount ||
         maxVertexCount > std::numeric_limits<int32_t>::max())
@@ -2572,11 +2562,10 @@ size_t GrTriangulator::polysToTriangles(
 
     size_t actualCount = polysToTriangles(polys,
                                           fFillRule,
-                                          pathID,
                                           reverseTriangles,
                                           negateWinding,
                                           windingFaces,
-                                          mappedMemory);
+                                          outVertices);
     assert(actualCount <= maxVertexCount);
     return actualCount;
 }
@@ -20,12 +20,21 @@
 #include "rive/math/aabb.hpp"
 #include "rive/renderer/gpu.hpp"
 #include "rive/renderer/trivial_block_allocator.hpp"
+#include <vector>
 
 namespace rive
 {
 #define TRIANGULATOR_LOGGING 0
 #define TRIANGULATOR_WIREFRAME 0
 
+// Triangle vertex emitted by GrTriangulator, in path space. The renderer adds
+// the pathID when it copies these into a gpu::TriangleVertex buffer.
+struct GrTriangleVertex
+{
+    Vec2D point;
+    int16_t weight;
+};
+
 /**
  * Provides utility functions for converting paths to a collection of triangles.
  */
@@ -123,11 +132,10 @@ protected:
     size_t polysToTriangles(
         Poly* polys,
         FillRule overrideFillRule,
-        uint16_t pathID,
         bool reverseTriangles,
         bool negateWinding,
         gpu::WindingFaces,
-        gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>*) const;
+        std::vector<GrTriangleVertex>*) const;
 
     // The vertex sorting in step (3) is a merge sort, since it plays well with
     // the linked list of vertices (and the necessity of inserting new vertices
@@ -185,24 +193,21 @@ protected:
     // Additional helpers and driver functions.
     size_t emitMonotonePoly(
         const MonotonePoly*,
-        uint16_t pathID,
         bool reverseTriangles,
         bool negateWinding,
         gpu::WindingFaces,
-        gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>*) const;
+        std::vector<GrTriangleVertex>*) const;
     size_t emitTriangle(Vertex* prev,
                         Vertex* curr,
                         Vertex* next,
                         int16_t riveWeight,
-                        uint16_t pathID,
                         bool reverseTriangles,
-                        gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>*) const;
+                        std::vector<GrTriangleVertex>*) const;
     size_t emitPoly(const Poly*,
-                    uint16_t pathID,
                     bool reverseTriangles,
                     bool negateWinding,
                     gpu::WindingFaces,
-                    gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>*) const;
+                    std::vector<GrTriangleVertex>*) const;
 
     Poly* makePoly(Poly** head, Vertex* v, int winding) const;
     void appendPointToContour(const Vec2D& p, VertexList* contour) const;
@@ -300,11 +305,10 @@ protected:
     size_t polysToTriangles(
         Poly*,
         uint64_t maxVertexCount,
-        uint16_t pathID,
         bool reverseTriangles,
         bool negateWinding,
         gpu::WindingFaces,
-        gpu::WriteOnlyMappedMemory<gpu::TriangleVertex>*) const;
+        std::vector<GrTriangleVertex>*) const;
 
     Comparator::Direction fDirection;
     FillRule fFillRule;
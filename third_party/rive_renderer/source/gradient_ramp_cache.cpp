@@ -0,0 +1,228 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "gradient_ramp_cache.hpp"
+
+#include "gradient.hpp"
+#include <string_view>
+
+namespace rive::gpu
+{
+GradientContentKey::GradientContentKey(rcp<const Gradient> gradient) :
+    m_gradient(std::move(gradient))
+{}
+
+GradientContentKey::GradientContentKey(GradientContentKey&& other) :
+    m_gradient(std::move(other.m_gradient))
+{}
+
+bool GradientContentKey::operator==(const GradientContentKey& other) const
+{
+    if (m_gradient.get() == other.m_gradient.get())
+    {
+        return true;
+    }
+    else
+    {
+        return m_gradient->count() == other.m_gradient->count() &&
+               !memcmp(m_gradient->stops(),
+                       other.m_gradient->stops(),
+                       m_gradient->count() * sizeof(float)) &&
+               !memcmp(m_gradient->colors(),
+                       other.m_gradient->colors(),
+                       m_gradient->count() * sizeof(ColorInt));
+    }
+}
+
+size_t DeepHashGradient::operator()(const GradientContentKey& key) const
+{
+    const Gradient* grad = key.gradient();
+    std::hash<std::string_view> hash;
+    size_t x =
+        hash(std::string_view(reinterpret_cast<const char*>(grad->stops()),
+                              grad->count() * sizeof(float)));
+    size_t y =
+        hash(std::string_view(reinterpret_cast<const char*>(grad->colors()),
+                              grad->count() * sizeof(ColorInt)));
+    return x ^ y;
+}
+
+void GradientRampCache::beginLogicalFlush()
+{
+    ++m_currentFlush;
+    if (m_capacity == 0)
+    {
+        clear();
+    }
+}
+
+bool GradientRampCache::allocateSimpleRamp(uint64_t colors,
+                                           Allocation* allocation)
+{
+    auto iter = m_simpleRamps.find(colors);
+    if (iter != m_simpleRamps.end())
+    {
+        touch(iter->second, allocation);
+        return true;
+    }
+
+    if (m_openSimpleRow < 0 ||
+        m_rows[m_openSimpleRow].simpleRamps.size() ==
+            kGradTextureWidthInSimpleRamps)
+    {
+        m_openSimpleRow = acquireRow();
+        if (m_openSimpleRow < 0)
+        {
+            return false;
+        }
+    }
+    Row& row = m_rows[m_openSimpleRow];
+    Entry entry;
+    entry.location.row = static_cast<uint16_t>(m_openSimpleRow);
+    entry.location.col = static_cast<uint16_t>(row.simpleRamps.size() * 2);
+    entry.generation = ++m_lastGeneration;
+    entry.lastUsedFlush = 0;
+    row.simpleRamps.push_back(colors);
+    touch(m_simpleRamps.emplace(colors, entry).first->second, allocation);
+    return true;
+}
+
+bool GradientRampCache::allocateComplexRamp(const Gradient* gradient,
+                                            Allocation* allocation)
+{
+    GradientContentKey key(ref_rcp(gradient));
+    auto iter = m_complexRamps.find(key);
+    if (iter != m_complexRamps.end())
+    {
+        touch(iter->second, allocation);
+        return true;
+    }
+
+    int row = acquireRow();
+    if (row < 0)
+    {
+        return false;
+    }
+    m_rows[row].complexRamp = ref_rcp(gradient);
+    Entry entry;
+    entry.location.row = static_cast<uint16_t>(row);
+    entry.location.col = ColorRampLocation::kComplexGradientMarker;
+    entry.generation = ++m_lastGeneration;
+    entry.lastUsedFlush = 0;
+    touch(m_complexRamps.emplace(std::move(key), entry).first->second,
+          allocation);
+    return true;
+}
+
+bool GradientRampCache::markRampWritten(ColorRampLocation location,
+                                        uint64_t generation)
+{
+    size_t idx = location.row * kGradTextureWidthInSimpleRamps;
+    if (!location.isComplex())
+    {
+        idx += location.col / 2;
+    }
+    if (idx >= m_texelGenerations.size())
+    {
+        m_texelGenerations.resize(
+            (location.row + 1) * kGradTextureWidthInSimpleRamps,
+            0);
+    }
+    if (m_texelGenerations[idx] == generation)
+    {
+        ++m_counters.rampsReused;
+        return false;
+    }
+    m_texelGenerations[idx] = generation;
+    ++m_counters.rampsWritten;
+    return true;
+}
+
+void GradientRampCache::invalidateTexture() { m_texelGenerations.clear(); }
+
+void GradientRampCache::setCapacity(size_t rowCount)
+{
+    m_capacity = rowCount;
+    clear();
+}
+
+void GradientRampCache::trim()
+{
+    if (m_rows.size() > m_capacity)
+    {
+        clear();
+    }
+}
+
+void GradientRampCache::clear()
+{
+    m_simpleRamps.clear();
+    m_complexRamps.clear();
+    m_rows.clear();
+    m_openSimpleRow = -1;
+}
+
+int GradientRampCache::acquireRow()
+{
+    if (m_rows.size() < m_capacity)
+    {
+        m_rows.emplace_back();
+        return static_cast<int>(m_rows.size() - 1);
+    }
+
+    // Recycle the least recently used row that the current logical flush
+    // doesn't need.
+    int lruRow = -1;
+    for (size_t i = 0; i < m_rows.size(); ++i)
+    {
+        uint64_t lastUsedFlush = m_rows[i].lastUsedFlush;
+        if (lastUsedFlush != m_currentFlush &&
+            (lruRow < 0 || lastUsedFlush < m_rows[lruRow].lastUsedFlush))
+        {
+            lruRow = static_cast<int>(i);
+        }
+    }
+    if (lruRow >= 0)
+    {
+        evictRow(lruRow);
+        return lruRow;
+    }
+
+    // The current logical flush uses every row. Go past the capacity.
+    if (m_rows.size() < m_maxRowCount)
+    {
+        m_rows.emplace_back();
+        return static_cast<int>(m_rows.size() - 1);
+    }
+    return -1;
+}
+
+void GradientRampCache::evictRow(uint32_t row)
+{
+    Row& evicted = m_rows[row];
+    for (uint64_t colors : evicted.simpleRamps)
+    {
+        m_simpleRamps.erase(colors);
+    }
+    evicted.simpleRamps.clear();
+    if (evicted.complexRamp != nullptr)
+    {
+        m_complexRamps.erase(
+            GradientContentKey(std::move(evicted.complexRamp)));
+    }
+    if (m_openSimpleRow == static_cast<int>(row))
+    {
+        m_openSimpleRow = -1;
+    }
+}
+
+void GradientRampCache::touch(Entry& entry, Allocation* allocation)
+{
+    allocation->location = entry.location;
+    allocation->generation = entry.generation;
+    allocation->firstUseInFlush = entry.lastUsedFlush != m_currentFlush;
+    entry.lastUsedFlush = m_currentFlush;
+    m_rows[entry.location.row].lastUsedFlush = m_currentFlush;
+}
+} // namespace rive::gpu
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/refcnt.hpp"
+#include "rive/renderer/gpu.hpp"
+#include "rive/renderer/render_context.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace rive::gpu
+{
+class Gradient;
+
+// Used as a key for complex gradients.
+class GradientContentKey
+{
+public:
+    GradientContentKey(rcp<const Gradient> gradient);
+    GradientContentKey(GradientContentKey&& other);
+    bool operator==(const GradientContentKey&) const;
+    const Gradient* gradient() const { return m_gradient.get(); }
+
+private:
+    rcp<const Gradient> m_gradient;
+};
+
+// Hashes all stops and all colors in a complex gradient.
+class DeepHashGradient
+{
+public:
+    size_t operator()(const GradientContentKey&) const;
+};
+
+// Keeps color ramps in the gradient texture across flushes. A ramp gets a
+// fixed location the first time it's allocated and keeps it for as long as it
+// stays in the cache, so it only has to be drawn into the texture again once
+// its texels were handed to a different ramp, or the texture lost its
+// contents.
+//
+// Texels get recycled a whole row at a time: each row holds either one complex
+// ramp or up to kGradTextureWidthInSimpleRamps simple ones, and the least
+// recently used row goes first. Rows used by the current logical flush are
+// never recycled.
+//
+// Every ramp placed in the texture gets a new generation number. Which
+// generation each location of the texture holds is tracked separately from the
+// allocations, in the order the logical flushes draw their ramps, since a
+// later logical flush of the same frame can take over texels that an earlier
+// one still has to draw.
+class GradientRampCache
+{
+public:
+    constexpr static size_t kDefaultCapacity = 64;
+
+    using Counters = RenderContext::GradientRampCacheCounters;
+
+    GradientRampCache(size_t maxRowCount) : m_maxRowCount(maxRowCount) {}
+
+    struct Allocation
+    {
+        ColorRampLocation location;
+        uint64_t generation;
+        // True if this is the first time the current logical flush used the
+        // ramp.
+        bool firstUseInFlush;
+    };
+
+    // Starts allocating for a new logical flush. With a capacity of 0, this
+    // also forgets every ramp, so each logical flush draws its own.
+    void beginLogicalFlush();
+
+    // Finds the ramp with the given colors, or gives it a location. Returns
+    // false if every row is taken by the current logical flush, at which point
+    // the caller must issue a logical flush and try again.
+    [[nodiscard]] bool allocateSimpleRamp(uint64_t colors, Allocation*);
+    [[nodiscard]] bool allocateComplexRamp(const Gradient*, Allocation*);
+
+    // Called in the order the logical flushes will draw their ramps. Returns
+    // true if the ramp's location doesn't already hold 'generation', which
+    // means it has to be drawn, and records it as being there from now on.
+    bool markRampWritten(ColorRampLocation, uint64_t generation);
+
+    // Forgets what the gradient texture holds, e.g. because it's about to be
+    // reallocated. Allocations are kept, but every ramp gets drawn again on
+    // its next use.
+    void invalidateTexture();
+
+    // Number of rows handed out, i.e., the height of the texture the cached
+    // ramps need.
+    size_t rowCount() const { return m_rows.size(); }
+
+    // Rows past the capacity are only handed out when the current logical
+    // flush already uses every other row.
+    void setCapacity(size_t rowCount);
+    size_t capacity() const { return m_capacity; }
+
+    // Forgets every ramp if a flush grew the cache past its capacity, so the
+    // texture can shrink again.
+    void trim();
+
+    void clear();
+
+    const Counters& counters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters(); }
+
+private:
+    struct Entry
+    {
+        ColorRampLocation location;
+        uint64_t generation;
+        uint64_t lastUsedFlush;
+    };
+
+    struct Row
+    {
+        uint64_t lastUsedFlush = 0;
+        // Colors of the simple ramps in this row, or the complex ramp that
+        // fills it.
+        std::vector<uint64_t> simpleRamps;
+        rcp<const Gradient> complexRamp;
+    };
+
+    // Returns an empty row, or -1 if the texture is out of rows.
+    int acquireRow();
+    void evictRow(uint32_t row);
+
+    void touch(Entry&, Allocation*);
+
+    const size_t m_maxRowCount;
+    size_t m_capacity = kDefaultCapacity;
+    uint64_t m_currentFlush = 0;
+    uint64_t m_lastGeneration = 0;
+
+    std::unordered_map<uint64_t, Entry> m_simpleRamps;
+    std::unordered_map<GradientContentKey, Entry, DeepHashGradient>
+        m_complexRamps;
+
+    std::vector<Row> m_rows;
+    // Row that new simple ramps get added to, or -1.
+    int m_openSimpleRow = -1;
+
+    // Generation held at each two-texel location of the texture, indexed by
+    // "row * kGradTextureWidthInSimpleRamps + col / 2". Complex ramps are
+    // tracked at col 0.
+    std::vector<uint64_t> m_texelGenerations;
+
+    Counters m_counters;
+};
+} // namespace rive::gpu
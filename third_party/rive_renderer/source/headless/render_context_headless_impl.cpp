@@ -0,0 +1,262 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "rive/renderer/headless/render_context_headless_impl.hpp"
+
+#include "rive/renderer/texture.hpp"
+#include "shaders/constants.glsl"
+#include "utils/factory_utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rive::gpu
+{
+// Host memory buffer ring that counts, and optionally hashes, the bytes
+// written through it.
+class RenderContextHeadlessImpl::HeadlessBufferRing : public HeapBufferRing
+{
+public:
+    HeadlessBufferRing(size_t capacityInBytes,
+                       bool hashContents,
+                       Counters* counters) :
+        HeapBufferRing(capacityInBytes),
+        m_hashContents(hashContents),
+        m_counters(counters)
+    {}
+
+protected:
+    void* onMapBuffer(int bufferIdx, size_t mapSizeInBytes) override
+    {
+        void* contents = HeapBufferRing::onMapBuffer(bufferIdx, mapSizeInBytes);
+        if (m_hashContents)
+        {
+            // Bytes the front end skips would otherwise hold whatever an
+            // earlier frame left there.
+            memset(contents, 0, mapSizeInBytes);
+        }
+        return contents;
+    }
+
+    void onUnmapAndSubmitBuffer(int bufferIdx, size_t mapSizeInBytes) override
+    {
+        m_counters->bytesMapped += mapSizeInBytes;
+        if (m_hashContents)
+        {
+            // FNV-1a, continued across buffers.
+            uint64_t hash = m_counters->mappedBytesHash;
+            const uint8_t* bytes = contents();
+            for (size_t i = 0; i < mapSizeInBytes; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+            }
+            m_counters->mappedBytesHash = hash;
+        }
+    }
+
+private:
+    const bool m_hashContents;
+    Counters* const m_counters;
+};
+
+std::unique_ptr<RenderContext> RenderContextHeadlessImpl::MakeContext(
+    const ContextOptions& contextOptions)
+{
+    auto renderContextImpl = std::unique_ptr<RenderContextHeadlessImpl>(
+        new RenderContextHeadlessImpl(contextOptions));
+    return std::make_unique<RenderContext>(std::move(renderContextImpl));
+}
+
+RenderContextHeadlessImpl::RenderContextHeadlessImpl(
+    const ContextOptions& contextOptions) :
+    m_options(contextOptions)
+{
+    m_platformFeatures.supportsRasterOrdering =
+        !contextOptions.disableRasterOrdering;
+    m_platformFeatures.supportsFragmentShaderAtomics =
+        !contextOptions.disableFragmentShaderAtomics;
+    m_platformFeatures.supportsClipPlanes = true;
+    // Lay out resources the way Metal, D3D and WebGPU do.
+    m_platformFeatures.clipSpaceBottomUp = true;
+    m_platformFeatures.framebufferBottomUp = false;
+    m_platformFeatures.maxTextureSize = 8192;
+}
+
+rcp<RenderBuffer> RenderContextHeadlessImpl::makeRenderBuffer(
+    RenderBufferType type,
+    RenderBufferFlags flags,
+    size_t sizeInBytes)
+{
+    return make_rcp<DataRenderBuffer>(type, flags, sizeInBytes);
+}
+
+rcp<Texture> RenderContextHeadlessImpl::makeImageTexture(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevelCount,
+    const uint8_t imageDataRGBAPremul[])
+{
+    return make_rcp<Texture>(width, height);
+}
+
+void RenderContextHeadlessImpl::resizeGradientTexture(uint32_t width,
+                                                      uint32_t height)
+{
+    m_gradientTextureWidth = width;
+    m_gradientTextureHeight = height;
+    if (m_options.emulateGradientTexture)
+    {
+        // A new texture starts out with undefined contents.
+        m_gradientTexels.assign(size_t(width) * height, 0);
+    }
+}
+
+void RenderContextHeadlessImpl::resizeTessellationTexture(uint32_t width,
+                                                          uint32_t height)
+{
+    m_tessTextureWidth = width;
+    m_tessTextureHeight = height;
+}
+
+std::unique_ptr<BufferRing> RenderContextHeadlessImpl::makeUniformBufferRing(
+    size_t capacityInBytes)
+{
+    return std::make_unique<HeadlessBufferRing>(capacityInBytes,
+                                                m_options.hashMappedBuffers,
+                                                &m_counters);
+}
+
+std::unique_ptr<BufferRing> RenderContextHeadlessImpl::makeStorageBufferRing(
+    size_t capacityInBytes,
+    gpu::StorageBufferStructure)
+{
+    return std::make_unique<HeadlessBufferRing>(capacityInBytes,
+                                                m_options.hashMappedBuffers,
+                                                &m_counters);
+}
+
+std::unique_ptr<BufferRing> RenderContextHeadlessImpl::makeVertexBufferRing(
+    size_t capacityInBytes)
+{
+    return std::make_unique<HeadlessBufferRing>(capacityInBytes,
+                                                m_options.hashMappedBuffers,
+                                                &m_counters);
+}
+
+void RenderContextHeadlessImpl::prepareToFlush(uint64_t nextFrameNumber,
+                                               uint64_t safeFrameNumber)
+{
+    // A new frame is starting; only keep the flushes of the latest one.
+    m_flushes.clear();
+    m_counters.frames++;
+}
+
+void RenderContextHeadlessImpl::flush(const FlushDescriptor& desc)
+{
+    RecordedFlush& recorded = m_flushes.emplace_back();
+    recorded.desc = desc;
+    recorded.desc.renderTarget = nullptr;
+    recorded.desc.externalCommandBuffer = nullptr;
+    recorded.desc.atlasFillBatches = nullptr;
+    recorded.desc.atlasStrokeBatches = nullptr;
+    recorded.desc.drawList = nullptr;
+    recorded.atlasFillBatches.assign(desc.atlasFillBatches,
+                                     desc.atlasFillBatches +
+                                         desc.atlasFillBatchCount);
+    recorded.atlasStrokeBatches.assign(desc.atlasStrokeBatches,
+                                       desc.atlasStrokeBatches +
+                                           desc.atlasStrokeBatchCount);
+    if (desc.drawList != nullptr)
+    {
+        recorded.drawBatches.reserve(desc.drawList->count());
+        for (const DrawBatch& batch : *desc.drawList)
+        {
+            recorded.drawBatches.push_back({batch.drawType,
+                                            batch.shaderMiscFlags,
+                                            batch.elementCount,
+                                            batch.baseElement,
+                                            batch.firstBlendMode,
+                                            batch.barriers,
+                                            batch.drawContents,
+                                            batch.shaderFeatures,
+                                            batch.imageDrawDataOffset,
+                                            batch.imageTexture != nullptr});
+        }
+    }
+    m_counters.flushes++;
+    m_counters.drawBatches += recorded.drawBatches.size();
+
+    if (m_options.emulateGradientTexture)
+    {
+        drawGradientSpans(desc);
+        uint64_t hash = m_counters.gradientTextureHash;
+        const auto* bytes =
+            reinterpret_cast<const uint8_t*>(m_gradientTexels.data());
+        for (size_t i = 0; i < m_gradientTexels.size() * 4; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+        m_counters.gradientTextureHash = hash;
+    }
+}
+
+void RenderContextHeadlessImpl::drawGradientSpans(const FlushDescriptor& desc)
+{
+    if (desc.gradSpanCount == 0)
+    {
+        return;
+    }
+    if (!desc.preserveGradTexture)
+    {
+        // The backends discard the texture before drawing into it.
+        std::fill(m_gradientTexels.begin(), m_gradientTexels.end(), 0);
+    }
+
+    auto* spanBuffer = static_cast<HeapBufferRing*>(gradSpanBufferRing());
+    const auto* spans =
+        reinterpret_cast<const GradientSpan*>(spanBuffer->contents()) +
+        desc.firstGradSpan;
+    const float width = static_cast<float>(m_gradientTextureWidth);
+    for (uint32_t i = 0; i < desc.gradSpanCount; ++i)
+    {
+        const GradientSpan& span = spans[i];
+        uint32_t flags = span.yWithFlags & GRAD_SPAN_FLAGS_MASK;
+        uint32_t y = span.yWithFlags & ~GRAD_SPAN_FLAGS_MASK;
+        assert(y < m_gradientTextureHeight);
+        float x0 = (span.horizontalSpan & 0xffff) / 65536.f * width;
+        float x1 = (span.horizontalSpan >> 16) / 65536.f * width;
+        bool complexBorder = flags & GRAD_SPAN_FLAG_COMPLEX_BORDER;
+        float left = x0;
+        float right = x1;
+        if (flags & GRAD_SPAN_FLAG_LEFT_BORDER)
+        {
+            left = complexBorder ? 0 : x0 - 1;
+        }
+        if (flags & GRAD_SPAN_FLAG_RIGHT_BORDER)
+        {
+            right = complexBorder ? width : x1 + 1;
+        }
+        uint32_t* row = m_gradientTexels.data() + y * m_gradientTextureWidth;
+        for (uint32_t x = 0; x < m_gradientTextureWidth; ++x)
+        {
+            float center = x + .5f;
+            if (center < left || center >= right)
+            {
+                continue;
+            }
+            float t = x1 > x0 ? std::clamp((center - x0) / (x1 - x0), 0.f, 1.f)
+                              : (center < x0 ? 0.f : 1.f);
+            uint32_t texel = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                float c0 = (span.color0 >> shift) & 0xff;
+                float c1 = (span.color1 >> shift) & 0xff;
+                texel |= static_cast<uint32_t>(c0 + (c1 - c0) * t + .5f)
+                         << shift;
+            }
+            row[x] = texel;
+        }
+    }
+}
+} // namespace rive::gpu
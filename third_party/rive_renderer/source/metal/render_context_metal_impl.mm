@@ -1190,7 +1190,9 @@ void RenderContextMetalImpl::flush(const FlushDescriptor& desc)
             [MTLRenderPassDescriptor renderPassDescriptor];
         gradPass.renderTargetWidth = kGradTextureWidth;
         gradPass.renderTargetHeight = desc.gradDataHeight;
-        gradPass.colorAttachments[0].loadAction = MTLLoadActionDontCare;
+        gradPass.colorAttachments[0].loadAction =
+            desc.preserveGradTexture ? MTLLoadActionLoad
+                                     : MTLLoadActionDontCare;
         gradPass.colorAttachments[0].storeAction = MTLStoreActionStore;
         gradPass.colorAttachments[0].texture = m_gradientTexture;
 
@@ -4,17 +4,17 @@
 
 #include "rive/renderer/render_context.hpp"
 
-#include "gr_inner_fan_triangulator.hpp"
 #include "intersection_board.hpp"
+#include "triangulation_cache.hpp"
+#include "gradient_ramp_cache.hpp"
 #include "gradient.hpp"
 #include "rive_render_paint.hpp"
 #include "rive/renderer/draw.hpp"
 #include "rive/renderer/rive_render_image.hpp"
 #include "rive/renderer/render_context_impl.hpp"
+#include "rive/profiler/profiler.hpp"
 #include "shaders/constants.glsl"
 
-#include <string_view>
-
 #ifdef RIVE_DECODERS
 #include "rive/decoders/bitmap_decoder.hpp"
 #endif
@@ -55,59 +55,14 @@ constexpr static size_t resource_texture_height(size_t itemCount)
     return (itemCount + WidthInItems - 1) / WidthInItems;
 }
 
-constexpr static size_t gradient_data_height(size_t simpleRampCount,
-                                             size_t complexRampCount)
-{
-    return resource_texture_height<gpu::kGradTextureWidthInSimpleRamps>(
-               simpleRampCount) +
-           complexRampCount;
-}
-
-inline GradientContentKey::GradientContentKey(rcp<const Gradient> gradient) :
-    m_gradient(std::move(gradient))
-{}
-
-inline GradientContentKey::GradientContentKey(GradientContentKey&& other) :
-    m_gradient(std::move(other.m_gradient))
-{}
-
-bool GradientContentKey::operator==(const GradientContentKey& other) const
-{
-    if (m_gradient.get() == other.m_gradient.get())
-    {
-        return true;
-    }
-    else
-    {
-        return m_gradient->count() == other.m_gradient->count() &&
-               !memcmp(m_gradient->stops(),
-                       other.m_gradient->stops(),
-                       m_gradient->count() * sizeof(float)) &&
-               !memcmp(m_gradient->colors(),
-                       other.m_gradient->colors(),
-                       m_gradient->count() * sizeof(ColorInt));
-    }
-}
-
-size_t DeepHashGradient::operator()(const GradientContentKey& key) const
-{
-    const Gradient* grad = key.gradient();
-    std::hash<std::string_view> hash;
-    size_t x =
-        hash(std::string_view(reinterpret_cast<const char*>(grad->stops()),
-                              grad->count() * sizeof(float)));
-    size_t y =
-        hash(std::string_view(reinterpret_cast<const char*>(grad->colors()),
-                              grad->count() * sizeof(ColorInt)));
-    return x ^ y;
-}
-
 RenderContext::RenderContext(std::unique_ptr<RenderContextImpl> impl) :
     m_impl(std::move(impl)),
     // -1 from m_maxPathID so we reserve a path record for the clearColor paint
     // (for atomic mode). This also allows us to index the storage buffers
     // directly by pathID.
-    m_maxPathID(MaxPathID(m_impl->platformFeatures().pathIDGranularity) - 1)
+    m_maxPathID(MaxPathID(m_impl->platformFeatures().pathIDGranularity) - 1),
+    m_triangulationCache(std::make_unique<TriangulationCache>()),
+    m_gradientRampCache(std::make_unique<GradientRampCache>(kMaxTextureHeight))
 {
     setResourceSizes(ResourceAllocationCounts(), /*forceRealloc =*/true);
     releaseResources();
@@ -162,10 +117,95 @@ rcp<RenderImage> RenderContext::decodeImage(Span<const uint8_t> encodedBytes)
                               : nullptr;
 }
 
+bool RenderContext::canDecodeImagePixels() const
+{
+#ifdef RIVE_DECODERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::unique_ptr<DecodedImage> RenderContext::decodeImagePixels(
+    Span<const uint8_t> encodedBytes)
+{
+#ifdef RIVE_DECODERS
+    auto bitmap = Bitmap::decode(encodedBytes.data(), encodedBytes.size());
+    if (bitmap)
+    {
+        if (bitmap->pixelFormat() != Bitmap::PixelFormat::RGBAPremul)
+        {
+            bitmap->pixelFormat(Bitmap::PixelFormat::RGBAPremul);
+        }
+        auto image = std::make_unique<DecodedImage>();
+        image->width = bitmap->width();
+        image->height = bitmap->height();
+        const uint8_t* bytes = bitmap->bytes();
+        image->pixels.assign(bytes,
+                             bytes + size_t(image->width) * image->height * 4);
+        return image;
+    }
+#endif
+    return nullptr;
+}
+
+rcp<RenderImage> RenderContext::makeImage(const DecodedImage& image)
+{
+    uint32_t mipLevelCount = math::msb(image.height | image.width);
+    rcp<Texture> texture = m_impl->makeImageTexture(image.width,
+                                                    image.height,
+                                                    mipLevelCount,
+                                                    image.pixels.data());
+    return texture != nullptr ? make_rcp<RiveRenderImage>(std::move(texture))
+                              : nullptr;
+}
+
+void RenderContext::setTriangulationCacheCapacity(size_t pathCount)
+{
+    m_triangulationCache->setCapacity(pathCount);
+}
+
+const RenderContext::TriangulationCacheCounters& RenderContext::
+    triangulationCacheCounters() const
+{
+    return m_triangulationCache->counters();
+}
+
+void RenderContext::resetTriangulationCacheCounters()
+{
+    m_triangulationCache->resetCounters();
+}
+
+void RenderContext::setGradientRampCacheCapacity(size_t rowCount)
+{
+    assert(!m_didBeginFrame);
+    m_gradientRampCache->setCapacity(rowCount);
+}
+
+const RenderContext::GradientRampCacheCounters& RenderContext::
+    gradientRampCacheCounters() const
+{
+    return m_gradientRampCache->counters();
+}
+
+void RenderContext::resetGradientRampCacheCounters()
+{
+    m_gradientRampCache->resetCounters();
+}
+
+void RenderContext::invalidateGradientRamps()
+{
+    assert(!m_didBeginFrame);
+    m_gradientRampCache->invalidateTexture();
+}
+
 void RenderContext::releaseResources()
 {
     assert(!m_didBeginFrame);
     resetContainers();
+    m_triangulationCache->clear();
+    m_gradientRampCache->clear();
+    m_gradientRampCache->invalidateTexture();
     setResourceSizes(ResourceAllocationCounts());
     m_maxRecentResourceRequirements = ResourceAllocationCounts();
     m_lastResourceTrimTimeInSeconds = m_impl->secondsNow();
@@ -198,9 +238,8 @@ void RenderContext::LogicalFlush::rewind()
 {
     m_resourceCounts = Draw::ResourceCounters();
     m_drawPassCount = 0;
-    m_simpleGradients.clear();
+    m_ctx->m_gradientRampCache->beginLogicalFlush();
     m_pendingSimpleGradDraws.clear();
-    m_complexGradients.clear();
     m_pendingComplexGradDraws.clear();
     m_pendingGradSpanCount = 0;
     m_clips.clear();
@@ -228,6 +267,10 @@ void RenderContext::LogicalFlush::rewind()
     m_currentPathID = 0;
     m_currentContourID = 0;
 
+    m_pendingTessellationData.clear();
+    m_pendingTessSpanCount = 0;
+    m_deferTessellationData = false;
+
     if (m_atlasRectanizer != nullptr)
     {
         m_atlasRectanizer->reset();
@@ -253,16 +296,10 @@ void RenderContext::LogicalFlush::resetContainers()
     m_draws.shrink_to_fit();
     m_draws.reserve(kDefaultDrawCapacity);
 
-    m_simpleGradients.rehash(0);
-    m_simpleGradients.reserve(kDefaultSimpleGradientCapacity);
-
     m_pendingSimpleGradDraws.clear();
     m_pendingSimpleGradDraws.shrink_to_fit();
     m_pendingSimpleGradDraws.reserve(kDefaultSimpleGradientCapacity);
 
-    m_complexGradients.rehash(0);
-    m_complexGradients.reserve(kDefaultComplexGradientCapacity);
-
     m_pendingComplexGradDraws.clear();
     m_pendingComplexGradDraws.shrink_to_fit();
     m_pendingComplexGradDraws.reserve(kDefaultComplexGradientCapacity);
@@ -481,68 +518,39 @@ bool RenderContext::LogicalFlush::allocateGradient(
         uint64_t simpleKey;
         static_assert(sizeof(simpleKey) == sizeof(ColorInt) * 2);
         RIVE_INLINE_MEMCPY(&simpleKey, &colorRamp, sizeof(ColorInt) * 2);
-        uint32_t rampTexelsIdx;
-        auto iter = m_simpleGradients.find(simpleKey);
-        if (iter != m_simpleGradients.end())
+        GradientRampCache::Allocation allocation;
+        if (!m_ctx->m_gradientRampCache->allocateSimpleRamp(simpleKey,
+                                                            &allocation))
         {
-            // This gradient is already in the texture.
-            rampTexelsIdx = iter->second;
+            // We ran out of rows in the gradient texture. Caller has to flush
+            // and try again.
+            return false;
         }
-        else
+        if (allocation.firstUseInFlush)
         {
-            if (gradient_data_height(m_simpleGradients.size() + 1,
-                                     m_complexGradients.size()) >
-                kMaxTextureHeight)
-            {
-                // We ran out of rows in the gradient texture. Caller has to
-                // flush and try again.
-                return false;
-            }
-            rampTexelsIdx = math::lossless_numeric_cast<uint32_t>(
-                m_simpleGradients.size() * 2);
-            m_simpleGradients.insert({simpleKey, rampTexelsIdx});
-            m_pendingSimpleGradDraws.push_back(colorRamp);
-            // Simple gradients get uploaded to the GPU as a single GradientSpan
-            // instance.
-            ++m_pendingGradSpanCount;
+            m_pendingSimpleGradDraws.push_back(
+                {colorRamp, allocation.location, allocation.generation});
         }
-        colorRampLocation->row = rampTexelsIdx / kGradTextureWidth;
-        colorRampLocation->col = rampTexelsIdx % kGradTextureWidth;
+        *colorRampLocation = allocation.location;
     }
     else
     {
         // This is a complex gradient. Render it to an entire row of the
         // gradient texture.
-        GradientContentKey key(ref_rcp(gradient));
-        auto iter = m_complexGradients.find(key);
-        uint16_t row;
-        if (iter != m_complexGradients.end())
+        GradientRampCache::Allocation allocation;
+        if (!m_ctx->m_gradientRampCache->allocateComplexRamp(gradient,
+                                                             &allocation))
         {
-            row = iter->second; // This gradient is already in the texture.
+            // We ran out of rows in the gradient texture. Caller has to flush
+            // and try again.
+            return false;
         }
-        else
+        if (allocation.firstUseInFlush)
         {
-            if (gradient_data_height(m_simpleGradients.size(),
-                                     m_complexGradients.size() + 1) >
-                kMaxTextureHeight)
-            {
-                // We ran out of rows in the gradient texture. Caller has to
-                // flush and try again.
-                return false;
-            }
-
-            row = static_cast<uint32_t>(m_complexGradients.size());
-            m_complexGradients.emplace(std::move(key), row);
-            m_pendingComplexGradDraws.push_back(gradient);
-
-            size_t spanCount = stopCount - 1;
-            m_pendingGradSpanCount += spanCount;
+            m_pendingComplexGradDraws.push_back(
+                {gradient, allocation.location, allocation.generation});
         }
-        // Store the row relative to the first complex gradient for now.
-        // PaintData::set() will offset this value by the number of simple
-        // gradient rows once its final value is known.
-        colorRampLocation->row = row;
-        colorRampLocation->col = ColorRampLocation::kComplexGradientMarker;
+        *colorRampLocation = allocation.location;
     }
     return true;
 }
@@ -633,6 +641,7 @@ void RenderContext::logicalFlush()
 
 void RenderContext::flush(const FlushResources& flushResources)
 {
+    RIVE_PROF_SCOPENAME("RenderContext::flush");
     assert(m_didBeginFrame);
     assert(flushResources.renderTarget->width() ==
            m_frameDescriptor.renderTargetWidth);
@@ -641,6 +650,21 @@ void RenderContext::flush(const FlushResources& flushResources)
 
     m_clipContentID = 0;
 
+    // Every 5 seconds, trim resources down to the most recent steady-state
+    // usage.
+    double flushTime = m_impl->secondsNow();
+    bool needsResourceTrim = flushTime - m_lastResourceTrimTimeInSeconds >= 5;
+
+    // The gradient texture loses its contents when it gets reallocated, which
+    // only happens when it grows or gets trimmed. Find out before layout, so
+    // the ramps it held get drawn again.
+    if (m_gradientRampCache->rowCount() >
+            m_currentResourceAllocations.gradTextureHeight ||
+        needsResourceTrim)
+    {
+        m_gradientRampCache->invalidateTexture();
+    }
+
     // Layout this frame's resource buffers and textures.
     LogicalFlush::ResourceCounters totalFrameResourceCounts;
     LogicalFlush::LayoutCounters layoutCounts;
@@ -673,7 +697,10 @@ void RenderContext::flush(const FlushResources& flushResources)
         totalFrameResourceCounts.maxTessellatedSegmentCount;
     resourceRequirements.triangleVertexBufferCount =
         totalFrameResourceCounts.maxTriangleVertexCount;
-    resourceRequirements.gradTextureHeight = layoutCounts.maxGradTextureHeight;
+    // Ramps kept from earlier flushes may sit below the rows this frame drew.
+    resourceRequirements.gradTextureHeight =
+        std::max<size_t>(layoutCounts.maxGradTextureHeight,
+                         m_gradientRampCache->rowCount());
     resourceRequirements.tessTextureHeight = layoutCounts.maxTessTextureHeight;
     resourceRequirements.atlasTextureWidth = layoutCounts.maxAtlasWidth;
     resourceRequirements.atlasTextureHeight = layoutCounts.maxAtlasHeight;
@@ -722,10 +749,7 @@ void RenderContext::flush(const FlushResources& flushResources)
         std::min(allocs.coverageBufferLength,
                  platformFeatures().maxCoverageBufferLength);
 
-    // Additionally, every 5 seconds, trim resources down to the most recent
-    // steady-state usage.
-    double flushTime = m_impl->secondsNow();
-    bool needsResourceTrim = flushTime - m_lastResourceTrimTimeInSeconds >= 5;
+    // Additionally, trim resources down to the most recent steady-state usage.
     if (needsResourceTrim)
     {
         // Trim GPU resource allocations to 125% of their maximum recent usage,
@@ -818,6 +842,7 @@ void RenderContext::flush(const FlushResources& flushResources)
     if (needsResourceTrim)
     {
         resetContainers();
+        m_gradientRampCache->trim();
     }
 }
 
@@ -849,6 +874,35 @@ void RenderContext::LogicalFlush::layoutResources(
         math::padding_to_align_up<gpu::kContourBufferAlignmentInElements>(
             m_resourceCounts.contourCount);
 
+    // Only draw the ramps the gradient texture doesn't hold yet. The texture
+    // still has to be tall enough for the ones it does.
+    GradientRampCache* gradientRampCache = m_ctx->m_gradientRampCache.get();
+    uint32_t gradDataHeight = 0;
+    size_t simpleGradDrawCount = 0;
+    for (const PendingSimpleGradDraw& draw : m_pendingSimpleGradDraws)
+    {
+        gradDataHeight = std::max(gradDataHeight, draw.location.row + 1u);
+        if (gradientRampCache->markRampWritten(draw.location, draw.generation))
+        {
+            m_pendingSimpleGradDraws[simpleGradDrawCount++] = draw;
+        }
+    }
+    m_pendingSimpleGradDraws.resize(simpleGradDrawCount);
+    // Simple gradients get uploaded to the GPU as a single GradientSpan
+    // instance.
+    m_pendingGradSpanCount = simpleGradDrawCount;
+    size_t complexGradDrawCount = 0;
+    for (const PendingComplexGradDraw& draw : m_pendingComplexGradDraws)
+    {
+        gradDataHeight = std::max(gradDataHeight, draw.location.row + 1u);
+        if (gradientRampCache->markRampWritten(draw.location, draw.generation))
+        {
+            m_pendingComplexGradDraws[complexGradDrawCount++] = draw;
+            m_pendingGradSpanCount += draw.gradient->count() - 1;
+        }
+    }
+    m_pendingComplexGradDraws.resize(complexGradDrawCount);
+
     // Metal requires vertex buffers to be 256-byte aligned.
     m_gradSpanPaddingCount =
         math::padding_to_align_up<gpu::kGradSpanBufferAlignmentInElements>(
@@ -908,12 +962,6 @@ void RenderContext::LogicalFlush::layoutResources(
             kMaxTessellationAlignmentVertices;
     }
 
-    // Complex gradients begin on the first row immediately after the simple
-    // gradients.
-    m_gradTextureLayout.complexOffsetY = math::lossless_numeric_cast<uint32_t>(
-        resource_texture_height<gpu::kGradTextureWidthInSimpleRamps>(
-            m_simpleGradients.size()));
-
     m_flushDesc.renderTarget = flushResources.renderTarget;
     m_flushDesc.interlockMode = m_ctx->frameInterlockMode();
     m_flushDesc.msaaSampleCount = frameDescriptor.msaaSampleCount;
@@ -1014,8 +1062,8 @@ void RenderContext::LogicalFlush::layoutResources(
         math::lossless_numeric_cast<uint32_t>(m_pendingGradSpanCount);
     m_flushDesc.firstGradSpan = runningFrameLayoutCounts->gradSpanCount +
                                 runningFrameLayoutCounts->gradSpanPaddingCount;
-    m_flushDesc.gradDataHeight = math::lossless_numeric_cast<uint32_t>(
-        m_gradTextureLayout.complexOffsetY + m_complexGradients.size());
+    m_flushDesc.gradDataHeight = gradDataHeight;
+    m_flushDesc.preserveGradTexture = gradientRampCache->capacity() != 0;
     m_flushDesc.tessDataHeight = tessDataHeight;
     m_flushDesc.clockwiseFillOverride = frameDescriptor.clockwiseFillOverride;
     m_flushDesc.wireframe = frameDescriptor.wireframe;
@@ -1098,17 +1146,15 @@ void RenderContext::LogicalFlush::writeResources()
 
     // Write out the simple gradient data.
     constexpr static uint32_t ONE_TEXEL_FIXED = 65536 / gpu::kGradTextureWidth;
-    assert(m_simpleGradients.size() == m_pendingSimpleGradDraws.size());
     if (!m_pendingSimpleGradDraws.empty())
     {
-        for (size_t i = 0; i < m_pendingSimpleGradDraws.size(); ++i)
+        for (const PendingSimpleGradDraw& draw : m_pendingSimpleGradDraws)
         {
             // Render each simple gradient as a single, empty GradientSpan with
             // 1px borders to the left and right.
-            auto [color0, color1] = m_pendingSimpleGradDraws[i];
-            uint32_t y = math::lossless_numeric_cast<uint32_t>(
-                i / gpu::kGradTextureWidthInSimpleRamps);
-            size_t centerX = (i % gpu::kGradTextureWidthInSimpleRamps) * 2 + 1;
+            auto [color0, color1] = draw.colorRamp;
+            uint32_t y = draw.location.row;
+            size_t centerX = draw.location.col + 1;
             uint32_t centerXFixed = math::lossless_numeric_cast<uint32_t>(
                 centerX * ONE_TEXEL_FIXED);
             m_ctx->m_gradSpanData.set_back(centerXFixed,
@@ -1122,20 +1168,17 @@ void RenderContext::LogicalFlush::writeResources()
     }
 
     // Write out the vertex data for rendering complex gradients.
-    assert(m_complexGradients.size() == m_pendingComplexGradDraws.size());
     if (!m_pendingComplexGradDraws.empty())
     {
-        // The viewport will start at simpleGradDataHeight when rendering color
-        // ramps.
-        for (uint32_t i = 0; i < m_pendingComplexGradDraws.size(); ++i)
+        for (const PendingComplexGradDraw& draw : m_pendingComplexGradDraws)
         {
             // Push "GradientSpan" instances that will render each section of
             // this color ramp's gradient.
-            const Gradient* gradient = m_pendingComplexGradDraws[i];
+            const Gradient* gradient = draw.gradient;
             const float* stops = gradient->stops();
             const ColorInt* colors = gradient->colors();
             size_t stopCount = gradient->count();
-            uint32_t y = i + m_gradTextureLayout.complexOffsetY;
+            uint32_t y = draw.location.row;
 
             // "stop * m + a" converts a stop position to a fixed-point x
             // coordinate in the gradient texture. (In an ideal world, stops
@@ -1203,6 +1246,11 @@ void RenderContext::LogicalFlush::writeResources()
         pushPaddingVertices(1, m_outerCubicTessEndLocation);
     }
 
+    // Nothing else writes TessVertexSpans from here on, so paths can write
+    // theirs in parallel once the draws below have reserved their locations.
+    m_deferTessellationData = m_ctx->frameDescriptor().parallelWriteResources &&
+                              m_ctx->m_parallelForProc != nullptr;
+
     // Write out all the data for our high level draws, and build up a low-level
     // draw list.
     if (m_ctx->frameInterlockMode() == gpu::InterlockMode::rasterOrdering)
@@ -1573,6 +1621,12 @@ void RenderContext::LogicalFlush::writeResources()
                m_pendingAtlasDraws.size());
     }
 
+    if (m_deferTessellationData)
+    {
+        writePendingTessellationData();
+        m_deferTessellationData = false;
+    }
+
     // Pad our buffers to 256-byte alignment.
     m_ctx->m_pathData.push_back_n(nullptr, m_pathPaddingCount);
     m_ctx->m_paintData.push_back_n(nullptr, m_paintPaddingCount);
@@ -2095,6 +2149,119 @@ uint32_t RenderContext::LogicalFlush::pushPath(const PathDraw* draw)
     return m_currentPathID;
 }
 
+void RenderContext::LogicalFlush::pushTessellationData(
+    PathDraw* draw,
+    uint32_t pathID,
+    gpu::ContourDirections contourDirections,
+    uint32_t forwardTessVertexCount,
+    uint32_t forwardTessLocation,
+    uint32_t mirroredTessVertexCount,
+    uint32_t mirroredTessLocation)
+{
+    assert(m_hasDoneLayout);
+
+    if (!m_deferTessellationData)
+    {
+        TessellationWriter tessWriter(this,
+                                      pathID,
+                                      contourDirections,
+                                      forwardTessVertexCount,
+                                      forwardTessLocation,
+                                      mirroredTessVertexCount,
+                                      mirroredTessLocation);
+        draw->writeTessellationData(&tessWriter);
+        return;
+    }
+
+    // Contour IDs and records are handed out in draw order, so reserve this
+    // draw's now.
+    size_t contourCount = draw->resourceCounts().contourCount;
+    PendingTessellationData& pending = m_pendingTessellationData.emplace_back();
+    pending.draw = draw;
+    pending.pathID = pathID;
+    pending.contourDirections = contourDirections;
+    pending.forwardTessVertexCount = forwardTessVertexCount;
+    pending.forwardTessLocation = forwardTessLocation;
+    pending.mirroredTessVertexCount = mirroredTessVertexCount;
+    pending.mirroredTessLocation = mirroredTessLocation;
+    pending.contourIDBase = m_currentContourID;
+    pending.contourData = m_ctx->m_contourData.split_back(contourCount);
+    m_currentContourID += math::lossless_numeric_cast<uint32_t>(contourCount);
+    assert(m_currentContourID <= gpu::kMaxContourID);
+
+    // The number of spans isn't known until they're written, since a span
+    // that crosses a row of the tessellation texture gets written twice. Give
+    // the draw room for one span per segment and contour, plus one more for
+    // every row its forward and mirrored vertices can cross.
+    pending.firstScratchSpan = m_pendingTessSpanCount;
+    pending.maxSpanCount =
+        draw->resourceCounts().maxTessellatedSegmentCount + contourCount +
+        (forwardTessVertexCount + mirroredTessVertexCount) /
+            kTessTextureWidth +
+        2;
+    m_pendingTessSpanCount += pending.maxSpanCount;
+}
+
+void RenderContext::LogicalFlush::writePendingTessellationData()
+{
+    if (m_pendingTessellationData.empty())
+    {
+        return;
+    }
+
+    std::vector<gpu::TessVertexSpan>& scratch = m_ctx->m_parallelTessSpans;
+    if (scratch.size() < m_pendingTessSpanCount)
+    {
+        scratch.resize(m_pendingTessSpanCount);
+    }
+    for (PendingTessellationData& pending : m_pendingTessellationData)
+    {
+        pending.tessSpanData.reset(scratch.data() + pending.firstScratchSpan,
+                                   pending.maxSpanCount);
+    }
+
+    constexpr static uint32_t kDrawsPerTask = 4;
+    m_ctx->m_parallelForProc(
+        math::lossless_numeric_cast<uint32_t>(
+            m_pendingTessellationData.size()),
+        kDrawsPerTask,
+        this,
+        [](void* context, uint32_t begin, uint32_t end) {
+            auto* flush = static_cast<LogicalFlush*>(context);
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                PendingTessellationData& pending =
+                    flush->m_pendingTessellationData[i];
+                TessellationWriter tessWriter(flush,
+                                              pending.pathID,
+                                              pending.contourDirections,
+                                              pending.forwardTessVertexCount,
+                                              pending.forwardTessLocation,
+                                              pending.mirroredTessVertexCount,
+                                              pending.mirroredTessLocation,
+                                              &pending.tessSpanData,
+                                              &pending.contourData,
+                                              pending.contourIDBase);
+                pending.draw->writeTessellationData(&tessWriter);
+                assert(pending.contourData.elementsWritten() ==
+                       pending.draw->resourceCounts().contourCount);
+            }
+        });
+
+    // Append the spans in draw order, which is where the serial path would
+    // have written them.
+    for (const PendingTessellationData& pending : m_pendingTessellationData)
+    {
+        const gpu::TessVertexSpan* spans =
+            scratch.data() + pending.firstScratchSpan;
+        m_ctx->m_tessSpanData.push_back_n(
+            spans,
+            pending.tessSpanData.elementsWritten());
+    }
+    m_pendingTessellationData.clear();
+    m_pendingTessSpanCount = 0;
+}
+
 RenderContext::TessellationWriter::TessellationWriter(
     LogicalFlush* flush,
     uint32_t pathID,
@@ -2105,6 +2272,7 @@ RenderContext::TessellationWriter::TessellationWriter(
     uint32_t mirroredTessLocation) :
     m_flush(flush),
     m_tessSpanData(m_flush->m_ctx->m_tessSpanData),
+    m_currentContourID(m_flush->m_currentContourID),
     m_pathID(pathID),
     m_contourDirections(contourDirections),
     m_pathTessLocation(forwardTessLocation),
@@ -2126,6 +2294,38 @@ RenderContext::TessellationWriter::TessellationWriter(
     assert(m_expectedPathMirroredTessEndLocation >= 0);
 }
 
+RenderContext::TessellationWriter::TessellationWriter(
+    LogicalFlush* flush,
+    uint32_t pathID,
+    gpu::ContourDirections contourDirections,
+    uint32_t forwardTessVertexCount,
+    uint32_t forwardTessLocation,
+    uint32_t mirroredTessVertexCount,
+    uint32_t mirroredTessLocation,
+    WriteOnlyMappedMemory<gpu::TessVertexSpan>* tessSpanData,
+    WriteOnlyMappedMemory<gpu::ContourData>* contourData,
+    uint32_t contourIDBase) :
+    m_flush(flush),
+    m_tessSpanData(*tessSpanData),
+    m_contourData(contourData),
+    m_currentContourID(contourIDBase),
+    m_pathID(pathID),
+    m_contourDirections(contourDirections),
+    m_pathTessLocation(forwardTessLocation),
+    m_pathMirroredTessLocation(mirroredTessLocation)
+{
+    RIVE_DEBUG_CODE(m_expectedPathTessEndLocation =
+                        m_pathTessLocation + forwardTessVertexCount;)
+    RIVE_DEBUG_CODE(m_expectedPathMirroredTessEndLocation =
+                        m_pathMirroredTessLocation - mirroredTessVertexCount;)
+    assert(m_flush->m_hasDoneLayout);
+    assert(pathID != 0);
+    assert(forwardTessVertexCount == 0 || mirroredTessVertexCount == 0 ||
+           forwardTessVertexCount == mirroredTessVertexCount);
+    assert(!gpu::ContourDirectionsAreDoubleSided(m_contourDirections) ||
+           forwardTessVertexCount == mirroredTessVertexCount);
+}
+
 RenderContext::TessellationWriter::~TessellationWriter()
 {
     assert(m_pathTessLocation == m_expectedPathTessEndLocation);
@@ -2166,11 +2366,26 @@ uint32_t RenderContext::TessellationWriter::pushContour(
     // patch size. (See math::padding_to_align_up().)
     m_nextCubicPaddingVertexCount = paddingVertexCount;
 
-    return m_flush->pushContour(m_pathID,
-                                midpoint,
-                                isStroke,
-                                closed,
-                                nextVertexIndex());
+    if (m_contourData == nullptr)
+    {
+        m_currentContourID = m_flush->pushContour(m_pathID,
+                                                  midpoint,
+                                                  isStroke,
+                                                  closed,
+                                                  nextVertexIndex());
+        return m_currentContourID;
+    }
+
+    // Same record as LogicalFlush::pushContour(), into the reserved range.
+    assert(isStroke || closed);
+    if (isStroke)
+    {
+        midpoint.x = closed ? 1 : 0;
+    }
+    m_contourData->emplace_back(midpoint, m_pathID, nextVertexIndex());
+    ++m_currentContourID;
+    assert(0 < m_currentContourID && m_currentContourID <= gpu::kMaxContourID);
+    return m_currentContourID;
 }
 
 void RenderContext::TessellationWriter::pushCubic(
@@ -2186,8 +2401,7 @@ void RenderContext::TessellationWriter::pushCubic(
            parametricSegmentCount <= kMaxParametricSegments);
     assert(0 <= polarSegmentCount && polarSegmentCount <= kMaxPolarSegments);
     assert(joinSegmentCount > 0);
-    assert((contourIDWithFlags & 0xffff) ==
-           (m_flush->m_currentContourID & 0xffff));
+    assert((contourIDWithFlags & 0xffff) == (m_currentContourID & 0xffff));
     assert((contourIDWithFlags & 0xffff) != 0); // contourID can't be zero.
 
     // Polar and parametric segments share the same beginning and ending
@@ -2457,9 +2671,10 @@ size_t RenderContext::LogicalFlush::pushInteriorTriangulationDraw(
     uint32_t baseVertex = math::lossless_numeric_cast<uint32_t>(
         m_ctx->m_triangleVertexData.elementsWritten());
     size_t actualVertexCount =
-        draw->triangulator()->polysToTriangles(pathID,
-                                               windingFaces,
-                                               &m_ctx->m_triangleVertexData);
+        draw->triangulation()->writeTriangles(pathID,
+                                              draw->negatesInteriorWinding(),
+                                              windingFaces,
+                                              &m_ctx->m_triangleVertexData);
     assert(baseVertex + actualVertexCount ==
            m_ctx->m_triangleVertexData.elementsWritten());
     if (actualVertexCount > 0)
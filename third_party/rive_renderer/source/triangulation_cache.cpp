@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "triangulation_cache.hpp"
+
+#include "gr_inner_fan_triangulator.hpp"
+#include "rive_render_path.hpp"
+#include <algorithm>
+
+namespace rive::gpu
+{
+size_t InteriorTriangulation::writeTriangles(
+    uint16_t pathID,
+    bool negateWinding,
+    WindingFaces windingFaces,
+    WriteOnlyMappedMemory<TriangleVertex>* mappedMemory) const
+{
+    assert(m_vertices.size() % 3 == 0);
+    size_t vertexCount = 0;
+    for (size_t i = 0; i < m_vertices.size(); i += 3)
+    {
+        // Each triangle has the weight of the polygon it came from.
+        int16_t weight = negateWinding
+                             ? static_cast<int16_t>(-m_vertices[i].weight)
+                             : m_vertices[i].weight;
+        if ((weight < 0 && !(windingFaces & WindingFaces::negative)) ||
+            (weight >= 0 && !(windingFaces & WindingFaces::positive)))
+        {
+            continue;
+        }
+        for (size_t j = i; j < i + 3; ++j)
+        {
+            mappedMemory->emplace_back(m_vertices[j].point, weight, pathID);
+        }
+        vertexCount += 3;
+    }
+    return vertexCount;
+}
+
+rcp<InteriorTriangulation> TriangulationCache::findOrTriangulate(
+    const RiveRenderPath* path,
+    FillRule fillRule,
+    GrTriangulator::Comparator::Direction direction,
+    const Mat2D& matrix,
+    Span<const uint8_t> numChops,
+    const RawPath& scratchPath,
+    TrivialBlockAllocator* allocator)
+{
+    uint64_t rawPathMutationID = path->getRawPathMutationID();
+    bool reverseTriangles = matrix[0] * matrix[3] - matrix[2] * matrix[1] < 0;
+
+    auto iter = m_entriesByPath.find(path);
+    if (iter != m_entriesByPath.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, iter->second);
+        const InteriorTriangulation* entry = iter->second->get();
+        if (entry->m_rawPathMutationID == rawPathMutationID &&
+            entry->m_fillRule == fillRule && entry->m_direction == direction &&
+            entry->m_reverseTriangles == reverseTriangles &&
+            std::equal(entry->m_numChops.begin(),
+                       entry->m_numChops.end(),
+                       numChops.begin(),
+                       numChops.end()))
+        {
+            ++m_counters.hits;
+            return *iter->second;
+        }
+    }
+    ++m_counters.misses;
+
+    auto triangulation = make_rcp<InteriorTriangulation>();
+    triangulation->m_path = path;
+    triangulation->m_rawPathMutationID = rawPathMutationID;
+    triangulation->m_fillRule = fillRule;
+    triangulation->m_direction = direction;
+    triangulation->m_reverseTriangles = reverseTriangles;
+    triangulation->m_numChops.assign(numChops.begin(), numChops.end());
+
+    const auto* triangulator = allocator->make<GrInnerFanTriangulator>(
+        scratchPath,
+        matrix,
+        direction,
+        fillRule,
+        allocator);
+    triangulation->m_vertices.reserve(triangulator->maxVertexCount());
+    triangulator->polysToTriangles(WindingFaces::all,
+                                   &triangulation->m_vertices);
+    for (auto* node = triangulator->groutList().head(); node;
+         node = node->fNext)
+    {
+        triangulation->m_groutTriangles.push_back(
+            {node->fPts[0], node->fPts[1], node->fPts[2]});
+    }
+
+    if (m_capacity == 0)
+    {
+        return triangulation;
+    }
+    if (iter != m_entriesByPath.end())
+    {
+        // Already moved to the front.
+        *iter->second = triangulation;
+    }
+    else
+    {
+        m_entries.push_front(triangulation);
+        m_entriesByPath[path] = m_entries.begin();
+        if (m_entries.size() > m_capacity)
+        {
+            m_entriesByPath.erase(m_entries.back()->m_path);
+            m_entries.pop_back();
+        }
+    }
+    return triangulation;
+}
+
+void TriangulationCache::setCapacity(size_t pathCount)
+{
+    m_capacity = pathCount;
+    while (m_entries.size() > m_capacity)
+    {
+        m_entriesByPath.erase(m_entries.back()->m_path);
+        m_entries.pop_back();
+    }
+}
+
+void TriangulationCache::clear()
+{
+    m_entries.clear();
+    m_entriesByPath.clear();
+}
+} // namespace rive::gpu
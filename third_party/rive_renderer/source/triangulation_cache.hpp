@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/refcnt.hpp"
+#include "rive/span.hpp"
+#include "rive/renderer/render_context.hpp"
+#include "gr_triangulator.hpp"
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace rive
+{
+class RiveRenderPath;
+} // namespace rive
+
+namespace rive::gpu
+{
+// The interior triangles and "grout" triangles a GrInnerFanTriangulator made
+// for a path, copied out of the per-frame allocator so later frames can draw
+// them again.
+class InteriorTriangulation : public RefCnt<InteriorTriangulation>
+{
+public:
+    // Upper bound on the vertices writeTriangles() emits.
+    size_t maxVertexCount() const { return m_vertices.size(); }
+
+    // Triangles that get drawn as outerCubic patches alongside the outer
+    // curves.
+    const std::vector<std::array<Vec2D, 3>>& groutTriangles() const
+    {
+        return m_groutTriangles;
+    }
+
+    // Writes the triangles whose winding faces windingFaces, in the order the
+    // triangulator emitted them. The weights are negated first if
+    // negateWinding is set. Returns the number of vertices written.
+    size_t writeTriangles(uint16_t pathID,
+                          bool negateWinding,
+                          WindingFaces windingFaces,
+                          WriteOnlyMappedMemory<TriangleVertex>*) const;
+
+private:
+    friend class TriangulationCache;
+
+    // What the triangulation was made from.
+    const RiveRenderPath* m_path = nullptr;
+    uint64_t m_rawPathMutationID = 0;
+    FillRule m_fillRule = FillRule::nonZero;
+    GrTriangulator::Comparator::Direction m_direction =
+        GrTriangulator::Comparator::Direction::kVertical;
+    bool m_reverseTriangles = false;
+    std::vector<uint8_t> m_numChops;
+
+    // Emitted for WindingFaces::all, without negating the winding.
+    std::vector<GrTriangleVertex> m_vertices;
+    std::vector<std::array<Vec2D, 3>> m_groutTriangles;
+};
+
+// Least-recently-used cache of InteriorTriangulations, with at most one entry
+// per path. The triangulator only sees a path's transform through the number
+// of lines each cubic gets chopped into and the sign of its determinant, so an
+// entry gets reused for as long as those, the raw path's mutation ID, the fill
+// rule and the sweep direction all stay the same.
+class TriangulationCache
+{
+public:
+    constexpr static size_t kDefaultCapacity = 64;
+
+    using Counters = RenderContext::TriangulationCacheCounters;
+
+    // Returns the triangulation of 'path' as seen through 'matrix'. On a miss,
+    // triangulates scratchPath, which is the path with each cubic chopped into
+    // numChops[i] lines, in 'allocator'.
+    rcp<InteriorTriangulation> findOrTriangulate(
+        const RiveRenderPath* path,
+        FillRule,
+        GrTriangulator::Comparator::Direction,
+        const Mat2D& matrix,
+        Span<const uint8_t> numChops,
+        const RawPath& scratchPath,
+        TrivialBlockAllocator* allocator);
+
+    // A capacity of 0 triangulates every path every time it's drawn.
+    void setCapacity(size_t pathCount);
+    size_t capacity() const { return m_capacity; }
+
+    void clear();
+
+    const Counters& counters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters(); }
+
+private:
+    using EntryList = std::list<rcp<InteriorTriangulation>>;
+
+    size_t m_capacity = kDefaultCapacity;
+    EntryList m_entries; // Most recently used first.
+    std::unordered_map<const RiveRenderPath*, EntryList::iterator>
+        m_entriesByPath;
+    Counters m_counters;
+};
+} // namespace rive::gpu
@@ -363,10 +363,12 @@ public:
                 .pVertexAttributeDescriptions = &vertexAttributeDescription,
             };
 
+        // Load the gradient texture, for flushes with preserveGradTexture.
+        // Otherwise its contents get invalidated by the barrier beforehand.
         VkAttachmentDescription attachment = {
             .format = VK_FORMAT_R8G8B8A8_UNORM,
             .samples = VK_SAMPLE_COUNT_1_BIT,
-            .loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .loadOp = VK_ATTACHMENT_LOAD_OP_LOAD,
             .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
             .initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
             .finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
@@ -2503,7 +2505,9 @@ void RenderContextVulkanImpl::flush(const FlushDescriptor& desc)
                 .accessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
                 .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
             },
-            vkutil::ImageAccessAction::invalidateContents);
+            desc.preserveGradTexture
+                ? vkutil::ImageAccessAction::preserveContents
+                : vkutil::ImageAccessAction::invalidateContents);
 
         VkRect2D renderArea = {
             .extent = {gpu::kGradTextureWidth, desc.gradDataHeight},
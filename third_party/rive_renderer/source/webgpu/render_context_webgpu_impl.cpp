@@ -2242,7 +2242,7 @@ void RenderContextWebGPUImpl::flush(const FlushDescriptor& desc)
     };
 
     // Render the complex color ramps to the gradient texture.
-    if (desc.gradDataHeight > 0)
+    if (desc.gradSpanCount > 0)
     {
         wgpu::BindGroupDescriptor colorRampBindGroupDesc = {
             .layout = m_colorRampPipeline->bindGroupLayout(),
@@ -2252,7 +2252,8 @@ void RenderContextWebGPUImpl::flush(const FlushDescriptor& desc)
 
         wgpu::RenderPassColorAttachment attachment = {
             .view = m_gradientTextureView,
-            .loadOp = wgpu::LoadOp::Clear,
+            .loadOp = desc.preserveGradTexture ? wgpu::LoadOp::Load
+                                               : wgpu::LoadOp::Clear,
             .storeOp = wgpu::StoreOp::Store,
             .clearValue = {},
         };